@@ -0,0 +1,461 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AsignadorSlab.h"
+#include "ErrorHandler.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+/* ================================================================
+ *          ASIGNADOR SLAB FRENTE A UN ASIGNADOR GENERAL
+ * ================================================================ */
+/**
+ * Corre la misma secuencia de pedidos de objetos de unos pocos tamaos
+ * fijos sobre el asignador slab (con y sin cargadores por CPU) y sobre
+ * un asignador general de mejor ajuste con fusin de huecos, y reporta
+ * la latencia de asignar y liberar, la memoria tomada y su
+ * fragmentacin en tres momentos:
+ *
+ * 1. Rgimen: tras llenar hasta 'vivos' objetos y mezclar asignaciones
+ *    y liberaciones al azar alrededor de ese nivel.
+ * 2. Vaciado parcial: tras liberar al azar una fraccin de los vivos,
+ *    donde los slabs quedan retenidos por unos pocos objetos.
+ * 3. Recuperacin: tras devolver los slabs vacos (solo slab).
+ */
+
+namespace {
+
+struct Opciones {
+    size_t operaciones;
+    size_t vivos;
+    vector<uint32_t> tamanos;
+    int cpus;
+    uint32_t cargador;
+    uint32_t tamSlab;
+    double liberar;
+    unsigned semilla;
+};
+
+enum TipoOperacion : uint8_t { ASIGNAR, LIBERAR };
+
+struct Operacion {
+    TipoOperacion tipo;
+    uint16_t cpu;
+    uint32_t valor;  // Tamao (ASIGNAR) o nmero al azar para elegir vctima (LIBERAR)
+};
+
+/**
+ * Estado de la memoria en un momento de la corrida.
+ */
+struct Foto {
+    uint64_t objetos;
+    uint64_t pedidos;      // Bytes pedidos por los objetos vivos
+    uint64_t tomados;      // Bytes que el asignador retiene de la arena
+    double fragmentacion;  // Segn el asignador (ver cada uno)
+};
+
+struct Fila {
+    string nombre;
+    vector<uint64_t> asignarNs;
+    vector<uint64_t> liberarNs;
+    uint64_t pico;         // Mximo de bytes tomados
+    size_t rechazos;
+    Foto regimen, vaciado, recuperado;
+    bool hayRecuperado;
+};
+
+/* ---------------- Asignador general de referencia ---------------- */
+
+/**
+ * Asignador de propsito general: cada bloque ocupa su tamao redondeado
+ * a 8 bytes (sin cabecera, a su favor), se elige el hueco ms chico que
+ * alcanza y al liberar se funde con los huecos vecinos. La memoria
+ * tomada es hasta el final del bloque ms alto; la fragmentacin es la
+ * de ResumenMemoria sobre los huecos por debajo de ese punto.
+ */
+class AsignadorGeneral {
+private:
+    map<uint32_t, uint32_t> huecos;                // inicio -> tamao
+    multimap<uint32_t, uint32_t> porTamano;        // tamao -> inicio
+    unordered_map<uint32_t, uint32_t> bloques;     // inicio -> tamao redondeado
+    unordered_map<uint32_t, uint32_t> pedidos;     // inicio -> tamao pedido
+    uint32_t fin;                                  // Final de la arena
+    uint64_t bytesPedidos;
+
+    void agregarHueco(uint32_t inicio, uint32_t tam) {
+        huecos[inicio] = tam;
+        porTamano.insert(make_pair(tam, inicio));
+    }
+
+    void quitarHueco(map<uint32_t, uint32_t>::iterator it) {
+        multimap<uint32_t, uint32_t>::iterator p = porTamano.find(it->second);
+        while (p->second != it->first) ++p;
+        porTamano.erase(p);
+        huecos.erase(it);
+    }
+
+public:
+    explicit AsignadorGeneral(uint64_t arena)
+        : fin((uint32_t)min<uint64_t>(arena, UINT32_MAX - 7)), bytesPedidos(0) {
+        agregarHueco(0, fin);
+    }
+
+    uint32_t asignar(uint32_t tamano, int) {
+        uint32_t tam = (tamano + 7) & ~7u;
+        multimap<uint32_t, uint32_t>::iterator p = porTamano.lower_bound(tam);
+        if (p == porTamano.end()) throw runtime_error("Memoria llena");
+        uint32_t inicio = p->second;
+        uint32_t libre = p->first;
+        quitarHueco(huecos.find(inicio));
+        if (libre > tam) agregarHueco(inicio + tam, libre - tam);
+        bloques[inicio] = tam;
+        pedidos[inicio] = tamano;
+        bytesPedidos += tamano;
+        return inicio;
+    }
+
+    void liberar(uint32_t inicio, int) {
+        unordered_map<uint32_t, uint32_t>::iterator b = bloques.find(inicio);
+        if (b == bloques.end()) throw runtime_error("Direccin no asignada");
+        uint32_t tam = b->second;
+        bloques.erase(b);
+        bytesPedidos -= pedidos[inicio];
+        pedidos.erase(inicio);
+
+        map<uint32_t, uint32_t>::iterator sig = huecos.lower_bound(inicio);
+        if (sig != huecos.end() && sig->first == inicio + tam) {
+            tam += sig->second;
+            quitarHueco(sig);
+            sig = huecos.lower_bound(inicio);
+        }
+        if (sig != huecos.begin()) {
+            map<uint32_t, uint32_t>::iterator ant = sig;
+            --ant;
+            if (ant->first + ant->second == inicio) {
+                inicio = ant->first;
+                tam += ant->second;
+                quitarHueco(ant);
+            }
+        }
+        agregarHueco(inicio, tam);
+    }
+
+    Foto foto() const {
+        Foto f;
+        f.objetos = bloques.size();
+        f.pedidos = bytesPedidos;
+        f.tomados = tomados();
+        uint64_t libre = 0;
+        double cuadrados = 0;
+        for (map<uint32_t, uint32_t>::const_iterator it = huecos.begin();
+             it != huecos.end() && it->first < f.tomados; ++it) {
+            libre += it->second;
+            cuadrados += (double)it->second * (double)it->second;
+        }
+        f.fragmentacion = libre ? 1.0 - cuadrados / ((double)libre * (double)libre) : 0.0;
+        return f;
+    }
+
+    /**
+     * Hasta el final del bloque ms alto: el hueco que llega al final de
+     * la arena no est tomado.
+     */
+    uint64_t tomados() const {
+        if (huecos.empty()) return fin;
+        map<uint32_t, uint32_t>::const_iterator ultimo = --huecos.end();
+        return (uint64_t)ultimo->first + ultimo->second == fin ? ultimo->first : fin;
+    }
+
+    bool recuperar() { return false; }
+};
+
+/**
+ * Adaptador del asignador slab a la misma interfaz. La fragmentacin
+ * que informa es 1 - utilizacin de los slabs tomados.
+ */
+class Slab {
+private:
+    AsignadorSlab a;
+
+public:
+    Slab(uint32_t paginas, uint32_t tamSlab, int cpus, uint32_t cargador)
+        : a(paginas, tamSlab, cpus, cargador) {}
+
+    uint32_t asignar(uint32_t tamano, int cpu) { return a.asignar(tamano, cpu); }
+    void liberar(uint32_t direccion, int cpu) { a.liberar(direccion, cpu); }
+
+    Foto foto() const {
+        ResumenSlab r = a.resumen();
+        Foto f;
+        f.objetos = r.objetos;
+        f.pedidos = r.bytesPedidos;
+        f.tomados = r.bytesSlabs;
+        f.fragmentacion = 1.0 - r.utilizacion;
+        return f;
+    }
+
+    uint64_t tomados() const { return a.resumen().bytesSlabs; }
+
+    bool recuperar() {
+        a.recuperar();
+        return true;
+    }
+
+    const AsignadorSlab& asignador() const { return a; }
+};
+
+/* ---------------- Carga ---------------- */
+
+vector<Operacion> generar(const Opciones& op, size_t& fin1) {
+    mt19937_64 azar(op.semilla);
+    vector<Operacion> ops;
+    ops.reserve(op.operaciones + op.vivos * 2);
+    size_t vivos = 0;
+    // Llenado hasta el nivel de rgimen
+    for (size_t i = 0; i < op.vivos; i++) {
+        Operacion o = { ASIGNAR, (uint16_t)(azar() % (uint64_t)op.cpus),
+                        op.tamanos[azar() % op.tamanos.size()] };
+        ops.push_back(o);
+        vivos++;
+    }
+    // Rgimen: asignar y liberar al azar, volviendo hacia 'vivos'
+    for (size_t i = 0; i < op.operaciones; i++) {
+        bool asignar = vivos == 0 || (azar() % (2 * op.vivos)) >= vivos;
+        Operacion o = { asignar ? ASIGNAR : LIBERAR, (uint16_t)(azar() % (uint64_t)op.cpus),
+                        asignar ? op.tamanos[azar() % op.tamanos.size()] : (uint32_t)azar() };
+        ops.push_back(o);
+        vivos += asignar ? 1 : -1;
+    }
+    fin1 = ops.size();
+    // Vaciado parcial
+    size_t quitar = (size_t)((double)vivos * op.liberar);
+    for (size_t i = 0; i < quitar; i++) {
+        Operacion o = { LIBERAR, (uint16_t)(azar() % (uint64_t)op.cpus), (uint32_t)azar() };
+        ops.push_back(o);
+    }
+    return ops;
+}
+
+uint64_t ahoraNs() {
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+               chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Nanosegundos entre dos lecturas del reloj, sin el costo de leerlo.
+ */
+uint64_t transcurrido(uint64_t t0, uint64_t reloj) {
+    uint64_t d = ahoraNs() - t0;
+    return d > reloj ? d - reloj : 0;
+}
+
+template <typename Asignador>
+Fila correr(const string& nombre, Asignador& a, const vector<Operacion>& ops, size_t fin1,
+            uint64_t reloj) {
+    Fila f;
+    f.nombre = nombre;
+    f.pico = 0;
+    f.rechazos = 0;
+    f.asignarNs.reserve(ops.size());
+    f.liberarNs.reserve(ops.size());
+    vector<uint32_t> vivos;
+    for (size_t i = 0; i < ops.size(); i++) {
+        const Operacion& o = ops[i];
+        if (i == fin1) f.regimen = a.foto();
+        if (o.tipo == ASIGNAR) {
+            try {
+                uint64_t t0 = ahoraNs();
+                uint32_t d = a.asignar(o.valor, o.cpu);
+                f.asignarNs.push_back(transcurrido(t0, reloj));
+                vivos.push_back(d);
+            } catch (const runtime_error&) {
+                f.rechazos++;
+            }
+            f.pico = max(f.pico, a.tomados());
+        } else if (!vivos.empty()) {
+            size_t v = o.valor % vivos.size();
+            uint32_t d = vivos[v];
+            vivos[v] = vivos.back();
+            vivos.pop_back();
+            uint64_t t0 = ahoraNs();
+            a.liberar(d, o.cpu);
+            f.liberarNs.push_back(transcurrido(t0, reloj));
+        }
+    }
+    if (fin1 == ops.size()) f.regimen = a.foto();
+    f.vaciado = a.foto();
+    f.hayRecuperado = a.recuperar();
+    f.recuperado = a.foto();
+    sort(f.asignarNs.begin(), f.asignarNs.end());
+    sort(f.liberarNs.begin(), f.liberarNs.end());
+    return f;
+}
+
+uint64_t percentil(const vector<uint64_t>& ordenadas, double q) {
+    if (ordenadas.empty()) return 0;
+    return ordenadas[(size_t)(q * (double)(ordenadas.size() - 1))];
+}
+
+double media(const vector<uint64_t>& v) {
+    if (v.empty()) return 0.0;
+    double s = 0;
+    for (size_t i = 0; i < v.size(); i++) s += (double)v[i];
+    return s / (double)v.size();
+}
+
+/**
+ * Costo de leer el reloj dos veces (mediana), que se descuenta de cada
+ * latencia.
+ */
+uint64_t costoReloj() {
+    vector<uint64_t> m(1001);
+    for (size_t i = 0; i < m.size(); i++) {
+        uint64_t t0 = ahoraNs();
+        m[i] = ahoraNs() - t0;
+    }
+    sort(m.begin(), m.end());
+    return m[m.size() / 2];
+}
+
+void mostrarFoto(const char* momento, const Foto& f) {
+    printf("   %-12s %10llu obj  %12llu pedidos  %12llu tomados  util %.3f  frag %.3f\n", momento,
+           (unsigned long long)f.objetos, (unsigned long long)f.pedidos,
+           (unsigned long long)f.tomados, f.tomados ? (double)f.pedidos / (double)f.tomados : 0.0,
+           f.fragmentacion);
+}
+
+vector<uint32_t> separar(const string& texto) {
+    vector<uint32_t> partes;
+    stringstream ss(texto);
+    string parte;
+    while (getline(ss, parte, ',')) {
+        if (!parte.empty()) partes.push_back((uint32_t)strtoul(parte.c_str(), NULL, 10));
+    }
+    return partes;
+}
+
+void mostrarUso(const char* programa) {
+    cout << "Uso: " << programa << " [--operaciones=1000000] [--vivos=50000]"
+         << " [--tamanos=24,40,64,100,200,320] [--cpus=4] [--cargador=32]"
+         << " [--tam-slab=4096] [--liberar=0.9] [--semilla=1]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Opciones op;
+    op.operaciones = 1000000;
+    op.vivos = 50000;
+    op.tamanos = separar("24,40,64,100,200,320");
+    op.cpus = 4;
+    op.cargador = 32;
+    op.tamSlab = 4096;
+    op.liberar = 0.9;
+    op.semilla = 1;
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (strncmp(a, "--operaciones=", 14) == 0) {
+            op.operaciones = strtoull(a + 14, NULL, 10);
+        } else if (strncmp(a, "--vivos=", 8) == 0) {
+            op.vivos = strtoull(a + 8, NULL, 10);
+        } else if (strncmp(a, "--tamanos=", 10) == 0) {
+            op.tamanos = separar(a + 10);
+        } else if (strncmp(a, "--cpus=", 7) == 0) {
+            op.cpus = atoi(a + 7);
+        } else if (strncmp(a, "--cargador=", 11) == 0) {
+            op.cargador = (uint32_t)strtoul(a + 11, NULL, 10);
+        } else if (strncmp(a, "--tam-slab=", 11) == 0) {
+            op.tamSlab = (uint32_t)strtoul(a + 11, NULL, 10);
+        } else if (strncmp(a, "--liberar=", 10) == 0) {
+            op.liberar = atof(a + 10);
+        } else if (strncmp(a, "--semilla=", 10) == 0) {
+            op.semilla = (unsigned)strtoul(a + 10, NULL, 10);
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    if (op.vivos == 0 || op.tamanos.empty() || op.cpus < 1 || op.cpus > 1024 ||
+        op.liberar < 0 || op.liberar > 1) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+
+    try {
+        uint32_t mayor = *max_element(op.tamanos.begin(), op.tamanos.end());
+        // Arena holgada: el doble de lo que ocuparan los vivos en el
+        // pico del rgimen, ms los cargadores llenos y un slab por clase
+        uint64_t bytes = 4 * (uint64_t)op.vivos * (mayor + 64) +
+                         (uint64_t)op.cpus * op.cargador * mayor * op.tamanos.size() +
+                         64ull * op.tamSlab;
+        uint64_t paginas = (bytes + op.tamSlab - 1) / op.tamSlab;
+        if (paginas * op.tamSlab > (1ull << 32)) {
+            throw runtime_error("La carga no cabe en una arena de 4 GiB");
+        }
+
+        size_t fin1 = 0;
+        vector<Operacion> ops = generar(op, fin1);
+        uint64_t reloj = costoReloj();
+        printf("Operaciones: %zu  Vivos: %zu  Tamaos: %zu  CPUs: %d  Slab: %u bytes"
+               "  Arena: %llu bytes\n",
+               ops.size(), op.vivos, op.tamanos.size(), op.cpus, op.tamSlab,
+               (unsigned long long)(paginas * op.tamSlab));
+        printf("Latencias en ns, descontados ~%llu ns de leer el reloj\n\n",
+               (unsigned long long)reloj);
+
+        vector<Fila> filas;
+        {
+            Slab a((uint32_t)paginas, op.tamSlab, op.cpus, op.cargador);
+            filas.push_back(correr("slab (cargador " + to_string_alt(op.cargador) + ")", a, ops,
+                                   fin1, reloj));
+            a.asignador().mostrarEstadisticas(cout);
+            cout << "\n";
+        }
+        {
+            Slab a((uint32_t)paginas, op.tamSlab, op.cpus, 0);
+            filas.push_back(correr("slab (sin cargadores)", a, ops, fin1, reloj));
+        }
+        {
+            AsignadorGeneral a(paginas * op.tamSlab);
+            filas.push_back(correr("mejor ajuste", a, ops, fin1, reloj));
+        }
+
+        printf("%-24s %8s %8s %8s %8s %8s %8s %12s %9s\n", "asignador", "asig.p50", "asig.p99",
+               "asig.med", "lib.p50", "lib.p99", "lib.med", "pico bytes", "rechazos");
+        for (size_t i = 0; i < filas.size(); i++) {
+            const Fila& f = filas[i];
+            printf("%-24s %8llu %8llu %8.1f %8llu %8llu %8.1f %12llu %9zu\n", f.nombre.c_str(),
+                   (unsigned long long)percentil(f.asignarNs, 0.50),
+                   (unsigned long long)percentil(f.asignarNs, 0.99), media(f.asignarNs),
+                   (unsigned long long)percentil(f.liberarNs, 0.50),
+                   (unsigned long long)percentil(f.liberarNs, 0.99), media(f.liberarNs),
+                   (unsigned long long)f.pico, f.rechazos);
+        }
+        printf("\nMemoria (util = pedidos / tomados; frag = 1 - utilizacin de los slabs,"
+               " o la de ResumenMemoria sobre los huecos)\n");
+        for (size_t i = 0; i < filas.size(); i++) {
+            const Fila& f = filas[i];
+            printf("%s\n", f.nombre.c_str());
+            mostrarFoto("rgimen", f.regimen);
+            mostrarFoto("vaciado", f.vaciado);
+            if (f.hayRecuperado) mostrarFoto("recuperado", f.recuperado);
+        }
+    } catch (const exception& e) {
+        ErrorHandler::manejar(e);
+        return 1;
+    }
+    return 0;
+}
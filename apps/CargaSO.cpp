@@ -0,0 +1,300 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "ErrorHandler.h"
+#include "ProtocoloRPC.h"
+#include "Utilidades.h"
+
+using namespace std;
+using namespace ProtocoloRPC;
+
+/* ================================================================
+ *          GENERADOR DE CARGA PARA EL SERVIDOR DE SIMULADORES
+ * ================================================================ */
+/**
+ * Abre varias conexiones a servidor_so; cada una crea sus instancias y
+ * les enva, con hasta 'ventana' solicitudes en vuelo, el ciclo de vida
+ * completo de procesos (insertar, encolar, despachar, asignar memoria,
+ * bloquear, avanzar el reloj, cambiar prioridad, terminar y eliminar).
+ * Reporta el rendimiento y los percentiles de latencia de ida y vuelta.
+ */
+
+namespace {
+
+struct Opciones {
+    string ruta;
+    int conexiones;
+    int instancias;
+    size_t solicitudes; // Por conexin
+    int ventana;        // Solicitudes en vuelo por conexin
+};
+
+struct Resultado {
+    size_t respondidas;
+    size_t errores;
+    string primerError;
+    vector<uint64_t> latenciasNs;
+};
+
+/**
+ * Estado de una instancia en el ciclo de operaciones.
+ */
+struct Instancia {
+    uint32_t id;
+    int pid;   // Proceso del ciclo en curso
+    int paso;
+};
+
+const int PASOS_CICLO = 10;
+
+#ifndef _WIN32
+
+int conectar(const string& ruta) {
+    sockaddr_un dir;
+    memset(&dir, 0, sizeof(dir));
+    dir.sun_family = AF_UNIX;
+    if (ruta.size() >= sizeof(dir.sun_path)) throw runtime_error("Ruta de socket invlida");
+    memcpy(dir.sun_path, ruta.c_str(), ruta.size());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (const sockaddr*)&dir, sizeof(dir)) < 0) {
+        if (fd >= 0) close(fd);
+        throw runtime_error("No se pudo conectar a " + ruta + ": " + strerror(errno));
+    }
+    return fd;
+}
+
+void enviarTodo(int fd, const string& datos) {
+    size_t enviados = 0;
+    while (enviados < datos.size()) {
+        ssize_t n = send(fd, datos.data() + enviados, datos.size() - enviados, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw runtime_error("Conexin cerrada por el servidor");
+        enviados += (size_t)n;
+    }
+}
+
+/**
+ * Lee lo disponible (bloquea hasta que llegue algo) y llama a
+ * f(respuesta, texto, largoTexto) por cada respuesta completa.
+ */
+template <typename F>
+void recibir(int fd, string& entrada, F f) {
+    char buf[65536];
+    ssize_t n;
+    do {
+        n = read(fd, buf, sizeof(buf));
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) throw runtime_error("Conexin cerrada por el servidor");
+    entrada.append(buf, (size_t)n);
+
+    size_t pos = 0;
+    for (;;) {
+        uint32_t longitud = longitudMensaje(entrada.data() + pos, entrada.size() - pos);
+        if (longitud == 0 || entrada.size() - pos < longitud) break;
+        if (longitud < sizeof(Respuesta)) throw runtime_error("Respuesta mal formada");
+        Respuesta r;
+        memcpy(&r, entrada.data() + pos, sizeof(r));
+        f(r, entrada.data() + pos + sizeof(r), longitud - sizeof(r));
+        pos += longitud;
+    }
+    entrada.erase(0, pos);
+}
+
+/**
+ * Enva un lote y espera todas sus respuestas (preparacin y limpieza).
+ */
+void sincronico(int fd, const string& lote, size_t cuantas) {
+    enviarTodo(fd, lote);
+    string entrada;
+    size_t recibidas = 0;
+    while (recibidas < cuantas) {
+        recibir(fd, entrada, [&recibidas](const Respuesta&, const char*, size_t) { recibidas++; });
+    }
+}
+
+/**
+ * Siguiente solicitud del ciclo de una instancia.
+ */
+void siguienteSolicitud(string& salida, uint32_t id, Instancia& ins) {
+    switch (ins.paso) {
+        case 0:
+            ins.pid++;
+            escribirSolicitud(salida, id, ins.id, INSERTAR_PROCESO, ins.pid, ins.pid % 101,
+                              "worker-" + to_string_alt(ins.pid % 16));
+            break;
+        case 1: escribirSolicitud(salida, id, ins.id, ENCOLAR, ins.pid); break;
+        case 2: escribirSolicitud(salida, id, ins.id, DESPACHAR); break;
+        case 3: escribirSolicitud(salida, id, ins.id, ASIGNAR_MEMORIA, ins.pid, ins.pid); break;
+        case 4: escribirSolicitud(salida, id, ins.id, BLOQUEAR, 2); break;
+        case 5: escribirSolicitud(salida, id, ins.id, AVANZAR_TIEMPO, 2); break;
+        case 6: escribirSolicitud(salida, id, ins.id, DESPACHAR); break;
+        case 7: escribirSolicitud(salida, id, ins.id, CAMBIAR_PRIORIDAD, ins.pid, 50); break;
+        case 8: escribirSolicitud(salida, id, ins.id, TERMINAR); break;
+        default: escribirSolicitud(salida, id, ins.id, ELIMINAR_PROCESO, ins.pid); break;
+    }
+    ins.paso = (ins.paso + 1) % PASOS_CICLO;
+}
+
+void conexion(const Opciones& op, int indice, Resultado& res) {
+    int fd = conectar(op.ruta);
+
+    // Instancias de esta conexin: indice, indice + conexiones, ...
+    vector<Instancia> propias;
+    for (int i = indice; i < op.instancias; i += op.conexiones) {
+        Instancia ins = { (uint32_t)i + 1, 0, 0 };
+        propias.push_back(ins);
+    }
+    if (propias.empty()) {
+        close(fd);
+        return;
+    }
+    string lote;
+    for (size_t i = 0; i < propias.size(); i++) {
+        // Quita las que hayan quedado de una corrida anterior
+        escribirSolicitud(lote, 0, propias[i].id, DESTRUIR_INSTANCIA);
+        escribirSolicitud(lote, 0, propias[i].id, CREAR_INSTANCIA);
+    }
+    sincronico(fd, lote, 2 * propias.size());
+
+    vector<chrono::steady_clock::time_point> envio(op.solicitudes);
+    res.latenciasNs.reserve(op.solicitudes);
+    string entrada;
+    size_t enviadas = 0, siguiente = 0;
+    while (res.respondidas < op.solicitudes) {
+        lote.clear();
+        size_t desde = enviadas;
+        while (enviadas < op.solicitudes && enviadas - res.respondidas < (size_t)op.ventana) {
+            siguienteSolicitud(lote, (uint32_t)enviadas, propias[siguiente]);
+            siguiente = (siguiente + 1) % propias.size();
+            enviadas++;
+        }
+        if (!lote.empty()) {
+            chrono::steady_clock::time_point ahora = chrono::steady_clock::now();
+            for (size_t i = desde; i < enviadas; i++) envio[i] = ahora;
+            enviarTodo(fd, lote);
+        }
+        recibir(fd, entrada, [&](const Respuesta& r, const char* texto, size_t largo) {
+            chrono::steady_clock::time_point ahora = chrono::steady_clock::now();
+            res.latenciasNs.push_back((uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+                                          ahora - envio[r.id]).count());
+            res.respondidas++;
+            if (r.estado != OK) {
+                if (res.errores++ == 0) res.primerError.assign(texto, largo);
+            }
+        });
+    }
+
+    lote.clear();
+    for (size_t i = 0; i < propias.size(); i++) {
+        escribirSolicitud(lote, 0, propias[i].id, DESTRUIR_INSTANCIA);
+    }
+    sincronico(fd, lote, propias.size());
+    close(fd);
+}
+
+#else
+
+void conexion(const Opciones&, int, Resultado&) {
+    throw runtime_error("El generador de carga requiere sockets Unix");
+}
+
+#endif
+
+double percentilUs(const vector<uint64_t>& ordenadas, double q) {
+    if (ordenadas.empty()) return 0.0;
+    size_t i = (size_t)(q * (double)(ordenadas.size() - 1));
+    return (double)ordenadas[i] / 1000.0;
+}
+
+void mostrarUso(const char* programa) {
+    cout << "Uso: " << programa << " [--socket=" << SOCKET_DEFECTO << "] [--conexiones=4]"
+         << " [--instancias=64] [--solicitudes=200000] [--ventana=64]\n"
+         << "  --solicitudes es por conexin\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Opciones op = { SOCKET_DEFECTO, 4, 64, 200000, 64 };
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--socket=", 9) == 0) {
+            op.ruta = argv[i] + 9;
+        } else if (strncmp(argv[i], "--conexiones=", 13) == 0) {
+            op.conexiones = max(1, atoi(argv[i] + 13));
+        } else if (strncmp(argv[i], "--instancias=", 13) == 0) {
+            op.instancias = max(1, atoi(argv[i] + 13));
+        } else if (strncmp(argv[i], "--solicitudes=", 14) == 0) {
+            op.solicitudes = strtoull(argv[i] + 14, NULL, 10);
+        } else if (strncmp(argv[i], "--ventana=", 10) == 0) {
+            op.ventana = max(1, atoi(argv[i] + 10));
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    if (op.instancias < op.conexiones) op.instancias = op.conexiones;
+
+    vector<Resultado> resultados(op.conexiones);
+    vector<string> fallos(op.conexiones);
+    vector<thread> hilos;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (int c = 0; c < op.conexiones; c++) {
+        resultados[c].respondidas = 0;
+        resultados[c].errores = 0;
+        hilos.push_back(thread([&op, &resultados, &fallos, c]() {
+            try {
+                conexion(op, c, resultados[c]);
+            } catch (const exception& e) {
+                fallos[c] = e.what();
+            }
+        }));
+    }
+    for (size_t c = 0; c < hilos.size(); c++) hilos[c].join();
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    vector<uint64_t> latencias;
+    size_t respondidas = 0, errores = 0;
+    string primerError;
+    for (int c = 0; c < op.conexiones; c++) {
+        if (!fallos[c].empty()) {
+            ErrorHandler::manejar(runtime_error("Conexin " + to_string_alt(c) + ": " + fallos[c]));
+            return 1;
+        }
+        respondidas += resultados[c].respondidas;
+        errores += resultados[c].errores;
+        if (primerError.empty()) primerError = resultados[c].primerError;
+        latencias.insert(latencias.end(), resultados[c].latenciasNs.begin(),
+                         resultados[c].latenciasNs.end());
+    }
+    sort(latencias.begin(), latencias.end());
+
+    cout << "Conexiones: " << op.conexiones << "  instancias: " << op.instancias
+         << "  ventana: " << op.ventana << "\n";
+    cout << "Solicitudes: " << respondidas << " en " << fixed << setprecision(3) << segundos
+         << " s (" << setprecision(0) << (segundos > 0 ? respondidas / segundos : 0.0)
+         << " sol/s)\n";
+    cout << "Rechazadas por el simulador: " << errores;
+    if (errores) cout << " (p. ej. \"" << primerError << "\")";
+    cout << "\n" << setprecision(1);
+    cout << "Latencia us  p50 " << percentilUs(latencias, 0.50) << "  p90 "
+         << percentilUs(latencias, 0.90) << "  p99 " << percentilUs(latencias, 0.99)
+         << "  p99.9 " << percentilUs(latencias, 0.999) << "  max "
+         << (latencias.empty() ? 0.0 : latencias.back() / 1000.0) << "\n";
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "ErrorHandler.h"
+#include "Persistencia.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+/* ================================================================
+ *          COMPARACIN DE FORMATOS DE PERSISTENCIA
+ * ================================================================ */
+/**
+ * Escribe la misma tabla de procesos en CSV y en el formato comprimido,
+ * y reporta tamao, razn de compresin y tiempos de guardado y carga.
+ * La tabla se genera (IDs crecientes, pocos nombres distintos) o se
+ * toma de un archivo existente.
+ */
+
+static void mostrarUso(const char* programa) {
+    cout << "Uso: " << programa << " [archivo] [--procesos=1000000] [--nombres=64]"
+         << " [--hilos=0] [--rep=3]\n";
+}
+
+static void liberar(NodoProcesso* p) {
+    while (p) {
+        NodoProcesso* sig = p->siguiente;
+        delete p;
+        p = sig;
+    }
+}
+
+static long tamArchivo(const string& ruta) {
+    FILE* f = fopen(ruta.c_str(), "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long tam = ftell(f);
+    fclose(f);
+    return tam;
+}
+
+template <typename F>
+static double mejorTiempoMs(int rep, F f) {
+    double mejor = 1e300;
+    for (int r = 0; r < rep; r++) {
+        chrono::steady_clock::time_point ini = chrono::steady_clock::now();
+        f();
+        mejor = min(mejor, chrono::duration<double, milli>(chrono::steady_clock::now() - ini).count());
+    }
+    return mejor;
+}
+
+int main(int argc, char** argv) {
+    string origen;
+    size_t procesos = 1000000;
+    size_t nombres = 64;
+    unsigned hilos = 0;
+    int rep = 3;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--procesos=", 11) == 0) {
+            procesos = strtoull(argv[i] + 11, NULL, 10);
+        } else if (strncmp(argv[i], "--nombres=", 10) == 0) {
+            nombres = max<size_t>(1, strtoull(argv[i] + 10, NULL, 10));
+        } else if (strncmp(argv[i], "--hilos=", 8) == 0) {
+            hilos = (unsigned)strtoul(argv[i] + 8, NULL, 10);
+        } else if (strncmp(argv[i], "--rep=", 6) == 0) {
+            rep = max(1, atoi(argv[i] + 6));
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            mostrarUso(argv[0]);
+            return 1;
+        } else {
+            origen = argv[i];
+        }
+    }
+
+    const string csv = "comparar_procesos.csv.dat";
+    const string comp = "comparar_procesos.z.dat";
+    try {
+        NodoProcesso* cabeza = NULL;
+        if (!origen.empty()) {
+            cabeza = Persistencia::cargarProcesos(origen);
+            if (!cabeza) throw runtime_error("No se pudo leer " + origen);
+        } else {
+            // IDs crecientes con huecos pequeos y nombres repetidos
+            NodoProcesso* ultimo = NULL;
+            uint64_t x = 88172645463325252ull;
+            int id = 1;
+            for (size_t i = 0; i < procesos; i++) {
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                id += 1 + (int)(x % 4);
+                NodoProcesso* n = new NodoProcesso(
+                    id, "servicio_" + to_string_alt((int)((x >> 8) % nombres)),
+                    (int)((x >> 24) % 101));
+                if (ultimo) ultimo->siguiente = n; else cabeza = n;
+                ultimo = n;
+            }
+        }
+        size_t registros = 0;
+        for (NodoProcesso* p = cabeza; p; p = p->siguiente) registros++;
+
+        double guardarCsv = mejorTiempoMs(rep, [&]() { Persistencia::guardarProcesos(cabeza, csv); });
+        double guardarComp = mejorTiempoMs(rep, [&]() {
+            Persistencia::guardarProcesosComprimido(cabeza, comp);
+        });
+        liberar(cabeza);
+
+        double cargarCsv1 = mejorTiempoMs(rep, [&]() {
+            liberar(Persistencia::cargarProcesosCsv(csv, 1));
+        });
+        double cargarCsv = mejorTiempoMs(rep, [&]() {
+            liberar(Persistencia::cargarProcesosCsv(csv, hilos));
+        });
+        double cargarComp = mejorTiempoMs(rep, [&]() {
+            liberar(Persistencia::cargarProcesosComprimido(comp, hilos));
+        });
+
+        long tamCsv = tamArchivo(csv);
+        long tamComp = tamArchivo(comp);
+        cout << "Registros: " << registros << "\n\n";
+        cout << left << setw(12) << "formato" << right << setw(14) << "bytes" << setw(14)
+             << "guardar ms" << setw(14) << "cargar ms" << "\n";
+        cout << fixed << setprecision(2);
+        cout << left << setw(12) << "csv" << right << setw(14) << tamCsv << setw(14) << guardarCsv
+             << setw(14) << cargarCsv1 << "  (1 hilo)\n";
+        cout << left << setw(12) << "csv" << right << setw(14) << tamCsv << setw(14) << guardarCsv
+             << setw(14) << cargarCsv << "  (paralelo)\n";
+        cout << left << setw(12) << "comprimido" << right << setw(14) << tamComp << setw(14)
+             << guardarComp << setw(14) << cargarComp << "\n\n";
+        cout << "Razn de compresin: " << (tamComp > 0 ? (double)tamCsv / tamComp : 0.0) << "x\n";
+        cout << "Aceleracin de carga CSV paralela: "
+             << (cargarCsv > 0 ? cargarCsv1 / cargarCsv : 0.0) << "x\n";
+        cout << "Aceleracin de carga comprimida: "
+             << (cargarComp > 0 ? cargarCsv / cargarComp : 0.0) << "x\n";
+    } catch (const exception& e) {
+        ErrorHandler::manejar(e);
+        remove(csv.c_str());
+        remove(comp.c_str());
+        return 1;
+    }
+    remove(csv.c_str());
+    remove(comp.c_str());
+    return 0;
+}
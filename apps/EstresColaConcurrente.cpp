@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ColaMPMC.h"
+#include "ErrorHandler.h"
+
+using namespace std;
+
+/* ================================================================
+ *          PRUEBA DE ESTRS DE LA COLA CONCURRENTE POR BANDAS
+ * ================================================================ */
+/**
+ * Varios hilos encolan y desencolan al azar sobre una misma ColaBandas
+ * y anotan, para cada operacin, el instante de invocacin y el de
+ * respuesta. Al terminar se vaca la cola y se verifica la historia:
+ *
+ * - Conservacin: todo lo encolado sale exactamente una vez, y nada sale
+ *   sin haber entrado.
+ * - Causalidad: nada sale antes de que se invoque su encolado.
+ * - FIFO linealizable por banda: si encolar(x) respondi antes de que se
+ *   invocara encolar(y) en la misma banda, no puede ser que desencolar(y)
+ *   responda antes de que se invoque desencolar(x).
+ *
+ * Tambin cuenta (sin tratarlas como error) las relajaciones que la cola
+ * documenta: "vaca" o una banda ms baja mientras un elemento de una
+ * banda ms alta estuvo presente durante toda la operacin.
+ *
+ * Los valores codifican hilo, secuencia y prioridad, as no hace falta
+ * crear procesos: la verificacin es sobre el mismo ColaBandas que usa
+ * ColaListosConcurrente.
+ */
+
+namespace {
+
+enum TipoEvento : uint8_t { ENCOLAR, ENCOLAR_LLENA, DESENCOLAR, DESENCOLAR_VACIA };
+
+struct Evento {
+    uint64_t valor;
+    uint64_t ini;   // ns desde el arranque
+    uint64_t fin;
+    TipoEvento tipo;
+    int8_t banda;   // Banda de la que sali (DESENCOLAR)
+};
+
+struct PrioridadCodificada {
+    int operator()(uint64_t v) const { return (int)(v & 127); }
+};
+
+typedef ColaBandas<uint64_t, PrioridadCodificada> Cola;
+
+chrono::steady_clock::time_point arranque;
+
+uint64_t ahoraNs() {
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() -
+                                                                 arranque).count();
+}
+
+void mostrarUso(const char* programa) {
+    cout << "Uso: " << programa << " [--hilos=8] [--operaciones=200000] [--bandas=8]"
+         << " [--capacidad=1024] [--semilla=1]\n";
+}
+
+void trabajar(Cola& cola, int hilo, size_t operaciones, unsigned semilla,
+              atomic<int>& listos, vector<Evento>& historia) {
+    mt19937_64 azar(semilla * 7919u + (unsigned)hilo);
+    historia.reserve(operaciones);
+    uint64_t secuencia = 0;
+    listos.fetch_sub(1);
+    while (listos.load() > 0) this_thread::yield();  // Todos arrancan a la vez
+
+    for (size_t i = 0; i < operaciones; i++) {
+        Evento e;
+        e.banda = -1;
+        if (azar() & 1) {
+            e.valor = ((uint64_t)hilo << 40) | (secuencia++ << 7) | (azar() % 101);
+            e.ini = ahoraNs();
+            bool ok = cola.encolar(e.valor);
+            e.fin = ahoraNs();
+            e.tipo = ok ? ENCOLAR : ENCOLAR_LLENA;
+        } else {
+            int banda = -1;
+            e.ini = ahoraNs();
+            bool ok = cola.desencolar(e.valor, &banda);
+            e.fin = ahoraNs();
+            e.tipo = ok ? DESENCOLAR : DESENCOLAR_VACIA;
+            e.banda = (int8_t)banda;
+            if (!ok) e.valor = 0;
+        }
+        historia.push_back(e);
+    }
+}
+
+/**
+ * Par encolado/desencolado de un elemento.
+ */
+struct Vida {
+    uint64_t encIni, encFin, desIni, desFin;
+    int banda;
+};
+
+/**
+ * Cuenta los elementos y de 'ys' para los que existe algn x de 'xs' que
+ * respondi su "antes" (clave a) antes de la invocacin de y (clave b) y
+ * cuyo "despus" (c) se invoc despus de la respuesta de y (d).
+ * Barrido O(n log n) con el mximo de c entre los x ya vistos.
+ */
+template <typename X, typename Y, typename A, typename B, typename C, typename D>
+size_t contarCruces(vector<X> xs, vector<Y> ys, A a, B b, C c, D d) {
+    sort(xs.begin(), xs.end(), [&](const X& p, const X& q) { return a(p) < a(q); });
+    sort(ys.begin(), ys.end(), [&](const Y& p, const Y& q) { return b(p) < b(q); });
+    size_t i = 0, cruces = 0;
+    uint64_t maximo = 0;
+    bool hay = false;
+    for (size_t j = 0; j < ys.size(); j++) {
+        while (i < xs.size() && a(xs[i]) < b(ys[j])) {
+            if (!hay || c(xs[i]) > maximo) maximo = c(xs[i]);
+            hay = true;
+            i++;
+        }
+        if (hay && maximo > d(ys[j])) cruces++;
+    }
+    return cruces;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int hilos = 8;
+    size_t operaciones = 200000;
+    int bandas = 8;
+    size_t capacidad = 1024;
+    unsigned semilla = 1;
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (strncmp(a, "--hilos=", 8) == 0) {
+            hilos = atoi(a + 8);
+        } else if (strncmp(a, "--operaciones=", 14) == 0) {
+            operaciones = strtoull(a + 14, NULL, 10);
+        } else if (strncmp(a, "--bandas=", 9) == 0) {
+            bandas = atoi(a + 9);
+        } else if (strncmp(a, "--capacidad=", 12) == 0) {
+            capacidad = strtoull(a + 12, NULL, 10);
+        } else if (strncmp(a, "--semilla=", 10) == 0) {
+            semilla = (unsigned)strtoul(a + 10, NULL, 10);
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    if (hilos < 1 || hilos > 255 || operaciones == 0) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+
+    try {
+        Cola cola(bandas, capacidad);
+        arranque = chrono::steady_clock::now();
+        vector<vector<Evento> > historias((size_t)hilos + 1);
+        vector<thread> trabajadores;
+        atomic<int> listos(hilos);
+        for (int h = 0; h < hilos; h++) {
+            trabajadores.push_back(thread(trabajar, ref(cola), h, operaciones, semilla, ref(listos),
+                                          ref(historias[(size_t)h])));
+        }
+        for (size_t h = 0; h < trabajadores.size(); h++) trabajadores[h].join();
+
+        // Lo que qued se saca con la cola ya quieta
+        vector<Evento>& resto = historias[(size_t)hilos];
+        for (;;) {
+            Evento e;
+            int banda = -1;
+            e.ini = ahoraNs();
+            if (!cola.desencolar(e.valor, &banda)) break;
+            e.fin = ahoraNs();
+            e.tipo = DESENCOLAR;
+            e.banda = (int8_t)banda;
+            resto.push_back(e);
+        }
+
+        /* ---- Conservacin y causalidad ---- */
+        size_t llenas = 0, vacias = 0, errores = 0;
+        unordered_map<uint64_t, Vida> vidas;
+        vector<Evento> vaciasEv;
+        vector<Evento> desencolados;
+        for (size_t h = 0; h < historias.size(); h++) {
+            for (size_t i = 0; i < historias[h].size(); i++) {
+                const Evento& e = historias[h][i];
+                if (e.tipo == ENCOLAR) {
+                    Vida v = { e.ini, e.fin, 0, 0, cola.bandaDe(PrioridadCodificada()(e.valor)) };
+                    vidas[e.valor] = v;
+                } else if (e.tipo == ENCOLAR_LLENA) {
+                    llenas++;
+                } else if (e.tipo == DESENCOLAR_VACIA) {
+                    vacias++;
+                    vaciasEv.push_back(e);
+                } else {
+                    desencolados.push_back(e);
+                }
+            }
+        }
+        size_t sinSalir = vidas.size();
+        for (size_t i = 0; i < desencolados.size(); i++) {
+            const Evento& e = desencolados[i];
+            unordered_map<uint64_t, Vida>::iterator it = vidas.find(e.valor);
+            if (it == vidas.end()) {
+                if (errores++ < 5) printf("ERROR: sali %llx sin haberse encolado\n",
+                                          (unsigned long long)e.valor);
+                continue;
+            }
+            Vida& v = it->second;
+            if (v.desFin != 0) {
+                if (errores++ < 5) printf("ERROR: %llx sali dos veces\n", (unsigned long long)e.valor);
+                continue;
+            }
+            if (e.banda != v.banda) {
+                if (errores++ < 5) printf("ERROR: %llx sali de la banda %d y no de la %d\n",
+                                          (unsigned long long)e.valor, e.banda, v.banda);
+            }
+            if (e.fin < v.encIni) {
+                if (errores++ < 5) printf("ERROR: %llx sali antes de encolarse\n",
+                                          (unsigned long long)e.valor);
+            }
+            v.desIni = e.ini;
+            v.desFin = e.fin;
+            sinSalir--;
+        }
+        if (sinSalir != 0) {
+            errores++;
+            printf("ERROR: %zu elementos encolados nunca salieron\n", sinSalir);
+        }
+
+        /* ---- FIFO por banda y relajaciones ---- */
+        vector<vector<Vida> > porBanda((size_t)bandas);
+        vector<Vida> todas;
+        for (unordered_map<uint64_t, Vida>::const_iterator it = vidas.begin(); it != vidas.end(); ++it) {
+            porBanda[(size_t)it->second.banda].push_back(it->second);
+            todas.push_back(it->second);
+        }
+        size_t fifo = 0;
+        for (int b = 0; b < bandas; b++) {
+            fifo += contarCruces(
+                porBanda[(size_t)b], porBanda[(size_t)b], [](const Vida& x) { return x.encFin; },
+                [](const Vida& y) { return y.encIni; }, [](const Vida& x) { return x.desIni; },
+                [](const Vida& y) { return y.desFin; });
+        }
+        if (fifo != 0) {
+            errores += fifo;
+            printf("ERROR: %zu violaciones del orden FIFO dentro de una banda\n", fifo);
+        }
+
+        size_t vaciasConDatos = contarCruces(
+            todas, vaciasEv, [](const Vida& x) { return x.encFin; },
+            [](const Evento& e) { return e.ini; }, [](const Vida& x) { return x.desIni; },
+            [](const Evento& e) { return e.fin; });
+        size_t inversiones = 0;
+        for (int b = 1; b < bandas; b++) {
+            vector<Evento> masBajas;
+            for (size_t i = 0; i < desencolados.size(); i++) {
+                if (desencolados[i].banda < b) masBajas.push_back(desencolados[i]);
+            }
+            inversiones += contarCruces(
+                porBanda[(size_t)b], masBajas, [](const Vida& x) { return x.encFin; },
+                [](const Evento& e) { return e.ini; }, [](const Vida& x) { return x.desIni; },
+                [](const Evento& e) { return e.fin; });
+        }
+
+        printf("Hilos: %d  Operaciones: %zu  Bandas: %d  Capacidad por banda: %zu\n", hilos,
+               (size_t)hilos * operaciones, bandas, capacidad);
+        printf("Encolados: %zu  Llenas: %zu  Vacas: %zu  Vaciado final: %zu\n", vidas.size(),
+               llenas, vacias, resto.size());
+        printf("Relajaciones: %zu vacas con datos presentes, %zu salidas de banda ms baja\n",
+               vaciasConDatos, inversiones);
+        printf(errores == 0 ? "Historia correcta\n" : "Historia INCORRECTA (%zu errores)\n", errores);
+        return errores == 0 ? 0 : 1;
+    } catch (const exception& e) {
+        ErrorHandler::manejar(e);
+        return 1;
+    }
+}
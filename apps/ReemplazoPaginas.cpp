@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ErrorHandler.h"
+#include "LectorTraza.h"
+#include "MemoriaVirtual.h"
+#include "Reemplazo.h"
+
+using namespace std;
+
+/* ================================================================
+ *          SIMULADOR DE ALGORITMOS DE REEMPLAZO
+ * ================================================================ */
+/**
+ * Reproduce una traza una sola vez alimentando a la vez todas las
+ * combinaciones de algoritmo y nmero de marcos pedidas, y reporta la
+ * tasa de fallos y los desalojos de cada una. La traza se lee en
+ * streaming: la memoria usada solo depende de los marcos simulados.
+ */
+
+static void mostrarUso(const char* programa) {
+    cout << "Uso: " << programa << " <traza> [--politicas=fifo,lru,clock,lfu,arc]"
+         << " [--marcos=16,64,256]\n";
+}
+
+static vector<string> separar(const string& texto) {
+    vector<string> partes;
+    stringstream ss(texto);
+    string parte;
+    while (getline(ss, parte, ',')) {
+        if (!parte.empty()) partes.push_back(parte);
+    }
+    return partes;
+}
+
+int main(int argc, char** argv) {
+    string traza;
+    vector<string> politicas = separar("fifo,lru,clock,lfu,arc");
+    vector<string> marcos = separar("16,64,256");
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--politicas=", 12) == 0) {
+            politicas = separar(argv[i] + 12);
+        } else if (strncmp(argv[i], "--marcos=", 9) == 0) {
+            marcos = separar(argv[i] + 9);
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            mostrarUso(argv[0]);
+            return 1;
+        } else {
+            traza = argv[i];
+        }
+    }
+    if (traza.empty()) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+
+    vector<AlgoritmoReemplazo*> algoritmos;
+    try {
+        for (size_t m = 0; m < marcos.size(); m++) {
+            size_t n = strtoull(marcos[m].c_str(), NULL, 10);
+            for (size_t p = 0; p < politicas.size(); p++) {
+                algoritmos.push_back(crearAlgoritmoReemplazo(politicas[p], n));
+            }
+        }
+
+        LectorTraza lector(traza);
+        AccesoMemoria acceso;
+        uint64_t total = 0;
+        chrono::steady_clock::time_point ini = chrono::steady_clock::now();
+        while (lector.siguiente(acceso)) {
+            uint64_t clave = TLB::etiqueta(acceso.pid, acceso.direccion >> BITS_DESPLAZAMIENTO);
+            uint64_t victima;
+            for (size_t a = 0; a < algoritmos.size(); a++) {
+                algoritmos[a]->referenciar(clave, victima);
+            }
+            total++;
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - ini).count();
+
+        printf("Referencias: %llu  Simulaciones: %zu  Tiempo: %.1f ms\n\n",
+               (unsigned long long)total, algoritmos.size(), ms);
+        printf("%-8s %10s %14s %12s %14s\n", "algoritmo", "marcos", "fallos",
+               "tasa fallos", "desalojos");
+        for (size_t a = 0; a < algoritmos.size(); a++) {
+            AlgoritmoReemplazo* alg = algoritmos[a];
+            printf("%-8s %10zu %14llu %11.4f%% %14llu\n", alg->nombre(), alg->getCapacidad(),
+                   (unsigned long long)alg->getFallos(), alg->tasaFallos() * 100.0,
+                   (unsigned long long)alg->getDesalojos());
+        }
+    } catch (const exception& e) {
+        ErrorHandler::manejar(e);
+        for (size_t a = 0; a < algoritmos.size(); a++) delete algoritmos[a];
+        return 1;
+    }
+    for (size_t a = 0; a < algoritmos.size(); a++) delete algoritmos[a];
+    return 0;
+}
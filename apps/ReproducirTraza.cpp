@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CargasTrabajo.h"
+#include "ErrorHandler.h"
+#include "ReproductorTraza.h"
+#include "Simulador.h"
+#include "Traza.h"
+
+using namespace std;
+
+/* ================================================================
+ *          REPRODUCTOR DE TRAZAS DE OPERACIONES
+ * ================================================================ */
+/**
+ * Reproduce una traza grabada con Traza a mxima velocidad, verifica que
+ * cada operacin d el mismo resultado que al grabarla y reporta el
+ * rendimiento. Tambin puede grabar una traza sinttica a partir de una
+ * carga del simulador con procesos corrutina.
+ */
+
+static void mostrarUso(const char* programa) {
+    cout << "Uso:\n"
+         << "  " << programa << " <traza> [--repeticiones=N] [--operaciones]\n"
+         << "  " << programa << " --generar=<archivo> [--procesos=N] [--semilla=S]\n";
+}
+
+/**
+ * Lee el valor de una opcin --nombre=valor.
+ */
+static const char* valorOpcion(const char* arg, const char* nombre) {
+    size_t n = strlen(nombre);
+    return strncmp(arg, nombre, n) == 0 ? arg + n : NULL;
+}
+
+/**
+ * Graba una traza de una carga mixta: llegan procesos con memoria y un
+ * cuerpo (de CPU o interactivo), se ejecutan por quantums, cambian de
+ * prioridad y se eliminan al terminar.
+ */
+static void generar(const string& archivo, int procesos, uint32_t semilla) {
+    uint64_t x = semilla ? semilla : 1;
+    auto azar = [&x](uint64_t n) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return x % n;
+    };
+
+    Simulador sim("", procesos * 3, 256);
+    Traza::iniciar(archivo);
+    vector<int> vivos;
+    int direccion = 0;
+    for (int id = 1; id <= procesos; id++) {
+        sim.getProcesos().insertarProcesso(id, "proc" + to_string(id), (int)azar(101));
+        for (int b = 1 + (int)azar(3); b > 0; b--) sim.asignarMemoria(id, direccion++);
+        if (azar(2)) {
+            sim.asignarCuerpo(id, CargasTrabajo::primos(50 + azar(300)));
+        } else {
+            sim.asignarCuerpo(id, CargasTrabajo::interactivo(1 + azar(4), 5 + azar(20),
+                                                             5 + azar(40)));
+        }
+        sim.encolar(id);
+        vivos.push_back(id);
+
+        if (azar(8) == 0) {
+            int otro = vivos[azar(vivos.size())];
+            sim.cambiarPrioridad(otro, (int)azar(101));
+        }
+        for (int q = (int)azar(3); q > 0; q--) {
+            if (!sim.getEnEjecucion() && !sim.getPlanificador().frente()) break;
+            ResultadoQuantum r = sim.ejecutarQuantum(10);
+            if (r.motivo == CuerpoProceso::TERMINO) {
+                sim.eliminarProceso(r.id);
+                vivos.erase(find(vivos.begin(), vivos.end(), r.id));
+            }
+        }
+    }
+    sim.correr(10, (size_t)-1);
+    for (size_t i = 0; i < vivos.size(); i++) sim.eliminarProceso(vivos[i]);
+    Traza::detener();
+}
+
+int main(int argc, char** argv) {
+    string traza, destino;
+    int repeticiones = 3;
+    bool operaciones = false;
+    int procesos = 100000;
+    uint32_t semilla = 12345;
+
+    for (int i = 1; i < argc; i++) {
+        const char* v;
+        if ((v = valorOpcion(argv[i], "--repeticiones="))) {
+            repeticiones = max(1, atoi(v));
+        } else if (strcmp(argv[i], "--operaciones") == 0) {
+            operaciones = true;
+        } else if ((v = valorOpcion(argv[i], "--generar="))) {
+            destino = v;
+        } else if ((v = valorOpcion(argv[i], "--procesos="))) {
+            procesos = max(1, atoi(v));
+        } else if ((v = valorOpcion(argv[i], "--semilla="))) {
+            semilla = (uint32_t)strtoul(v, NULL, 10);
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            mostrarUso(argv[0]);
+            return 1;
+        } else {
+            traza = argv[i];
+        }
+    }
+
+    try {
+        if (!destino.empty()) {
+            generar(destino, procesos, semilla);
+            Traza::EstadisticasTraza s = Traza::estadisticas();
+            cout << "Traza grabada: " << destino << " (" << s.registros << " registros, "
+                 << s.bytes << " bytes, " << fixed << setprecision(1)
+                 << (s.registros ? (double)s.bytes / (double)s.registros : 0.0)
+                 << " bytes/registro, " << s.esperas << " esperas)\n";
+            return 0;
+        }
+        if (traza.empty()) {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+
+        chrono::steady_clock::time_point ini = chrono::steady_clock::now();
+        Traza::TrazaCargada t = Traza::cargar(traza);
+        double msCarga = chrono::duration<double, milli>(chrono::steady_clock::now() - ini).count();
+        uint64_t n = t.eventos.size();
+        double msGrabados = n ? (double)(t.eventos.back().ns - t.eventos.front().ns) / 1e6 : 0.0;
+        cout << "Traza: " << n << " eventos de " << t.hilos << " hilo(s), " << fixed
+             << setprecision(2) << msGrabados << " ms grabados, cargada en " << msCarga << " ms\n";
+
+        // Cada repeticin parte de estructuras nuevas; se reporta la mejor
+        ReproductorTraza reproductor;
+        double mejor = 0.0;
+        for (int r = 0; r < repeticiones; r++) {
+            reproductor.reiniciar();
+            ini = chrono::steady_clock::now();
+            reproductor.reproducir(t);
+            double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - ini).count();
+            if (r == 0 || ns < mejor) mejor = ns;
+        }
+        cout << "Reproduccin (mejor de " << repeticiones << "): " << mejor / 1e6 << " ms, "
+             << (n ? mejor / (double)n : 0.0) << " ns/evento, "
+             << (mejor > 0 ? (double)n / mejor * 1e3 : 0.0) << " Meventos/s\n";
+
+        if (operaciones) {
+            cout << "\n" << left << setw(26) << "Operacin" << right << setw(12) << "Eventos\n";
+            for (int op = 0; op < Traza::NUM_OPERACIONES; op++) {
+                uint64_t c = reproductor.getPorOperacion((Traza::Operacion)op);
+                if (!c) continue;
+                cout << left << setw(26) << Traza::nombre((Traza::Operacion)op) << right
+                     << setw(11) << c << "\n";
+            }
+            cout << "\n";
+        }
+
+        if (reproductor.getDivergencias() == 0) {
+            cout << "Reproduccin determinista: sin divergencias\n";
+            return 0;
+        }
+        cout << "Divergencias: " << reproductor.getDivergencias() << "\nPrimera: "
+             << reproductor.getPrimeraDivergencia() << "\n";
+        return 2;
+    } catch (const exception& e) {
+        ErrorHandler::manejar(e);
+        return 1;
+    }
+}
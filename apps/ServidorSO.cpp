@@ -0,0 +1,79 @@
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "ErrorHandler.h"
+#include "Metricas.h"
+#include "ProtocoloRPC.h"
+#include "ServidorSimulador.h"
+#include "Traza.h"
+
+using namespace std;
+
+/* ================================================================
+ *                   SERVIDOR DE SIMULADORES
+ * ================================================================ */
+/**
+ * Aloja instancias de Simulador atendidas por un socket Unix (ver
+ * ProtocoloRPC.h). Termina con SIGINT o SIGTERM y muestra las mtricas.
+ * Con --traza graba las operaciones de todas las instancias (un anillo
+ * por hilo de fragmento) para reproducirlas con reproducir_traza.
+ */
+
+static ServidorSimulador* servidorActivo = NULL;
+
+static void alRecibirSenal(int) {
+    if (servidorActivo) servidorActivo->detener();
+}
+
+static void mostrarUso(const char* programa) {
+    cout << "Uso: " << programa << " [--socket=" << ProtocoloRPC::SOCKET_DEFECTO
+         << "] [--hilos=0] [--traza=<archivo>]\n";
+}
+
+int main(int argc, char** argv) {
+    string ruta = ProtocoloRPC::SOCKET_DEFECTO;
+    unsigned hilos = 0;
+    string traza;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--socket=", 9) == 0) {
+            ruta = argv[i] + 9;
+        } else if (strncmp(argv[i], "--hilos=", 8) == 0) {
+            hilos = (unsigned)strtoul(argv[i] + 8, NULL, 10);
+        } else if (strncmp(argv[i], "--traza=", 8) == 0) {
+            traza = argv[i] + 8;
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        if (!traza.empty()) Traza::iniciar(traza);
+        {
+            ServidorSimulador servidor(ruta, hilos);
+            servidorActivo = &servidor;
+            signal(SIGINT, alRecibirSenal);
+            signal(SIGTERM, alRecibirSenal);
+            cout << "Atendiendo en " << servidor.getRuta() << " con " << servidor.getHilos()
+                 << " hilos (Ctrl+C para terminar)\n";
+            servidor.ejecutar();
+            signal(SIGINT, SIG_DFL);
+            signal(SIGTERM, SIG_DFL);
+            servidorActivo = NULL;
+        }
+        if (!traza.empty()) {
+            Traza::detener();
+            Traza::EstadisticasTraza s = Traza::estadisticas();
+            cout << "Traza " << traza << ": " << s.registros << " registros, " << s.bytes
+                 << " bytes\n";
+        }
+    } catch (const exception& e) {
+        ErrorHandler::manejar(e);
+        return 1;
+    }
+    if (Metricas::habilitadas()) Metricas::mostrar(cout);
+    return 0;
+}
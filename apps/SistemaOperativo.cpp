@@ -0,0 +1,585 @@
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "CargasTrabajo.h"
+#include "ErrorHandler.h"
+#include "Instantanea.h"
+#include "Metricas.h"
+#include "NodoProcesso.h"
+#include "Simulador.h"
+#include "Traza.h"
+
+using namespace std;
+
+/**
+ * Direcciones por pgina al listar la memoria asignada.
+ */
+const size_t DIRECCIONES_POR_PAGINA = 50;
+
+/**
+ * Direcciones que revisa cada paso de la compactacin.
+ */
+const size_t PASO_COMPACTACION = 64;
+
+/**
+ * Tramos de CPU que registra la lnea de tiempo de la sesin (~1.5 MB).
+ */
+const size_t TRAMOS_LINEA_TIEMPO = 1 << 16;
+
+/* ================================================================
+ *                   INTERFAZ DE USUARIO
+ * ================================================================ */
+/**
+ * Lee un entero de la entrada estndar con validacin.
+ * @param mensaje Mensaje a mostrar al usuario
+ * @param min Valor mnimo permitido
+ * @param max Valor mximo permitido
+ * @return Entero vlido introducido por el usuario
+ */
+int leerEntero(const string& mensaje, int min = INT_MIN, int max = INT_MAX) {
+    int valor;
+    while (true) {
+        cout << mensaje;
+        if (cin >> valor && valor >= min && valor <= max) {
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            return valor;
+        }
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Entrada invlida. Debe ser nmero entre " << min << " y " << max << endl;
+    }
+}
+
+/**
+ * Lee una manija de bloque de la entrada estndar con validacin.
+ * @param mensaje Mensaje a mostrar al usuario
+ * @param memoria Pila cuyas manijas se aceptan
+ * @return Manija de un bloque asignado en 'memoria' (debe haber alguno)
+ */
+PilaMemoria::Manija leerManija(const string& mensaje, const PilaMemoria& memoria) {
+    PilaMemoria::Manija valor;
+    while (true) {
+        cout << mensaje;
+        if (cin >> valor && memoria.manijaValida(valor)) {
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            return valor;
+        }
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Entrada invlida. Debe ser la manija de un bloque asignado" << endl;
+    }
+}
+
+/**
+ * Lee una cadena de la entrada estndar.
+ * @param mensaje Mensaje a mostrar al usuario
+ * @return Cadena introducida por el usuario
+ */
+string leerCadena(const string& mensaje) {
+    string valor;
+    cout << mensaje;
+    getline(cin >> ws, valor);
+    return valor;
+}
+
+/**
+ * Muestra el men principal del sistema.
+ */
+void mostrarMenuPrincipal() {
+    system("clear || cls");
+    cout << "\n=== SISTEMA OPERATIVO MINI v2.0 ===";
+    cout << "\n1. Gestor de Procesos";
+    cout << "\n2. Planificador CPU";
+    cout << "\n3. Gestor de Memoria";
+    cout << "\n4. Estadsticas";
+    cout << "\n5. Guardar instantnea";
+    cout << "\n6. Restaurar instantnea";
+    cout << "\n7. Salir";
+    cout << "\nSeleccin: ";
+}
+
+/**
+ * Muestra un proceso y sus descendientes, sangrados por nivel.
+ * @param raiz Proceso desde el que mostrar (ArbolProcesos::INIT = todos)
+ */
+void mostrarArbol(Simulador& sim, int raiz) {
+    const ArbolProcesos& arbol = sim.getArbol();
+    if (!arbol.contiene(raiz)) {
+        // Insertado directamente en la tabla: cuelga de init y no tiene hijos
+        NodoProcesso* p = sim.getProcesos().buscarPorId(raiz);
+        if (!p) throw runtime_error("Proceso no encontrado");
+        cout << p->id << " " << p->nombre << " [" << nombreEstado(p->estado) << "]\n";
+        return;
+    }
+    arbol.recorrer(raiz, [&sim](int pid, int profundidad) {
+        cout << string((size_t)profundidad * 2, ' ');
+        if (pid == ArbolProcesos::INIT) {
+            cout << "init\n";
+            return;
+        }
+        NodoProcesso* p = sim.getProcesos().buscarPorId(pid);
+        cout << pid << " " << p->nombre << " [" << nombreEstado(p->estado) << "]\n";
+    });
+}
+
+/**
+ * Muestra el men de gestin de procesos.
+ * @param sim Referencia al simulador
+ */
+void menuProcesos(Simulador& sim) {
+    ListaProcesso& gestor = sim.getProcesos();
+    int opcion = 0;
+    do {
+        system("clear || cls");
+        cout << "\n--- GESTOR DE PROCESOS ---";
+        cout << "\n1. Insertar proceso";
+        cout << "\n2. Eliminar proceso";
+        cout << "\n3. Mostrar procesos";
+        cout << "\n4. Mostrar rango de IDs";
+        cout << "\n5. Guardar procesos (segundo plano)";
+        cout << "\n6. Insertar tarea de tiempo real";
+        cout << "\n7. Clonar proceso (fork)";
+        cout << "\n8. Eliminar proceso y descendientes";
+        cout << "\n9. Mostrar rbol de procesos";
+        cout << "\n10. Colgar proceso de init";
+        cout << "\n11. Volver";
+        cout << "\nSeleccin: ";
+        cin >> opcion;
+        
+        try {
+            if (opcion == 1) {
+                int id = leerEntero("ID: ", 0);
+                string nombre = leerCadena("Nombre: ");
+                int prioridad = leerEntero("Prioridad (0-100): ", 0, 100);
+                gestor.insertarProcesso(id, std::move(nombre), prioridad);
+                cout << "Proceso insertado! (ID: " << id << ")\n";
+            } else if (opcion == 2) {
+                int id = leerEntero("ID a eliminar: ");
+                int bloques = sim.eliminarProceso(id);
+                cout << "Proceso eliminado! (" << bloques << " bloques de memoria liberados)\n";
+            } else if (opcion == 3) {
+                gestor.mostrar();
+            } else if (opcion == 4) {
+                int desde = leerEntero("Desde ID: ");
+                int hasta = leerEntero("Hasta ID: ");
+                gestor.mostrarRango(desde, hasta);
+            } else if (opcion == 5) {
+                if (sim.guardarProcesosEnSegundoPlano()) {
+                    cout << "Guardando " << gestor.getArchivo() << " en segundo plano...\n";
+                } else {
+                    cout << "Ya hay un guardado en curso!\n";
+                }
+            } else if (opcion == 6) {
+                int id = leerEntero("ID: ", 0);
+                string nombre = leerCadena("Nombre: ");
+                int prioridad = leerEntero("Prioridad (0-100): ", 0, 100);
+                int periodo = leerEntero("Periodo (ticks): ", 1);
+                int costo = leerEntero("Costo por trabajo (ticks): ", 1, periodo);
+                int plazo = leerEntero("Plazo relativo (0 = el periodo): ", 0, periodo);
+                int esporadica = leerEntero("Espordica (1 = s, 0 = peridica): ", 0, 1);
+                TareaTiempoReal tarea((uint64_t)periodo, (uint64_t)costo, (uint64_t)plazo,
+                                      esporadica == 1);
+                gestor.insertarProcesso(id, std::move(nombre), prioridad, tarea);
+                const AdmisionTiempoReal& admision = gestor.getAdmision();
+                cout << "Tarea admitida! (ID: " << id << ") | Utilizacin: "
+                     << admision.getUtilizacion() << " de " << admision.cota(admision.getTareas())
+                     << "\n";
+            } else if (opcion == 7) {
+                int padre = leerEntero("ID del padre: ");
+                int hijo = leerEntero("ID del hijo: ", 0);
+                sim.clonarProceso(padre, hijo);
+                cout << "Proceso clonado! (ID: " << hijo << ", padre: " << padre << ")\n";
+            } else if (opcion == 8) {
+                int id = leerEntero("ID a eliminar: ");
+                int bloques = 0;
+                size_t eliminados = sim.eliminarSubarbol(id, &bloques);
+                cout << eliminados << " procesos eliminados! (" << bloques
+                     << " bloques de memoria liberados)\n";
+            } else if (opcion == 9) {
+                int raiz = leerEntero("ID raz (-1 = init): ", ArbolProcesos::INIT);
+                mostrarArbol(sim, raiz);
+                if (raiz != ArbolProcesos::INIT) {
+                    cout << "Descendientes: " << sim.contarDescendientes(raiz) << "\n";
+                }
+            } else if (opcion == 10) {
+                int id = leerEntero("ID: ");
+                sim.reparentarAInit(id);
+                cout << "Proceso " << id << " cuelga ahora de init\n";
+            }
+        } catch (const exception& e) {
+            ErrorHandler::manejar(e);
+        }
+        if (opcion != 11) system("pause");
+    } while (opcion != 11);
+}
+
+/**
+ * Muestra el men del planificador de CPU.
+ * @param sim Referencia al simulador
+ */
+void menuPlanificador(Simulador& sim) {
+    ColaPrioridad& planificador = sim.getPlanificador();
+    int opcion = 0;
+    do {
+        system("clear || cls");
+        cout << "\n--- PLANIFICADOR CPU ---";
+        cout << "\n1. Encolar proceso";
+        cout << "\n2. Ejecutar proceso";
+        cout << "\n3. Mostrar cola";
+        cout << "\n4. Cambiar prioridad";
+        cout << "\n5. Retirar proceso de la cola";
+        cout << "\n6. Bloquear proceso en ejecucin";
+        cout << "\n7. Desbloquear proceso";
+        cout << "\n8. Terminar proceso en ejecucin";
+        cout << "\n9. Avanzar reloj";
+        cout << "\n10. Asignar carga de trabajo";
+        cout << "\n11. Ejecutar quantums";
+        cout << "\n12. Exportar lnea de tiempo";
+        cout << "\n13. Poltica de planificacin";
+        cout << "\n14. Activar tarea espordica";
+        cout << "\n15. Reporte de plazos";
+        cout << "\n16. Volver";
+        cout << "\nSeleccin: ";
+        cin >> opcion;
+        
+        try {
+            if (opcion == 1) {
+                int id = leerEntero("ID del proceso: ");
+                sim.encolar(id);
+                cout << "Proceso encolado! (ID: " << id << ")\n";
+            } else if (opcion == 2) {
+                NodoProcesso* proc = sim.despachar();
+                cout << "Ejecutando proceso ID: " << proc->id << endl;
+            } else if (opcion == 3) {
+                planificador.mostrar();
+                NodoProcesso* actual = sim.getEnEjecucion();
+                cout << "En ejecucin: ";
+                if (actual) {
+                    cout << actual->id << "\n";
+                } else {
+                    cout << "ninguno\n";
+                }
+                cout << "Bloqueados: " << sim.contarBloqueados()
+                     << " | Tiempo: " << sim.getAhora() << "\n";
+            } else if (opcion == 4) {
+                int id = leerEntero("ID del proceso: ");
+                int prioridad = leerEntero("Nueva prioridad (0-100): ", 0, 100);
+                sim.cambiarPrioridad(id, prioridad);
+                cout << "Prioridad actualizada! (ID: " << id << ")\n";
+            } else if (opcion == 5) {
+                int id = leerEntero("ID del proceso: ");
+                if (sim.retirarDeCola(id)) {
+                    cout << "Proceso retirado de la cola! (ID: " << id << ")\n";
+                } else {
+                    cout << "Error: El proceso no est en la cola!\n";
+                }
+            } else if (opcion == 6) {
+                int ticks = leerEntero("Ticks de espera (0 = hasta desbloquear): ", 0);
+                NodoProcesso* proc = sim.bloquear((uint64_t)ticks);
+                cout << "Proceso bloqueado! (ID: " << proc->id << ")\n";
+            } else if (opcion == 7) {
+                int id = leerEntero("ID del proceso: ");
+                sim.desbloquear(id);
+                cout << "Proceso desbloqueado! (ID: " << id << ")\n";
+            } else if (opcion == 8) {
+                NodoProcesso* proc = sim.terminar();
+                cout << "Proceso terminado! (ID: " << proc->id << ")\n";
+            } else if (opcion == 9) {
+                int ticks = leerEntero("Ticks a avanzar: ", 1);
+                size_t despertados = sim.avanzarTiempo((uint64_t)ticks);
+                cout << "Tiempo: " << sim.getAhora() << " | Procesos despertados: "
+                     << despertados << "\n";
+            } else if (opcion == 10) {
+                int id = leerEntero("ID del proceso: ");
+                int tipo = leerEntero("Carga (1 = primos, 2 = interactiva, 3 = cedente): ", 1, 3);
+                if (tipo == 1) {
+                    int limite = leerEntero("Buscar primos hasta: ", 2);
+                    sim.asignarCuerpo(id, CargasTrabajo::primos((uint64_t)limite));
+                } else if (tipo == 2) {
+                    int rafagas = leerEntero("Rfagas: ", 1);
+                    int cpu = leerEntero("Unidades de CPU por rfaga: ", 1);
+                    int es = leerEntero("Ticks de E/S por rfaga: ", 1);
+                    sim.asignarCuerpo(id, CargasTrabajo::interactivo((uint64_t)rafagas, (uint64_t)cpu,
+                                                                     (uint64_t)es));
+                } else {
+                    int veces = leerEntero("Veces que cede la CPU: ", 1);
+                    sim.asignarCuerpo(id, CargasTrabajo::cedente((uint64_t)veces));
+                }
+                cout << "Carga asignada! (ID: " << id << ")\n";
+            } else if (opcion == 11) {
+                int quantum = leerEntero("Quantum (ticks): ", 1);
+                int cuantos = leerEntero("Quantums a ejecutar: ", 1);
+                static const char* motivos[] = {"cedi", "espera E/S", "termin"};
+                for (int i = 0; i < cuantos; i++) {
+                    if (!sim.getEnEjecucion() && !sim.getPlanificador().frente()) {
+                        if (sim.contarBloqueados() == 0) break;
+                        // Solo quedan procesos en E/S: la CPU queda ociosa un quantum
+                        sim.avanzarTiempo((uint64_t)quantum);
+                        cout << "t=" << sim.getAhora() << " CPU ociosa\n";
+                        continue;
+                    }
+                    ResultadoQuantum r = sim.ejecutarQuantum((uint64_t)quantum);
+                    cout << "t=" << sim.getAhora() << " ID " << r.id << ": " << r.usadas
+                         << " ticks, " << motivos[r.motivo];
+                    if (r.motivo == CuerpoProceso::TERMINO) cout << " (resultado " << r.valor << ")";
+                    cout << "\n";
+                }
+            } else if (opcion == 12) {
+                const LineaTiempo& linea = sim.getLineaTiempo();
+                int formato = leerEntero("Formato (1 = traza de Chrome, 2 = CSV): ", 1, 2);
+                string archivo = leerCadena("Archivo destino: ");
+                linea.guardar(archivo, formato == 2);
+                cout << linea.getCantidad() << " tramos exportados a " << archivo;
+                if (linea.getDescartados()) cout << " (" << linea.getDescartados() << " descartados)";
+                cout << "\n";
+            } else if (opcion == 13) {
+                cout << "Poltica actual: " << nombrePolitica(sim.getPolitica()) << "\n";
+                int politica = leerEntero("Nueva (1 = prioridad, 2 = EDF, 3 = Rate Monotonic): ", 1, 3);
+                sim.setPolitica((PoliticaPlanificacion)(politica - 1));
+                int admision = leerEntero("Control de admisin (1 = activo, 0 = aceptar todas): ", 0, 1);
+                sim.getProcesos().getAdmision().setActiva(admision == 1);
+                cout << "Poltica: " << nombrePolitica(sim.getPolitica()) << "\n";
+            } else if (opcion == 14) {
+                int id = leerEntero("ID de la tarea: ");
+                if (sim.activarEsporadica(id)) {
+                    cout << "Trabajo activado! (ID: " << id << ")\n";
+                } else {
+                    cout << "Activacin diferida hasta cumplir el periodo mnimo (ID: " << id << ")\n";
+                }
+            } else if (opcion == 15) {
+                EstadisticasTiempoReal e = sim.estadisticasTiempoReal();
+                const AdmisionTiempoReal& admision = sim.getProcesos().getAdmision();
+                cout << "\n--- Plazos (" << nombrePolitica(sim.getPolitica()) << ") ---\n";
+                cout << "Tareas admitidas: " << admision.getTareas()
+                     << " | Utilizacin: " << admision.getUtilizacion()
+                     << " | Cota: " << admision.cota(admision.getTareas()) << "\n";
+                cout << "Trabajos completados: " << e.completados
+                     << " | Perdidos: " << e.perdidos << " | Vencidos sin terminar: " << e.vencidos
+                     << "\n";
+                cout << "Tasa de plazos perdidos: " << e.tasaPerdidas() * 100.0 << "%"
+                     << " | Tardanza mxima: " << e.tardanzaMaxima << " ticks\n";
+            }
+        } catch (const exception& e) {
+            ErrorHandler::manejar(e);
+        }
+        if (opcion != 16) system("pause");
+    } while (opcion != 16);
+}
+
+/**
+ * Muestra el men de gestin de memoria.
+ * @param sim Referencia al simulador
+ */
+void menuMemoria(Simulador& sim) {
+    ListaProcesso& gestor = sim.getProcesos();
+    PilaMemoria& memoria = sim.getMemoria();
+    MemoriaVirtual& mv = sim.getMemoriaVirtual();
+    int opcion = 0;
+    do {
+        system("clear || cls");
+        cout << "\n--- GESTOR DE MEMORIA ---";
+        cout << "\n1. Asignar memoria";
+        cout << "\n2. Liberar memoria";
+        cout << "\n3. Estado memoria";
+        cout << "\n4. Listar direcciones asignadas";
+        cout << "\n5. Traducir direccin virtual";
+        cout << "\n6. Estadsticas de paginacin";
+        cout << "\n7. Compactar memoria";
+        cout << "\n8. Direccin de una manija";
+        cout << "\n9. Volver";
+        cout << "\nSeleccin: ";
+        cin >> opcion;
+        
+        try {
+            if (opcion == 1) {
+                int dir = leerEntero("Direccin: ");
+                int pid = leerEntero("PID dueo (-1 = sistema): ", -1);
+                PilaMemoria::Manija manija = sim.asignarMemoria(pid, dir);
+                cout << "Memoria asignada! (Dir: " << dir << ", manija " << manija << ")\n";
+            } else if (opcion == 2) {
+                int dir = memoria.pop();
+                cout << "Memoria liberada! (Dir: " << dir << ")\n";
+            } else if (opcion == 3) {
+                memoria.estadoMemoria();
+            } else if (opcion == 4) {
+                // Pgina a pgina: con mucha memoria el listado completo no cabe
+                int pagina = 1;
+                while (pagina > 0) {
+                    size_t paginas = memoria.mostrarDirecciones((size_t)pagina - 1,
+                                                                DIRECCIONES_POR_PAGINA);
+                    if (paginas <= 1) break;
+                    pagina = leerEntero("Pgina (1-" + to_string(paginas) + ", 0 = salir): ", 0,
+                                        (int)paginas);
+                }
+            } else if (opcion == 5) {
+                int id = leerEntero("ID del proceso: ");
+                NodoProcesso* proc = gestor.buscarPorId(id);
+                if (!proc) {
+                    cout << "Error: Proceso no encontrado!\n";
+                } else {
+                    // El espacio de direcciones se crea en el primer acceso
+                    if (!proc->tablaPaginas) mv.crearEspacio(proc);
+                    int dir = leerEntero("Direccin virtual: ", 0);
+                    uint32_t fisica = mv.traducir(proc, (uint32_t)dir);
+                    cout << "Direccin fsica: " << fisica
+                         << " (marco " << (fisica >> BITS_DESPLAZAMIENTO) << ")\n";
+                }
+            } else if (opcion == 6) {
+                mv.mostrarEstadisticas(cout);
+            } else if (opcion == 7) {
+                // Por pasos acotados, como correra entre asignaciones
+                memoria.iniciarCompactacion();
+                while (memoria.pasoCompactacion(PASO_COMPACTACION)) {}
+                memoria.estadoMemoria();
+            } else if (opcion == 8) {
+                if (memoria.usados() == 0) {
+                    cout << "No hay bloques asignados\n";
+                } else {
+                    PilaMemoria::Manija manija = leerManija("Manija: ", memoria);
+                    cout << "Direccin actual: " << memoria.direccionDe(manija) << "\n";
+                }
+            }
+        } catch (const exception& e) {
+            ErrorHandler::manejar(e);
+        }
+        if (opcion != 9) system("pause");
+    } while (opcion != 9);
+}
+
+/**
+ * Muestra el men de estadsticas (mtricas de todos los subsistemas).
+ */
+void menuEstadisticas() {
+    int opcion = 0;
+    do {
+        system("clear || cls");
+        cout << "\n--- ESTADSTICAS ---";
+        cout << "\n1. Mostrar mtricas";
+        cout << "\n2. Exportar JSON";
+        cout << "\n3. Exportar Prometheus";
+        cout << "\n4. Reiniciar contadores";
+        cout << "\n5. Volver";
+        cout << "\nSeleccin: ";
+        cin >> opcion;
+
+        try {
+            if (opcion == 1) {
+                Metricas::mostrar(cout);
+            } else if (opcion == 2 || opcion == 3) {
+                string archivo = leerCadena("Archivo destino: ");
+                Metricas::guardar(archivo, opcion == 3);
+                cout << "Mtricas exportadas a " << archivo << "\n";
+            } else if (opcion == 4) {
+                Metricas::reiniciar();
+                cout << "Contadores reiniciados!\n";
+            }
+        } catch (const exception& e) {
+            ErrorHandler::manejar(e);
+        }
+        if (opcion != 5) system("pause");
+    } while (opcion != 5);
+}
+
+/**
+ * Detiene la grabacin de la traza al salir, despus de destruir el
+ * simulador (as la traza tambin registra su destruccin).
+ */
+struct SesionTraza {
+    bool activa;
+    SesionTraza() : activa(false) {}
+    ~SesionTraza() {
+        if (!activa) return;
+        try {
+            Traza::detener();
+        } catch (const exception& e) {
+            ErrorHandler::manejar(e);
+        }
+    }
+};
+
+/* ================================================================
+ *                   FUNCIN PRINCIPAL
+ * ================================================================ */
+/**
+ * Uso: sistema_operativo [--traza=<archivo>]
+ * Con --traza se graban todas las operaciones de la sesin para
+ * reproducirlas despus con reproducir_traza.
+ */
+int main(int argc, char** argv) {
+    SesionTraza sesion;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--traza=", 8) == 0) {
+            try {
+                sesion.activa = Traza::iniciar(argv[i] + 8);
+            } catch (const exception& e) {
+                ErrorHandler::manejar(e);
+                return 1;
+            }
+        } else {
+            cout << "Uso: " << argv[0] << " [--traza=<archivo>]\n";
+            return 1;
+        }
+    }
+
+    // Inicializacin de los componentes principales: procesos, planificador,
+    // memoria con capacidad 3 y memoria virtual con 256 marcos
+    Simulador sim;
+    sim.activarLineaTiempo(TRAMOS_LINEA_TIEMPO);
+
+    int opcion = 0;
+    do {
+        mostrarMenuPrincipal();
+        try {
+            opcion = leerEntero("", 1, 7);
+            
+            // Manejo de las opciones del men principal
+            switch(opcion) {
+                case 1:
+                    menuProcesos(sim);
+                    break;
+                case 2:
+                    menuPlanificador(sim);
+                    break;
+                case 3:
+                    menuMemoria(sim);
+                    break;
+                case 4:
+                    menuEstadisticas();
+                    break;
+                case 5:
+                    if (sim.guardarInstantaneaEnSegundoPlano(PilaMemoria::ARCHIVO_MEMORIA)) {
+                        cout << "Guardando instantnea en " << PilaMemoria::ARCHIVO_MEMORIA
+                             << " en segundo plano...\n";
+                    } else {
+                        cout << "Ya hay un guardado en curso!\n";
+                    }
+                    system("pause");
+                    break;
+                case 6:
+                    // Una instantnea a medio escribir an no existe: se espera a que termine
+                    if (!sim.getGuardado().esperar()) {
+                        cout << "Aviso: el ltimo guardado fall: "
+                             << sim.getGuardado().getUltimoError() << "\n";
+                    }
+                    Instantanea::restaurar(sim, PilaMemoria::ARCHIVO_MEMORIA);
+                    cout << "Instantnea restaurada desde " << PilaMemoria::ARCHIVO_MEMORIA << "\n";
+                    system("pause");
+                    break;
+                case 7:
+                    cout << "Saliendo del sistema...\n";
+                    break;
+            }
+        } catch (const exception& e) {
+            ErrorHandler::manejar(e);
+        }
+    } while (opcion != 7);
+    
+    cout << "Sistema finalizado. Hasta pronto!\n";
+    return 0;
+}
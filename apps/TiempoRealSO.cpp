@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ErrorHandler.h"
+#include "Simulador.h"
+
+using namespace std;
+
+/* ================================================================
+ *          PLANIFICACIN DE TIEMPO REAL SOBRE CONJUNTOS GRANDES
+ * ================================================================ */
+/**
+ * Genera un conjunto de tareas peridicas al azar (utilizaciones con
+ * UUniFast, periodos log-uniformes), lo crea en un simulador por cada
+ * combinacin de poltica y control de admisin pedida, lo corre hasta
+ * el horizonte y reporta cuntas tareas se admitieron y la tasa de
+ * plazos perdidos. Todas las tareas se activan juntas en el tick 0 (el
+ * peor caso para Rate Monotonic).
+ */
+
+namespace {
+
+struct Opciones {
+    size_t tareas;
+    double utilizacion;
+    uint64_t periodoMin;   // 0 = segn la cantidad de tareas
+    uint64_t periodoMax;   // 0 = 10 veces el mnimo
+    double plazo;          // Plazo relativo como fraccin del periodo
+    uint64_t horizonte;    // 0 = dos periodos mximos
+    uint64_t quantum;
+    unsigned semilla;
+    vector<string> politicas;
+    vector<string> admision;
+};
+
+struct Fila {
+    string politica;
+    bool admision;
+    size_t admitidas;
+    size_t rechazadas;
+    double utilizacion;
+    size_t quantums;
+    EstadisticasTiempoReal plazos;
+    double ms;
+};
+
+void mostrarUso(const char* programa) {
+    cout << "Uso: " << programa << " [--tareas=100000] [--utilizacion=0.9]"
+         << " [--periodo-min=T] [--periodo-max=T] [--plazo=1.0] [--horizonte=T]"
+         << " [--quantum=25] [--semilla=1] [--politicas=edf,rm,prioridad]"
+         << " [--admision=si,no]\n";
+}
+
+vector<string> separar(const string& texto) {
+    vector<string> partes;
+    stringstream ss(texto);
+    string parte;
+    while (getline(ss, parte, ',')) {
+        if (!parte.empty()) partes.push_back(parte);
+    }
+    return partes;
+}
+
+PoliticaPlanificacion politicaDe(const string& nombre) {
+    if (nombre == "edf") return PLAN_EDF;
+    if (nombre == "rm") return PLAN_RATE_MONOTONIC;
+    if (nombre == "prioridad") return PLAN_PRIORIDAD;
+    throw runtime_error("Poltica desconocida: " + nombre);
+}
+
+/**
+ * UUniFast (Bini y Buttazzo): n utilizaciones uniformes sobre el
+ * simplex de suma 'total'.
+ */
+vector<double> uunifast(size_t n, double total, mt19937_64& azar) {
+    uniform_real_distribution<double> u(0.0, 1.0);
+    vector<double> us(n);
+    double resto = total;
+    for (size_t i = 0; i + 1 < n; i++) {
+        double siguiente = resto * pow(u(azar), 1.0 / (double)(n - 1 - i));
+        us[i] = resto - siguiente;
+        resto = siguiente;
+    }
+    us[n - 1] = resto;
+    return us;
+}
+
+vector<TareaTiempoReal> generar(const Opciones& op) {
+    mt19937_64 azar(op.semilla);
+    vector<double> us = uunifast(op.tareas, op.utilizacion, azar);
+    uniform_real_distribution<double> u(0.0, 1.0);
+    double lmin = log((double)op.periodoMin);
+    double lmax = log((double)op.periodoMax);
+
+    vector<TareaTiempoReal> tareas(op.tareas);
+    for (size_t i = 0; i < op.tareas; i++) {
+        uint64_t periodo = (uint64_t)exp(lmin + (lmax - lmin) * u(azar));
+        uint64_t costo = max<uint64_t>(1, (uint64_t)llround(us[i] * (double)periodo));
+        uint64_t plazo = max(costo, (uint64_t)((double)periodo * op.plazo));
+        tareas[i] = TareaTiempoReal(periodo, min(costo, periodo), min(plazo, periodo));
+    }
+    return tareas;
+}
+
+Fila correr(const Opciones& op, const vector<TareaTiempoReal>& tareas, const string& politica,
+            bool admision) {
+    Fila f;
+    f.politica = politica;
+    f.admision = admision;
+    f.rechazadas = 0;
+    f.quantums = 0;
+
+    chrono::steady_clock::time_point ini = chrono::steady_clock::now();
+    Simulador sim("", 16, 16);
+    sim.setPolitica(politicaDe(politica));
+    sim.getProcesos().getAdmision().setActiva(admision);
+    for (size_t i = 0; i < tareas.size(); i++) {
+        try {
+            sim.getProcesos().insertarProcesso((int)i, "tarea", 50, tareas[i]);
+            sim.encolar((int)i);
+        } catch (const runtime_error&) {
+            f.rechazadas++;
+        }
+    }
+    f.admitidas = sim.getProcesos().getAdmision().getTareas();
+    f.utilizacion = sim.getProcesos().getAdmision().getUtilizacion();
+
+    while (sim.getAhora() < op.horizonte) {
+        if (sim.getEnEjecucion() || sim.getPlanificador().frente()) {
+            sim.ejecutarQuantum(op.quantum);
+            f.quantums++;
+        } else {
+            sim.avanzarTiempo(op.quantum);
+        }
+    }
+    f.plazos = sim.estadisticasTiempoReal();
+    f.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - ini).count();
+    return f;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Opciones op;
+    op.tareas = 100000;
+    op.utilizacion = 0.9;
+    op.periodoMin = 0;
+    op.periodoMax = 0;
+    op.plazo = 1.0;
+    op.horizonte = 0;
+    op.quantum = 25;
+    op.semilla = 1;
+    op.politicas = separar("edf,rm,prioridad");
+    op.admision = separar("si,no");
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (strncmp(a, "--tareas=", 9) == 0) {
+            op.tareas = strtoull(a + 9, NULL, 10);
+        } else if (strncmp(a, "--utilizacion=", 14) == 0) {
+            op.utilizacion = atof(a + 14);
+        } else if (strncmp(a, "--periodo-min=", 14) == 0) {
+            op.periodoMin = strtoull(a + 14, NULL, 10);
+        } else if (strncmp(a, "--periodo-max=", 14) == 0) {
+            op.periodoMax = strtoull(a + 14, NULL, 10);
+        } else if (strncmp(a, "--plazo=", 8) == 0) {
+            op.plazo = atof(a + 8);
+        } else if (strncmp(a, "--horizonte=", 12) == 0) {
+            op.horizonte = strtoull(a + 12, NULL, 10);
+        } else if (strncmp(a, "--quantum=", 10) == 0) {
+            op.quantum = strtoull(a + 10, NULL, 10);
+        } else if (strncmp(a, "--semilla=", 10) == 0) {
+            op.semilla = (unsigned)strtoul(a + 10, NULL, 10);
+        } else if (strncmp(a, "--politicas=", 12) == 0) {
+            op.politicas = separar(a + 12);
+        } else if (strncmp(a, "--admision=", 11) == 0) {
+            op.admision = separar(a + 11);
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    if (op.tareas == 0 || op.utilizacion <= 0 || op.quantum == 0 || op.plazo <= 0 ||
+        op.plazo > 1) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+    // Periodos largos frente a la utilizacin media por tarea: costos de
+    // unos 20 ticks en promedio, con poco error al redondearlos
+    if (op.periodoMin == 0) {
+        op.periodoMin = (uint64_t)ceil(20.0 * (double)op.tareas / op.utilizacion);
+    }
+    if (op.periodoMax == 0) op.periodoMax = 10 * op.periodoMin;
+    if (op.periodoMax < op.periodoMin || op.periodoMax > AdmisionTiempoReal::PERIODO_MAXIMO) {
+        cout << "Periodos fuera de rango\n";
+        return 1;
+    }
+    if (op.horizonte == 0) op.horizonte = 2 * op.periodoMax;
+
+    try {
+        vector<TareaTiempoReal> tareas = generar(op);
+        double real = 0;
+        for (size_t i = 0; i < tareas.size(); i++) {
+            real += (double)tareas[i].costo / (double)tareas[i].plazo;
+        }
+        printf("Tareas: %zu  Utilizacin: %.4f (pedida %.4f)  Periodos: %llu-%llu"
+               "  Horizonte: %llu  Quantum: %llu\n\n",
+               tareas.size(), real, op.utilizacion, (unsigned long long)op.periodoMin,
+               (unsigned long long)op.periodoMax, (unsigned long long)op.horizonte,
+               (unsigned long long)op.quantum);
+        printf("%-10s %-9s %10s %10s %8s %12s %10s %9s %9s %10s %9s\n", "politica", "admision",
+               "admitidas", "rechazadas", "U", "trabajos", "perdidos", "vencidos", "tasa",
+               "tard.max", "ms");
+        for (size_t p = 0; p < op.politicas.size(); p++) {
+            for (size_t a = 0; a < op.admision.size(); a++) {
+                Fila f = correr(op, tareas, op.politicas[p], op.admision[a] != "no");
+                printf("%-10s %-9s %10zu %10zu %8.4f %12llu %10llu %9llu %8.4f%% %10llu %9.0f\n",
+                       f.politica.c_str(), f.admision ? "si" : "no", f.admitidas, f.rechazadas,
+                       f.utilizacion, (unsigned long long)f.plazos.completados,
+                       (unsigned long long)f.plazos.perdidos,
+                       (unsigned long long)f.plazos.vencidos, f.plazos.tasaPerdidas() * 100.0,
+                       (unsigned long long)f.plazos.tardanzaMaxima, f.ms);
+                fflush(stdout);
+            }
+        }
+    } catch (const exception& e) {
+        ErrorHandler::manejar(e);
+        return 1;
+    }
+    return 0;
+}
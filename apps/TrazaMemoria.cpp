@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "ErrorHandler.h"
+#include "LectorTraza.h"
+#include "ListaProcesso.h"
+#include "MemoriaVirtual.h"
+
+using namespace std;
+
+/* ================================================================
+ *          REPRODUCTOR DE TRAZAS DE MEMORIA VIRTUAL
+ * ================================================================ */
+/**
+ * Reproduce una traza de accesos a memoria sobre el subsistema de
+ * paginacin y reporta la tasa de aciertos de la TLB, los fallos de
+ * pgina y el costo de los page walks.
+ */
+
+static void mostrarUso(const char* programa) {
+    cout << "Uso:\n"
+         << "  " << programa << " <traza> [--marcos=N] [--tlb=CONJUNTOSxVIAS]"
+         << " [--reemplazo=fifo|lru|clock|lfu|arc]\n"
+         << "  " << programa << " --generar=<archivo> [--accesos=N] [--procesos=P]"
+         << " [--trabajo=PAGINAS]\n";
+}
+
+/**
+ * Lee el valor de una opcin --nombre=valor.
+ */
+static const char* valorOpcion(const char* arg, const char* nombre) {
+    size_t n = strlen(nombre);
+    return strncmp(arg, nombre, n) == 0 ? arg + n : NULL;
+}
+
+int main(int argc, char** argv) {
+    string traza, generar, reemplazo;
+    uint32_t marcos = 1u << 20;
+    uint32_t conjuntos = 16, vias = 4;
+    uint64_t accesos = 1000000;
+    int procesos = 8;
+    uint32_t trabajo = 64;
+
+    for (int i = 1; i < argc; i++) {
+        const char* v;
+        if ((v = valorOpcion(argv[i], "--marcos="))) {
+            marcos = (uint32_t)strtoul(v, NULL, 10);
+        } else if ((v = valorOpcion(argv[i], "--tlb="))) {
+            if (sscanf(v, "%ux%u", &conjuntos, &vias) != 2) {
+                mostrarUso(argv[0]);
+                return 1;
+            }
+        } else if ((v = valorOpcion(argv[i], "--reemplazo="))) {
+            reemplazo = v;
+        } else if ((v = valorOpcion(argv[i], "--generar="))) {
+            generar = v;
+        } else if ((v = valorOpcion(argv[i], "--accesos="))) {
+            accesos = strtoull(v, NULL, 10);
+        } else if ((v = valorOpcion(argv[i], "--procesos="))) {
+            procesos = atoi(v);
+        } else if ((v = valorOpcion(argv[i], "--trabajo="))) {
+            trabajo = (uint32_t)strtoul(v, NULL, 10);
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            mostrarUso(argv[0]);
+            return 1;
+        } else {
+            traza = argv[i];
+        }
+    }
+
+    try {
+        if (!generar.empty()) {
+            generarTraza(generar, accesos, procesos, trabajo);
+            cout << "Traza generada: " << generar << " (" << accesos << " accesos)\n";
+            return 0;
+        }
+        if (traza.empty()) {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+
+        ListaProcesso lista("");
+        MemoriaVirtual mv(marcos, conjuntos, vias);
+        if (!reemplazo.empty()) {
+            mv.setAlgoritmoReemplazo(crearAlgoritmoReemplazo(reemplazo, marcos));
+        }
+        unordered_map<int, NodoProcesso*> porPid;
+        NodoProcesso* ultimo = NULL;
+
+        LectorTraza lector(traza);
+        AccesoMemoria acceso;
+        uint64_t total = 0;
+        uint64_t suma = 0;
+        chrono::steady_clock::time_point ini = chrono::steady_clock::now();
+        while (lector.siguiente(acceso)) {
+            // Los procesos de la traza se crean la primera vez que aparecen
+            if (!ultimo || ultimo->id != acceso.pid) {
+                unordered_map<int, NodoProcesso*>::iterator it = porPid.find(acceso.pid);
+                if (it == porPid.end()) {
+                    lista.insertarProcesso(acceso.pid, "traza", 50);
+                    NodoProcesso* p = lista.buscarPorId(acceso.pid);
+                    mv.crearEspacio(p);
+                    it = porPid.insert(make_pair(acceso.pid, p)).first;
+                }
+                ultimo = it->second;
+            }
+            suma += mv.traducir(ultimo, acceso.direccion, acceso.escritura);
+            total++;
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - ini).count();
+
+        cout << "Accesos reproducidos: " << total << " (" << porPid.size() << " procesos)\n";
+        cout << "Tiempo: " << ns / 1e6 << " ms (" << (total ? ns / (double)total : 0.0)
+             << " ns/acceso, lectura incluida)\n";
+        mv.mostrarEstadisticas(cout);
+        if (suma == 1) cout << "\n"; // Evita que el compilador descarte las traducciones
+    } catch (const exception& e) {
+        ErrorHandler::manejar(e);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ColaPrioridad.h"
+#include "NodoProcesso.h"
+
+using namespace std;
+
+/* ================================================================
+ *     COLA DE LISTOS CONCURRENTE FRENTE A COLAPRIORIDAD CON MUTEX
+ * ================================================================ */
+/**
+ * Cada hilo repite un despacho (sacar el primero y volver a encolarlo)
+ * sobre una cola compartida con VIVOS procesos. Se compara
+ * ColaListosConcurrente con ColaPrioridad protegida por un mutex, de 1 a
+ * 64 hilos; n es el total de despachos entre todos los hilos, as que
+ * ns/op mide el rendimiento agregado (incluye crear los hilos).
+ */
+
+namespace {
+
+const size_t VIVOS = 1024;
+
+vector<unique_ptr<NodoProcesso> > procesosDePrueba() {
+    vector<unique_ptr<NodoProcesso> > procesos;
+    for (size_t i = 0; i < VIVOS; i++) {
+        procesos.emplace_back(new NodoProcesso((int)i, NombreProceso(), (int)((i * 37) % 101)));
+    }
+    return procesos;
+}
+
+/**
+ * Reparte n despachos entre 'hilos' hilos que corren 'cuerpo(cuantos)'.
+ */
+template <typename Cuerpo>
+size_t repartir(int hilos, size_t n, Cuerpo cuerpo) {
+    size_t porHilo = n / (size_t)hilos;
+    vector<thread> trabajadores;
+    for (int h = 0; h < hilos; h++) trabajadores.push_back(thread(cuerpo, porHilo));
+    for (size_t h = 0; h < trabajadores.size(); h++) trabajadores[h].join();
+    return porHilo * (size_t)hilos;
+}
+
+template <int HILOS>
+size_t despachosConcurrentes(size_t n) {
+    vector<unique_ptr<NodoProcesso> > procesos = procesosDePrueba();
+    ColaListosConcurrente cola(8, VIVOS);
+    for (size_t i = 0; i < VIVOS; i++) cola.encolar(procesos[i].get());
+    return repartir(HILOS, n, [&cola](size_t cuantos) {
+        NodoProcesso* p;
+        for (size_t i = 0; i < cuantos; i++) {
+            while (!cola.desencolar(p)) {}  // Frente an sin publicar
+            cola.encolar(p);
+        }
+    });
+}
+
+template <int HILOS>
+size_t despachosConMutex(size_t n) {
+    vector<unique_ptr<NodoProcesso> > procesos = procesosDePrueba();
+    ColaPrioridad cola;
+    cola.setPeriodoEnvejecimiento(0);
+    for (size_t i = 0; i < VIVOS; i++) cola.encolarPrioridad(procesos[i].get());
+    mutex cerrojo;
+    return repartir(HILOS, n, [&cola, &cerrojo](size_t cuantos) {
+        for (size_t i = 0; i < cuantos; i++) {
+            NodoProcesso* p;
+            {
+                lock_guard<mutex> guardia(cerrojo);
+                p = cola.desencolar();
+            }
+            lock_guard<mutex> guardia(cerrojo);
+            cola.encolarPrioridad(p);
+        }
+    });
+}
+
+#define BENCH_HILOS(h)                                                                       \
+    static RegistradorBench registro_concurrente_##h("cola_concurrente_hilos_" #h,           \
+                                                     despachosConcurrentes<h>, 2000000);     \
+    static RegistradorBench registro_mutex_##h("cola_mutex_hilos_" #h, despachosConMutex<h>, \
+                                               2000000);
+
+BENCH_HILOS(1)
+BENCH_HILOS(2)
+BENCH_HILOS(4)
+BENCH_HILOS(8)
+BENCH_HILOS(16)
+BENCH_HILOS(32)
+BENCH_HILOS(64)
+
+} // namespace
@@ -0,0 +1,177 @@
+#include <memory>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ColaPrioridad.h"
+#include "ListaProcesso.h"
+#include "NodoProcesso.h"
+#include "PilaMemoria.h"
+
+using namespace std;
+
+/* ================================================================
+ *     CONTENEDORES GENRICOS FRENTE A LAS CLASES DEL NCLEO
+ * ================================================================ */
+/**
+ * Cada grupo corre la misma carga sobre la clase del ncleo y sobre su
+ * versin genrica con capacidad fija (dentro del objeto) y dinmica.
+ * Las clases del ncleo hacen adems trabajo que las genricas no
+ * (traza, mtricas, ndices, resumen de memoria): la diferencia mide lo
+ * que cuesta eso ms los nodos en el heap y las comparaciones fuera de
+ * lnea.
+ */
+
+namespace {
+
+const size_t VIVOS = 1024;  // Elementos presentes durante la carga
+
+/**
+ * Procesos con prioridades repartidas en 0..100 para las colas.
+ */
+vector<unique_ptr<NodoProcesso> > procesosDePrueba() {
+    vector<unique_ptr<NodoProcesso> > procesos;
+    for (size_t i = 0; i < VIVOS; i++) {
+        procesos.emplace_back(new NodoProcesso((int)i, NombreProceso(), (int)((i * 37) % 101)));
+    }
+    return procesos;
+}
+
+/**
+ * Despacho estable sobre una cola de procesos genrica: saca el primero
+ * y lo vuelve a encolar (operacin = desencolar + encolar).
+ */
+template <typename Cola>
+size_t despachos(Cola& cola, size_t n) {
+    vector<unique_ptr<NodoProcesso> > procesos = procesosDePrueba();
+    for (size_t i = 0; i < VIVOS; i++) cola.encolar(procesos[i].get());
+    for (size_t i = 0; i < n; i++) cola.encolar(cola.desencolar());
+    noOptimizar(cola.frente());
+    return n;
+}
+
+/**
+ * Llenar y vaciar una pila de bloques genrica (operacin = push + pop).
+ */
+template <typename Pila>
+size_t ciclosPila(Pila& pila, size_t n) {
+    size_t rondas = n / VIVOS;
+    for (size_t r = 0; r < rondas; r++) {
+        for (size_t i = 0; i < VIVOS; i++) {
+            BloqueMemoria b = { (int)i, (int)(i & 7) };
+            pila.apilar(b);
+        }
+        for (size_t i = 0; i < VIVOS; i++) noOptimizar(pila.desapilar());
+    }
+    return rondas * VIVOS;
+}
+
+/**
+ * Rotacin de procesos en una lista genrica: entra uno nuevo al final
+ * y sale el ms antiguo, que est al frente (operacin = insertar +
+ * eliminar).
+ */
+template <typename Lista>
+size_t rotacionLista(Lista& lista, size_t n) {
+    for (size_t i = 0; i < VIVOS; i++) {
+        DatosProceso p = { (int)i, NombreProceso(), (int)(i % 101) };
+        lista.insertarAlFinal(p);
+    }
+    for (size_t i = VIVOS; i < VIVOS + n; i++) {
+        DatosProceso p = { (int)i, NombreProceso(), (int)(i % 101) };
+        lista.insertarAlFinal(p);
+        lista.eliminar((int)(i - VIVOS));
+    }
+    return n;
+}
+
+typedef bool (*Comparador)(const NodoProcesso*, const NodoProcesso*);
+
+bool mayorPrioridad(const NodoProcesso* a, const NodoProcesso* b) {
+    return a->prioridad > b->prioridad;
+}
+
+/**
+ * Criterio llamado a travs de un puntero a funcin elegido en tiempo de
+ * ejecucin: el compilador no puede expandirlo en lnea.
+ */
+struct PorPuntero {
+    Comparador f;
+    bool operator()(const NodoProcesso* a, const NodoProcesso* b) const { return f(a, b); }
+};
+
+} // namespace
+
+/* ---------------- Cola de procesos ---------------- */
+
+BENCH_SO(contenedor_cola_prioridad, 2000000) {
+    vector<unique_ptr<NodoProcesso> > procesos = procesosDePrueba();
+    ColaPrioridad cola;
+    cola.setPeriodoEnvejecimiento(0);
+    for (size_t i = 0; i < VIVOS; i++) cola.encolarPrioridad(procesos[i].get());
+    for (size_t i = 0; i < n; i++) cola.encolarPrioridad(cola.desencolar());
+    noOptimizar(cola.frente());
+    return n;
+}
+
+BENCH_SO(contenedor_cola_procesos_fija, 2000000) {
+    ColaProcesos<VIVOS> cola;
+    return despachos(cola, n);
+}
+
+BENCH_SO(contenedor_cola_procesos_dinamica, 2000000) {
+    ColaProcesos<> cola;
+    return despachos(cola, n);
+}
+
+// El mismo montculo con el criterio detrs de un puntero a funcin
+BENCH_SO(contenedor_cola_procesos_puntero, 2000000) {
+    Comparador f = mayorPrioridad;
+    noOptimizar(f);
+    PorPuntero criterio = { f };
+    ColaGenerica<NodoProcesso*, PorPuntero> cola(criterio);
+    return despachos(cola, n);
+}
+
+/* ---------------- Pila de memoria ---------------- */
+
+BENCH_SO(contenedor_pila_memoria, 2000000) {
+    PilaMemoria memoria((int)VIVOS);
+    size_t rondas = n / VIVOS;
+    for (size_t r = 0; r < rondas; r++) {
+        for (size_t i = 0; i < VIVOS; i++) memoria.push((int)i, (int)(i & 7));
+        for (size_t i = 0; i < VIVOS; i++) noOptimizar(memoria.pop());
+    }
+    return rondas * VIVOS;
+}
+
+BENCH_SO(contenedor_pila_bloques_fija, 2000000) {
+    PilaBloques<VIVOS> pila;
+    return ciclosPila(pila, n);
+}
+
+BENCH_SO(contenedor_pila_bloques_dinamica, 2000000) {
+    PilaBloques<> pila(VIVOS);
+    return ciclosPila(pila, n);
+}
+
+/* ---------------- Lista de procesos ---------------- */
+
+BENCH_SO(contenedor_lista_procesos, 2000000) {
+    ListaProcesso lista("");
+    for (size_t i = 0; i < VIVOS; i++) lista.insertarProcesso((int)i, "worker", (int)(i % 101));
+    for (size_t i = VIVOS; i < VIVOS + n; i++) {
+        lista.insertarProcesso((int)i, "worker", (int)(i % 101));
+        lista.eliminarProcesso((int)(i - VIVOS));
+    }
+    return n;
+}
+
+BENCH_SO(contenedor_lista_compacta_fija, 2000000) {
+    ListaProcesosCompacta<VIVOS + 1> lista;
+    return rotacionLista(lista, n);
+}
+
+BENCH_SO(contenedor_lista_compacta_dinamica, 2000000) {
+    ListaProcesosCompacta<> lista;
+    return rotacionLista(lista, n);
+}
@@ -0,0 +1,91 @@
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "CargasTrabajo.h"
+#include "CuerpoProceso.h"
+#include "Simulador.h"
+
+using namespace std;
+
+/* ================================================================
+ *          PROCESOS CON CUERPO (CORRUTINAS)
+ * ================================================================ */
+
+namespace {
+
+/**
+ * Simulador solo en memoria con n procesos de cuerpo mixto, ya en la
+ * cola de listos: la mitad cuenta primos, la otra mitad alterna rfagas
+ * de CPU y E/S.
+ */
+void poblarMixto(Simulador& sim, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int id = (int)i;
+        sim.getProcesos().insertarProcesso(id, i % 2 ? "calculo" : "interactivo",
+                                           (int)(i % 101));
+        if (i % 2) {
+            sim.asignarCuerpo(id, CargasTrabajo::primos(200));
+        } else {
+            sim.asignarCuerpo(id, CargasTrabajo::interactivo(3, 20, 50));
+        }
+        sim.encolar(id);
+    }
+}
+
+const uint64_t QUANTUM = 10;
+
+} // namespace
+
+// Reanudar y suspender una corrutina: el cambio de contexto en s
+BENCH_SO(corrutina_ceder, 10000000) {
+    CuerpoProceso cuerpo = CargasTrabajo::cedente(n);
+    uint64_t usadas;
+    size_t reanudaciones = 0;
+    while (!cuerpo.terminado()) {
+        cuerpo.reanudar(1, usadas);
+        reanudaciones++;
+    }
+    noOptimizar(cuerpo.getValor());
+    return reanudaciones;
+}
+
+// Cambio de contexto completo por el simulador: desencolar, reanudar,
+// avanzar el reloj y volver a encolar (1000 procesos que solo ceden)
+BENCH_SO(simulador_quantum_cedentes, 1000000) {
+    Simulador sim("", 16, 16);
+    const size_t procesos = 1000;
+    for (size_t i = 0; i < procesos; i++) {
+        sim.getProcesos().insertarProcesso((int)i, "cedente", (int)(i % 101));
+        sim.asignarCuerpo((int)i, CargasTrabajo::cedente(n / procesos));
+        sim.encolar((int)i);
+    }
+    return sim.correr(1, (size_t)-1);
+}
+
+// Carga mixta de n procesos hasta que todos terminan (operacin = quantum)
+BENCH_SO(simulador_corrutinas_mixtas, 200000) {
+    Simulador sim("", 16, 16);
+    poblarMixto(sim, n);
+    return sim.correr(QUANTUM, (size_t)-1);
+}
+
+// La misma carga repartida en 4 simuladores, uno por hilo anfitrin
+BENCH_SO(simulador_corrutinas_4_hilos, 200000) {
+    const int HILOS = 4;
+    vector<size_t> quantums(HILOS, 0);
+    vector<thread> hilos;
+    for (int h = 0; h < HILOS; h++) {
+        hilos.push_back(thread([h, n, &quantums]() {
+            Simulador sim("", 16, 16);
+            poblarMixto(sim, n / HILOS);
+            quantums[h] = sim.correr(QUANTUM, (size_t)-1);
+        }));
+    }
+    size_t total = 0;
+    for (int h = 0; h < HILOS; h++) {
+        hilos[h].join();
+        total += quantums[h];
+    }
+    return total;
+}
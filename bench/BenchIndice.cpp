@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <vector>
+
+#include "Benchmark.h"
+#include "IndiceProcesos.h"
+#include "NodoProcesso.h"
+
+using namespace std;
+
+/* ================================================================
+ *          NDICE ORDENADO FRENTE A LA LISTA ENLAZADA
+ * ================================================================ */
+
+namespace {
+
+/**
+ * Cadena de n procesos con IDs 0..n-1 en orden disperso, como queda la
+ * lista tras cargas e inserciones sin orden.
+ */
+struct Cadena {
+    vector<NodoProcesso*> nodos;
+    NodoProcesso* cabeza;
+
+    explicit Cadena(size_t n) : cabeza(NULL) {
+        for (size_t i = 0; i < n; i++) {
+            nodos.push_back(new NodoProcesso((int)((i * 7919) % n), "worker", 1));
+        }
+        for (size_t i = n; i-- > 0;) {
+            nodos[i]->siguiente = cabeza;
+            cabeza = nodos[i];
+        }
+    }
+
+    ~Cadena() {
+        for (size_t i = 0; i < nodos.size(); i++) delete nodos[i];
+    }
+};
+
+const int ANCHO_RANGO = 100;
+
+} // namespace
+
+// Inserciones una a una en orden disperso (divisiones de nodos incluidas)
+BENCH_SO(indice_insertar, 1000000) {
+    Cadena cadena(n);
+    IndiceProcesos indice;
+    for (size_t i = 0; i < n; i++) indice.insertar(cadena.nodos[i]);
+    noOptimizar(indice.tam());
+    return n;
+}
+
+// Alternancia de eliminaciones e inserciones sobre un ndice lleno
+BENCH_SO(indice_eliminar_insertar, 1000000) {
+    Cadena cadena(n);
+    IndiceProcesos indice;
+    indice.construir(cadena.cabeza);
+    for (size_t i = 0; i < n; i++) {
+        NodoProcesso* p = indice.eliminar((int)((i * 104729) % n));
+        if (p) indice.insertar(p);
+    }
+    return 2 * n;
+}
+
+// Bsqueda puntual por ID en el ndice
+BENCH_SO(indice_buscar, 1000000) {
+    Cadena cadena(n);
+    IndiceProcesos indice;
+    indice.construir(cadena.cabeza);
+    size_t encontrados = 0;
+    for (size_t i = 0; i < n; i++) {
+        encontrados += indice.buscar((int)((i * 104729) % n)) != NULL;
+    }
+    noOptimizar(encontrados);
+    return n;
+}
+
+// La misma bsqueda recorriendo la lista (lo que haca buscarPorId)
+BENCH_SO(lista_buscar_escaneo, 20000) {
+    Cadena cadena(n);
+    size_t encontrados = 0;
+    for (size_t i = 0; i < n; i++) {
+        int id = (int)((i * 104729) % n);
+        NodoProcesso* p = cadena.cabeza;
+        while (p && p->id != id) p = p->siguiente;
+        encontrados += p != NULL;
+    }
+    noOptimizar(encontrados);
+    return n;
+}
+
+// Consultas "IDs entre A y B" de ANCHO_RANGO procesos con el ndice
+// (n procesos y n consultas; cuenta como operacin cada consulta)
+BENCH_SO(indice_rango, 1000000) {
+    Cadena cadena(n);
+    IndiceProcesos indice;
+    indice.construir(cadena.cabeza);
+    size_t consultas = n, suma = 0;
+    for (size_t q = 0; q < consultas; q++) {
+        int desde = (int)((q * 104729) % n);
+        indice.rango(desde, desde + ANCHO_RANGO - 1,
+                     [&suma](NodoProcesso* p) { suma += (size_t)p->prioridad; });
+    }
+    noOptimizar(suma);
+    return consultas;
+}
+
+// Las mismas consultas filtrando la lista completa y ordenando el
+// resultado (n / 100 consultas: cada una recorre los n procesos)
+BENCH_SO(lista_rango_escaneo, 100000) {
+    Cadena cadena(n);
+    size_t consultas = n / 100, suma = 0;
+    vector<NodoProcesso*> resultado;
+    for (size_t q = 0; q < consultas; q++) {
+        int desde = (int)((q * 104729) % n);
+        int hasta = desde + ANCHO_RANGO - 1;
+        resultado.clear();
+        for (NodoProcesso* p = cadena.cabeza; p; p = p->siguiente) {
+            if (p->id >= desde && p->id <= hasta) resultado.push_back(p);
+        }
+        sort(resultado.begin(), resultado.end(),
+             [](NodoProcesso* a, NodoProcesso* b) { return a->id < b->id; });
+        for (size_t i = 0; i < resultado.size(); i++) suma += (size_t)resultado[i]->prioridad;
+    }
+    noOptimizar(suma);
+    return consultas;
+}
+
+// Seleccin del k-simo ID y rango de un ID
+BENCH_SO(indice_seleccionar_posicion, 1000000) {
+    Cadena cadena(n);
+    IndiceProcesos indice;
+    indice.construir(cadena.cabeza);
+    size_t suma = 0;
+    for (size_t i = 0; i < n; i++) {
+        NodoProcesso* p = indice.seleccionar((i * 104729) % n);
+        suma += indice.posicion(p->id);
+    }
+    noOptimizar(suma);
+    return 2 * n;
+}
+
+// Diez recorridos ordenados completos
+BENCH_SO(indice_recorrer, 1000000) {
+    Cadena cadena(n);
+    IndiceProcesos indice;
+    indice.construir(cadena.cabeza);
+    size_t suma = 0;
+    for (int r = 0; r < 10; r++) {
+        indice.recorrer([&suma](NodoProcesso* p) { suma += (size_t)p->id; });
+    }
+    noOptimizar(suma);
+    return 10 * n;
+}
@@ -0,0 +1,48 @@
+#include <cstdio>
+
+#include "Benchmark.h"
+#include "Instantanea.h"
+#include "Simulador.h"
+
+using namespace std;
+
+// Ronda de guardado y restauracin de una instantnea con n procesos
+// encolados y un bloque de memoria por proceso
+BENCH_SO(instantanea_guardar_restaurar, 5000) {
+    const char* archivo = "bench_instantanea.dat";
+    const int RONDAS = 20;
+    Simulador sim("", (int)n, 16);
+    for (size_t i = 0; i < n; i++) {
+        sim.getProcesos().insertarProcesso((int)i, "kthread", (int)(i % 101));
+        sim.encolar((int)i);
+        sim.asignarMemoria((int)i, (int)(0x1000 + i));
+    }
+    for (int r = 0; r < RONDAS; r++) {
+        Instantanea::guardar(sim, archivo);
+        Instantanea::restaurar(sim, archivo);
+    }
+    noOptimizar(sim.getPlanificador().frente());
+    remove(archivo);
+    return 2 * RONDAS * n;
+}
+
+// Despachos con guardados en segundo plano lanzados continuamente: el
+// costo por operacin debe parecerse al de la cola sin guardado
+BENCH_SO(instantanea_despachos_durante_guardado, 200000) {
+    const char* archivo = "bench_instantanea_fondo.dat";
+    const int PROCESOS = 1000;
+    Simulador sim("", PROCESOS, 16);
+    for (int i = 0; i < PROCESOS; i++) {
+        sim.getProcesos().insertarProcesso(i, "kthread", i % 101);
+        sim.encolar(i);
+    }
+    for (size_t i = 0; i < n; i++) {
+        if ((i & 1023) == 0 && !sim.getGuardado().enCurso()) {
+            sim.guardarInstantaneaEnSegundoPlano(archivo);
+        }
+        noOptimizar(sim.despachar());
+    }
+    sim.getGuardado().esperar();
+    remove(archivo);
+    return n;
+}
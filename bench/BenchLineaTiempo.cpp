@@ -0,0 +1,71 @@
+#include <cstdio>
+#include <memory>
+
+#include "Benchmark.h"
+#include "Simulador.h"
+
+using namespace std;
+
+/* ================================================================
+ *          LNEA DE TIEMPO DE PLANIFICACIN
+ * ================================================================ */
+
+namespace {
+
+const char* const ARCHIVO_LINEA = "bench_linea_tiempo.out";
+
+/**
+ * Despacho puro: 1000 procesos sin cuerpo que agotan cada uno su
+ * quantum y vuelven a la cola (operacin = quantum).
+ */
+size_t quantumsSinCuerpo(Simulador& sim, size_t n) {
+    for (int i = 0; i < 1000; i++) {
+        sim.getProcesos().insertarProcesso(i, "kworker", i % 101);
+        sim.encolar(i);
+    }
+    for (size_t i = 0; i < n; i++) sim.ejecutarQuantum(10);
+    return n;
+}
+
+/**
+ * Lnea de tiempo con n tramos de 1000 procesos, para medir la
+ * exportacin. Se registra una sola vez, en la primera repeticin.
+ */
+const LineaTiempo& lineaDe(size_t n) {
+    static unique_ptr<Simulador> sim;
+    static size_t nRegistrado = 0;
+    if (nRegistrado != n) {
+        sim.reset(new Simulador("", 16, 16));
+        sim->activarLineaTiempo(n);
+        quantumsSinCuerpo(*sim, n);
+        nRegistrado = n;
+    }
+    return sim->getLineaTiempo();
+}
+
+} // namespace
+
+BENCH_SO(linea_tiempo_quantum_sin_registrar, 2000000) {
+    Simulador sim("", 16, 16);
+    return quantumsSinCuerpo(sim, n);
+}
+
+// Lo mismo registrando cada tramo (capacidad para todos)
+BENCH_SO(linea_tiempo_quantum_registrando, 2000000) {
+    Simulador sim("", 16, 16);
+    sim.activarLineaTiempo(n);
+    return quantumsSinCuerpo(sim, n);
+}
+
+// Exportacin (operacin = tramo escrito)
+BENCH_SO(linea_tiempo_exportar_chrome, 1000000) {
+    lineaDe(n).guardar(ARCHIVO_LINEA, false);
+    remove(ARCHIVO_LINEA);
+    return n;
+}
+
+BENCH_SO(linea_tiempo_exportar_csv, 1000000) {
+    lineaDe(n).guardar(ARCHIVO_LINEA, true);
+    remove(ARCHIVO_LINEA);
+    return n;
+}
@@ -0,0 +1,48 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "ListaProcesso.h"
+#include "MemoriaVirtual.h"
+
+using namespace std;
+
+/* ================================================================
+ *          BENCHMARKS DE TRADUCCIN DE DIRECCIONES
+ * ================================================================ */
+
+/**
+ * Traduce n direcciones de 4 procesos con un conjunto de trabajo de
+ * `paginas` pginas por proceso (precalculadas, sin costo de parseo).
+ */
+static size_t traducirConjunto(size_t n, uint32_t paginas) {
+    ListaProcesso lista("");
+    MemoriaVirtual mv(1u << 16, 64, 8);
+    NodoProcesso* procesos[4];
+    for (int p = 0; p < 4; p++) {
+        lista.insertarProcesso(p + 1, "bench", 50);
+        procesos[p] = lista.buscarPorId(p + 1);
+        mv.crearEspacio(procesos[p]);
+    }
+    vector<uint32_t> direcciones(4096);
+    uint32_t x = 2463534242u;
+    for (size_t i = 0; i < direcciones.size(); i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        direcciones[i] = ((x % paginas) << BITS_DESPLAZAMIENTO) | (x & 0xFFF);
+    }
+    uint64_t suma = 0;
+    for (size_t i = 0; i < n; i++) {
+        suma += mv.traducir(procesos[i & 3], direcciones[i & 4095]);
+    }
+    noOptimizar(suma);
+    return n;
+}
+
+// Conjunto de trabajo que cabe en la TLB (aciertos casi siempre)
+BENCH_SO(vm_traducir_tlb_caliente, 10000000) {
+    return traducirConjunto(n, 32);
+}
+
+// Conjunto de trabajo mucho mayor que la TLB (page walk frecuente)
+BENCH_SO(vm_traducir_tlb_fria, 10000000) {
+    return traducirConjunto(n, 8192);
+}
@@ -0,0 +1,238 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ColaPrioridad.h"
+#include "ListaProcesso.h"
+#include "Metricas.h"
+#include "NodoProcesso.h"
+#include "Persistencia.h"
+#include "PilaMemoria.h"
+#include "PoolNombres.h"
+#include "Simulador.h"
+
+using namespace std;
+
+/* ================================================================
+ *          BENCHMARKS DE LAS ESTRUCTURAS DEL NCLEO
+ * ================================================================ */
+
+// Insercin al final de la lista (incluye la bsqueda de duplicados)
+BENCH_SO(lista_insertar, 5000) {
+    ListaProcesso lista("");
+    for (size_t i = 0; i < n; i++) {
+        lista.insertarProcesso((int)i, "worker", (int)(i % 101));
+    }
+    return n;
+}
+
+// Bsqueda puntual por ID sobre una lista ya poblada
+BENCH_SO(lista_buscar, 5000) {
+    ListaProcesso lista("");
+    for (size_t i = 0; i < n; i++) {
+        lista.insertarProcesso((int)i, "worker", (int)(i % 101));
+    }
+    size_t encontrados = 0;
+    for (size_t i = 0; i < n; i++) {
+        encontrados += lista.buscarPorId((int)((i * 7919) % n)) != NULL;
+    }
+    noOptimizar(encontrados);
+    return 2 * n;
+}
+
+// Encolado ordenado seguido de vaciado completo de la cola
+BENCH_SO(cola_encolar_desencolar, 5000) {
+    ListaProcesso lista("");
+    for (size_t i = 0; i < n; i++) {
+        lista.insertarProcesso((int)i, "worker", (int)((i * 37) % 101));
+    }
+    ColaPrioridad cola;
+    for (NodoProcesso* p = lista.primero(); p; p = p->siguiente) {
+        cola.encolarPrioridad(p);
+    }
+    for (size_t i = 0; i < n; i++) {
+        noOptimizar(cola.desencolar());
+    }
+    return 2 * n;
+}
+
+// Ciclos push/pop sobre la pila de memoria
+BENCH_SO(pila_push_pop, 1000000) {
+    PilaMemoria memoria((int)n);
+    for (size_t i = 0; i < n; i++) memoria.push((int)i);
+    for (size_t i = 0; i < n; i++) noOptimizar(memoria.pop());
+    return 2 * n;
+}
+
+// Lo mismo con direcciones dispersas: cada una cae entre dos ocupadas y
+// parte o une huecos (el caso caro de las estadsticas incrementales)
+BENCH_SO(pila_push_pop_dispersas, 1000000) {
+    PilaMemoria memoria((int)n);
+    for (size_t i = 0; i < n; i++) memoria.push((int)((i * 2654435761u) & 0x7fffffff));
+    noOptimizar(memoria.resumen().fragmentacion);
+    for (size_t i = 0; i < n; i++) noOptimizar(memoria.pop());
+    return 2 * n;
+}
+
+// Compactacin completa de direcciones dispersas en pasos de 64
+// (operacin = una direccin revisada y movida)
+BENCH_SO(pila_compactar, 1000000) {
+    PilaMemoria memoria((int)n);
+    for (size_t i = 0; i < n; i++) memoria.push((int)((i * 2654435761u) & 0x7fffffff));
+    memoria.iniciarCompactacion();
+    EstadisticasCompactacion e = memoria.compactar(64);
+    noOptimizar(memoria.resumen().libre);
+    return (size_t)e.examinadas;
+}
+
+// rbol de n procesos clonados de uno al azar, con un bloque de memoria
+// cada uno; se elimina entero desde la raz (operacin = un proceso)
+void clonarArbol(Simulador& sim, size_t n) {
+    sim.getProcesos().insertarProcesso(0, "init_usuario", 50);
+    for (size_t i = 1; i < n; i++) {
+        sim.clonarProceso((int)((i * 2654435761u) % i), (int)i);
+    }
+    for (size_t i = 0; i < n; i++) sim.asignarMemoria((int)i, (int)i);
+}
+
+BENCH_SO(arbol_eliminar_subarbol, 5000) {
+    Simulador sim("", (int)n, 16);
+    clonarArbol(sim, n);
+    return sim.eliminarSubarbol(0);
+}
+
+// Lo mismo proceso por proceso, hijos antes que padres (as nadie pasa
+// a init): cada eliminacin busca su anterior en la tabla, O(n)
+BENCH_SO(arbol_eliminar_uno_a_uno, 5000) {
+    Simulador sim("", (int)n, 16);
+    clonarArbol(sim, n);
+    vector<int> pids;
+    sim.getArbol().recorrer(0, [&pids](int pid, int) { pids.push_back(pid); });
+    for (size_t i = pids.size(); i-- > 0;) sim.eliminarProceso(pids[i]);
+    return pids.size();
+}
+
+// Guardado y carga del archivo CSV de procesos
+BENCH_SO(persistencia_guardar_cargar, 5000) {
+    const char* archivo = "bench_procesos.dat";
+    {
+        ListaProcesso lista("");
+        for (size_t i = 0; i < n; i++) {
+            lista.insertarProcesso((int)i, "kthread", (int)(i % 101));
+        }
+        Persistencia::guardarProcesos(lista.primero(), archivo);
+    }
+    NodoProcesso* cabeza = Persistencia::cargarProcesos(archivo);
+    while (cabeza) {
+        NodoProcesso* temp = cabeza;
+        cabeza = cabeza->siguiente;
+        delete temp;
+    }
+    remove(archivo);
+    return 2 * n;
+}
+
+// Lo mismo con el formato comprimido (bloques LZ, carga en paralelo)
+BENCH_SO(persistencia_comprimida_guardar_cargar, 5000) {
+    const char* archivo = "bench_procesos_z.dat";
+    {
+        ListaProcesso lista("");
+        for (size_t i = 0; i < n; i++) {
+            lista.insertarProcesso((int)i, "kthread", (int)(i % 101));
+        }
+        Persistencia::guardarProcesosComprimido(lista.primero(), archivo);
+    }
+    NodoProcesso* cabeza = Persistencia::cargarProcesos(archivo);
+    while (cabeza) {
+        NodoProcesso* temp = cabeza;
+        cabeza = cabeza->siguiente;
+        delete temp;
+    }
+    remove(archivo);
+    return 2 * n;
+}
+
+// Costo de un incremento de contador thread-local
+BENCH_SO(metricas_contador, 10000000) {
+    for (size_t i = 0; i < n; i++) {
+        SO_CONTAR(LISTA_BUSQUEDAS);
+    }
+    return n;
+}
+
+// Costo de registrar un valor en un histograma HDR
+BENCH_SO(metricas_histograma, 10000000) {
+    for (size_t i = 0; i < n; i++) {
+        SO_HISTOGRAMA(COLA_LONGITUD_ESCANEO, i & 4095);
+    }
+    return n;
+}
+
+// Eliminacin por ID de procesos dispersos en la cola
+BENCH_SO(cola_eliminar_por_id, 100000) {
+    vector<NodoProcesso*> nodos;
+    for (size_t i = 0; i < n; i++) {
+        nodos.push_back(new NodoProcesso((int)i, "worker", (int)((i * 37) % 101)));
+    }
+    ColaPrioridad cola;
+    for (size_t i = 0; i < n; i++) cola.encolarPrioridad(nodos[i]);
+    for (size_t i = 0; i < n; i++) cola.eliminar((int)((i * 7919) % n));
+    for (size_t i = 0; i < n; i++) delete nodos[i];
+    return n;
+}
+
+// Liberacin de la memoria de un proceso en una pila con muchos dueos
+BENCH_SO(pila_liberar_proceso, 100000) {
+    PilaMemoria memoria((int)n);
+    for (size_t i = 0; i < n; i++) memoria.push((int)i, (int)(i % 1000));
+    size_t liberados = 0;
+    for (int pid = 0; pid < 1000; pid++) liberados += memoria.liberarProceso(pid);
+    noOptimizar(liberados);
+    return n;
+}
+
+// Cambios de prioridad (subidas y bajadas) sobre una cola poblada
+BENCH_SO(cola_cambiar_prioridad, 100000) {
+    vector<NodoProcesso*> nodos;
+    for (size_t i = 0; i < n; i++) {
+        nodos.push_back(new NodoProcesso((int)i, "worker", (int)((i * 37) % 101)));
+    }
+    ColaPrioridad cola;
+    for (size_t i = 0; i < n; i++) cola.encolarPrioridad(nodos[i]);
+    for (size_t i = 0; i < 4 * n; i++) {
+        cola.cambiarPrioridad((int)((i * 7919) % n), (int)((i * 13) % 101));
+    }
+    for (size_t i = 0; i < n; i++) delete nodos[i];
+    return 4 * n;
+}
+
+// Carga sostenida de alta prioridad con un proceso de prioridad 0:
+// el envejecimiento debe despacharlo en un nmero acotado de ticks
+BENCH_SO(cola_envejecimiento, 100000) {
+    vector<NodoProcesso*> nodos;
+    for (size_t i = 0; i < 64; i++) {
+        nodos.push_back(new NodoProcesso((int)i, "worker", i == 0 ? 0 : 90));
+    }
+    ColaPrioridad cola;
+    for (size_t i = 0; i < nodos.size(); i++) cola.encolarPrioridad(nodos[i]);
+    for (size_t i = 0; i < n; i++) {
+        cola.encolarPrioridad(cola.desencolar());
+    }
+    noOptimizar(cola.getEsperaMaxima());
+    for (size_t i = 0; i < nodos.size(); i++) delete nodos[i];
+    return n;
+}
+
+// Internado de nombres ya presentes en el pool (camino de lectura
+// compartida que siguen los cargadores al reconstruir la lista)
+BENCH_SO(pool_internar_nombres, 1000000) {
+    char buf[16];
+    uint32_t suma = 0;
+    for (size_t i = 0; i < n; i++) {
+        int len = snprintf(buf, sizeof(buf), "worker-%u", (unsigned)(i & 255));
+        suma += PoolNombres::internar(string_view(buf, (size_t)len));
+    }
+    noOptimizar(suma);
+    return n;
+}
@@ -0,0 +1,41 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "Reemplazo.h"
+
+using namespace std;
+
+/* ================================================================
+ *          BENCHMARKS DE ALGORITMOS DE REEMPLAZO
+ * ================================================================ */
+
+/**
+ * Referencias con sesgo (90% a un 10% de las pginas) sobre 64K
+ * pginas, simuladas con 4096 marcos.
+ */
+static size_t simular(const char* politica, size_t n) {
+    static vector<uint64_t> refs;
+    if (refs.empty()) {
+        uint32_t x = 88172645u;
+        refs.resize(1 << 16);
+        for (size_t i = 0; i < refs.size(); i++) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            uint32_t pagina = (x % 10 < 9) ? (x >> 8) % 6553 : (x >> 8) % 65536;
+            refs[i] = pagina;
+        }
+    }
+    AlgoritmoReemplazo* alg = crearAlgoritmoReemplazo(politica, 4096);
+    uint64_t victima;
+    for (size_t i = 0; i < n; i++) {
+        alg->referenciar(refs[i & (refs.size() - 1)], victima);
+    }
+    noOptimizar(alg->getFallos());
+    delete alg;
+    return n;
+}
+
+BENCH_SO(reemplazo_fifo, 5000000) { return simular("fifo", n); }
+BENCH_SO(reemplazo_lru, 5000000) { return simular("lru", n); }
+BENCH_SO(reemplazo_clock, 5000000) { return simular("clock", n); }
+BENCH_SO(reemplazo_lfu, 5000000) { return simular("lfu", n); }
+BENCH_SO(reemplazo_arc, 5000000) { return simular("arc", n); }
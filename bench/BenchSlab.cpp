@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <vector>
+
+#include "AsignadorSlab.h"
+#include "Benchmark.h"
+#include "PilaMemoria.h"
+
+using namespace std;
+
+/* ================================================================
+ *                   ASIGNADOR SLAB
+ * ================================================================ */
+/**
+ * Rotacin de objetos de unos pocos tamaos con VIVOS presentes: libera
+ * uno al azar y asigna otro del mismo tamao desde la misma CPU
+ * (operacin = liberar + asignar). Con cargador casi todo se sirve sin
+ * tocar las listas de slabs; sin cargador cada operacin las recorre.
+ */
+
+namespace {
+
+const size_t VIVOS = 4096;
+const uint32_t TAMANOS[] = { 24, 40, 64, 100, 200, 320 };
+const int CPUS = 4;
+
+size_t rotacionSlab(uint32_t cargador, size_t n) {
+    AsignadorSlab a(4096, 4096, CPUS, cargador);
+    vector<uint32_t> vivos(VIVOS);
+    vector<uint32_t> tamanos(VIVOS);
+    for (size_t i = 0; i < VIVOS; i++) {
+        tamanos[i] = TAMANOS[i % 6];
+        vivos[i] = a.asignar(tamanos[i], (int)(i % CPUS));
+    }
+    uint64_t azar = 88172645463325252ull;
+    for (size_t i = 0; i < n; i++) {
+        azar ^= azar << 13;
+        azar ^= azar >> 7;
+        azar ^= azar << 17;
+        size_t v = azar % VIVOS;
+        int cpu = (int)(i % CPUS);
+        a.liberar(vivos[v], cpu);
+        vivos[v] = a.asignar(tamanos[v], cpu);
+    }
+    noOptimizar(vivos[0]);
+    return n;
+}
+
+} // namespace
+
+BENCH_SO(slab_rotacion_cargador, 2000000) {
+    return rotacionSlab(32, n);
+}
+
+BENCH_SO(slab_rotacion_sin_cargador, 2000000) {
+    return rotacionSlab(0, n);
+}
+
+// Lo mismo sobre la pila de memoria, que solo admite orden LIFO
+BENCH_SO(slab_referencia_pila_memoria, 2000000) {
+    PilaMemoria memoria((int)VIVOS + 1);
+    for (size_t i = 0; i < VIVOS; i++) memoria.push((int)i * 64);
+    for (size_t i = 0; i < n; i++) {
+        int d = memoria.pop();
+        memoria.push(d);
+    }
+    return n;
+}
@@ -0,0 +1,38 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "RuedaTemporizadores.h"
+
+using namespace std;
+
+// Programa n temporizadores con plazos dispersos y los dispara todos
+BENCH_SO(rueda_programar_disparar, 1000000) {
+    vector<Temporizador> temporizadores(n);
+    RuedaTemporizadores rueda;
+    uint64_t x = 88172645463325252ull;
+    for (size_t i = 0; i < n; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        rueda.programar(&temporizadores[i], 1 + x % 100000);
+    }
+    size_t disparados = rueda.avanzar(100000, [](Temporizador*) {});
+    noOptimizar(disparados);
+    return 2 * n;
+}
+
+// Programar y cancelar con un milln de temporizadores pendientes
+BENCH_SO(rueda_programar_cancelar, 1000000) {
+    vector<Temporizador> dormidos(1000000);
+    RuedaTemporizadores rueda;
+    for (size_t i = 0; i < dormidos.size(); i++) {
+        rueda.programar(&dormidos[i], 1 + (i * 7919) % 5000000);
+    }
+    Temporizador t;
+    for (size_t i = 0; i < n; i++) {
+        rueda.programar(&t, 1 + (i * 104729) % 10000000);
+        rueda.cancelar(&t);
+    }
+    noOptimizar(rueda.getActivos());
+    return 2 * n;
+}
@@ -0,0 +1,102 @@
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ColaPrioridad.h"
+#include "ListaProcesso.h"
+#include "ReproductorTraza.h"
+#include "Simulador.h"
+#include "Traza.h"
+
+using namespace std;
+
+static const char* const ARCHIVO_TRAZA = "bench_traza.tr";
+
+// Inserta, busca y elimina el proceso ms antiguo con 1000 vivos
+static size_t cicloLista(size_t n) {
+    const size_t VIVOS = 1000;
+    ListaProcesso lista("");
+    for (size_t i = 0; i < n; i++) {
+        lista.insertarProcesso((int)i, "kworker", (int)(i % 101));
+        noOptimizar(lista.buscarPorId((int)(i / 2)));
+        if (i >= VIVOS) lista.eliminarProcesso((int)(i - VIVOS));
+    }
+    return 3 * n;
+}
+
+// Despacha y reencola con 1024 procesos listos
+static size_t cicloCola(size_t n) {
+    vector<NodoProcesso*> nodos;
+    ColaPrioridad cola;
+    for (int i = 0; i < 1024; i++) {
+        nodos.push_back(new NodoProcesso(i, "kworker", i % 101));
+        cola.encolarPrioridad(nodos.back());
+    }
+    for (size_t i = 0; i < n; i++) {
+        NodoProcesso* p = cola.desencolar();
+        cola.encolarPrioridad(p);
+    }
+    cola.vaciar();
+    for (size_t i = 0; i < nodos.size(); i++) delete nodos[i];
+    return 2 * n;
+}
+
+BENCH_SO(traza_lista_sin_grabar, 1000000) {
+    return cicloLista(n);
+}
+
+// Lo mismo grabando; incluye el vaciado final al detener
+BENCH_SO(traza_lista_grabando, 1000000) {
+    Traza::iniciar(ARCHIVO_TRAZA);
+    size_t ops = cicloLista(n);
+    Traza::detener();
+    remove(ARCHIVO_TRAZA);
+    return ops;
+}
+
+BENCH_SO(traza_cola_sin_grabar, 1000000) {
+    return cicloCola(n);
+}
+
+BENCH_SO(traza_cola_grabando, 1000000) {
+    Traza::iniciar(ARCHIVO_TRAZA);
+    size_t ops = cicloCola(n);
+    Traza::detener();
+    remove(ARCHIVO_TRAZA);
+    return ops;
+}
+
+// Reproduccin de una traza del ciclo de vida completo de n procesos
+// (alta, memoria, cola, despacho, fin y baja, con 1000 vivos). La traza
+// se graba y se carga una sola vez, en la primera repeticin: la
+// mediana mide solo la reproduccin.
+BENCH_SO(traza_reproducir, 200000) {
+    static size_t nGrabado = 0;
+    static Traza::TrazaCargada traza;
+    if (nGrabado != n) {
+        const size_t VIVOS = 1000;
+        {
+            Simulador sim("", (int)(2 * VIVOS), 16);
+            Traza::iniciar(ARCHIVO_TRAZA);
+            for (size_t i = 0; i < n; i++) {
+                int id = (int)i;
+                sim.getProcesos().insertarProcesso(id, "kworker", id % 101);
+                sim.asignarMemoria(id, 0x1000 + id);
+                sim.encolar(id);
+                if (i >= VIVOS) {
+                    sim.despachar();
+                    sim.terminar();
+                    sim.eliminarProceso(id - (int)VIVOS);
+                }
+            }
+        }
+        Traza::detener();
+        traza = Traza::cargar(ARCHIVO_TRAZA);
+        remove(ARCHIVO_TRAZA);
+        nGrabado = n;
+    }
+    ReproductorTraza reproductor;
+    reproductor.reproducir(traza);
+    noOptimizar(reproductor.getDivergencias());
+    return traza.eventos.size();
+}
@@ -0,0 +1,75 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+vector<CasoBench>& casosBench() {
+    static vector<CasoBench> casos;
+    return casos;
+}
+
+/**
+ * Muestra la ayuda de lnea de comandos.
+ */
+static void mostrarUso(const char* programa) {
+    cout << "Uso: " << programa << " [filtro] [--n=N] [--rep=R] [--lista]\n"
+         << "  filtro   Ejecuta solo los casos cuyo nombre contiene el texto\n"
+         << "  --n=N    Tamao de problema (por defecto, el de cada caso)\n"
+         << "  --rep=R  Repeticiones por caso (mediana reportada, defecto 5)\n"
+         << "  --lista  Lista los casos registrados y sale\n";
+}
+
+int main(int argc, char** argv) {
+    string filtro;
+    size_t n = 0;
+    int repeticiones = 5;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--n=", 4) == 0) {
+            n = strtoull(argv[i] + 4, NULL, 10);
+        } else if (strncmp(argv[i], "--rep=", 6) == 0) {
+            repeticiones = max(1, atoi(argv[i] + 6));
+        } else if (strcmp(argv[i], "--lista") == 0) {
+            for (size_t c = 0; c < casosBench().size(); c++) {
+                cout << casosBench()[c].nombre << "\n";
+            }
+            return 0;
+        } else if (argv[i][0] == '-') {
+            mostrarUso(argv[0]);
+            return 1;
+        } else {
+            filtro = argv[i];
+        }
+    }
+
+    vector<CasoBench> casos = casosBench();
+    sort(casos.begin(), casos.end(),
+         [](const CasoBench& a, const CasoBench& b) { return a.nombre < b.nombre; });
+
+    printf("%-40s %12s %14s %14s\n", "caso", "n", "ns/op", "Mop/s");
+    for (size_t c = 0; c < casos.size(); c++) {
+        if (!filtro.empty() && casos[c].nombre.find(filtro) == string::npos) continue;
+
+        size_t tam = n ? n : casos[c].nDefecto;
+        vector<double> muestras;
+        size_t ops = 0;
+        for (int r = 0; r < repeticiones; r++) {
+            chrono::steady_clock::time_point ini = chrono::steady_clock::now();
+            ops = casos[c].funcion(tam);
+            chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+            double ns = chrono::duration<double, nano>(fin - ini).count();
+            muestras.push_back(ops ? ns / ops : ns);
+        }
+        sort(muestras.begin(), muestras.end());
+        double mediana = muestras[muestras.size() / 2];
+        printf("%-40s %12zu %14.1f %14.3f\n", casos[c].nombre.c_str(), tam,
+               mediana, mediana > 0 ? 1e3 / mediana : 0.0);
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/* ================================================================
+ *                   ARNS DE BENCHMARKS
+ * ================================================================ */
+/**
+ * Arns mnimo de benchmarks sin dependencias externas.
+ * Cada caso recibe un tamao de problema y devuelve el nmero de
+ * operaciones que ejecut; el arns mide el tiempo de pared, repite
+ * el caso varias veces y reporta la mediana en ns/op.
+ */
+typedef std::size_t (*FuncionBench)(std::size_t n);
+
+struct CasoBench {
+    std::string nombre;    // Nombre nico del caso (grupo/operacin)
+    FuncionBench funcion;  // Cuerpo del caso
+    std::size_t nDefecto;  // Tamao de problema por defecto
+};
+
+/**
+ * Registro global de casos, poblado por inicializadores estticos.
+ */
+std::vector<CasoBench>& casosBench();
+
+/**
+ * Objeto auxiliar cuyo constructor aade un caso al registro.
+ */
+struct RegistradorBench {
+    RegistradorBench(const char* nombre, FuncionBench funcion, std::size_t nDefecto) {
+        CasoBench caso = { nombre, funcion, nDefecto };
+        casosBench().push_back(caso);
+    }
+};
+
+/**
+ * Impide que el optimizador elimine un valor calculado en el benchmark.
+ */
+template <typename T>
+inline void noOptimizar(const T& valor) {
+    asm volatile("" : : "g"(&valor) : "memory");
+}
+
+/**
+ * Define y registra un caso: BENCH_SO(lista_insertar, 10000) { ... return n; }
+ */
+#define BENCH_SO(nombre, nDefecto)                                              \
+    static std::size_t bench_##nombre(std::size_t n);                           \
+    static RegistradorBench registro_##nombre(#nombre, bench_##nombre, nDefecto); \
+    static std::size_t bench_##nombre(std::size_t n)
+
+#endif // BENCHMARK_H
@@ -0,0 +1,107 @@
+#ifndef ALMACEN_H
+#define ALMACEN_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+/* ================================================================
+ *              POLTICA DE CAPACIDAD DE LOS CONTENEDORES
+ * ================================================================ */
+/**
+ * Espacio de elementos de los contenedores genricos (PilaGenerica,
+ * ColaGenerica, ListaGenerica), elegido en tiempo de compilacin:
+ *
+ * - N > 0: capacidad fija de N elementos dentro del propio objeto, sin
+ *   ninguna reserva en el heap. Agregar ms all de N falla.
+ * - N == 0: arreglo pedido al asignador que crece al doble cuando hace
+ *   falta.
+ *
+ * Los elementos deben ser copiables trivialmente (enteros, punteros,
+ * estructuras simples): el almacn los mueve byte a byte al crecer y no
+ * ejecuta constructores ni destructores.
+ *
+ * @tparam T Tipo de elemento
+ * @tparam N Capacidad fija (0 = dinmica)
+ * @tparam Asignador Asignador para el caso dinmico
+ */
+template <typename T, std::size_t N, typename Asignador>
+class Almacen {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "los contenedores genricos guardan tipos copiables trivialmente");
+
+private:
+    alignas(T) unsigned char bytes[N * sizeof(T)];
+
+public:
+    static const bool FIJO = true;
+
+    Almacen() {}
+
+    T* datos() { return reinterpret_cast<T*>(bytes); }
+    const T* datos() const { return reinterpret_cast<const T*>(bytes); }
+    std::size_t capacidad() const { return N; }
+
+    /**
+     * Asegura lugar para n elementos.
+     * @param usados Elementos ocupados hoy (los que se conservan al crecer)
+     * @return false si n supera la capacidad fija
+     */
+    bool asegurar(std::size_t n, std::size_t /*usados*/) { return n <= N; }
+
+private:
+    Almacen(const Almacen&);
+    Almacen& operator=(const Almacen&);
+};
+
+template <typename T, typename Asignador>
+class Almacen<T, 0, Asignador> {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "los contenedores genricos guardan tipos copiables trivialmente");
+
+private:
+    typedef typename std::allocator_traits<Asignador>::template rebind_alloc<T> AsignadorT;
+    typedef std::allocator_traits<AsignadorT> Rasgos;
+
+    AsignadorT asignador;
+    T* arreglo;
+    std::size_t cap;
+
+public:
+    static const bool FIJO = false;
+
+    Almacen() : arreglo(NULL), cap(0) {}
+    ~Almacen() { liberar(); }
+
+    T* datos() { return arreglo; }
+    const T* datos() const { return arreglo; }
+    std::size_t capacidad() const { return cap; }
+
+    bool asegurar(std::size_t n, std::size_t usados) {
+        if (n > cap) crecer(n, usados);
+        return true;
+    }
+
+private:
+    void crecer(std::size_t n, std::size_t usados) {
+        std::size_t nueva = cap < 16 ? 16 : cap * 2;
+        if (nueva < n) nueva = n;
+        T* otro = Rasgos::allocate(asignador, nueva);
+        if (usados != 0) std::memcpy(otro, arreglo, usados * sizeof(T));
+        liberar();
+        arreglo = otro;
+        cap = nueva;
+    }
+
+    void liberar() {
+        if (arreglo != NULL) Rasgos::deallocate(asignador, arreglo, cap);
+        arreglo = NULL;
+        cap = 0;
+    }
+
+    Almacen(const Almacen&);
+    Almacen& operator=(const Almacen&);
+};
+
+#endif // ALMACEN_H
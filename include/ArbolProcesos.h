@@ -0,0 +1,163 @@
+#ifndef ARBOL_PROCESOS_H
+#define ARBOL_PROCESOS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* ================================================================
+ *                   RBOL DE PROCESOS
+ * ================================================================ */
+/**
+ * Jerarqua padre-hijo de los procesos (quin hizo fork de quin).
+ *
+ * Los nodos viven en un arreglo denso y se enlazan por posicin, como
+ * primer hijo / siguiente hermano (ms el ltimo hijo y el hermano
+ * anterior, para agregar y desenlazar en O(1)). Las posiciones de los
+ * nodos quitados se reutilizan. La raz, en la posicin 0, es init: no
+ * es un proceso de la tabla y no se puede quitar.
+ *
+ * Recorrer un subrbol no usa pila: baja por el primer hijo, pasa al
+ * siguiente hermano y sube por el padre, as que contar descendientes
+ * o quitar un subrbol cuesta O(tamao del subrbol).
+ *
+ * Con archivo de persistencia, el rbol se carga al construirse y se
+ * guarda al destruirse (ver Persistencia::guardarArbol).
+ */
+class ArbolProcesos {
+public:
+    static const int INIT = -1;                 // PID de la raz
+    static const std::string ARCHIVO_ARBOL;     // Archivo de persistencia por defecto
+
+private:
+    static const uint32_t NINGUNO = UINT32_MAX;
+
+    struct Nodo {
+        int pid;
+        uint32_t padre;
+        uint32_t primerHijo;
+        uint32_t ultimoHijo;
+        uint32_t sigHermano;
+        uint32_t antHermano;
+    };
+
+    std::vector<Nodo> nodos;                    // Posicin 0: init
+    std::vector<uint32_t> libres;               // Posiciones para reutilizar
+    std::unordered_map<int, uint32_t> posiciones; // pid -> posicin
+    std::string archivo;                        // "" = sin persistencia
+
+public:
+    /**
+     * @param archivo Archivo de persistencia ("" = solo en memoria)
+     */
+    explicit ArbolProcesos(const std::string& archivo = "");
+
+    /**
+     * Guarda el rbol en su archivo, si tiene.
+     */
+    ~ArbolProcesos();
+
+    /**
+     * Guarda el rbol en su archivo.
+     * @throws runtime_error Si no hay archivo o falla la escritura
+     */
+    void guardar() const;
+
+    /**
+     * Agrega un proceso como ltimo hijo de otro, en O(1).
+     * @param padre PID del padre (INIT para colgarlo de la raz)
+     * @throws runtime_error Si el PID ya est o es INIT, o el padre no est
+     */
+    void agregar(int pid, int padre = INIT);
+
+    /**
+     * Quita un proceso; sus hijos pasan a ser hijos de init, en
+     * O(hijos).
+     * @return Hijos reasignados
+     * @throws runtime_error Si el PID no est
+     */
+    size_t eliminar(int pid);
+
+    /**
+     * Cuelga un proceso (con todo su subrbol) de init, en O(1).
+     * @throws runtime_error Si el PID no est
+     */
+    void reparentarAInit(int pid);
+
+    /**
+     * Quita un proceso y todos sus descendientes, en O(tamao del subrbol).
+     * @param pids Recibe los PID quitados, en preorden (padres antes que hijos)
+     * @return Procesos quitados
+     * @throws runtime_error Si el PID no est o es INIT
+     */
+    size_t quitarSubarbol(int pid, std::vector<int>& pids);
+
+    /**
+     * Cuenta los descendientes (sin contar al proceso), en
+     * O(tamao del subrbol).
+     * @throws runtime_error Si el PID no est
+     */
+    size_t contarDescendientes(int pid) const;
+
+    /**
+     * PID del padre (INIT si cuelga de la raz).
+     * @throws runtime_error Si el PID no est o es INIT
+     */
+    int padreDe(int pid) const;
+
+    bool contiene(int pid) const { return pid == INIT || posiciones.count(pid) != 0; }
+
+    /**
+     * Procesos en el rbol (sin contar init).
+     */
+    size_t tamano() const { return posiciones.size(); }
+
+    /**
+     * Quita todos los procesos; queda solo init.
+     */
+    void vaciar();
+
+    /**
+     * Llama a f(pid, profundidad) para un proceso y sus descendientes en
+     * preorden, con los hermanos en el orden en que se agregaron. El
+     * proceso tiene profundidad 0.
+     * @throws runtime_error Si el PID no est
+     */
+    template <typename F>
+    void recorrer(int pid, F f) const {
+        uint32_t raiz = posicion(pid);
+        int profundidad = 0;
+        for (uint32_t n = raiz; n != NINGUNO; n = siguiente(n, raiz, profundidad)) {
+            f(nodos[n].pid, profundidad);
+        }
+    }
+
+    const std::string& getArchivo() const { return archivo; }
+
+private:
+    uint32_t posicion(int pid) const;
+    void enlazar(uint32_t n, uint32_t padre);
+    void desenlazar(uint32_t n);
+
+    /**
+     * Nodo que sigue a n en el preorden del subrbol de raz, o NINGUNO.
+     */
+    uint32_t siguiente(uint32_t n, uint32_t raiz, int& profundidad) const {
+        if (nodos[n].primerHijo != NINGUNO) {
+            profundidad++;
+            return nodos[n].primerHijo;
+        }
+        while (n != raiz && nodos[n].sigHermano == NINGUNO) {
+            n = nodos[n].padre;
+            profundidad--;
+        }
+        return n == raiz ? NINGUNO : nodos[n].sigHermano;
+    }
+
+    ArbolProcesos(const ArbolProcesos&);
+    ArbolProcesos& operator=(const ArbolProcesos&);
+};
+
+#endif // ARBOL_PROCESOS_H
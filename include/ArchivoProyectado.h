@@ -0,0 +1,43 @@
+#ifndef ARCHIVO_PROYECTADO_H
+#define ARCHIVO_PROYECTADO_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/* ================================================================
+ *                   ARCHIVO PROYECTADO EN MEMORIA
+ * ================================================================ */
+/**
+ * Proyeccin de solo lectura de un archivo completo (mmap en POSIX;
+ * en Windows se lee a un bfer). Los datos viven mientras viva el objeto.
+ */
+class ArchivoProyectado {
+public:
+    /**
+     * @param archivo Ruta del archivo
+     * @throws runtime_error Si no se puede abrir o proyectar
+     */
+    explicit ArchivoProyectado(const std::string& archivo);
+    ~ArchivoProyectado();
+
+    /**
+     * Indica si un archivo existe y se puede abrir para lectura.
+     */
+    static bool existe(const std::string& archivo);
+
+    const char* datos() const { return inicio; }
+    size_t tam() const { return longitud; }
+
+private:
+    const char* inicio;
+    size_t longitud;
+#ifdef _WIN32
+    std::vector<char> copia;
+#endif
+
+    ArchivoProyectado(const ArchivoProyectado&);
+    ArchivoProyectado& operator=(const ArchivoProyectado&);
+};
+
+#endif // ARCHIVO_PROYECTADO_H
@@ -0,0 +1,204 @@
+#ifndef ASIGNADOR_SLAB_H
+#define ASIGNADOR_SLAB_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * Estado de una clase de tamao del asignador slab.
+ */
+struct EstadisticasClaseSlab {
+    uint32_t tamano;          // Bytes por objeto
+    uint32_t objetosPorSlab;
+    size_t parciales;         // Slabs con objetos libres y ocupados
+    size_t llenos;            // Slabs sin objetos libres
+    size_t vacios;            // Slabs sin objetos ocupados (retenidos)
+    uint64_t enUso;           // Objetos entregados al cliente
+    uint64_t enCargadores;    // Objetos libres en los cargadores de las CPU
+    uint64_t bytesPedidos;    // Suma de los tamaos pedidos de los objetos en uso
+    uint64_t asignaciones;
+    uint64_t liberaciones;
+    uint64_t recargas;        // Asignaciones que no encontraron nada en el cargador
+    uint64_t descargas;       // Liberaciones que encontraron el cargador lleno
+};
+
+/**
+ * Resumen de todo el asignador.
+ */
+struct ResumenSlab {
+    uint32_t paginas;         // Pginas de la arena
+    uint32_t paginasLibres;   // Sin clase asignada
+    uint64_t objetos;         // Objetos entregados al cliente
+    uint64_t bytesPedidos;    // Lo que pidi el cliente
+    uint64_t bytesObjetos;    // Lo que ocupan sus objetos (tamao de la clase)
+    uint64_t bytesSlabs;      // Pginas tomadas por alguna clase
+    uint64_t asignaciones;
+    uint64_t recargas;
+    /**
+     * bytesObjetos / bytesSlabs: cunto de las pginas tomadas est
+     * realmente entregado (1 = ningn objeto libre ni slab vaco).
+     */
+    double utilizacion;
+    /**
+     * 1 - bytesPedidos / bytesObjetos: lo que se pierde por redondear
+     * cada pedido a su clase.
+     */
+    double fragmentacionInterna;
+    /**
+     * Fraccin de asignaciones servidas por el cargador de la CPU.
+     */
+    double aciertosCargador;
+};
+
+/* ================================================================
+ *                   ASIGNADOR SLAB
+ * ================================================================ */
+/**
+ * Asignador de objetos de tamao fijo al estilo slab (Bonwick) sobre una
+ * arena simulada de pginas. Cada pedido se redondea a la menor clase de
+ * tamao que lo contiene; cada clase toma pginas enteras (slabs) y las
+ * parte en objetos de su tamao. Los slabs de una clase estn en una de
+ * tres listas segn sus objetos ocupados: parciales, llenos o vacos. Se
+ * toma primero de un parcial, despus de un vaco y por ltimo de una
+ * pgina libre; un slab que queda vaco se retiene hasta 'vaciosMax' por
+ * clase y el resto vuelve a las pginas libres. Si no quedan pginas se
+ * recupera lo retenido (ver recuperar()) antes de rechazar el pedido.
+ *
+ * Cada CPU tiene adems un cargador por clase (la "magazine" de
+ * Bonwick): una pila de objetos libres de la que asignar y liberar no
+ * tocan las listas de slabs. Cuando se vaca se recarga con media
+ * capacidad de objetos de los slabs, y cuando se llena se devuelve a los
+ * slabs su mitad ms antigua. Con cargadores de capacidad 0 cada
+ * operacin va directo a los slabs.
+ *
+ * Las direcciones son desplazamientos de 32 bits dentro de la arena: el
+ * slab de una direccin es su nmero de pgina, as liberar no busca.
+ * Cada slab recuerda el tamao pedido de sus objetos en uso, que sirve
+ * para detectar liberaciones invlidas y medir la fragmentacin interna.
+ */
+class AsignadorSlab {
+public:
+    static const uint32_t NINGUNO = UINT32_MAX;
+
+    /**
+     * Clases por defecto: de 16 a 2048 bytes, potencias de dos y sus
+     * puntos medios (como las cachs kmalloc de Linux).
+     */
+    static std::vector<uint32_t> clasesPorDefecto();
+
+private:
+    enum EstadoSlab : uint8_t { SLAB_LIBRE, SLAB_PARCIAL, SLAB_LLENO, SLAB_VACIO };
+
+    struct Slab {
+        int clase;                     // -1 si la pgina est libre
+        EstadoSlab estado;
+        uint32_t ocupados;             // Objetos fuera del slab (cliente o cargador)
+        std::vector<uint16_t> libres;  // ndices de objetos libres (pila)
+        std::vector<uint16_t> pedido;  // Tamao pedido por objeto (0 = no lo tiene el cliente)
+        Slab* ant;                     // Lista de su estado en la clase
+        Slab* sig;
+    };
+
+    struct ListaSlabs {
+        Slab* cabeza;
+        size_t tam;
+    };
+
+    struct Clase {
+        uint32_t tamano;
+        uint32_t objetosPorSlab;
+        ListaSlabs listas[4];          // Por EstadoSlab (la de SLAB_LIBRE no se usa)
+        EstadisticasClaseSlab est;
+    };
+
+    std::vector<Slab> slabs;           // Uno por pgina
+    std::vector<uint32_t> paginasLibres;
+    std::vector<Clase> clases;
+    std::vector<uint8_t> clasePorTamano; // (tamao + 7) / 8 -> clase
+    uint32_t bitsSlab;
+    uint32_t tamSlab;
+    int cpus;
+    uint32_t tamCargador;
+    size_t vaciosMax;
+    std::vector<uint32_t> cargadores;  // [cpu][clase][tamCargador] direcciones
+    std::vector<uint32_t> cargados;    // [cpu][clase] objetos en el cargador
+
+public:
+    /**
+     * @param paginas Pginas de la arena (cada una puede ser un slab)
+     * @param tamSlab Bytes por pgina (potencia de dos, 256-32768)
+     * @param cpus CPUs con cargador propio (>= 1)
+     * @param tamCargador Objetos por cargador (0 = sin cargadores)
+     * @param clases Tamaos de las clases, crecientes y mltiplos de 8
+     * @param vaciosMax Slabs vacos que retiene cada clase
+     * @throws runtime_error Si algn parmetro es invlido
+     */
+    AsignadorSlab(uint32_t paginas, uint32_t tamSlab = 4096, int cpus = 1,
+                  uint32_t tamCargador = 32,
+                  const std::vector<uint32_t>& clases = clasesPorDefecto(),
+                  size_t vaciosMax = 2);
+
+    /**
+     * Asigna un objeto de al menos 'tamano' bytes desde la CPU dada.
+     * @return Direccin del objeto
+     * @throws runtime_error Si el tamao no tiene clase, la CPU no existe
+     *         o no quedan pginas libres
+     */
+    uint32_t asignar(uint32_t tamano, int cpu = 0);
+
+    /**
+     * Libera un objeto desde la CPU dada (no tiene que ser la que lo asign).
+     * @throws runtime_error Si la direccin no es un objeto asignado
+     */
+    void liberar(uint32_t direccion, int cpu = 0);
+
+    /**
+     * Devuelve a los slabs los objetos de todos los cargadores.
+     */
+    void vaciarCargadores();
+
+    /**
+     * Vaca los cargadores y devuelve a las pginas libres todos los
+     * slabs vacos, tambin los retenidos.
+     * @return Pginas liberadas
+     */
+    size_t recuperar();
+
+    /**
+     * Tamao pedido del objeto en una direccin (0 si no est asignado).
+     */
+    uint32_t tamanoPedido(uint32_t direccion) const;
+
+    int getClases() const { return (int)clases.size(); }
+    uint32_t getTamSlab() const { return tamSlab; }
+    int getCpus() const { return cpus; }
+    uint32_t getTamCargador() const { return tamCargador; }
+
+    EstadisticasClaseSlab estadisticasClase(int clase) const { return clases[(size_t)clase].est; }
+
+    /**
+     * Resumen del asignador, O(clases).
+     */
+    ResumenSlab resumen() const;
+
+    /**
+     * Muestra el resumen y una fila por clase usada.
+     */
+    void mostrarEstadisticas(std::ostream& os) const;
+
+private:
+    int claseDe(uint32_t tamano) const;
+    uint32_t tomarObjeto(int c, bool reclamar);
+    void devolverObjeto(uint32_t direccion);
+    void recargar(int c, size_t k);
+    void descargar(int c, size_t k, uint32_t cuantos);
+    Slab* nuevoSlab(int c);
+    void mover(Clase& clase, Slab* s, EstadoSlab estado);
+
+    AsignadorSlab(const AsignadorSlab&);
+    AsignadorSlab& operator=(const AsignadorSlab&);
+};
+
+#endif // ASIGNADOR_SLAB_H
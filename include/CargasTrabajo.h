@@ -0,0 +1,40 @@
+#ifndef CARGAS_TRABAJO_H
+#define CARGAS_TRABAJO_H
+
+#include <cstdint>
+
+#include "CuerpoProceso.h"
+
+/* ================================================================
+ *                   CARGAS DE TRABAJO DE EJEMPLO
+ * ================================================================ */
+/**
+ * Cuerpos de proceso listos para usar: hacen clculo real y cobran una
+ * unidad de CPU por paso, as su duracin simulada sigue al trabajo.
+ */
+namespace CargasTrabajo {
+
+/**
+ * Limitado por CPU: cuenta los primos menores que 'limite' por divisin
+ * de prueba (una unidad por candidato).
+ * @return (co_return) Cantidad de primos
+ */
+CuerpoProceso primos(uint64_t limite);
+
+/**
+ * Interactivo: 'rafagas' ciclos de 'cpu' unidades de clculo (un hash
+ * FNV-1a) seguidas de 'es' ticks de E/S.
+ * @return (co_return) Hash final
+ */
+CuerpoProceso interactivo(uint64_t rafagas, uint64_t cpu, uint64_t es);
+
+/**
+ * Cooperativo: cede la CPU 'veces' veces sin consumirla; mide el costo
+ * puro del cambio de contexto.
+ * @return (co_return) 'veces'
+ */
+CuerpoProceso cedente(uint64_t veces);
+
+} // namespace CargasTrabajo
+
+#endif // CARGAS_TRABAJO_H
@@ -0,0 +1,49 @@
+#ifndef CODEC_LZ_H
+#define CODEC_LZ_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* ================================================================
+ *                   CODEC DE BLOQUES LZ
+ * ================================================================ */
+/**
+ * Compresor LZ77 rpido al estilo LZ4, sin dependencias externas.
+ *
+ * Cada secuencia es: token (4 bits de longitud de literales y 4 de
+ * longitud de coincidencia - 4), bytes extra de longitud (255 = sigue),
+ * literales, desplazamiento de 2 bytes (little-endian) y bytes extra de
+ * la coincidencia. La ltima secuencia solo lleva literales. Las
+ * coincidencias se buscan con una tabla hash de 4 bytes y una ventana de
+ * 64 KiB; el costo es lineal y descomprimir es una copia con saltos.
+ */
+namespace CodecLZ {
+
+/**
+ * Tamao mximo de la salida para una entrada de n bytes.
+ */
+inline size_t cotaComprimido(size_t n) { return n + n / 255 + 16; }
+
+/**
+ * Comprime un bloque.
+ * @param entrada Datos a comprimir
+ * @param n Bytes de entrada
+ * @param salida Recibe el bloque comprimido (se reemplaza su contenido)
+ * @return Bytes comprimidos
+ */
+size_t comprimir(const uint8_t* entrada, size_t n, std::vector<uint8_t>& salida);
+
+/**
+ * Descomprime un bloque cuyo tamao original se conoce.
+ * @param entrada Bloque comprimido
+ * @param n Bytes comprimidos
+ * @param salida Destino con espacio para tamOriginal bytes
+ * @param tamOriginal Tamao exacto esperado
+ * @throws runtime_error Si el bloque est daado
+ */
+void descomprimir(const uint8_t* entrada, size_t n, uint8_t* salida, size_t tamOriginal);
+
+} // namespace CodecLZ
+
+#endif // CODEC_LZ_H
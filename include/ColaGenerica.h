@@ -0,0 +1,141 @@
+#ifndef COLA_GENERICA_H
+#define COLA_GENERICA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "Almacen.h"
+
+/* ================================================================
+ *                   COLA DE PRIORIDAD GENRICA
+ * ================================================================ */
+/**
+ * Montculo binario estable: sale primero el elemento que el criterio
+ * pone antes y, entre equivalentes, el que lleg primero.
+ *
+ * El criterio es un tipo (functor sin estado, normalmente) y no un
+ * puntero a funcin: el compilador lo ve en cada comparacin y lo
+ * expande en lnea dentro de subir() y bajar().
+ *
+ * @tparam T Elemento (copiable trivialmente)
+ * @tparam Antes Criterio: Antes()(a, b) es true si a debe salir antes que b
+ * @tparam N Capacidad fija dentro del objeto (0 = dinmica)
+ * @tparam Asignador Asignador del caso dinmico
+ */
+template <typename T, typename Antes, std::size_t N = 0,
+          typename Asignador = std::allocator<T> >
+class ColaGenerica {
+private:
+    struct Entrada {
+        T valor;
+        uint64_t orden;  // Nmero de llegada (desempate FIFO)
+    };
+
+    Almacen<Entrada, N, Asignador> almacen;
+    std::size_t n;
+    uint64_t llegadas;
+    [[no_unique_address]] Antes criterio;
+
+public:
+    explicit ColaGenerica(const Antes& criterio = Antes())
+        : n(0), llegadas(0), criterio(criterio) {}
+
+    /**
+     * Encola un elemento. O(log n).
+     * @throws runtime_error Si la capacidad fija est llena
+     */
+    void encolar(const T& valor) {
+        if (!almacen.asegurar(n + 1, n)) throw std::runtime_error("Cola llena");
+        Entrada e = { valor, llegadas++ };
+        subir(n++, e);
+    }
+
+    /**
+     * Saca el primer elemento. O(log n).
+     * @throws runtime_error Si la cola est vaca
+     */
+    T desencolar() {
+        if (n == 0) throw std::runtime_error("Cola vaca");
+        Entrada* m = almacen.datos();
+        T primero = m[0].valor;
+        if (--n > 0) bajar(0, m[n]);
+        return primero;
+    }
+
+    const T& frente() const { return almacen.datos()[0].valor; }
+
+    /**
+     * Quita el primer elemento (en el orden del arreglo, no de salida)
+     * que cumple el predicado. O(n) la bsqueda, O(log n) el arreglo.
+     * @return false si ninguno lo cumple
+     */
+    template <typename Predicado>
+    bool eliminarPrimero(Predicado pred) {
+        Entrada* m = almacen.datos();
+        for (std::size_t i = 0; i < n; i++) {
+            if (!pred(m[i].valor)) continue;
+            Entrada ultimo = m[--n];
+            if (i < n) {
+                if (i > 0 && antes(ultimo, m[(i - 1) / 2])) {
+                    subir(i, ultimo);
+                } else {
+                    bajar(i, ultimo);
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Recorre los elementos en el orden del arreglo (no el de salida).
+     */
+    template <typename Funcion>
+    void recorrer(Funcion f) const {
+        const Entrada* m = almacen.datos();
+        for (std::size_t i = 0; i < n; i++) f(m[i].valor);
+    }
+
+    void vaciar() { n = 0; }
+
+    std::size_t tam() const { return n; }
+    bool vacia() const { return n == 0; }
+
+private:
+    bool antes(const Entrada& a, const Entrada& b) const {
+        if (criterio(a.valor, b.valor)) return true;
+        return !criterio(b.valor, a.valor) && a.orden < b.orden;
+    }
+
+    // Huecos en vez de intercambios: cada nivel es una sola copia
+    void subir(std::size_t i, const Entrada& e) {
+        Entrada* m = almacen.datos();
+        while (i > 0) {
+            std::size_t padre = (i - 1) / 2;
+            if (!antes(e, m[padre])) break;
+            m[i] = m[padre];
+            i = padre;
+        }
+        m[i] = e;
+    }
+
+    void bajar(std::size_t i, const Entrada& e) {
+        Entrada* m = almacen.datos();
+        for (;;) {
+            std::size_t hijo = 2 * i + 1;
+            if (hijo >= n) break;
+            if (hijo + 1 < n && antes(m[hijo + 1], m[hijo])) hijo++;
+            if (!antes(m[hijo], e)) break;
+            m[i] = m[hijo];
+            i = hijo;
+        }
+        m[i] = e;
+    }
+
+    ColaGenerica(const ColaGenerica&);
+    ColaGenerica& operator=(const ColaGenerica&);
+};
+
+#endif // COLA_GENERICA_H
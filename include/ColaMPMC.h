@@ -0,0 +1,212 @@
+#ifndef COLA_MPMC_H
+#define COLA_MPMC_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+/* ================================================================
+ *          COLA ACOTADA CONCURRENTE (VARIOS PRODUCTORES Y CONSUMIDORES)
+ * ================================================================ */
+/**
+ * Cola FIFO acotada para varios hilos productores y consumidores, sin
+ * mutex (el anillo de D. Vyukov). Cada celda lleva un nmero de
+ * secuencia que dice de quin es el turno: un productor reserva la
+ * posicin con un CAS sobre 'cola', escribe el dato y publica la celda;
+ * un consumidor hace lo mismo sobre 'cabeza'. Los ndices van cada uno
+ * en su propia lnea de cach para que productores y consumidores no se
+ * invaliden la lnea entre s.
+ *
+ * Semntica: cada operacin exitosa es linealizable como en una cola
+ * FIFO. Un desencolar puede informar "vaca" mientras el productor de
+ * la celda del frente todava no la public, aunque detrs haya datos
+ * ya publicados.
+ *
+ * @tparam T Elemento (copiable trivialmente: punteros, enteros)
+ */
+template <typename T>
+class ColaMPMC {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ColaMPMC guarda tipos copiables trivialmente");
+
+public:
+    static const size_t LINEA_CACHE = 64;
+
+private:
+    struct Celda {
+        std::atomic<size_t> secuencia;
+        T dato;
+    };
+
+    alignas(LINEA_CACHE) std::atomic<size_t> cola;    // Prxima posicin a escribir
+    alignas(LINEA_CACHE) std::atomic<size_t> cabeza;  // Prxima posicin a leer
+    alignas(LINEA_CACHE) Celda* celdas;               // Solo lectura tras construir
+    size_t mascara;
+
+public:
+    /**
+     * @param capacidad Elementos mximos (se redondea a potencia de dos, >= 2)
+     */
+    explicit ColaMPMC(size_t capacidad) : cola(0), cabeza(0) {
+        if (capacidad == 0 || capacidad > ((size_t)1 << 40)) {
+            throw std::runtime_error("Capacidad de cola invlida");
+        }
+        size_t n = 2;
+        while (n < capacidad) n <<= 1;
+        celdas = new Celda[n];
+        mascara = n - 1;
+        for (size_t i = 0; i < n; i++) celdas[i].secuencia.store(i, std::memory_order_relaxed);
+    }
+
+    ~ColaMPMC() { delete[] celdas; }
+
+    /**
+     * @return false si la cola est llena
+     */
+    bool encolar(const T& valor) {
+        size_t pos = cola.load(std::memory_order_relaxed);
+        for (;;) {
+            Celda& c = celdas[pos & mascara];
+            size_t sec = c.secuencia.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)sec - (intptr_t)pos;
+            if (dif == 0) {
+                // Turno de escribir: se reserva la posicin
+                if (cola.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.dato = valor;
+                    c.secuencia.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false;  // La celda an no se ley: vuelta completa
+            } else {
+                pos = cola.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @return false si la cola est vaca (o su frente sin publicar)
+     */
+    bool desencolar(T& valor) {
+        size_t pos = cabeza.load(std::memory_order_relaxed);
+        for (;;) {
+            Celda& c = celdas[pos & mascara];
+            size_t sec = c.secuencia.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)sec - (intptr_t)(pos + 1);
+            if (dif == 0) {
+                if (cabeza.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    valor = c.dato;
+                    // La celda queda libre para la prxima vuelta
+                    c.secuencia.store(pos + mascara + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = cabeza.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Elementos en la cola; aproximado si hay operaciones en curso.
+     */
+    size_t tamAproximado() const {
+        size_t c = cola.load(std::memory_order_relaxed);
+        size_t h = cabeza.load(std::memory_order_relaxed);
+        return c > h ? c - h : 0;
+    }
+
+    size_t capacidad() const { return mascara + 1; }
+
+private:
+    ColaMPMC(const ColaMPMC&);
+    ColaMPMC& operator=(const ColaMPMC&);
+};
+
+/* ================================================================
+ *          COLA CONCURRENTE POR BANDAS DE PRIORIDAD
+ * ================================================================ */
+/**
+ * Cola de listos concurrente: un anillo ColaMPMC por banda de prioridad
+ * (las prioridades 0-100 se reparten en 'bandas' tramos iguales).
+ * Desencolar recorre las bandas de la ms alta a la ms baja y saca el
+ * primero de la primera que tenga algo; dentro de una banda el orden es
+ * de llegada. Productores de bandas distintas no comparten ninguna
+ * lnea de cach.
+ *
+ * Comparada con ColaPrioridad es una aproximacin: no hay orden exacto
+ * dentro de la banda, ni envejecimiento, ni sacar un proceso concreto.
+ *
+ * @tparam T Elemento (copiable trivialmente)
+ * @tparam Prioridad Extractor: Prioridad()(valor) en 0-100, ledo al encolar
+ */
+template <typename T, typename Prioridad>
+class ColaBandas {
+public:
+    static const int BANDAS_MAX = 64;
+    static const int PRIORIDAD_MAXIMA = 100;
+
+private:
+    ColaMPMC<T>* anillos[BANDAS_MAX];
+    int bandas;
+    [[no_unique_address]] Prioridad prioridad;
+
+public:
+    /**
+     * @param bandas Nmero de bandas (1-64)
+     * @param capacidadPorBanda Elementos por banda (potencia de dos)
+     */
+    explicit ColaBandas(int bandas = 8, size_t capacidadPorBanda = 1024)
+        : bandas(bandas) {
+        if (bandas < 1 || bandas > BANDAS_MAX) {
+            throw std::runtime_error("Nmero de bandas debe ser 1-64");
+        }
+        for (int i = 0; i < bandas; i++) anillos[i] = new ColaMPMC<T>(capacidadPorBanda);
+    }
+
+    ~ColaBandas() {
+        for (int i = 0; i < bandas; i++) delete anillos[i];
+    }
+
+    int bandaDe(int p) const {
+        if (p < 0) p = 0;
+        if (p > PRIORIDAD_MAXIMA) p = PRIORIDAD_MAXIMA;
+        return p * bandas / (PRIORIDAD_MAXIMA + 1);
+    }
+
+    /**
+     * @return false si la banda del elemento est llena
+     */
+    bool encolar(const T& valor) { return anillos[bandaDe(prioridad(valor))]->encolar(valor); }
+
+    /**
+     * @param banda Si no es NULL, recibe la banda de la que sali
+     * @return false si no encontr nada en ninguna banda
+     */
+    bool desencolar(T& valor, int* banda = NULL) {
+        for (int i = bandas - 1; i >= 0; i--) {
+            if (anillos[i]->desencolar(valor)) {
+                if (banda) *banda = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t tamAproximado() const {
+        size_t total = 0;
+        for (int i = 0; i < bandas; i++) total += anillos[i]->tamAproximado();
+        return total;
+    }
+
+    int getBandas() const { return bandas; }
+
+private:
+    ColaBandas(const ColaBandas&);
+    ColaBandas& operator=(const ColaBandas&);
+};
+
+#endif // COLA_MPMC_H
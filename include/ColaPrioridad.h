@@ -0,0 +1,256 @@
+#ifndef COLA_PRIORIDAD_H
+#define COLA_PRIORIDAD_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ColaGenerica.h"
+#include "ColaMPMC.h"
+#include "NodoProcesso.h"
+#include "Traza.h"
+
+/* ================================================================
+ *                   PLANIFICADOR CPU
+ * ================================================================ */
+/**
+ * Clase que implementa una cola de prioridad para planificacin de procesos.
+ * Los procesos con mayor prioridad se ejecutan primero; a igual prioridad,
+ * en orden de llegada.
+ *
+ * Internamente es un montculo binario indexado: un mapa ID -> posicin
+ * permite sacar un proceso concreto o cambiar su prioridad en O(log n).
+ * La cola guarda su propia copia de la prioridad; para modificarla debe
+ * usarse cambiarPrioridad(), nunca el campo de NodoProcesso directamente.
+ *
+ * Envejecimiento: cada despacho avanza un reloj lgico y un proceso gana
+ * un punto de prioridad efectiva por cada 'periodo' ticks de espera.
+ * En vez de recorrer la cola en cada tick, se ordena por la clave
+ * prioridad * periodo - tickDeLlegada, que no cambia con el tiempo y
+ * produce el mismo orden que la prioridad efectiva; el costo extra por
+ * despacho es O(1).
+ *
+ * Con una poltica de tiempo real la clave es el plazo absoluto del
+ * trabajo en curso (EDF) o el plazo relativo de la tarea (Rate
+ * Monotonic, que con plazo < periodo se ordena como Deadline Monotonic;
+ * ver AdmisionTiempoReal), y el envejecimiento no se aplica. Los procesos comunes quedan detrs de
+ * todas las tareas de tiempo real, por prioridad.
+ */
+class ColaPrioridad {
+private:
+    // Entrada interna del montculo
+    struct EntradaCola {
+        NodoProcesso* proceso; // Puntero al proceso
+        int prioridad;         // Prioridad base
+        int64_t clave;         // Clave de orden con el envejecimiento aplicado
+        uint64_t encolado;     // Tick del reloj en que lleg
+        uint64_t orden;        // Nmero de llegada (desempate FIFO)
+    };
+
+    std::vector<EntradaCola> monticulo;          // Montculo binario (mximo al frente)
+    std::unordered_map<int, size_t> posiciones;  // ID -> ndice en el montculo
+    uint64_t llegadas;                           // Contador de encolados
+    uint64_t reloj;                              // Ticks lgicos (uno por despacho)
+    int periodo;                                 // Ticks por punto de envejecimiento (0 = sin)
+    PoliticaPlanificacion politica;              // Criterio de la clave
+    uint64_t esperaMaxima;                       // Mayor espera observada al despachar
+    uint32_t idTraza;                            // Identificador en la traza de operaciones
+    uint32_t epocaTraza;                         // Sesin de traza en que ya se anunci
+
+    friend class Instantanea;
+
+public:
+    /**
+     * Ticks de espera por cada punto de prioridad ganado, por defecto.
+     */
+    static const int PERIODO_ENVEJECIMIENTO = 10;
+
+    /**
+     * Constructor que inicializa una cola vaca.
+     */
+    ColaPrioridad();
+
+    /**
+     * Destructor.
+     */
+    ~ColaPrioridad();
+
+    /**
+     * Aade un proceso a la cola segn su prioridad.
+     * @param proceso Puntero al proceso a encolar
+     * @throws runtime_error Si el proceso es invlido o ya est encolado
+     */
+    void encolarPrioridad(NodoProcesso* proceso);
+
+    /**
+     * Extrae y devuelve el proceso con mayor prioridad.
+     * @return Puntero al proceso a ejecutar
+     * @throws runtime_error Si la cola est vaca
+     */
+    NodoProcesso* desencolar();
+
+    /**
+     * Saca de la cola el proceso con el ID dado, est donde est.
+     * @param id Identificador del proceso
+     * @return true si estaba encolado
+     */
+    bool eliminar(int id);
+
+    /**
+     * Saca todos los procesos de la cola (el reloj se conserva).
+     */
+    void vaciar();
+
+    /**
+     * Cambia la prioridad de un proceso encolado y lo reubica
+     * (aumento o disminucin de clave en O(log n)). Tambin actualiza
+     * NodoProcesso::prioridad. Conserva su turno de llegada para desempates.
+     * @param id Identificador del proceso
+     * @param prioridad Nueva prioridad
+     * @return true si el proceso estaba encolado
+     */
+    bool cambiarPrioridad(int id, int prioridad);
+
+    /**
+     * Proceso que se ejecutara a continuacin, sin sacarlo.
+     * @return Puntero al proceso, o NULL si la cola est vaca
+     */
+    NodoProcesso* frente() const { return monticulo.empty() ? NULL : monticulo[0].proceso; }
+
+    /**
+     * Avanza el reloj lgico sin despachar (p. ej. tiempo ocioso).
+     */
+    void avanzarReloj(uint64_t ticks) {
+        if (trazando()) Traza::registrar(Traza::COLA_AVANZAR_RELOJ, idTraza, (int64_t)ticks);
+        reloj += ticks;
+    }
+
+    /**
+     * Configura el envejecimiento y reordena la cola en O(n).
+     * @param ticks Ticks de espera por punto de prioridad (0 lo desactiva)
+     * @throws runtime_error Si es negativo
+     */
+    void setPeriodoEnvejecimiento(int ticks);
+
+    /**
+     * Prioridad efectiva actual de un proceso encolado.
+     * @return Prioridad base ms lo ganado esperando, o -1 si no est
+     */
+    int prioridadEfectiva(int id) const;
+
+    /**
+     * Mayor tiempo de espera (en ticks) de un proceso despachado.
+     */
+    uint64_t getEsperaMaxima() const { return esperaMaxima; }
+
+    uint64_t getReloj() const { return reloj; }
+    int getPeriodoEnvejecimiento() const { return periodo; }
+
+    /**
+     * Cambia el criterio de orden y reordena la cola en O(n). Bajo EDF la
+     * clave de una tarea se toma al encolarla: el plazo de su trabajo en
+     * curso.
+     */
+    void setPolitica(PoliticaPlanificacion valor);
+    PoliticaPlanificacion getPolitica() const { return politica; }
+
+    /**
+     * Indica si un proceso est en la cola.
+     */
+    bool contiene(int id) const { return posiciones.count(id) != 0; }
+
+    /**
+     * Muestra los procesos en la cola de prioridad (en orden de ejecucin).
+     */
+    void mostrar() const;
+
+    /**
+     * Cuenta los procesos en la cola.
+     * @return Nmero de procesos en cola
+     */
+    int contarProcesos() const { return (int)monticulo.size(); }
+
+private:
+    static bool antes(const EntradaCola& a, const EntradaCola& b) {
+        return a.clave > b.clave || (a.clave == b.clave && a.orden < b.orden);
+    }
+
+    /**
+     * Por debajo de cualquier clave de tiempo real (-plazo absoluto o relativo).
+     */
+    static const int64_t FONDO = INT64_MIN / 2;
+
+    int64_t calcularClave(const NodoProcesso* p, int prioridad, uint64_t encolado) const {
+        if (politica != PLAN_PRIORIDAD) {
+            const TareaTiempoReal& t = p->tiempoReal;
+            if (!t.esTiempoReal()) return FONDO + prioridad;
+            return -(int64_t)(politica == PLAN_EDF ? t.plazoAbsoluto : t.plazo);
+        }
+        if (periodo == 0) return prioridad;
+        return (int64_t)prioridad * periodo - (int64_t)encolado;
+    }
+
+    int efectiva(const EntradaCola& e) const {
+        if (periodo == 0 || politica != PLAN_PRIORIDAD) return e.prioridad;
+        return e.prioridad + (int)((reloj - e.encolado) / (uint64_t)periodo);
+    }
+
+    void colocar(size_t i, const EntradaCola& e);
+    size_t subir(size_t i);
+    size_t bajar(size_t i);
+    void quitarEn(size_t i);
+    void recalcularClaves();
+
+    /**
+     * Indica si hay que grabar la operacin en curso. La primera vez en
+     * cada sesin anuncia la cola y su contenido actual en la traza.
+     */
+    bool trazando() {
+        uint32_t e = Traza::epoca();
+        return e != 0 && (e == epocaTraza || anunciarTraza(e));
+    }
+    bool anunciarTraza(uint32_t epoca);
+
+    /**
+     * Graba los plazos de un proceso de tiempo real antes de encolarlo:
+     * bajo EDF o RM su clave sale de ellos y no de la prioridad.
+     */
+    void registrarPlazos(const NodoProcesso* proceso);
+
+    // La cola no se copia
+    ColaPrioridad(const ColaPrioridad&);
+    ColaPrioridad& operator=(const ColaPrioridad&);
+};
+
+/**
+ * Criterio de la cola de procesos: mayor prioridad primero.
+ */
+struct MayorPrioridad {
+    bool operator()(const NodoProcesso* a, const NodoProcesso* b) const {
+        return a->prioridad > b->prioridad;
+    }
+};
+
+/**
+ * Cola de procesos sin envejecimiento, ndice por ID ni traza: el mismo
+ * orden que ColaPrioridad con periodo 0 (prioridad y luego llegada), con
+ * el criterio expandido en lnea. ColaProcesos<256> no usa el heap.
+ */
+template <std::size_t N = 0>
+using ColaProcesos = ColaGenerica<NodoProcesso*, MayorPrioridad, N>;
+
+/**
+ * Prioridad de un proceso para ColaBandas.
+ */
+struct PrioridadDeProceso {
+    int operator()(const NodoProcesso* p) const { return p->prioridad; }
+};
+
+/**
+ * Cola de listos para varios hilos sin mutex: un anillo por banda de
+ * prioridad (ver ColaBandas). La prioridad se lee al encolar; no debe
+ * cambiarse mientras el proceso est en la cola.
+ */
+typedef ColaBandas<NodoProcesso*, PrioridadDeProceso> ColaListosConcurrente;
+
+#endif // COLA_PRIORIDAD_H
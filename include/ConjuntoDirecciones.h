@@ -0,0 +1,104 @@
+#ifndef CONJUNTO_DIRECCIONES_H
+#define CONJUNTO_DIRECCIONES_H
+
+#include <cstddef>
+#include <vector>
+
+/* ================================================================
+ *                   CONJUNTO ORDENADO DE DIRECCIONES
+ * ================================================================ */
+/**
+ * Conjunto ordenado de enteros que, al insertar o eliminar, devuelve
+ * tambin los vecinos del elemento (el anterior y el siguiente).
+ *
+ * Los elementos viven en hojas anchas ordenadas (HOJA claves contiguas
+ * por hoja) y un directorio guarda la clave mxima de cada hoja. Ubicar
+ * un elemento es una bsqueda binaria (sin saltos) en el directorio, que
+ * cabe en cach, y otra dentro de una sola hoja; los vecinos estn al
+ * lado, en la misma hoja o en la contigua. Agregar por encima del mximo
+ * y quitar el mximo, lo habitual en una pila, van directo a la ltima
+ * hoja.
+ *
+ * Una hoja llena se parte en dos, y una que queda con menos de un
+ * cuarto se funde con una vecina si caben juntas.
+ */
+class ConjuntoDirecciones {
+public:
+    /**
+     * Claves por hoja (1 KiB): hojas ms chicas agrandan el directorio y
+     * ms grandes encarecen los corrimientos al insertar al azar.
+     */
+    static const int HOJA = 256;
+
+    /**
+     * Vecinos de un elemento en el conjunto.
+     */
+    struct Vecinos {
+        bool hayAnterior;
+        bool haySiguiente;
+        int anterior;
+        int siguiente;
+    };
+
+private:
+    struct Hoja {
+        int n;
+        int claves[HOJA];
+        Hoja() : n(0) {}
+    };
+
+    std::vector<int> maximos;    // Clave mxima de cada hoja (directorio)
+    std::vector<Hoja*> hojas;    // Ninguna vaca
+    size_t total;
+
+public:
+    ConjuntoDirecciones();
+    ~ConjuntoDirecciones();
+
+    /**
+     * @param v Vecinos que quedan a los lados del elemento insertado
+     * @return false si ya estaba (v no se modifica)
+     */
+    bool insertar(int x, Vecinos& v);
+
+    /**
+     * @param v Vecinos que tena el elemento eliminado
+     * @return false si no estaba (v no se modifica)
+     */
+    bool eliminar(int x, Vecinos& v);
+
+    bool contiene(int x) const;
+
+    /**
+     * Menor elemento no menor que x.
+     * @return false si no hay ninguno (y no se modifica)
+     */
+    bool primeroDesde(int x, int& y) const;
+
+    void vaciar();
+
+    size_t tam() const { return total; }
+    bool vacio() const { return total == 0; }
+
+    /**
+     * Menor y mayor elemento (el conjunto no puede estar vaco).
+     */
+    int minimo() const { return hojas.front()->claves[0]; }
+    int maximo() const { return maximos.back(); }
+
+private:
+    /**
+     * Hoja donde est o ira x: la primera cuyo mximo no es menor que
+     * x, o la ltima si x supera a todos.
+     */
+    size_t hojaPara(int x) const;
+
+    void vecinos(size_t i, int pos, Vecinos& v) const;
+    void partir(size_t i);
+    void fundir(size_t i);
+
+    ConjuntoDirecciones(const ConjuntoDirecciones&);
+    ConjuntoDirecciones& operator=(const ConjuntoDirecciones&);
+};
+
+#endif // CONJUNTO_DIRECCIONES_H
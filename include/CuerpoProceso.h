@@ -0,0 +1,181 @@
+#ifndef CUERPO_PROCESO_H
+#define CUERPO_PROCESO_H
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+/* ================================================================
+ *                   CUERPOS DE PROCESO (CORRUTINAS)
+ * ================================================================ */
+/**
+ * Cdigo que ejecuta un proceso simulado, escrito como corrutina de
+ * C++20:
+ *
+ *     CuerpoProceso trabajo(int n) {
+ *         for (int i = 0; i < n; i++) {
+ *             co_await usarCpu(1);      // Una unidad de CPU (un tick)
+ *             ...clculo real...
+ *         }
+ *         co_await esperarES(20);       // Se bloquea 20 ticks
+ *         co_return resultado;
+ *     }
+ *
+ * El simulador reanuda el cuerpo con un quantum de unidades de CPU.
+ * usarCpu() descuenta del quantum sin suspender mientras alcance; al
+ * agotarse, el cuerpo se suspende y lo que faltaba queda como deuda
+ * que se paga al comienzo de los quantums siguientes sin reanudarlo.
+ * ceder() y esperarES() suspenden siempre. Un cambio de contexto es
+ * una reanudacin de corrutina: no hay pilas ni hilos por proceso.
+ */
+class CuerpoProceso {
+public:
+    /**
+     * Por qu volvi el control al simulador.
+     */
+    enum Motivo {
+        CEDIO,     // Agot el quantum o cedi la CPU: vuelve a listos
+        ESPERA_ES, // Pidi E/S: se bloquea getTicksES() ticks
+        TERMINO    // Lleg a co_return
+    };
+
+    struct Cpu { uint64_t unidades; };
+    struct Ceder {};
+    struct EntradaSalida { uint64_t ticks; };
+
+    struct promise_type {
+        uint64_t restante; // Unidades que quedan del quantum en curso
+        uint64_t usadas;   // Unidades consumidas en el quantum en curso
+        uint64_t deuda;    // CPU pedida que no cupo en el quantum anterior
+        uint64_t ticksES;
+        uint64_t valor;    // Valor de co_return
+        Motivo motivo;
+        std::exception_ptr error;
+
+        promise_type() : restante(0), usadas(0), deuda(0), ticksES(0), valor(0), motivo(CEDIO) {}
+
+        CuerpoProceso get_return_object() {
+            return CuerpoProceso(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        // Nace suspendido: corre recin cuando lo despachan
+        std::suspend_always initial_suspend() noexcept { return std::suspend_always(); }
+        std::suspend_always final_suspend() noexcept {
+            motivo = TERMINO;
+            return std::suspend_always();
+        }
+        void return_value(uint64_t v) { valor = v; }
+        void unhandled_exception() { error = std::current_exception(); }
+
+        struct EsperaCpu {
+            promise_type& p;
+            uint64_t pendiente;
+
+            bool await_ready() noexcept {
+                uint64_t t = pendiente < p.restante ? pendiente : p.restante;
+                p.restante -= t;
+                p.usadas += t;
+                pendiente -= t;
+                return pendiente == 0;
+            }
+            void await_suspend(std::coroutine_handle<>) noexcept {
+                p.deuda = pendiente;
+                p.motivo = CEDIO;
+            }
+            void await_resume() noexcept {}
+        };
+
+        struct Suspension {
+            promise_type& p;
+            Motivo motivo;
+            uint64_t ticks;
+
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<>) noexcept {
+                p.motivo = motivo;
+                p.ticksES = ticks;
+            }
+            void await_resume() noexcept {}
+        };
+
+        EsperaCpu await_transform(Cpu c) { return EsperaCpu{ *this, c.unidades }; }
+        Suspension await_transform(Ceder) { return Suspension{ *this, CEDIO, 0 }; }
+        Suspension await_transform(EntradaSalida e) { return Suspension{ *this, ESPERA_ES, e.ticks }; }
+    };
+
+    CuerpoProceso() : h() {}
+    CuerpoProceso(CuerpoProceso&& otro) noexcept : h(std::exchange(otro.h, nullptr)) {}
+    CuerpoProceso& operator=(CuerpoProceso&& otro) noexcept {
+        if (this != &otro) {
+            if (h) h.destroy();
+            h = std::exchange(otro.h, nullptr);
+        }
+        return *this;
+    }
+    ~CuerpoProceso() {
+        if (h) h.destroy();
+    }
+
+    explicit operator bool() const { return (bool)h; }
+    bool terminado() const { return h && h.done(); }
+
+    /**
+     * Corre el cuerpo hasta que agote el quantum, ceda, pida E/S o
+     * termine. Si todava debe CPU de antes, el quantum se gasta en esa
+     * deuda sin reanudarlo.
+     * @param quantum Unidades de CPU disponibles (> 0)
+     * @param usadas Recibe las unidades consumidas
+     * @return Motivo de la suspensin
+     * @throws La excepcin que haya escapado del cuerpo (queda terminado)
+     */
+    Motivo reanudar(uint64_t quantum, uint64_t& usadas) {
+        promise_type& p = h.promise();
+        if (p.deuda >= quantum) {
+            p.deuda -= quantum;
+            usadas = quantum;
+            return CEDIO;
+        }
+        p.usadas = p.deuda;
+        p.restante = quantum - p.deuda;
+        p.deuda = 0;
+        h.resume();
+        usadas = p.usadas;
+        if (p.error) std::rethrow_exception(std::exchange(p.error, nullptr));
+        return p.motivo;
+    }
+
+    uint64_t getTicksES() const { return h.promise().ticksES; }
+    uint64_t getDeuda() const { return h.promise().deuda; }
+    uint64_t getValor() const { return h.promise().valor; }
+
+private:
+    std::coroutine_handle<promise_type> h;
+
+    explicit CuerpoProceso(std::coroutine_handle<promise_type> h) : h(h) {}
+
+    CuerpoProceso(const CuerpoProceso&);
+    CuerpoProceso& operator=(const CuerpoProceso&);
+};
+
+/**
+ * Consume unidades de CPU del quantum (suspende solo si se agota).
+ */
+inline CuerpoProceso::Cpu usarCpu(uint64_t unidades) {
+    return CuerpoProceso::Cpu{ unidades };
+}
+
+/**
+ * Cede la CPU: el proceso vuelve a la cola de listos.
+ */
+inline CuerpoProceso::Ceder ceder() {
+    return CuerpoProceso::Ceder();
+}
+
+/**
+ * E/S simulada: el proceso se bloquea la cantidad de ticks indicada.
+ */
+inline CuerpoProceso::EntradaSalida esperarES(uint64_t ticks) {
+    return CuerpoProceso::EntradaSalida{ ticks };
+}
+
+#endif // CUERPO_PROCESO_H
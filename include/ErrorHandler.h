@@ -0,0 +1,23 @@
+#ifndef ERROR_HANDLER_H
+#define ERROR_HANDLER_H
+
+#include <exception>
+
+/* ================================================================
+ *                   GESTOR DE ERRORES
+ * ================================================================ */
+/**
+ * Clase para manejo centralizado de errores.
+ * Proporciona funcionalidad para mostrar errores en consola
+ * y registrarlos en un archivo de log.
+ */
+class ErrorHandler {
+public:
+    /**
+     * Maneja una excepcin mostrndola en consola y guardndola en log.
+     * @param e Excepcin a manejar
+     */
+    static void manejar(const std::exception& e);
+};
+
+#endif // ERROR_HANDLER_H
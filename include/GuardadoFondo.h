@@ -0,0 +1,86 @@
+#ifndef GUARDADO_FONDO_H
+#define GUARDADO_FONDO_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/* ================================================================
+ *                   GUARDADO EN SEGUNDO PLANO
+ * ================================================================ */
+/**
+ * Ejecuta una rutina de guardado sobre una copia lgica congelada del
+ * estado, sin detener al sistema mientras dura la E/S.
+ *
+ * En POSIX la copia se obtiene con fork(): el hijo ve la memoria tal como
+ * estaba al llamar a iniciar() y serializa a su ritmo; el ncleo solo
+ * duplica (copy-on-write) las pginas que el padre modifica mientras
+ * tanto, as la memoria extra est acotada por lo que cambie durante el
+ * guardado y nunca supera una copia. La pausa del llamador es solo la
+ * del fork (copiar tablas de pginas). Un hilo viga espera al hijo y
+ * recoge el resultado; se admite un nico guardado a la vez.
+ *
+ * Hilos: el hijo nace con un solo hilo, as que un cerrojo que otro hilo
+ * tuviera al hacer fork quedara tomado para siempre. Lo que la rutina
+ * puede usar est preparado para eso: la memoria dinmica (glibc la
+ * deja consistente en el hijo), el pool de nombres y el registro de
+ * mtricas (ambos se bloquean durante el fork con pthread_atfork). La
+ * rutina no debe tomar otros cerrojos compartidos con hilos que sigan
+ * corriendo (traza, instancias del servidor). La tubera del resultado
+ * se crea con O_CLOEXEC.
+ *
+ * En Windows no hay fork: la rutina se ejecuta en el acto.
+ */
+class GuardadoFondo {
+private:
+    std::thread vigia;              // Espera al hijo y recoge su resultado
+    std::atomic<bool> activo;       // Hay un guardado en curso
+    mutable std::mutex mutex;       // Protege los campos del ltimo resultado
+    bool ultimoExito;
+    std::string ultimoError;
+    double ultimaDuracionMs;
+    int guardados;
+
+public:
+    GuardadoFondo();
+
+    /**
+     * Espera a que termine el guardado en curso, si lo hay.
+     */
+    ~GuardadoFondo();
+
+    /**
+     * Lanza el guardado. La rutina ve el estado en el instante de la
+     * llamada; los errores que lance se informan en getUltimoError().
+     * @param rutina Serializacin a ejecutar sobre la copia
+     * @return false si ya haba un guardado en curso (no se lanza otro)
+     * @throws runtime_error Si no se pudo crear el proceso hijo
+     */
+    bool iniciar(const std::function<void()>& rutina);
+
+    /**
+     * Indica si hay un guardado en curso.
+     */
+    bool enCurso() const { return activo.load(std::memory_order_acquire); }
+
+    /**
+     * Bloquea hasta que termine el guardado en curso.
+     * @return true si el ltimo guardado termin bien
+     */
+    bool esperar();
+
+    bool getUltimoExito() const;
+    std::string getUltimoError() const;
+    double getUltimaDuracionMs() const;
+    int getGuardados() const;
+
+private:
+    void terminar(bool exito, const std::string& error, double ms);
+
+    GuardadoFondo(const GuardadoFondo&);
+    GuardadoFondo& operator=(const GuardadoFondo&);
+};
+
+#endif // GUARDADO_FONDO_H
@@ -0,0 +1,173 @@
+#ifndef INDICE_PROCESOS_H
+#define INDICE_PROCESOS_H
+
+#include <algorithm>
+#include <cstddef>
+
+#include "NodoProcesso.h"
+
+/* ================================================================
+ *                   NDICE ORDENADO POR ID
+ * ================================================================ */
+/**
+ * rbol B+ de nodos anchos (ORDEN claves por nodo) que indexa los
+ * procesos por ID. Las hojas estn enlazadas en orden, para recorridos
+ * y consultas de rango secuenciales; los nodos internos guardan cuntos
+ * procesos hay bajo cada hijo, lo que da rango (posicin de un ID) y
+ * seleccin (k-simo ID) en O(log n).
+ *
+ * El ndice no es dueo de los nodos: solo guarda punteros a los
+ * NodoProcesso de la lista, que debe mantenerlo al insertar y eliminar.
+ */
+class IndiceProcesos {
+public:
+    /**
+     * Claves por nodo: 64 enteros de 32 bits ocupan cuatro lneas de
+     * cach, y la bsqueda dentro del nodo no sale de ellas.
+     */
+    static const int ORDEN = 64;
+    static const int MINIMO = ORDEN / 2;
+
+private:
+    struct Nodo {
+        int n;                    // Claves en uso
+        bool hoja;
+        int claves[ORDEN + 1];    // Una de holgura para dividir tras insertar
+
+        explicit Nodo(bool hoja) : n(0), hoja(hoja) {}
+    };
+
+    struct Hoja : Nodo {
+        NodoProcesso* valores[ORDEN + 1];
+        Hoja* siguiente;          // Hoja con las claves mayores (o NULL)
+
+        Hoja() : Nodo(true), siguiente(NULL) {}
+    };
+
+    struct Interno : Nodo {
+        Nodo* hijos[ORDEN + 2];
+        size_t cuentas[ORDEN + 2]; // Procesos bajo cada hijo
+
+        Interno() : Nodo(false) {}
+    };
+
+    Nodo* raiz;
+    size_t total;
+    int altura;                   // Niveles (1 = la raz es hoja)
+
+public:
+    IndiceProcesos();
+    ~IndiceProcesos();
+
+    /**
+     * Agrega un proceso.
+     * @return false si ya haba un proceso con ese ID (no se modifica)
+     */
+    bool insertar(NodoProcesso* proceso);
+
+    /**
+     * Quita un ID del ndice.
+     * @return Proceso que estaba indexado, o NULL si no exista
+     */
+    NodoProcesso* eliminar(int id);
+
+    /**
+     * Bsqueda puntual.
+     * @return Proceso con ese ID, o NULL
+     */
+    NodoProcesso* buscar(int id) const {
+        const Hoja* h = hojaPara(id);
+        const int* fin = h->claves + h->n;
+        const int* c = std::lower_bound(h->claves, fin, id);
+        return (c != fin && *c == id) ? h->valores[c - h->claves] : NULL;
+    }
+
+    /**
+     * Llama a f(proceso) por cada ID en [desde, hasta], en orden creciente.
+     * @return Procesos visitados
+     */
+    template <typename F>
+    size_t rango(int desde, int hasta, F f) const {
+        if (desde > hasta) return 0;
+        const Hoja* h = hojaPara(desde);
+        int i = (int)(std::lower_bound(h->claves, h->claves + h->n, desde) - h->claves);
+        size_t visitados = 0;
+        for (; h; h = h->siguiente, i = 0) {
+            for (; i < h->n; i++) {
+                if (h->claves[i] > hasta) return visitados;
+                f(h->valores[i]);
+                visitados++;
+            }
+        }
+        return visitados;
+    }
+
+    /**
+     * Llama a f(proceso) por cada proceso, en orden creciente de ID.
+     */
+    template <typename F>
+    void recorrer(F f) const {
+        for (const Hoja* h = primeraHoja(); h; h = h->siguiente) {
+            for (int i = 0; i < h->n; i++) f(h->valores[i]);
+        }
+    }
+
+    /**
+     * Rango: cuntos IDs indexados son menores que id.
+     */
+    size_t posicion(int id) const;
+
+    /**
+     * Seleccin: proceso con el k-simo ID ms chico (desde 0).
+     * @return NULL si k >= tam()
+     */
+    NodoProcesso* seleccionar(size_t k) const;
+
+    /**
+     * Cuntos IDs caen en [desde, hasta], sin recorrerlos.
+     */
+    size_t contarRango(int desde, int hasta) const;
+
+    /**
+     * Reconstruye el ndice desde una lista enlazada, llenando los nodos
+     * de abajo hacia arriba; el costo lo domina ordenar los IDs. Si un ID se repite
+     * se indexa su primera aparicin, igual que buscarPorId en la lista.
+     */
+    void construir(NodoProcesso* cabeza);
+
+    /**
+     * Deja el ndice vaco (no toca los procesos).
+     */
+    void vaciar();
+
+    size_t tam() const { return total; }
+    int getAltura() const { return altura; }
+
+private:
+    const Hoja* hojaPara(int id) const {
+        const Nodo* nodo = raiz;
+        while (!nodo->hoja) {
+            const Interno* in = static_cast<const Interno*>(nodo);
+            int i = (int)(std::upper_bound(in->claves, in->claves + in->n, id) - in->claves);
+            nodo = in->hijos[i];
+        }
+        return static_cast<const Hoja*>(nodo);
+    }
+
+    const Hoja* primeraHoja() const {
+        const Nodo* nodo = raiz;
+        while (!nodo->hoja) nodo = static_cast<const Interno*>(nodo)->hijos[0];
+        return static_cast<const Hoja*>(nodo);
+    }
+
+    bool insertarEn(Nodo* nodo, NodoProcesso* proceso, int& claveSubida, Nodo*& hermano);
+    NodoProcesso* eliminarEn(Nodo* nodo, int id);
+    void rebalancear(Interno* padre, int i);
+    static size_t tamNodo(const Nodo* nodo);
+    static void liberar(Nodo* nodo);
+
+    IndiceProcesos(const IndiceProcesos&);
+    IndiceProcesos& operator=(const IndiceProcesos&);
+};
+
+#endif // INDICE_PROCESOS_H
@@ -0,0 +1,55 @@
+#ifndef INSTANTANEA_H
+#define INSTANTANEA_H
+
+#include <cstdint>
+#include <string>
+
+class Simulador;
+
+/* ================================================================
+ *                   INSTANTNEAS DEL SISTEMA
+ * ================================================================ */
+/**
+ * Guarda y restaura el estado completo de un Simulador en un archivo
+ * binario: tabla de procesos (con estado y plazo de despertar), orden
+ * exacto de la cola de listos con su envejecimiento, bloques de memoria
+ * con su dueo, el rbol de procesos y el tiempo simulado.
+ *
+ * El archivo se escribe con una sola escritura vectorizada (writev) y
+ * se restaura proyectndolo con mmap: las secciones son arreglos de
+ * registros de tamao fijo alineados a 8 bytes que se leen en el sitio,
+ * y las estructuras se reconstruyen enlazando nodos en O(n), sin pasar
+ * por insertarProcesso ni por los sift del montculo.
+ *
+ * Formato (orden de bytes del host):
+ *   CabeceraInstantanea | RegistroProceso[n] | RegistroCola[m] |
+ *   RegistroBloque[k] | RegistroArbol[a] | nombres (bytes sin terminador)
+ *
+ * La memoria virtual no se incluye: los espacios de direcciones se
+ * vuelven a poblar por fallos de pgina tras restaurar.
+ */
+class Instantanea {
+public:
+    static const uint32_t VERSION = 3;
+
+    /**
+     * Escribe la instantnea. Se escribe a un temporal que luego se
+     * renombra, as un fallo nunca deja una instantnea a medias.
+     * @param sim Simulador a guardar
+     * @param archivo Ruta destino
+     * @return Bytes escritos
+     * @throws runtime_error Si no se puede escribir el archivo
+     */
+    static size_t guardar(const Simulador& sim, const std::string& archivo);
+
+    /**
+     * Reemplaza el estado del simulador por el de la instantnea. El
+     * archivo se valida completo antes de tocar el estado actual.
+     * @param sim Simulador destino
+     * @param archivo Ruta de la instantnea
+     * @throws runtime_error Si el archivo no existe, est daado o es de otra versin
+     */
+    static void restaurar(Simulador& sim, const std::string& archivo);
+};
+
+#endif // INSTANTANEA_H
@@ -0,0 +1,81 @@
+#ifndef LECTOR_TRAZA_H
+#define LECTOR_TRAZA_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* ================================================================
+ *                   LECTOR DE TRAZAS DE MEMORIA
+ * ================================================================ */
+/**
+ * Acceso a memoria ledo de una traza.
+ */
+struct AccesoMemoria {
+    int pid;            // Proceso que accede
+    uint32_t direccion; // Direccin virtual
+    bool escritura;     // true = escritura (W), false = lectura (R)
+};
+
+/**
+ * Lector en streaming de trazas de texto, una referencia por lnea:
+ *
+ *     <pid> <direccin> [R|W]
+ *
+ * La direccin puede ser decimal o hexadecimal con prefijo 0x; las
+ * lneas vacas o que empiezan con '#' se ignoran. El archivo se lee
+ * por bloques de tamao fijo, as que la memoria usada no depende del
+ * largo de la traza.
+ */
+class LectorTraza {
+private:
+    FILE* archivo;
+    std::vector<char> bufer;
+    size_t pos;       // Siguiente byte por consumir
+    size_t fin;       // Bytes vlidos en el bfer
+    bool eof;
+    uint64_t linea;   // Lnea actual (para mensajes de error)
+
+public:
+    /**
+     * @param ruta Archivo de traza ("-" para entrada estndar)
+     * @param tamBufer Bytes por bloque de lectura
+     * @throws runtime_error Si no se puede abrir el archivo
+     */
+    explicit LectorTraza(const std::string& ruta, size_t tamBufer = 1 << 20);
+    ~LectorTraza();
+
+    /**
+     * Lee el siguiente acceso.
+     * @return false al llegar al final de la traza
+     * @throws runtime_error Si una lnea tiene formato invlido
+     */
+    bool siguiente(AccesoMemoria& acceso);
+
+    uint64_t getLinea() const { return linea; }
+
+private:
+    bool rellenar();
+    int caracter();
+    int mirar();
+
+    LectorTraza(const LectorTraza&);
+    LectorTraza& operator=(const LectorTraza&);
+};
+
+/**
+ * Genera una traza sinttica con localidad: cada proceso recorre un
+ * conjunto de trabajo que se desplaza lentamente, con saltos
+ * aleatorios ocasionales.
+ * @param ruta Archivo destino
+ * @param accesos Nmero de referencias
+ * @param procesos Nmero de procesos distintos
+ * @param paginasTrabajo Tamao del conjunto de trabajo por proceso
+ * @param semilla Semilla del generador
+ * @throws runtime_error Si no se puede abrir el archivo
+ */
+void generarTraza(const std::string& ruta, uint64_t accesos, int procesos,
+                  uint32_t paginasTrabajo, uint32_t semilla = 12345);
+
+#endif // LECTOR_TRAZA_H
@@ -0,0 +1,131 @@
+#ifndef LINEA_TIEMPO_H
+#define LINEA_TIEMPO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "PoolNombres.h"
+
+/* ================================================================
+ *              LNEA DE TIEMPO DE PLANIFICACIN
+ * ================================================================ */
+/**
+ * Registro de qu proceso ocup cada CPU y cundo: un tramo por cada
+ * paso por la CPU (proceso, CPU, inicio, fin y motivo de salida), en
+ * tiempo simulado. Sirve para dibujar el diagrama de Gantt de una
+ * ejecucin.
+ *
+ * Los tramos se guardan por columnas en arreglos reservados de una vez
+ * al activarla: registrar uno son unas pocas escrituras, sin reservar
+ * memoria. Si se llena, los tramos siguientes solo se cuentan como
+ * descartados.
+ *
+ * Se exporta como JSON de eventos de traza de Chrome (chrome://tracing,
+ * Perfetto; un tick simulado = 1 microsegundo) o como CSV.
+ */
+class LineaTiempo {
+public:
+    /**
+     * Por qu el proceso dej la CPU.
+     */
+    enum Salida {
+        CEDIO,       // Cedi o agot el quantum: vuelve a listos
+        BLOQUEO,     // Pas a esperar E/S o un temporizador
+        TERMINO,     // Termin
+        EXPROPIADO,  // Otro despacho lo devolvi a listos
+        ELIMINADO    // Se elimin mientras ejecutaba
+    };
+
+private:
+    // Columnas de los tramos registrados
+    std::vector<uint64_t> inicios;
+    std::vector<uint32_t> duraciones;  // Ticks, saturados a 2^32 - 1
+    std::vector<int32_t> ids;
+    std::vector<uint32_t> nombres;     // IDs de PoolNombres
+    std::vector<uint16_t> cpus;
+    std::vector<uint8_t> salidas;
+    size_t cantidad;
+    size_t capacidad;
+    uint64_t descartados;
+    uint16_t cpu;  // CPU que se anota en los tramos nuevos
+
+public:
+    LineaTiempo();
+
+    /**
+     * Activa el registro reservando espacio para 'capacidad' tramos y
+     * descarta los registrados hasta ahora.
+     * @param capacidad Tramos mximos (0 = desactivar y liberar)
+     * @param cpu CPU a la que pertenecen los tramos nuevos
+     */
+    void activar(size_t capacidad, uint16_t cpu = 0);
+
+    bool activa() const { return capacidad != 0; }
+
+    /**
+     * Registra un paso por la CPU.
+     * @param inicio Tick en que el proceso entr a la CPU
+     * @param fin Tick en que la dej
+     */
+    void registrar(int id, NombreProceso nombre, uint64_t inicio, uint64_t fin, Salida salida) {
+        if (cantidad == capacidad) {
+            descartados++;
+            return;
+        }
+        // Dentro de la capacidad reservada: push_back nunca realoja
+        uint64_t duracion = fin - inicio;
+        inicios.push_back(inicio);
+        duraciones.push_back(duracion > UINT32_MAX ? UINT32_MAX : (uint32_t)duracion);
+        ids.push_back(id);
+        nombres.push_back(nombre.getId());
+        cpus.push_back(cpu);
+        salidas.push_back((uint8_t)salida);
+        cantidad++;
+    }
+
+    /**
+     * Olvida los tramos registrados, conservando el espacio reservado.
+     */
+    void limpiar();
+
+    size_t getCantidad() const { return cantidad; }
+    size_t getCapacidad() const { return capacidad; }
+    uint64_t getDescartados() const { return descartados; }
+
+    uint64_t getInicio(size_t i) const { return inicios[i]; }
+    uint64_t getFin(size_t i) const { return inicios[i] + duraciones[i]; }
+    int getId(size_t i) const { return ids[i]; }
+    NombreProceso getNombre(size_t i) const { return NombreProceso(nombres[i]); }
+    uint16_t getCpu(size_t i) const { return cpus[i]; }
+    Salida getSalida(size_t i) const { return (Salida)salidas[i]; }
+
+    /**
+     * Exporta los tramos como eventos completos ("ph": "X") de una traza
+     * de Chrome: un hilo por CPU y un evento por tramo, con el motivo de
+     * salida como categora y el ID del proceso en "args".
+     */
+    void exportarChrome(std::ostream& os) const;
+
+    /**
+     * Exporta los tramos como CSV: cpu,id,nombre,inicio,fin,salida.
+     */
+    void exportarCSV(std::ostream& os) const;
+
+    /**
+     * Escribe la exportacin en un archivo.
+     * @param csv true para CSV, false para JSON de Chrome
+     * @throws runtime_error Si no se puede escribir el archivo
+     */
+    void guardar(const std::string& archivo, bool csv) const;
+
+    static const char* nombreSalida(Salida salida);
+
+private:
+    LineaTiempo(const LineaTiempo&);
+    LineaTiempo& operator=(const LineaTiempo&);
+};
+
+#endif // LINEA_TIEMPO_H
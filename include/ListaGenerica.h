@@ -0,0 +1,144 @@
+#ifndef LISTA_GENERICA_H
+#define LISTA_GENERICA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "Almacen.h"
+
+/* ================================================================
+ *                   LISTA ENLAZADA GENRICA
+ * ================================================================ */
+/**
+ * Lista simplemente enlazada cuyos nodos salen de un arreglo propio y
+ * se enlazan por ndice. Los nodos liberados quedan en una lista de
+ * libres y se reusan: insertar y quitar no llaman al asignador una vez
+ * que el arreglo alcanz su tamao (y nunca con N > 0, donde el arreglo
+ * est dentro del objeto).
+ *
+ * Los elementos se identifican por la clave que devuelve el extractor,
+ * que el compilador expande en lnea en buscar() y eliminar().
+ *
+ * @tparam T Elemento (copiable trivialmente)
+ * @tparam Clave Extractor: Clave()(valor) devuelve su clave (comparable con ==)
+ * @tparam N Nodos mximos dentro del objeto (0 = dinmica)
+ * @tparam Asignador Asignador del caso dinmico
+ */
+template <typename T, typename Clave, std::size_t N = 0,
+          typename Asignador = std::allocator<T> >
+class ListaGenerica {
+private:
+    static const uint32_t NINGUNO = UINT32_MAX;
+
+    struct Nodo {
+        T valor;
+        uint32_t siguiente;  // ndice del siguiente nodo (NINGUNO al final)
+    };
+
+    Almacen<Nodo, N, Asignador> almacen;
+    uint32_t cabeza;
+    uint32_t ultimo;
+    uint32_t libres;      // Primer nodo de la lista de libres
+    std::size_t creados;  // Nodos del arreglo usados alguna vez
+    std::size_t n;
+    [[no_unique_address]] Clave clave;
+
+public:
+    explicit ListaGenerica(const Clave& clave = Clave())
+        : cabeza(NINGUNO), ultimo(NINGUNO), libres(NINGUNO), creados(0), n(0),
+          clave(clave) {}
+
+    /**
+     * Inserta un elemento al final. O(1).
+     * @throws runtime_error Si la capacidad fija est llena
+     */
+    void insertarAlFinal(const T& valor) {
+        uint32_t i = tomarNodo();
+        Nodo* d = almacen.datos();
+        d[i].valor = valor;
+        d[i].siguiente = NINGUNO;
+        if (ultimo == NINGUNO) {
+            cabeza = i;
+        } else {
+            d[ultimo].siguiente = i;
+        }
+        ultimo = i;
+        n++;
+    }
+
+    /**
+     * Busca un elemento por su clave. O(n).
+     * @return Puntero al elemento o NULL si no est (vlido hasta la
+     *         prxima insercin)
+     */
+    template <typename K>
+    T* buscar(const K& k) {
+        Nodo* d = almacen.datos();
+        for (uint32_t i = cabeza; i != NINGUNO; i = d[i].siguiente) {
+            if (clave(d[i].valor) == k) return &d[i].valor;
+        }
+        return NULL;
+    }
+
+    /**
+     * Quita el primer elemento con la clave dada. O(n).
+     * @return false si no est
+     */
+    template <typename K>
+    bool eliminar(const K& k) {
+        Nodo* d = almacen.datos();
+        uint32_t anterior = NINGUNO;
+        for (uint32_t i = cabeza; i != NINGUNO; anterior = i, i = d[i].siguiente) {
+            if (!(clave(d[i].valor) == k)) continue;
+            if (anterior == NINGUNO) {
+                cabeza = d[i].siguiente;
+            } else {
+                d[anterior].siguiente = d[i].siguiente;
+            }
+            if (ultimo == i) ultimo = anterior;
+            d[i].siguiente = libres;
+            libres = i;
+            n--;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Recorre los elementos en orden de insercin.
+     */
+    template <typename Funcion>
+    void recorrer(Funcion f) const {
+        const Nodo* d = almacen.datos();
+        for (uint32_t i = cabeza; i != NINGUNO; i = d[i].siguiente) f(d[i].valor);
+    }
+
+    void vaciar() {
+        cabeza = ultimo = libres = NINGUNO;
+        creados = 0;
+        n = 0;
+    }
+
+    std::size_t tam() const { return n; }
+    bool vacia() const { return n == 0; }
+
+private:
+    uint32_t tomarNodo() {
+        if (libres != NINGUNO) {
+            uint32_t i = libres;
+            libres = almacen.datos()[i].siguiente;
+            return i;
+        }
+        if (creados == NINGUNO || !almacen.asegurar(creados + 1, creados)) {
+            throw std::runtime_error("Lista llena");
+        }
+        return (uint32_t)creados++;
+    }
+
+    ListaGenerica(const ListaGenerica&);
+    ListaGenerica& operator=(const ListaGenerica&);
+};
+
+#endif // LISTA_GENERICA_H
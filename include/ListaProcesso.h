@@ -0,0 +1,185 @@
+#ifndef LISTA_PROCESSO_H
+#define LISTA_PROCESSO_H
+
+#include <string>
+#include <vector>
+
+#include "IndiceProcesos.h"
+#include "ListaGenerica.h"
+#include "NodoProcesso.h"
+#include "Traza.h"
+
+/* ================================================================
+ *                   GESTOR DE PROCESOS
+ * ================================================================ */
+/**
+ * Clase que gestiona una lista enlazada de procesos.
+ * Proporciona operaciones CRUD para los procesos y maneja su persistencia.
+ */
+class ListaProcesso {
+private:
+    NodoProcesso* cabeza; // Puntero al primer nodo de la lista
+    NodoProcesso* ultimo; // ltimo nodo: insercin al final en O(1)
+    std::string archivo;  // Archivo de persistencia ("" = sin persistencia)
+    bool comprimido;      // Guardar en el formato comprimido de Persistencia
+    IndiceProcesos indice; // Los mismos nodos, ordenados por ID
+    AdmisionTiempoReal admision; // Utilizacin de las tareas de tiempo real
+    uint32_t idTraza;      // Identificador en la traza de operaciones
+    mutable uint32_t epocaTraza; // Sesin de traza en que ya se anunci
+
+    friend class Instantanea;
+
+public:
+    static const std::string ARCHIVO_PROCESOS; // Nombre del archivo de persistencia
+
+    /**
+     * Constructor que carga los procesos desde archivo al iniciar.
+     * @param archivo Archivo de persistencia; cadena vaca para trabajar
+     *        solo en memoria (benchmarks, pruebas, uso embebido)
+     */
+    explicit ListaProcesso(const std::string& archivo = ARCHIVO_PROCESOS);
+
+    /**
+     * Destructor que guarda los procesos al archivo y libera memoria.
+     */
+    ~ListaProcesso();
+
+    /**
+     * Guarda la lista en su archivo, en el formato elegido.
+     * @throws runtime_error Si no hay archivo o falla la escritura
+     */
+    void guardar() const;
+
+    /**
+     * Elige el formato de guardado. Al cargar se adopta el del archivo.
+     */
+    void setComprimido(bool valor) { comprimido = valor; }
+    bool esComprimido() const { return comprimido; }
+
+    /**
+     * Libera toda la memoria ocupada por la lista de procesos.
+     */
+    void liberarMemoria();
+
+    /**
+     * Inserta un nuevo proceso en la lista.
+     * @param id Identificador del proceso (debe ser nico)
+     * @param nombre Nombre del proceso (un NombreProceso ya internado se
+     *        pasa sin volver a buscarlo en el pool)
+     * @param prioridad Nivel de prioridad (0-100)
+     * @throws runtime_error Si el ID ya existe o la prioridad es invlida
+     */
+    void insertarProcesso(int id, NombreProceso nombre, int prioridad);
+
+    /**
+     * Inserta una tarea de tiempo real, pasando antes por el control de
+     * admisin (se usan los parmetros de 'tarea'; su estado se ignora).
+     * Se libera su utilizacin al eliminarla.
+     * @throws runtime_error Si el ID ya existe, la prioridad o los
+     *         parmetros son invlidos, o la tarea no pasa la admisin
+     */
+    void insertarProcesso(int id, NombreProceso nombre, int prioridad, const TareaTiempoReal& tarea);
+
+    /**
+     * Elimina un proceso de la lista por su ID.
+     * @param id Identificador del proceso a eliminar
+     * @throws runtime_error Si la lista est vaca o el ID no existe
+     */
+    void eliminarProcesso(int id);
+
+    /**
+     * Elimina varios procesos en una sola pasada por la lista (que se
+     * detiene al encontrar el ltimo), en vez de una bsqueda del nodo
+     * anterior por cada uno.
+     * @param ids Identificadores a eliminar (los repetidos se ignoran)
+     * @throws runtime_error Si alguno no existe (no se elimina ninguno)
+     */
+    void eliminarProcesos(const std::vector<int>& ids);
+
+    /**
+     * Busca un proceso por su ID (en el ndice, O(log n)).
+     * @param id Identificador a buscar
+     * @return Puntero al nodo encontrado o NULL si no existe
+     */
+    NodoProcesso* buscarPorId(int id) const;
+
+    /**
+     * Muestra todos los procesos en la lista.
+     */
+    void mostrar() const;
+
+    /**
+     * Muestra, ordenados por ID, los procesos con ID en [desde, hasta].
+     */
+    void mostrarRango(int desde, int hasta) const;
+
+    /**
+     * ndice ordenado por ID: rangos, recorrido ordenado, rango/seleccin.
+     */
+    const IndiceProcesos& getIndice() const { return indice; }
+
+    /**
+     * Control de admisin de las tareas de tiempo real.
+     */
+    AdmisionTiempoReal& getAdmision() { return admision; }
+    const AdmisionTiempoReal& getAdmision() const { return admision; }
+
+    /**
+     * Cuenta la cantidad de procesos en la lista.
+     * @return Nmero de procesos
+     */
+    int contarProcesos() const;
+
+    /**
+     * Devuelve el primer nodo de la lista (recorridos de solo lectura).
+     */
+    NodoProcesso* primero() const { return cabeza; }
+
+    /**
+     * Archivo de persistencia ("" si trabaja solo en memoria).
+     */
+    const std::string& getArchivo() const { return archivo; }
+
+private:
+    void liberarNodos();
+
+    /**
+     * Indica si hay que grabar la operacin en curso. La primera vez en
+     * cada sesin anuncia la lista y su contenido actual en la traza.
+     */
+    bool trazando() const {
+        uint32_t e = Traza::epoca();
+        return e != 0 && (e == epocaTraza || anunciarTraza(e));
+    }
+    bool anunciarTraza(uint32_t epoca) const;
+
+    // La lista es duea de sus nodos: no se copia
+    ListaProcesso(const ListaProcesso&);
+    ListaProcesso& operator=(const ListaProcesso&);
+};
+
+/**
+ * Datos de un proceso como valor (el nombre va internado en PoolNombres).
+ */
+struct DatosProceso {
+    int id;
+    NombreProceso nombre;
+    int prioridad;
+};
+
+/**
+ * Extractor de la clave de DatosProceso: su ID.
+ */
+struct IdDeProceso {
+    int operator()(const DatosProceso& p) const { return p.id; }
+};
+
+/**
+ * Lista de procesos por valor, sin ndice, persistencia ni traza: los
+ * nodos salen de un arreglo propio (dentro del objeto con N > 0) en vez
+ * de un new por proceso. Buscar y eliminar por ID recorren la lista.
+ */
+template <std::size_t N = 0>
+using ListaProcesosCompacta = ListaGenerica<DatosProceso, IdDeProceso, N>;
+
+#endif // LISTA_PROCESSO_H
@@ -0,0 +1,341 @@
+#ifndef MEMORIA_VIRTUAL_H
+#define MEMORIA_VIRTUAL_H
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "NodoProcesso.h"
+#include "Reemplazo.h"
+
+/* ================================================================
+ *                   MEMORIA VIRTUAL (PAGINACIN)
+ * ================================================================ */
+/**
+ * Direcciones virtuales de 32 bits con pginas de 4 KiB y una tabla de
+ * dos niveles (10 + 10 bits de nmero de pgina, 12 bits de
+ * desplazamiento), como en x86 de 32 bits sin PAE.
+ */
+const int BITS_DESPLAZAMIENTO = 12;
+const int BITS_NIVEL = 10;
+const uint32_t TAM_PAGINA = 1u << BITS_DESPLAZAMIENTO;
+const uint32_t ENTRADAS_NIVEL = 1u << BITS_NIVEL;
+
+/**
+ * Entrada de tabla de pginas empaquetada en 32 bits:
+ * bits 0-19 nmero de marco, bit 29 sucia, bit 30 referenciada,
+ * bit 31 presente.
+ */
+const uint32_t PTE_MARCO = 0x000FFFFFu;
+const uint32_t PTE_SUCIA = 1u << 29;
+const uint32_t PTE_REFERENCIADA = 1u << 30;
+const uint32_t PTE_PRESENTE = 1u << 31;
+
+/**
+ * Tabla de pginas de dos niveles de un proceso. Las tablas de segundo
+ * nivel se reservan bajo demanda.
+ */
+class TablaPaginas {
+private:
+    uint32_t* directorio[ENTRADAS_NIVEL]; // Tablas de segundo nivel (o NULL)
+    int paginasMapeadas;                  // Entradas presentes
+
+public:
+    TablaPaginas();
+    ~TablaPaginas();
+
+    /**
+     * Recorre la tabla para una pgina virtual.
+     * @param vpn Nmero de pgina virtual
+     * @param niveles Recibe cuntos niveles se leyeron (costo del walk)
+     * @return Puntero a la entrada, o NULL si falta la tabla de segundo nivel
+     */
+    uint32_t* recorrer(uint32_t vpn, int& niveles) const {
+        uint32_t* tabla = directorio[vpn >> BITS_NIVEL];
+        if (!tabla) {
+            niveles = 1;
+            return NULL;
+        }
+        niveles = 2;
+        return &tabla[vpn & (ENTRADAS_NIVEL - 1)];
+    }
+
+    /**
+     * Entrada de una pgina, creando la tabla de segundo nivel si falta.
+     */
+    uint32_t* entrada(uint32_t vpn);
+
+    /**
+     * Mapea una pgina virtual a un marco fsico.
+     */
+    void mapear(uint32_t vpn, uint32_t marco);
+
+    /**
+     * Elimina el mapeo de una pgina.
+     * @return Marco que ocupaba la pgina, o -1 si no estaba presente
+     */
+    int desmapear(uint32_t vpn);
+
+    /**
+     * Llama a f(vpn, marco) por cada pgina presente.
+     */
+    template <typename F>
+    void recorrerPresentes(F f) const {
+        for (uint32_t d = 0; d < ENTRADAS_NIVEL; d++) {
+            if (!directorio[d]) continue;
+            for (uint32_t t = 0; t < ENTRADAS_NIVEL; t++) {
+                uint32_t pte = directorio[d][t];
+                if (pte & PTE_PRESENTE) f((d << BITS_NIVEL) | t, pte & PTE_MARCO);
+            }
+        }
+    }
+
+    int getPaginasMapeadas() const { return paginasMapeadas; }
+
+private:
+    TablaPaginas(const TablaPaginas&);
+    TablaPaginas& operator=(const TablaPaginas&);
+};
+
+/**
+ * Asignador de marcos fsicos con pila de marcos libres y mapa inverso
+ * marco -> (proceso, pgina) para los algoritmos de reemplazo.
+ */
+class AsignadorMarcos {
+public:
+    struct Marco {
+        int pid;      // Proceso dueo (-1 si est libre)
+        uint32_t vpn; // Pgina virtual que contiene
+    };
+
+private:
+    std::vector<uint32_t> libres;
+    std::vector<Marco> marcos;
+
+public:
+    /**
+     * @param numMarcos Nmero de marcos de memoria fsica
+     */
+    explicit AsignadorMarcos(uint32_t numMarcos);
+
+    /**
+     * Reserva un marco libre.
+     * @return Nmero de marco, o -1 si no quedan libres
+     */
+    int asignar(int pid, uint32_t vpn);
+
+    /**
+     * Devuelve un marco a la lista de libres.
+     */
+    void liberar(uint32_t marco);
+
+    const Marco& info(uint32_t marco) const { return marcos[marco]; }
+    uint32_t total() const { return (uint32_t)marcos.size(); }
+    uint32_t disponibles() const { return (uint32_t)libres.size(); }
+};
+
+/**
+ * TLB asociativa por conjuntos con etiquetas (pid, pgina) y reemplazo
+ * LRU dentro de cada conjunto.
+ */
+class TLB {
+private:
+    struct Via {
+        uint64_t etiqueta; // (pid << 32) | vpn; VACIA si no es vlida
+        uint32_t* pte;     // Entrada de la tabla de pginas cacheada
+        uint64_t uso;      // Marca de tiempo para LRU
+    };
+
+    std::vector<Via> vias;  // conjuntos * asociatividad, contiguas por conjunto
+    uint32_t mascaraConjuntos;
+    uint32_t asociatividad;
+    uint64_t reloj;
+
+public:
+    static const uint64_t VACIA = ~0ull;
+
+    /**
+     * @param conjuntos Nmero de conjuntos (se redondea a potencia de 2)
+     * @param asociatividad Vas por conjunto
+     */
+    TLB(uint32_t conjuntos, uint32_t asociatividad);
+
+    static uint64_t etiqueta(int pid, uint32_t vpn) {
+        return ((uint64_t)(uint32_t)pid << 32) | vpn;
+    }
+
+    /**
+     * Busca una traduccin en la TLB.
+     * @return Entrada cacheada, o NULL si es un fallo de TLB
+     */
+    uint32_t* buscar(int pid, uint32_t vpn) {
+        uint64_t e = etiqueta(pid, vpn);
+        Via* conjunto = &vias[(size_t)indiceConjunto(pid, vpn) * asociatividad];
+        for (uint32_t w = 0; w < asociatividad; w++) {
+            if (conjunto[w].etiqueta == e) {
+                conjunto[w].uso = ++reloj;
+                return conjunto[w].pte;
+            }
+        }
+        return NULL;
+    }
+
+    /**
+     * Inserta una traduccin desalojando la va menos usada del conjunto.
+     */
+    void insertar(int pid, uint32_t vpn, uint32_t* pte);
+
+    /**
+     * Invalida la traduccin de una pgina.
+     */
+    void invalidar(int pid, uint32_t vpn);
+
+    /**
+     * Invalida todas las traducciones de un proceso.
+     */
+    void invalidarProceso(int pid);
+
+    /**
+     * Vaca la TLB completa.
+     */
+    void vaciar();
+
+    uint32_t getConjuntos() const { return mascaraConjuntos + 1; }
+    uint32_t getAsociatividad() const { return asociatividad; }
+
+private:
+    uint32_t indiceConjunto(int pid, uint32_t vpn) const {
+        return (vpn ^ ((uint32_t)pid * 0x9E3779B1u)) & mascaraConjuntos;
+    }
+};
+
+/**
+ * Estadsticas acumuladas de traduccin.
+ */
+struct EstadisticasVM {
+    uint64_t traducciones;
+    uint64_t aciertosTLB;
+    uint64_t fallosTLB;
+    uint64_t fallosPagina;
+    uint64_t nivelesRecorridos; // Lecturas de tabla hechas por los page walks
+    uint64_t desalojos;         // Pginas expulsadas por el algoritmo de reemplazo
+    uint64_t escriturasDisco;   // Desalojos de pginas sucias
+};
+
+/**
+ * Subsistema de memoria virtual: tablas de pginas por proceso (enlazadas
+ * desde NodoProcesso::tablaPaginas), asignador de marcos y TLB.
+ * Las pginas se asignan bajo demanda en el primer acceso; con un
+ * algoritmo de reemplazo configurado, al agotarse los marcos se desaloja
+ * la vctima que este elija en lugar de fallar.
+ */
+class MemoriaVirtual {
+private:
+    AsignadorMarcos asignador;
+    TLB tlb;
+    std::unordered_map<int, TablaPaginas*> espacios; // pid -> tabla (dueo)
+    EstadisticasVM estadisticas;
+    AlgoritmoReemplazo* reemplazo; // Poltica de desalojo (dueo, o NULL)
+
+public:
+    /**
+     * Ciclos estimados por acierto de TLB y por nivel ledo en un walk,
+     * usados solo para reportar el costo de traduccin.
+     */
+    static const int CICLOS_TLB = 1;
+    static const int CICLOS_NIVEL = 100;
+
+    /**
+     * @param numMarcos Marcos de memoria fsica
+     * @param conjuntosTLB Conjuntos de la TLB
+     * @param viasTLB Asociatividad de la TLB
+     */
+    MemoriaVirtual(uint32_t numMarcos, uint32_t conjuntosTLB = 16, uint32_t viasTLB = 4);
+    ~MemoriaVirtual();
+
+    /**
+     * Crea el espacio de direcciones de un proceso y lo enlaza al nodo.
+     * @throws runtime_error Si el proceso es invlido o ya tiene espacio
+     */
+    void crearEspacio(NodoProcesso* proceso);
+
+    /**
+     * Libera todos los marcos y la tabla de pginas de un proceso.
+     */
+    void destruirEspacio(NodoProcesso* proceso);
+
+    /**
+     * Traduce una direccin virtual a fsica.
+     * @param proceso Proceso con espacio de direcciones
+     * @param direccion Direccin virtual
+     * @param escritura true si el acceso es de escritura (marca la pgina sucia)
+     * @return Direccin fsica
+     * @throws runtime_error Si el proceso no tiene espacio o no hay marcos libres
+     */
+    uint32_t traducir(NodoProcesso* proceso, uint32_t direccion, bool escritura = false) {
+        uint32_t vpn = direccion >> BITS_DESPLAZAMIENTO;
+        estadisticas.traducciones++;
+        uint32_t* pte = tlb.buscar(proceso->id, vpn);
+        if (pte) {
+            estadisticas.aciertosTLB++;
+            if (reemplazo) notificarReemplazo(proceso->id, vpn);
+        } else {
+            pte = recorrerTabla(proceso, vpn);
+        }
+        *pte |= PTE_REFERENCIADA | (escritura ? PTE_SUCIA : 0);
+        return ((*pte & PTE_MARCO) << BITS_DESPLAZAMIENTO) | (direccion & (TAM_PAGINA - 1));
+    }
+
+    /**
+     * Configura el algoritmo de reemplazo (toma posesin de l).
+     * @param algoritmo Algoritmo con capacidad igual al nmero de marcos,
+     *        o NULL para volver a fallar cuando no quedan marcos
+     * @throws runtime_error Si ya hay pginas mapeadas o la capacidad no coincide
+     */
+    void setAlgoritmoReemplazo(AlgoritmoReemplazo* algoritmo);
+
+    const AlgoritmoReemplazo* getAlgoritmoReemplazo() const { return reemplazo; }
+    const EstadisticasVM& getEstadisticas() const { return estadisticas; }
+    const AsignadorMarcos& getAsignador() const { return asignador; }
+    const TLB& getTLB() const { return tlb; }
+
+    /**
+     * Tasa de aciertos de la TLB (0-1).
+     */
+    double tasaAciertosTLB() const;
+
+    /**
+     * Ciclos estimados promedio por traduccin.
+     */
+    double ciclosPorTraduccion() const;
+
+    /**
+     * Muestra las estadsticas de traduccin.
+     */
+    void mostrarEstadisticas(std::ostream& os) const;
+
+    /**
+     * Pone a cero las estadsticas (no toca mapeos ni TLB).
+     */
+    void reiniciarEstadisticas();
+
+private:
+    /**
+     * Camino lento: page walk, fallo de pgina y recarga de la TLB. El
+     * algoritmo de reemplazo recibe la referencia solo despus de validar
+     * el espacio del proceso; en un fallo, antes de pedir el marco.
+     */
+    uint32_t* recorrerTabla(NodoProcesso* proceso, uint32_t vpn);
+
+    /**
+     * Informa la referencia al algoritmo de reemplazo y desaloja la
+     * vctima si la hay, dejando su marco libre para el fallo en curso.
+     */
+    void notificarReemplazo(int pid, uint32_t vpn);
+
+    MemoriaVirtual(const MemoriaVirtual&);
+    MemoriaVirtual& operator=(const MemoriaVirtual&);
+};
+
+#endif // MEMORIA_VIRTUAL_H
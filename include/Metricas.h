@@ -0,0 +1,300 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/* ================================================================
+ *                   MTRICAS E INSTRUMENTACIN
+ * ================================================================ */
+/**
+ * Contadores, medidores e histogramas de latencia por subsistema.
+ *
+ * Cada hilo escribe en su propio bloque (almacenamiento thread-local)
+ * sin sincronizacin; las lecturas recorren todos los bloques vivos
+ * y suman los de hilos ya terminados. Reiniciar no escribe en los
+ * bloques ajenos: avanza una poca global y cada hilo pone a cero su
+ * propio bloque la prxima vez que lo usa (hasta entonces, los
+ * lectores lo cuentan como cero). Con SO_METRICAS desactivado los
+ * macros de instrumentacin no generan cdigo.
+ */
+namespace Metricas {
+
+/**
+ * Contadores montonos (solo crecen).
+ */
+enum Contador {
+    LISTA_INSERCIONES,
+    LISTA_ELIMINACIONES,
+    LISTA_BUSQUEDAS,
+    COLA_ENCOLADOS,
+    COLA_DESENCOLADOS,
+    MEMORIA_ASIGNACIONES,
+    MEMORIA_LIBERACIONES,
+    MEMORIA_RECHAZOS,
+    MEMORIA_REUBICADOS,
+    PERSISTENCIA_GUARDADOS,
+    PERSISTENCIA_CARGAS,
+    PERSISTENCIA_REGISTROS,
+    PERSISTENCIA_GUARDADOS_FONDO,
+    PERSISTENCIA_DUPLICADOS,
+    VM_FALLOS_TLB,
+    VM_FALLOS_PAGINA,
+    TEMPORIZADORES_DISPARADOS,
+    RPC_SOLICITUDES,
+    RPC_REENVIADAS,
+    CPU_QUANTUMS,
+    CPU_REANUDACIONES,
+    TR_TRABAJOS,
+    TR_PLAZOS_PERDIDOS,
+    TR_RECHAZADAS,
+    SLAB_ASIGNACIONES,
+    SLAB_LIBERACIONES,
+    SLAB_RECARGAS,
+    ARBOL_CLONACIONES,
+    ARBOL_ELIMINADOS_SUBARBOL,
+    NUM_CONTADORES
+};
+
+/**
+ * Medidores de nivel (suben y bajan): cada hilo acumula deltas.
+ */
+enum Medidor {
+    LISTA_PROCESOS,
+    COLA_PROFUNDIDAD,
+    MEMORIA_OCUPACION,
+    PROCESOS_BLOQUEADOS,
+    NOMBRES_INTERNADOS,
+    RPC_CONEXIONES,
+    RPC_INSTANCIAS,
+    SLAB_PAGINAS,
+    NUM_MEDIDORES
+};
+
+/**
+ * Histogramas de distribucin (latencias en ns o longitudes).
+ */
+enum Histograma {
+    LISTA_INSERTAR_NS,
+    LISTA_NODOS_RECORRIDOS,
+    COLA_ENCOLAR_NS,
+    COLA_LONGITUD_ESCANEO,
+    COLA_ESPERA_TICKS,
+    PERSISTENCIA_GUARDAR_NS,
+    PERSISTENCIA_CARGAR_NS,
+    PERSISTENCIA_PAUSA_FORK_NS,
+    TR_TARDANZA_TICKS,
+    NUM_HISTOGRAMAS
+};
+
+/**
+ * Histograma log-lineal al estilo HDR: 16 sub-cubetas por potencia
+ * de dos, error relativo mximo ~6% en todo el rango de 64 bits.
+ * Solo el hilo dueo escribe; los lectores pueden leer en paralelo.
+ */
+class HistogramaHdr {
+public:
+    static const int BITS_SUB = 4;
+    static const int SUB_CUBETAS = 1 << BITS_SUB;
+    static const int NUM_CUBETAS = (64 - BITS_SUB + 1) * SUB_CUBETAS;
+
+    /**
+     * Cubeta que corresponde a un valor.
+     */
+    static int indice(uint64_t v) {
+        if (v < (uint64_t)SUB_CUBETAS) return (int)v;
+        int e = 63 - __builtin_clzll(v);
+        int sub = (int)(v >> (e - BITS_SUB)) & (SUB_CUBETAS - 1);
+        return (e - BITS_SUB + 1) * SUB_CUBETAS + sub;
+    }
+
+    /**
+     * Menor valor que cae en la cubeta i.
+     */
+    static uint64_t limiteInferior(int i) {
+        if (i < SUB_CUBETAS) return (uint64_t)i;
+        int grupo = i / SUB_CUBETAS;
+        int sub = i % SUB_CUBETAS;
+        return (uint64_t)(SUB_CUBETAS + sub) << (grupo - 1);
+    }
+
+    /**
+     * Registra un valor (solo desde el hilo dueo).
+     */
+    void registrar(uint64_t v) {
+        incrementar(cubetas[indice(v)], 1);
+        incrementar(suma, v);
+        if (v > maximo.load(std::memory_order_relaxed)) {
+            maximo.store(v, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint64_t> cubetas[NUM_CUBETAS];
+    std::atomic<uint64_t> suma;
+    std::atomic<uint64_t> maximo;
+
+    /**
+     * Suma de un solo escritor: carga y guarda relajadas, sin RMW atmico.
+     */
+    static void incrementar(std::atomic<uint64_t>& a, uint64_t d) {
+        a.store(a.load(std::memory_order_relaxed) + d, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Bloque de mtricas de un hilo.
+ */
+struct BloqueHilo {
+    std::atomic<uint32_t> epoca;   // ltimo reinicio que vio su dueo
+    std::atomic<uint64_t> contadores[NUM_CONTADORES];
+    std::atomic<int64_t> medidores[NUM_MEDIDORES];
+    HistogramaHdr histogramas[NUM_HISTOGRAMAS];
+};
+
+/**
+ * Nmero de reinicios (ver reiniciar()).
+ */
+extern std::atomic<uint32_t> epocaReinicio;
+
+/**
+ * Crea y registra el bloque del hilo actual (camino lento).
+ */
+BloqueHilo* registrarHilo();
+
+/**
+ * Pone a cero contadores e histogramas del bloque del hilo actual tras
+ * un reinicio (camino lento; lo llama solo su dueo).
+ */
+void alcanzarReinicio(BloqueHilo& bloque);
+
+/**
+ * Bloque de mtricas del hilo actual.
+ */
+inline BloqueHilo& bloqueLocal() {
+    static thread_local BloqueHilo* bloque = NULL;
+    if (__builtin_expect(bloque == NULL, 0)) bloque = registrarHilo();
+    if (__builtin_expect(bloque->epoca.load(std::memory_order_relaxed) !=
+                             epocaReinicio.load(std::memory_order_relaxed), 0)) {
+        alcanzarReinicio(*bloque);
+    }
+    return *bloque;
+}
+
+inline void contar(Contador c, uint64_t n = 1) {
+    std::atomic<uint64_t>& a = bloqueLocal().contadores[c];
+    a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void ajustar(Medidor m, int64_t delta) {
+    std::atomic<int64_t>& a = bloqueLocal().medidores[m];
+    a.store(a.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+inline void registrar(Histograma h, uint64_t valor) {
+    bloqueLocal().histogramas[h].registrar(valor);
+}
+
+/**
+ * Cronmetro de mbito: registra en el histograma los ns transcurridos
+ * entre su construccin y su destruccin.
+ */
+class Cronometro {
+public:
+    explicit Cronometro(Histograma h) : h(h), inicio(std::chrono::steady_clock::now()) {}
+    ~Cronometro() {
+        registrar(h, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - inicio).count());
+    }
+
+private:
+    Histograma h;
+    std::chrono::steady_clock::time_point inicio;
+};
+
+/**
+ * Resumen de un histograma ya fusionado entre hilos.
+ */
+struct ResumenHistograma {
+    uint64_t cuenta;
+    uint64_t suma;
+    uint64_t maximo;
+    uint64_t p50, p90, p99, p999;
+};
+
+/**
+ * Vista consolidada de todas las mtricas en un instante.
+ */
+struct Instantanea {
+    uint64_t contadores[NUM_CONTADORES];
+    int64_t medidores[NUM_MEDIDORES];
+    ResumenHistograma histogramas[NUM_HISTOGRAMAS];
+};
+
+/**
+ * Indica si la instrumentacin est compilada.
+ */
+bool habilitadas();
+
+/**
+ * Fusiona los bloques de todos los hilos (vivos y terminados).
+ */
+Instantanea tomarInstantanea();
+
+/**
+ * Pone a cero contadores e histogramas (los medidores se conservan,
+ * pues reflejan el estado vivo de las estructuras). Un incremento que
+ * corre a la vez en otro hilo puede quedar antes o despus del reinicio,
+ * pero no se mezcla con los valores viejos.
+ */
+void reiniciar();
+
+const char* nombre(Contador c);
+const char* nombre(Medidor m);
+const char* nombre(Histograma h);
+
+/**
+ * Muestra las mtricas en formato de tabla legible.
+ */
+void mostrar(std::ostream& os);
+
+/**
+ * Exporta las mtricas como objeto JSON.
+ */
+void exportarJSON(std::ostream& os);
+
+/**
+ * Exporta las mtricas en el formato de texto de Prometheus.
+ */
+void exportarPrometheus(std::ostream& os);
+
+/**
+ * Escribe la exportacin en un archivo.
+ * @param archivo Ruta destino
+ * @param prometheus true para formato Prometheus, false para JSON
+ * @throws runtime_error Si no se puede abrir el archivo
+ */
+void guardar(const std::string& archivo, bool prometheus);
+
+} // namespace Metricas
+
+/* ---------------- Macros de instrumentacin ---------------- */
+#if SO_METRICAS
+#define SO_MET_CONCAT2(a, b) a##b
+#define SO_MET_CONCAT(a, b) SO_MET_CONCAT2(a, b)
+#define SO_CONTAR(c) Metricas::contar(Metricas::c)
+#define SO_CONTAR_N(c, n) Metricas::contar(Metricas::c, (uint64_t)(n))
+#define SO_MEDIDOR(m, delta) Metricas::ajustar(Metricas::m, (int64_t)(delta))
+#define SO_HISTOGRAMA(h, v) Metricas::registrar(Metricas::h, (uint64_t)(v))
+#define SO_CRONOMETRO(h) Metricas::Cronometro SO_MET_CONCAT(cronometro_, __LINE__)(Metricas::h)
+#else
+#define SO_CONTAR(c) ((void)0)
+#define SO_CONTAR_N(c, n) ((void)0)
+#define SO_MEDIDOR(m, delta) ((void)0)
+#define SO_HISTOGRAMA(h, v) ((void)0)
+#define SO_CRONOMETRO(h) ((void)0)
+#endif
+
+#endif // METRICAS_H
@@ -0,0 +1,70 @@
+#ifndef NODO_PROCESSO_H
+#define NODO_PROCESSO_H
+
+#include <cstddef>
+#include <string>
+
+#include "CuerpoProceso.h"
+#include "PoolNombres.h"
+#include "RuedaTemporizadores.h"
+#include "TiempoReal.h"
+
+class TablaPaginas;
+
+/**
+ * Estados del ciclo de vida de un proceso.
+ */
+enum EstadoProceso {
+    NUEVO,      // Creado, an no admitido en la cola de listos
+    LISTO,      // En la cola de listos
+    EJECUCION,  // Ocupando la CPU
+    BLOQUEADO,  // Esperando E/S o un temporizador
+    TERMINADO   // Finalizado; conserva su entrada hasta eliminarse
+};
+
+/**
+ * Nombre legible de un estado.
+ */
+inline const char* nombreEstado(EstadoProceso e) {
+    static const char* const NOMBRES[] = { "Nuevo", "Listo", "Ejecucin", "Bloqueado",
+                                           "Terminado" };
+    return NOMBRES[e];
+}
+
+/* ================================================================
+ *                   NODO DE PROCESO
+ * ================================================================ */
+/**
+ * Clase que representa un nodo de proceso en la lista enlazada.
+ * Contiene informacin bsica del proceso y un puntero al siguiente nodo.
+ */
+class NodoProcesso {
+public:
+    int id;             // Identificador nico del proceso
+    NombreProceso nombre; // Nombre descriptivo (internado en PoolNombres)
+    int prioridad;      // Prioridad del proceso (0-100)
+    NodoProcesso* siguiente; // Puntero al siguiente nodo en la lista
+    TablaPaginas* tablaPaginas; // Espacio de direcciones (NULL si no tiene)
+    EstadoProceso estado;       // Estado en el ciclo de vida
+    Temporizador despertar;     // Temporizador de bloqueo con plazo
+    CuerpoProceso cuerpo;       // Cdigo que ejecuta (vaco = solo consume CPU)
+    TareaTiempoReal tiempoReal; // Periodo, plazo y trabajo en curso (periodo 0 = comn)
+
+    /**
+     * Constructor del nodo de proceso.
+     * @param id Identificador del proceso
+     * @param nombre Nombre del proceso; una std::string temporal se mueve
+     *        al pool si es nueva, y un nombre ya internado no cuesta nada
+     * @param prioridad Nivel de prioridad (0-100)
+     */
+    NodoProcesso(int id, NombreProceso nombre, int prioridad)
+        : id(id), nombre(nombre), prioridad(prioridad), siguiente(NULL),
+          tablaPaginas(NULL), estado(NUEVO), despertar(this) {}
+
+private:
+    // El temporizador apunta a su nodo: los nodos no se copian
+    NodoProcesso(const NodoProcesso&);
+    NodoProcesso& operator=(const NodoProcesso&);
+};
+
+#endif // NODO_PROCESSO_H
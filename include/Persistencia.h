@@ -0,0 +1,103 @@
+#ifndef PERSISTENCIA_H
+#define PERSISTENCIA_H
+
+#include <string>
+
+#include "NodoProcesso.h"
+
+class ArbolProcesos;
+
+/* ================================================================
+ *                   GESTOR DE PERSISTENCIA
+ * ================================================================ */
+/**
+ * Clase para manejar la persistencia de datos en archivos.
+ * Proporciona mtodos para guardar y cargar procesos desde/hacia archivos.
+ *
+ * Hay dos formatos: el CSV original (id,nombre,prioridad) y uno
+ * comprimido opcional (ver guardarProcesosComprimido). cargarProcesos
+ * reconoce el formato por su cabecera.
+ *
+ * El rbol de procesos va en su propio archivo, en el mismo estilo CSV
+ * (pid,padre), ver guardarArbol.
+ */
+class Persistencia {
+public:
+    /**
+     * Guarda la lista de procesos en un archivo.
+     * @param cabeza Puntero al primer nodo de la lista
+     * @param archivo Nombre del archivo donde guardar
+     * @throws runtime_error Si no se puede abrir el archivo
+     */
+    static void guardarProcesos(NodoProcesso* cabeza, const std::string& archivo);
+
+    /**
+     * Carga procesos desde un archivo a una lista enlazada.
+     * @param archivo Nombre del archivo a cargar
+     * @return Puntero al primer nodo de la lista cargada (NULL si no existe archivo)
+     */
+    static NodoProcesso* cargarProcesos(const std::string& archivo);
+
+    /**
+     * Carga el CSV en paralelo: el archivo proyectado se parte en trozos
+     * alineados a saltos de lnea que se analizan a la vez, cada uno en
+     * su propia arena de registros; los ID repetidos se detectan por
+     * cubetas de hash (se conserva la primera aparicin y se avisa de
+     * las dems) y la lista final respeta el orden del archivo.
+     * @param archivo Nombre del archivo a cargar
+     * @param hilos Hilos a usar (0 = los ncleos disponibles; los
+     *        archivos pequeos usan menos)
+     * @return Puntero al primer nodo (NULL si no existe archivo)
+     */
+    static NodoProcesso* cargarProcesosCsv(const std::string& archivo, unsigned hilos = 0);
+
+    /**
+     * Guarda la lista en formato comprimido. Los registros se agrupan en
+     * bloques de REGISTROS_POR_BLOQUE; cada bloque guarda por columnas
+     * los ID como diferencias varint (zigzag), las prioridades como un
+     * byte y los nombres como ndices varint a un diccionario comn, y
+     * se comprime con CodecLZ.
+     * @param cabeza Puntero al primer nodo de la lista
+     * @param archivo Nombre del archivo donde guardar
+     * @return Bytes escritos
+     * @throws runtime_error Si no se puede escribir o una prioridad no cabe en un byte
+     */
+    static size_t guardarProcesosComprimido(NodoProcesso* cabeza, const std::string& archivo);
+
+    /**
+     * Carga un archivo comprimido descomprimiendo sus bloques en paralelo;
+     * la lista resultante conserva el orden original.
+     * @param archivo Nombre del archivo a cargar
+     * @param hilos Hilos a usar (0 = los ncleos disponibles)
+     * @return Puntero al primer nodo (NULL si el archivo no tiene procesos)
+     * @throws runtime_error Si el archivo no existe o est daado
+     */
+    static NodoProcesso* cargarProcesosComprimido(const std::string& archivo,
+                                                  unsigned hilos = 0);
+
+    /**
+     * Indica si un archivo est en el formato comprimido.
+     */
+    static bool esComprimido(const std::string& archivo);
+
+    /**
+     * Guarda el rbol de procesos, una lnea "pid,padre" por proceso
+     * (padre = ArbolProcesos::INIT si cuelga de init). Las lneas van en
+     * preorden: cada padre aparece antes que sus hijos, y los hermanos
+     * en su orden.
+     * @throws runtime_error Si no se puede abrir el archivo
+     */
+    static void guardarArbol(const ArbolProcesos& arbol, const std::string& archivo);
+
+    /**
+     * Agrega al rbol los procesos de un archivo de guardarArbol. Las
+     * lneas invlidas (formato, PID repetido o padre desconocido) se
+     * informan con ErrorHandler y se saltan.
+     * @return Procesos agregados (0 si no existe el archivo)
+     */
+    static size_t cargarArbol(const std::string& archivo, ArbolProcesos& arbol);
+
+    static const unsigned REGISTROS_POR_BLOQUE = 8192;
+};
+
+#endif // PERSISTENCIA_H
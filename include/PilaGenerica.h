@@ -0,0 +1,101 @@
+#ifndef PILA_GENERICA_H
+#define PILA_GENERICA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "Almacen.h"
+
+/* ================================================================
+ *                   PILA GENRICA
+ * ================================================================ */
+/**
+ * Pila sobre un arreglo contiguo, con el tipo de elemento, la capacidad
+ * y el asignador fijados en tiempo de compilacin.
+ *
+ * Con N > 0 los elementos viven dentro del objeto (PilaGenerica<T, 1024>
+ * no usa el heap); con N == 0 el arreglo crece con el asignador hasta
+ * el lmite dado al construirla.
+ *
+ * @tparam T Elemento (copiable trivialmente)
+ * @tparam N Capacidad fija (0 = dinmica)
+ * @tparam Asignador Asignador del caso dinmico
+ */
+template <typename T, std::size_t N = 0, typename Asignador = std::allocator<T> >
+class PilaGenerica {
+private:
+    Almacen<T, N, Asignador> almacen;
+    std::size_t usados;
+    std::size_t limite;
+
+public:
+    /**
+     * @param limite Elementos mximos (solo cuenta con N == 0; con N > 0
+     *        el lmite es N)
+     */
+    explicit PilaGenerica(std::size_t limite = SIZE_MAX)
+        : usados(0), limite(N > 0 ? N : limite) {}
+
+    /**
+     * Apila un elemento.
+     * @throws runtime_error Si la pila est llena
+     */
+    void apilar(const T& valor) {
+        if (usados == limite || !almacen.asegurar(usados + 1, usados)) {
+            throw std::runtime_error("Pila llena");
+        }
+        almacen.datos()[usados++] = valor;
+    }
+
+    /**
+     * Desapila el elemento del tope.
+     * @throws runtime_error Si la pila est vaca
+     */
+    T desapilar() {
+        if (usados == 0) throw std::runtime_error("Pila vaca");
+        return almacen.datos()[--usados];
+    }
+
+    const T& tope() const { return almacen.datos()[usados - 1]; }
+
+    /**
+     * Quita los elementos que cumplen el predicado, conservando el orden
+     * de los dems. O(n).
+     * @return Cantidad de elementos quitados
+     */
+    template <typename Predicado>
+    std::size_t eliminarSi(Predicado pred) {
+        T* d = almacen.datos();
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < usados; i++) {
+            if (!pred(d[i])) d[j++] = d[i];
+        }
+        std::size_t quitados = usados - j;
+        usados = j;
+        return quitados;
+    }
+
+    /**
+     * Recorre los elementos del tope hacia el fondo.
+     */
+    template <typename Funcion>
+    void recorrer(Funcion f) const {
+        const T* d = almacen.datos();
+        for (std::size_t i = usados; i > 0; i--) f(d[i - 1]);
+    }
+
+    void vaciar() { usados = 0; }
+
+    std::size_t tam() const { return usados; }
+    std::size_t capacidad() const { return limite; }
+    bool vacia() const { return usados == 0; }
+    bool llena() const { return usados == limite; }
+
+private:
+    PilaGenerica(const PilaGenerica&);
+    PilaGenerica& operator=(const PilaGenerica&);
+};
+
+#endif // PILA_GENERICA_H
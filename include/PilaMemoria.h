@@ -0,0 +1,292 @@
+#ifndef PILA_MEMORIA_H
+#define PILA_MEMORIA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ConjuntoDirecciones.h"
+#include "PilaGenerica.h"
+#include "Traza.h"
+
+/**
+ * Resumen del estado de la memoria. Los huecos son los tramos de
+ * direcciones libres entre la mnima y la mxima ocupadas (cada bloque
+ * ocupa una direccin).
+ */
+struct ResumenMemoria {
+    static const int CLASES = 32;
+
+    int usados;                // Bloques asignados
+    int capacidad;
+    size_t direcciones;        // Direcciones distintas ocupadas
+    int minima;                // Direccin ocupada ms baja (0 si no hay)
+    int maxima;                // Direccin ocupada ms alta (0 si no hay)
+    uint64_t huecos;           // Tramos libres entre minima y maxima
+    uint64_t libre;            // Direcciones libres entre minima y maxima
+    uint64_t histograma[CLASES]; // Huecos de tamao [2^k, 2^(k+1))
+    /**
+     * 1 - (suma de tamaos^2) / (libre^2): 0 si todo el espacio libre es
+     * un solo hueco (o no hay), tiende a 1 con muchos huecos chicos.
+     */
+    double fragmentacion;
+};
+
+/**
+ * Progreso de la compactacin en curso (o la ltima).
+ */
+struct EstadisticasCompactacion {
+    bool activa;                 // Hay una compactacin en curso
+    uint64_t pasos;              // Pasos ejecutados
+    uint64_t examinadas;         // Direcciones revisadas (movidas o ya en su lugar)
+    uint64_t direccionesMovidas;
+    uint64_t bloquesMovidos;     // Varios bloques pueden compartir direccin
+    // Estado al iniciarla, para medir lo recuperado
+    uint64_t huecosInicio;
+    uint64_t libreInicio;
+    double fragmentacionInicio;
+};
+
+/* ================================================================
+ *                   GESTOR DE MEMORIA
+ * ================================================================ */
+/**
+ * Clase que implementa una pila para gestin de memoria.
+ * Simula asignacin y liberacin de bloques de memoria.
+ *
+ * Cada bloque registra el proceso dueo y queda enlazado en la lista de
+ * bloques de ese proceso, de modo que al terminar un proceso su memoria
+ * se libera en tiempo proporcional a sus propios bloques.
+ *
+ * Las estadsticas del resumen (direcciones mnima y mxima, huecos,
+ * fragmentacin) se actualizan en cada push y pop a partir de las
+ * direcciones vecinas, que da un ConjuntoDirecciones de las ocupadas:
+ * resumen() cuesta O(1).
+ *
+ * Cada bloque tiene adems una manija estable: la compactacin desliza
+ * las direcciones ocupadas hacia la ms baja, sin huecos, y los dueos
+ * que guardan la manija siguen encontrando su bloque con direccionDe().
+ * Compactar avanza por pasos de trabajo acotado entre los que se puede
+ * seguir asignando y liberando.
+ */
+class PilaMemoria {
+private:
+    // Nodo interno para la pila de memoria
+    struct NodoMemoria {
+        int direccion;            // Direccin de memoria
+        int pid;                  // Proceso dueo (SIN_DUENO si es del sistema)
+        NodoMemoria* abajo;       // Puntero al nodo inferior en la pila
+        NodoMemoria* arriba;      // Puntero al nodo superior en la pila
+        NodoMemoria* sigProceso;  // Siguiente bloque del mismo proceso
+        NodoMemoria* antProceso;  // Bloque anterior del mismo proceso
+        NodoMemoria* sigDireccion; // Otro bloque en la misma direccin
+        NodoMemoria* antDireccion;
+        uint32_t manija;          // ndice en la tabla de manijas
+        NodoMemoria(int dir, int pid)
+            : direccion(dir), pid(pid), abajo(NULL), arriba(NULL),
+              sigProceso(NULL), antProceso(NULL), sigDireccion(NULL), antDireccion(NULL),
+              manija(0) {}
+    };
+
+    NodoMemoria* tope;     // Puntero al tope de la pila
+    int capacidad;          // Capacidad mxima de la pila
+    int contador;           // Contador de bloques asignados
+    std::unordered_map<int, NodoMemoria*> porProceso; // pid -> su bloque ms reciente
+    ConjuntoDirecciones ocupadas; // Direcciones con algn bloque
+    std::unordered_map<int, NodoMemoria*> porDireccion; // direccin -> sus bloques
+    std::vector<NodoMemoria*> manijas;    // Tabla de manijas (NULL = libre)
+    std::vector<uint32_t> generaciones;   // Por entrada: detecta manijas viejas
+    std::vector<uint32_t> manijasLibres;
+    uint64_t huecos;        // Huecos entre direcciones ocupadas
+    uint64_t libre;         // Suma de sus tamaos
+    uint64_t libreCuadrados; // Suma de sus tamaos al cuadrado (< 2^64: libre < 2^32)
+    uint64_t histograma[ResumenMemoria::CLASES];
+    uint32_t idTraza;       // Identificador en la traza de operaciones
+    uint32_t epocaTraza;    // Sesin de traza en que ya se anunci
+    // Compactacin: [baseCompactacion, cursorCompactacion) ya no tiene huecos
+    int baseCompactacion;
+    int cursorCompactacion;
+    EstadisticasCompactacion compactacion;
+
+    friend class Instantanea;
+
+public:
+    static const int SIN_DUENO = -1;
+    static const std::string ARCHIVO_MEMORIA; // Imagen binaria del sistema (ver Instantanea)
+
+    /**
+     * Referencia estable a un bloque: generacin (32 bits altos) e ndice
+     * en la tabla. Deja de ser vlida al liberarse el bloque; nunca es 0.
+     */
+    typedef uint64_t Manija;
+
+    /**
+     * Constructor que inicializa la pila de memoria.
+     * @param cap Capacidad mxima de la pila
+     */
+    PilaMemoria(int cap);
+
+    /**
+     * Destructor que libera todos los nodos de la pila.
+     */
+    ~PilaMemoria();
+
+    /**
+     * Asigna un nuevo bloque de memoria (push en la pila).
+     * @param direccion Direccin de memoria a asignar
+     * @param pid Proceso dueo del bloque (SIN_DUENO para el sistema)
+     * @return Manija del bloque
+     * @throws runtime_error Si la memoria est llena
+     */
+    Manija push(int direccion, int pid = SIN_DUENO);
+
+    /**
+     * Libera el ltimo bloque de memoria asignado (pop de la pila).
+     * @return Direccin del bloque liberado
+     * @throws runtime_error Si la memoria est vaca
+     */
+    int pop();
+
+    /**
+     * Libera todos los bloques de un proceso, estn donde estn en la pila.
+     * Cuesta O(bloques del proceso), no O(bloques totales).
+     * @param pid Proceso dueo
+     * @return Nmero de bloques liberados
+     */
+    int liberarProceso(int pid);
+
+    /**
+     * Libera en una sola llamada los bloques de varios procesos (por
+     * ejemplo, un subrbol que se elimina), en O(bloques de esos procesos).
+     * @return Nmero total de bloques liberados
+     */
+    int liberarProcesos(const std::vector<int>& pids);
+
+    /**
+     * Cuenta los bloques que posee un proceso.
+     */
+    int bloquesDe(int pid) const;
+
+    /**
+     * Libera todos los bloques.
+     */
+    void vaciar();
+
+    /**
+     * Direccin actual del bloque de una manija, en O(1).
+     * @throws runtime_error Si la manija no es de un bloque asignado
+     */
+    int direccionDe(Manija manija) const;
+
+    bool manijaValida(Manija manija) const;
+
+    /**
+     * Mueve todos los bloques de una direccin a otra libre. Las manijas
+     * siguen valiendo; quien guard la direccin vieja debe volver a
+     * consultarla.
+     * @return Bloques movidos
+     * @throws runtime_error Si el origen no tiene bloques o el destino s
+     */
+    int reubicar(int origen, int destino);
+
+    /**
+     * Empieza a compactar desde la direccin ocupada ms baja (sin efecto
+     * si ya hay una compactacin en curso o no hay bloques).
+     */
+    void iniciarCompactacion();
+
+    /**
+     * Avanza la compactacin en curso revisando a lo sumo 'presupuesto'
+     * direcciones: la prxima ocupada por encima de la parte ya compacta
+     * se mueve al primer hueco. Ubicarla es O(log n); moverla corre
+     * claves dentro de una hoja de ConjuntoDirecciones, O(HOJA), y si la
+     * hoja se parte o se funde tambin el directorio, que es un vector:
+     * O(n / HOJA). Liberar un bloque de la parte compacta hace retroceder
+     * el cursor hasta su hueco.
+     * @return true si queda trabajo
+     */
+    bool pasoCompactacion(size_t presupuesto = 64);
+
+    /**
+     * Compacta por completo, en pasos.
+     */
+    EstadisticasCompactacion compactar(size_t presupuesto = 64);
+
+    bool compactando() const { return compactacion.activa; }
+    const EstadisticasCompactacion& estadisticasCompactacion() const { return compactacion; }
+
+    /**
+     * Muestra el resumen del estado de la memoria, en O(1).
+     */
+    void estadoMemoria() const;
+
+    /**
+     * Muestra una pgina de las direcciones asignadas, del tope hacia
+     * el fondo. Cuesta O(pagina * porPagina + porPagina).
+     * @param pagina Pgina a mostrar (desde 0)
+     * @param porPagina Direcciones por pgina (> 0)
+     * @return Total de pginas
+     */
+    size_t mostrarDirecciones(size_t pagina, size_t porPagina = 50) const;
+
+    /**
+     * Estadsticas actuales de la memoria, en O(1).
+     */
+    ResumenMemoria resumen() const;
+
+    /**
+     * Nmero de bloques asignados actualmente.
+     */
+    int usados() const { return contador; }
+
+    /**
+     * Capacidad mxima de la pila.
+     */
+    int getCapacidad() const { return capacidad; }
+
+private:
+    Manija apilar(int direccion, int pid);
+    void desenlazar(NodoMemoria* nodo);
+    void liberarBloques();
+    int liberarBloquesDe(int pid, bool traza);
+    void ocupar(int direccion);
+    void desocupar(int direccion);
+    int moverDireccion(int origen, int destino);
+    void sumarHueco(int64_t tam);
+    void restarHueco(int64_t tam);
+
+    /**
+     * Indica si hay que grabar la operacin en curso. La primera vez en
+     * cada sesin anuncia la pila y sus bloques actuales en la traza.
+     */
+    bool trazando() {
+        uint32_t e = Traza::epoca();
+        return e != 0 && (e == epocaTraza || anunciarTraza(e));
+    }
+    bool anunciarTraza(uint32_t epoca);
+
+    // La pila es duea de sus nodos: no se copia
+    PilaMemoria(const PilaMemoria&);
+    PilaMemoria& operator=(const PilaMemoria&);
+};
+
+/**
+ * Bloque de memoria como valor: direccin y proceso dueo.
+ */
+struct BloqueMemoria {
+    int direccion;
+    int pid;  // PilaMemoria::SIN_DUENO si es del sistema
+};
+
+/**
+ * Pila de bloques sin traza, resumen ni listas por proceso, para usos
+ * embebidos: PilaBloques<1024> guarda sus 1024 bloques dentro del objeto
+ * y no toca el heap; PilaBloques<> crece en el heap. Liberar los bloques
+ * de un proceso es eliminarSi() con un predicado por pid, O(n).
+ */
+template <std::size_t N = 0>
+using PilaBloques = PilaGenerica<BloqueMemoria, N>;
+
+#endif // PILA_MEMORIA_H
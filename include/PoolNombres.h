@@ -0,0 +1,98 @@
+#ifndef POOL_NOMBRES_H
+#define POOL_NOMBRES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/* ================================================================
+ *                   POOL DE NOMBRES INTERNADOS
+ * ================================================================ */
+/**
+ * Tabla global de cadenas internadas: cada texto distinto se guarda una
+ * sola vez y se identifica con un entero de 32 bits estable durante toda
+ * la ejecucin (el pool solo crece). Los nombres de proceso salen de un
+ * vocabulario chico ("worker", "kthread", "sshd"...), as cada proceso
+ * guarda 4 bytes en vez de una std::string y casi nunca reserva memoria.
+ *
+ * internar() es seguro entre hilos (bsqueda con bloqueo compartido);
+ * texto() no bloquea: las cadenas viven en trozos que nunca se mueven.
+ *
+ * Vida de los nombres: el pool no libera nada. Eliminar un proceso, vaciar
+ * una lista o reiniciar un simulador deja sus nombres internados, y los
+ * cargadores (CSV, comprimido, instantneas) internan cada nombre distinto
+ * que leen. La memoria crece con los textos distintos vistos, no con los
+ * procesos: un vocabulario chico cuesta lo mismo tras millones de altas y
+ * bajas. No se reclama porque los ID se comparten sin conteo entre listas,
+ * hilos e hijos de fork(), y un ID reutilizado cambiara el nombre de un
+ * proceso vivo.
+ *
+ * Lmite: 2^16 trozos de 4096 textos (unos 268 millones de nombres
+ * distintos). Al llenarse, internar() lanza runtime_error; los ID ya
+ * entregados siguen vlidos. Quien genere nombres nicos sin cota (por
+ * ejemplo, con el PID dentro del nombre) debe tenerlo en cuenta.
+ */
+class PoolNombres {
+public:
+    /**
+     * ID del texto, agregndolo si es nuevo.
+     * @throws runtime_error Si el texto es nuevo y el pool est lleno
+     */
+    static uint32_t internar(std::string_view texto);
+
+    /**
+     * Igual, pero si el texto es nuevo se mueve al pool sin copiarlo.
+     */
+    static uint32_t internar(std::string&& texto);
+
+    /**
+     * Texto de un ID devuelto por internar().
+     */
+    static const std::string& texto(uint32_t id);
+
+    /**
+     * Cantidad de textos distintos.
+     */
+    static size_t cantidad();
+
+    /**
+     * Bytes de texto guardados (sin contar estructuras auxiliares).
+     */
+    static size_t bytes();
+};
+
+/**
+ * Nombre de proceso internado: 4 bytes que se comparan por ID y se leen
+ * como std::string desde el pool.
+ */
+class NombreProceso {
+private:
+    uint32_t id;
+
+public:
+    /**
+     * Nombre vaco (el ID 0 es siempre "").
+     */
+    NombreProceso() : id(0) {}
+
+    explicit NombreProceso(uint32_t id) : id(id) {}
+
+    NombreProceso(std::string&& texto) : id(PoolNombres::internar(std::move(texto))) {}
+    NombreProceso(const std::string& texto) : id(PoolNombres::internar(std::string_view(texto))) {}
+    NombreProceso(const char* texto) : id(PoolNombres::internar(std::string_view(texto))) {}
+
+    const std::string& str() const { return PoolNombres::texto(id); }
+    operator const std::string&() const { return str(); }
+    uint32_t getId() const { return id; }
+
+    bool operator==(NombreProceso otro) const { return id == otro.id; }
+    bool operator!=(NombreProceso otro) const { return id != otro.id; }
+};
+
+inline std::ostream& operator<<(std::ostream& os, NombreProceso nombre) {
+    return os << nombre.str();
+}
+
+#endif // POOL_NOMBRES_H
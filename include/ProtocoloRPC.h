@@ -0,0 +1,136 @@
+#ifndef PROTOCOLO_RPC_H
+#define PROTOCOLO_RPC_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/* ================================================================
+ *                   PROTOCOLO BINARIO DEL SERVIDOR
+ * ================================================================ */
+/**
+ * Mensajes entre ServidorSimulador y sus clientes. Cada solicitud es una
+ * cabecera fija de 24 bytes seguida, en INSERTAR_PROCESO, del nombre del
+ * proceso; cada respuesta es una cabecera de 20 bytes seguida, si hubo
+ * error, del mensaje. Los campos viajan en el orden de bytes del
+ * anfitrin: el socket es local y ambos extremos corren en la misma
+ * mquina.
+ *
+ * Las respuestas llevan el id de su solicitud y pueden llegar en otro
+ * orden que las solicitudes, salvo entre solicitudes a una misma
+ * instancia, que se atienden y responden en el orden en que se enviaron.
+ */
+namespace ProtocoloRPC {
+
+/**
+ * Operaciones: cada una corresponde a un mtodo de Simulador.
+ */
+enum Operacion {
+    PING,              // Sin instancia; responde de inmediato
+    CREAR_INSTANCIA,   // a = bloques de memoria, b = marcos (0 = por defecto; hay mximos)
+    DESTRUIR_INSTANCIA,
+    INSERTAR_PROCESO,  // a = ID, b = prioridad, nombre a continuacin
+    ELIMINAR_PROCESO,  // a = ID; valor 0 = bloques liberados
+    ENCOLAR,           // a = ID
+    DESPACHAR,         // valor 0 = ID despachado
+    BLOQUEAR,          // a = ticks; valor 0 = ID bloqueado
+    DESBLOQUEAR,       // a = ID
+    TERMINAR,          // valor 0 = ID terminado
+    AVANZAR_TIEMPO,    // a = ticks; valor 0 = procesos despertados
+    CAMBIAR_PRIORIDAD, // a = ID, b = prioridad
+    ASIGNAR_MEMORIA,   // a = ID dueo, b = direccin
+    CONSULTAR_ESTADO,  // valor 0 = procesos, valor 1 = listos
+    NUM_OPERACIONES
+};
+
+/**
+ * Resultado de una solicitud.
+ */
+enum Estado {
+    OK,
+    ERROR_OPERACION,    // El simulador rechaz la operacin (mensaje adjunto)
+    SIN_INSTANCIA,      // La instancia no existe
+    SOLICITUD_INVALIDA  // Operacin desconocida o mensaje mal formado
+};
+
+struct Solicitud {
+    uint32_t longitud;  // Bytes del mensaje, cabecera incluida
+    uint32_t id;        // Elegido por el cliente; vuelve en la respuesta
+    uint32_t instancia; // Simulador destino
+    uint16_t operacion;
+    uint16_t reservado;
+    int32_t a;
+    int32_t b;
+};
+
+struct Respuesta {
+    uint32_t longitud;  // Bytes del mensaje, cabecera incluida
+    uint32_t id;        // Id de la solicitud
+    int32_t estado;
+    int32_t valores[2];
+};
+
+static_assert(sizeof(Solicitud) == 24, "Solicitud debe ocupar 24 bytes");
+static_assert(sizeof(Respuesta) == 20, "Respuesta debe ocupar 20 bytes");
+
+/**
+ * Lmite de un mensaje: un mensaje ms largo es un error de protocolo
+ * y cierra la conexin.
+ */
+const uint32_t LONGITUD_MAXIMA = 4096;
+
+/**
+ * Ruta del socket por defecto.
+ */
+const char* const SOCKET_DEFECTO = "/tmp/simulador_so.sock";
+
+/**
+ * Agrega una solicitud al final de un bfer de salida.
+ */
+inline void escribirSolicitud(std::string& salida, uint32_t id, uint32_t instancia,
+                              Operacion operacion, int32_t a = 0, int32_t b = 0,
+                              const std::string& nombre = std::string()) {
+    Solicitud s;
+    s.longitud = (uint32_t)(sizeof(Solicitud) + nombre.size());
+    s.id = id;
+    s.instancia = instancia;
+    s.operacion = (uint16_t)operacion;
+    s.reservado = 0;
+    s.a = a;
+    s.b = b;
+    salida.append((const char*)&s, sizeof(s));
+    salida.append(nombre);
+}
+
+/**
+ * Agrega una respuesta al final de un bfer de salida.
+ */
+inline void escribirRespuesta(std::string& salida, uint32_t id, Estado estado,
+                              int32_t valor0 = 0, int32_t valor1 = 0,
+                              const std::string& error = std::string()) {
+    Respuesta r;
+    std::string::size_type largo = error.size();
+    if (sizeof(Respuesta) + largo > LONGITUD_MAXIMA) largo = LONGITUD_MAXIMA - sizeof(Respuesta);
+    r.longitud = (uint32_t)(sizeof(Respuesta) + largo);
+    r.id = id;
+    r.estado = estado;
+    r.valores[0] = valor0;
+    r.valores[1] = valor1;
+    salida.append((const char*)&r, sizeof(r));
+    salida.append(error, 0, largo);
+}
+
+/**
+ * Longitud del mensaje que empieza en datos, o 0 si an no llegaron los
+ * 4 bytes que la indican.
+ */
+inline uint32_t longitudMensaje(const char* datos, size_t disponibles) {
+    if (disponibles < sizeof(uint32_t)) return 0;
+    uint32_t longitud;
+    std::memcpy(&longitud, datos, sizeof(longitud));
+    return longitud;
+}
+
+} // namespace ProtocoloRPC
+
+#endif // PROTOCOLO_RPC_H
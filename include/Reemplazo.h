@@ -0,0 +1,248 @@
+#ifndef REEMPLAZO_H
+#define REEMPLAZO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "TablaHash.h"
+
+/* ================================================================
+ *                   REEMPLAZO DE PGINAS
+ * ================================================================ */
+/**
+ * Algoritmos de reemplazo intercambiables. Cada algoritmo administra un
+ * conjunto residente de `capacidad` pginas identificadas por una clave
+ * de 64 bits ((pid << 32) | pgina virtual) y decide qu pgina desalojar
+ * cuando llega un fallo con la memoria llena. Todas las estructuras se
+ * dimensionan al construir: la memoria usada depende del nmero de
+ * marcos, no de la longitud de la traza.
+ */
+class AlgoritmoReemplazo {
+protected:
+    size_t capacidad;
+    uint64_t accesos;
+    uint64_t fallos;
+    uint64_t desalojos;
+
+    /**
+     * Procesa una referencia.
+     * @param clave Pgina referenciada
+     * @param victima Recibe la pgina desalojada, o SIN_VICTIMA
+     * @return true si la referencia fue un fallo de pgina
+     */
+    virtual bool acceder(uint64_t clave, uint64_t& victima) = 0;
+
+public:
+    static const uint64_t SIN_VICTIMA = ~0ull;
+
+    explicit AlgoritmoReemplazo(size_t capacidad);
+    virtual ~AlgoritmoReemplazo();
+
+    /**
+     * Referencia una pgina y actualiza las estadsticas.
+     * @return true si fue un fallo de pgina
+     */
+    bool referenciar(uint64_t clave, uint64_t& victima) {
+        victima = SIN_VICTIMA;
+        accesos++;
+        bool fallo = acceder(clave, victima);
+        fallos += fallo;
+        desalojos += (victima != SIN_VICTIMA);
+        return fallo;
+    }
+
+    /**
+     * Saca una pgina del conjunto residente sin contarla como desalojo
+     * (por ejemplo, al terminar su proceso).
+     */
+    virtual void eliminar(uint64_t clave) = 0;
+
+    virtual const char* nombre() const = 0;
+    virtual size_t residentes() const = 0;
+
+    size_t getCapacidad() const { return capacidad; }
+    uint64_t getAccesos() const { return accesos; }
+    uint64_t getFallos() const { return fallos; }
+    uint64_t getDesalojos() const { return desalojos; }
+    double tasaFallos() const { return accesos ? (double)fallos / (double)accesos : 0.0; }
+
+private:
+    AlgoritmoReemplazo(const AlgoritmoReemplazo&);
+    AlgoritmoReemplazo& operator=(const AlgoritmoReemplazo&);
+};
+
+/**
+ * Enlaces de una lista doblemente enlazada intrusiva sobre ndices.
+ */
+struct Enlace {
+    uint32_t ant;
+    uint32_t sig;
+};
+
+/**
+ * Lista intrusiva cuyos nodos son posiciones de un arreglo de Enlace.
+ * El frente es el elemento ms reciente (MRU), el final el ms antiguo.
+ */
+class ListaIntrusiva {
+public:
+    static const uint32_t NIL = ~0u;
+
+    uint32_t frente;
+    uint32_t final;
+    size_t tam;
+
+    ListaIntrusiva() : frente(NIL), final(NIL), tam(0) {}
+
+    void insertarFrente(std::vector<Enlace>& e, uint32_t i) {
+        e[i].ant = NIL;
+        e[i].sig = frente;
+        if (frente != NIL) e[frente].ant = i; else final = i;
+        frente = i;
+        tam++;
+    }
+
+    void quitar(std::vector<Enlace>& e, uint32_t i) {
+        if (e[i].ant != NIL) e[e[i].ant].sig = e[i].sig; else frente = e[i].sig;
+        if (e[i].sig != NIL) e[e[i].sig].ant = e[i].ant; else final = e[i].ant;
+        tam--;
+    }
+};
+
+/**
+ * FIFO: desaloja la pgina que lleva ms tiempo residente.
+ */
+class ReemplazoFIFO : public AlgoritmoReemplazo {
+private:
+    std::vector<uint64_t> anillo; // Pginas en orden de llegada
+    size_t cabeza;                // Prxima vctima
+    size_t ocupados;
+    TablaHash residentesHash;
+
+protected:
+    bool acceder(uint64_t clave, uint64_t& victima);
+
+public:
+    explicit ReemplazoFIFO(size_t capacidad);
+    void eliminar(uint64_t clave);
+    const char* nombre() const { return "FIFO"; }
+    size_t residentes() const { return ocupados; }
+};
+
+/**
+ * LRU exacto: tabla hash + lista intrusiva ordenada por recencia.
+ */
+class ReemplazoLRU : public AlgoritmoReemplazo {
+private:
+    std::vector<uint64_t> claves;
+    std::vector<Enlace> enlaces;
+    std::vector<uint32_t> libres;
+    ListaIntrusiva lista;
+    TablaHash indice;
+
+protected:
+    bool acceder(uint64_t clave, uint64_t& victima);
+
+public:
+    explicit ReemplazoLRU(size_t capacidad);
+    void eliminar(uint64_t clave);
+    const char* nombre() const { return "LRU"; }
+    size_t residentes() const { return lista.tam; }
+};
+
+/**
+ * Clock (segunda oportunidad): bit de referencia y manecilla circular.
+ */
+class ReemplazoClock : public AlgoritmoReemplazo {
+private:
+    std::vector<uint64_t> claves;   // TablaHash::VACIA = marco libre
+    std::vector<uint8_t> referencia;
+    std::vector<uint32_t> libres;
+    size_t manecilla;
+    TablaHash indice;
+
+protected:
+    bool acceder(uint64_t clave, uint64_t& victima);
+
+public:
+    explicit ReemplazoClock(size_t capacidad);
+    void eliminar(uint64_t clave);
+    const char* nombre() const { return "Clock"; }
+    size_t residentes() const { return indice.size(); }
+};
+
+/**
+ * LFU en O(1): lista de nodos de frecuencia ordenada, cada uno con la
+ * lista de sus pginas; los empates se rompen por LRU.
+ */
+class ReemplazoLFU : public AlgoritmoReemplazo {
+private:
+    struct NodoFrecuencia {
+        uint64_t frecuencia;
+        ListaIntrusiva paginas;
+    };
+
+    std::vector<uint64_t> claves;      // Por pgina
+    std::vector<uint32_t> nodoDe;      // Nodo de frecuencia de cada pgina
+    std::vector<Enlace> enlacesPagina;
+    std::vector<uint32_t> paginasLibres;
+
+    std::vector<NodoFrecuencia> nodos; // Por nodo de frecuencia
+    std::vector<Enlace> enlacesNodo;
+    std::vector<uint32_t> nodosLibres;
+    ListaIntrusiva frecuencias;        // Ascendente: frente = menor frecuencia
+
+    TablaHash indice;
+
+    uint32_t nuevoNodo(uint64_t frecuencia, uint32_t despuesDe);
+    void quitarPagina(uint32_t pagina);
+
+protected:
+    bool acceder(uint64_t clave, uint64_t& victima);
+
+public:
+    explicit ReemplazoLFU(size_t capacidad);
+    void eliminar(uint64_t clave);
+    const char* nombre() const { return "LFU"; }
+    size_t residentes() const { return indice.size(); }
+};
+
+/**
+ * ARC (Adaptive Replacement Cache, Megiddo y Modha): equilibra recencia
+ * (T1) y frecuencia (T2) con listas fantasma B1/B2 de pginas ya
+ * desalojadas que ajustan el objetivo p.
+ */
+class ReemplazoARC : public AlgoritmoReemplazo {
+private:
+    enum { T1, T2, B1, B2, NUM_LISTAS };
+
+    std::vector<uint64_t> claves;
+    std::vector<uint8_t> listaDe;
+    std::vector<Enlace> enlaces;
+    std::vector<uint32_t> libres;
+    ListaIntrusiva listas[NUM_LISTAS];
+    size_t p; // Tamao objetivo de T1
+    TablaHash indice;
+
+    void mover(uint32_t i, int destino);
+    void borrarFinal(int lista);
+    void reemplazar(bool enB2, uint64_t& victima);
+
+protected:
+    bool acceder(uint64_t clave, uint64_t& victima);
+
+public:
+    explicit ReemplazoARC(size_t capacidad);
+    void eliminar(uint64_t clave);
+    const char* nombre() const { return "ARC"; }
+    size_t residentes() const { return listas[T1].tam + listas[T2].tam; }
+};
+
+/**
+ * Crea un algoritmo por nombre (fifo, lru, clock, lfu, arc).
+ * @throws runtime_error Si el nombre no es conocido
+ */
+AlgoritmoReemplazo* crearAlgoritmoReemplazo(const std::string& nombre, size_t capacidad);
+
+#endif // REEMPLAZO_H
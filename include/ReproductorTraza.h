@@ -0,0 +1,70 @@
+#ifndef REPRODUCTOR_TRAZA_H
+#define REPRODUCTOR_TRAZA_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Traza.h"
+
+class ListaProcesso;
+class PilaMemoria;
+
+/* ================================================================
+ *                   REPRODUCTOR DE TRAZAS
+ * ================================================================ */
+/**
+ * Vuelve a ejecutar una traza de operaciones (ver Traza) sobre
+ * estructuras nuevas, sin esperas, y compara cada resultado con el
+ * grabado: una divergencia indica que el comportamiento cambi respecto
+ * de la versin que grab la traza.
+ *
+ * Las listas se crean sin archivo de persistencia y cada cola usa sus
+ * propios nodos de proceso, creados la primera vez que se encola su ID.
+ */
+class ReproductorTraza {
+private:
+    struct ColaReproducida;
+
+    std::unordered_map<uint32_t, ListaProcesso*> listas;
+    std::unordered_map<uint32_t, ColaReproducida*> colas;
+    std::unordered_map<uint32_t, PilaMemoria*> pilas;
+    uint64_t aplicados;
+    uint64_t divergencias;
+    std::string primeraDivergencia;
+    uint64_t porOperacion[Traza::NUM_OPERACIONES];
+
+public:
+    ReproductorTraza();
+    ~ReproductorTraza();
+
+    /**
+     * Aplica un evento de la traza.
+     * @param textos Textos de la traza a la que pertenece el evento
+     */
+    void aplicar(const Traza::Evento& e, const std::vector<std::string>& textos);
+
+    /**
+     * Aplica todos los eventos de una traza, en orden.
+     */
+    void reproducir(const Traza::TrazaCargada& traza);
+
+    /**
+     * Destruye todas las estructuras y pone a cero los contadores.
+     */
+    void reiniciar();
+
+    uint64_t getAplicados() const { return aplicados; }
+    uint64_t getDivergencias() const { return divergencias; }
+    const std::string& getPrimeraDivergencia() const { return primeraDivergencia; }
+    uint64_t getPorOperacion(Traza::Operacion op) const { return porOperacion[op]; }
+
+private:
+    void divergir(const Traza::Evento& e, const std::string& detalle);
+
+    ReproductorTraza(const ReproductorTraza&);
+    ReproductorTraza& operator=(const ReproductorTraza&);
+};
+
+#endif // REPRODUCTOR_TRAZA_H
@@ -0,0 +1,130 @@
+#ifndef RUEDA_TEMPORIZADORES_H
+#define RUEDA_TEMPORIZADORES_H
+
+#include <cstddef>
+#include <cstdint>
+
+/* ================================================================
+ *                   RUEDA JERRQUICA DE TEMPORIZADORES
+ * ================================================================ */
+/**
+ * Temporizador intrusivo: vive dentro del objeto que espera (p. ej. un
+ * NodoProcesso), as programar y cancelar no reservan memoria.
+ */
+struct Temporizador {
+    uint64_t expira;    // Tick absoluto de vencimiento
+    Temporizador* ant;  // Enlaces en la ranura (NULL si no est programado)
+    Temporizador* sig;
+    void* dueno;        // Objeto que contiene al temporizador
+
+    explicit Temporizador(void* dueno = NULL) : expira(0), ant(NULL), sig(NULL), dueno(dueno) {}
+
+    bool programado() const { return sig != NULL; }
+};
+
+/**
+ * Rueda jerrquica de temporizadores (Varghese y Lauck): 4 niveles de
+ * 64 ranuras cubren 2^24 ticks; los vencimientos ms lejanos esperan en
+ * una lista de desborde que se revisa una vez por vuelta completa.
+ *
+ * Programar y cancelar son O(1). Cada tick dispara una ranura y, al
+ * completar la vuelta de un nivel, redistribuye una ranura del nivel
+ * superior; cada temporizador baja a lo sumo una vez por nivel.
+ */
+class RuedaTemporizadores {
+public:
+    static const int BITS_NIVEL = 6;
+    static const int RANURAS = 1 << BITS_NIVEL;
+    static const int NIVELES = 4;
+    static const uint64_t ALCANCE = 1ull << (BITS_NIVEL * NIVELES);
+
+private:
+    Temporizador ranuras[NIVELES][RANURAS]; // Centinelas de listas circulares
+    Temporizador desborde;                  // Vencimientos ms all de ALCANCE
+    uint64_t ahora;                         // Tick actual
+    size_t activos;                         // Temporizadores programados
+
+public:
+    RuedaTemporizadores();
+
+    /**
+     * Programa (o reprograma) un temporizador. Un vencimiento que ya pas
+     * dispara en el siguiente tick.
+     * @param t Temporizador a programar
+     * @param expira Tick absoluto de vencimiento
+     */
+    void programar(Temporizador* t, uint64_t expira);
+
+    /**
+     * Cancela un temporizador si estaba programado.
+     * @return true si estaba programado
+     */
+    bool cancelar(Temporizador* t);
+
+    /**
+     * Avanza el tiempo y llama a f(Temporizador*) por cada vencimiento,
+     * en orden de tick. f puede volver a programar el temporizador.
+     * @param ticks Ticks a avanzar
+     * @return Nmero de temporizadores disparados
+     */
+    template <typename F>
+    size_t avanzar(uint64_t ticks, F f) {
+        uint64_t destino = ahora + ticks;
+        size_t disparados = 0;
+        while (ahora < destino) {
+            if (activos == 0) {
+                // Nada pendiente: se salta directamente al destino
+                ahora = destino;
+                break;
+            }
+            ahora++;
+            redistribuir();
+            Temporizador vencidos;
+            vencidos.ant = vencidos.sig = &vencidos;
+            trasladar(&ranuras[0][ahora & (RANURAS - 1)], &vencidos);
+            while (vencidos.sig != &vencidos) {
+                Temporizador* t = vencidos.sig;
+                desenlazar(t);
+                activos--;
+                disparados++;
+                f(t);
+            }
+        }
+        return disparados;
+    }
+
+    /**
+     * Descarta todos los temporizadores y fija el tiempo actual.
+     */
+    void reiniciar(uint64_t tiempo);
+
+    uint64_t getAhora() const { return ahora; }
+    size_t getActivos() const { return activos; }
+
+private:
+    void insertar(Temporizador* t);
+    void redistribuir();
+
+    static void enlazar(Temporizador* lista, Temporizador* t) {
+        t->sig = lista;
+        t->ant = lista->ant;
+        lista->ant->sig = t;
+        lista->ant = t;
+    }
+
+    static void desenlazar(Temporizador* t) {
+        t->ant->sig = t->sig;
+        t->sig->ant = t->ant;
+        t->ant = t->sig = NULL;
+    }
+
+    /**
+     * Mueve todos los elementos de una lista a otra (vaca) en O(1).
+     */
+    static void trasladar(Temporizador* origen, Temporizador* destino);
+
+    RuedaTemporizadores(const RuedaTemporizadores&);
+    RuedaTemporizadores& operator=(const RuedaTemporizadores&);
+};
+
+#endif // RUEDA_TEMPORIZADORES_H
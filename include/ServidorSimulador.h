@@ -0,0 +1,98 @@
+#ifndef SERVIDOR_SIMULADOR_H
+#define SERVIDOR_SIMULADOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* ================================================================
+ *                   SERVIDOR DE SIMULADORES
+ * ================================================================ */
+/**
+ * Aloja muchas instancias independientes de Simulador y las atiende por
+ * un socket Unix con el protocolo binario de ProtocoloRPC.
+ *
+ * Las instancias se reparten en fragmentos, uno por hilo: la instancia i
+ * vive en el fragmento i % hilos y solo ese hilo la toca, as que los
+ * simuladores no necesitan cerrojos. Cada fragmento tiene su propio
+ * epoll, acepta conexiones del socket compartido y atiende directamente
+ * las solicitudes a sus instancias; las de otro fragmento se le envan
+ * por su buzn (cola con cerrojo ms un eventfd que lo despierta) y la
+ * respuesta vuelve por el buzn del fragmento de la conexin. Los envos
+ * entre buzones y las escrituras al socket se agrupan por vuelta del
+ * bucle de eventos.
+ */
+class ServidorSimulador {
+public:
+    /**
+     * Bloques de memoria y marcos de una instancia cuando la solicitud
+     * de creacin no los indica.
+     */
+    static const int BLOQUES_DEFECTO = 1024;
+    static const int MARCOS_DEFECTO = 256;
+
+    /**
+     * Lmites de creacin: los clientes no se autentican, as que una
+     * solicitud que pida ms bloques o marcos se rechaza con
+     * SOLICITUD_INVALIDA, y un fragmento con INSTANCIAS_POR_FRAGMENTO
+     * instancias no crea ms hasta que se destruya alguna.
+     */
+    static const int BLOQUES_MAXIMOS = 1 << 16;
+    static const int MARCOS_MAXIMOS = 1 << 14;
+    static const unsigned INSTANCIAS_POR_FRAGMENTO = 1024;
+
+    /**
+     * Crea el socket y los fragmentos (an no atiende).
+     * @param ruta Ruta del socket Unix (se reemplaza si qued de antes)
+     * @param hilos Fragmentos; 0 = uno por ncleo
+     * @throws runtime_error Si no se puede crear el socket o el sistema
+     *         no es Linux (requiere epoll y eventfd)
+     */
+    explicit ServidorSimulador(const std::string& ruta, unsigned hilos = 0);
+
+    /**
+     * Detiene los hilos si siguen corriendo, cierra las conexiones,
+     * destruye las instancias y borra el socket.
+     */
+    ~ServidorSimulador();
+
+    /**
+     * Atiende hasta que se llame a detener().
+     */
+    void ejecutar();
+
+    /**
+     * Pide a los hilos que terminen. Es seguro llamarla desde un
+     * manejador de seales.
+     */
+    void detener();
+
+    unsigned getHilos() const { return (unsigned)fragmentos.size(); }
+    const std::string& getRuta() const { return ruta; }
+
+private:
+    struct Conexion;
+    struct Mensaje;
+    struct Fragmento;
+
+    std::string ruta;
+    int escucha;                       // Socket de escucha, compartido por los fragmentos
+    std::atomic<bool> parar;
+    std::vector<Fragmento*> fragmentos;
+
+    void bucle(Fragmento& f);
+    void aceptar(Fragmento& f);
+    void leer(Fragmento& f, Conexion* c);
+    void atender(Fragmento& f, Conexion* c, const char* datos, uint32_t longitud);
+    void resolver(Fragmento& f, const char* datos, uint32_t longitud, std::string& salida);
+    void recibirBuzon(Fragmento& f);
+    void enviarBuzones(Fragmento& f);
+    bool escribir(Fragmento& f, Conexion* c);
+    void cerrar(Fragmento& f, Conexion* c);
+
+    ServidorSimulador(const ServidorSimulador&);
+    ServidorSimulador& operator=(const ServidorSimulador&);
+};
+
+#endif // SERVIDOR_SIMULADOR_H
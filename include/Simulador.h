@@ -0,0 +1,308 @@
+#ifndef SIMULADOR_H
+#define SIMULADOR_H
+
+#include <cstdint>
+#include <string>
+
+#include "ArbolProcesos.h"
+#include "ColaPrioridad.h"
+#include "GuardadoFondo.h"
+#include "LineaTiempo.h"
+#include "ListaProcesso.h"
+#include "MemoriaVirtual.h"
+#include "PilaMemoria.h"
+#include "RuedaTemporizadores.h"
+
+/**
+ * Resultado de correr un quantum.
+ */
+struct ResultadoQuantum {
+    int id;                        // Proceso que ocup la CPU
+    CuerpoProceso::Motivo motivo;  // Cmo la dej
+    uint64_t usadas;               // Unidades de CPU (ticks) consumidas
+    uint64_t valor;                // Valor de co_return si termin
+};
+
+/* ================================================================
+ *                   SIMULADOR (FACHADA DEL SISTEMA)
+ * ================================================================ */
+/**
+ * Agrupa los subsistemas de una instancia del sistema operativo simulado
+ * (tabla de procesos, planificador, memoria y memoria virtual) y coordina
+ * las operaciones que afectan a varios de ellos a la vez.
+ *
+ * Tambin lleva el ciclo de vida de los procesos en una CPU:
+ * NUEVO -> LISTO -> EJECUCION -> (BLOQUEADO -> LISTO) -> TERMINADO.
+ * Los listos esperan en la cola de prioridad; los bloqueados con plazo
+ * esperan en una rueda de temporizadores que los despierta en O(1).
+ * Los procesos con cuerpo (CuerpoProceso) ejecutan cdigo de verdad:
+ * ejecutarQuantum() lo reanuda y aplica la transicin que pida.
+ *
+ * Los procesos creados con clonarProceso() forman un rbol (ArbolProcesos)
+ * que se guarda junto a la tabla; los que se insertan directamente en
+ * la tabla cuelgan de init. Al eliminar un proceso sus hijos pasan a
+ * init, y eliminarSubarbol() se lleva tambin a sus descendientes.
+ *
+ * Con la lnea de tiempo activa, cada salida de la CPU registra el tramo
+ * que el proceso pas en ella (diagrama de Gantt de la ejecucin).
+ *
+ * Tareas de tiempo real (NodoProcesso::tiempoReal): al encolarla se
+ * activa su primer trabajo. Cada quantum le da a lo sumo lo que le falta
+ * al trabajo; al completarlo se anota si cumpli el plazo y la tarea se
+ * bloquea hasta su prxima activacin (la rueda de temporizadores la
+ * despierta con el trabajo siguiente ya activado). Si la prxima
+ * activacin ya pas, sigue lista con el trabajo atrasado. Con EDF o
+ * Rate Monotonic la expropiacin ocurre al final de cada quantum.
+ */
+class Simulador {
+private:
+    ListaProcesso procesos;        // Tabla de procesos
+    ArbolProcesos arbol;           // Quin clon a quin (se destruye antes que la tabla)
+    ColaPrioridad planificador;    // Cola de listos
+    PilaMemoria memoria;           // Bloques de memoria con dueo
+    MemoriaVirtual memoriaVirtual; // Paginacin
+    RuedaTemporizadores temporizadores; // Despertares de bloqueados (tiempo simulado)
+    NodoProcesso* enEjecucion;     // Proceso en la CPU (o NULL)
+    int bloqueados;                // Procesos en estado BLOQUEADO
+    uint64_t inicioEjecucion;      // Tick en que enEjecucion entr a la CPU
+    EstadisticasTiempoReal plazos; // Trabajos de tiempo real completados y perdidos
+    LineaTiempo lineaTiempo;       // Tramos de CPU (inactiva por defecto)
+    GuardadoFondo guardado;        // Guardado en curso (se destruye primero: espera al hijo)
+
+    friend class Instantanea;
+
+public:
+    /**
+     * @param archivoProcesos Archivo de persistencia ("" = solo en memoria); si
+     *        lo hay, el rbol de procesos usa ArbolProcesos::ARCHIVO_ARBOL
+     * @param capacidadMemoria Bloques de la pila de memoria
+     * @param marcos Marcos fsicos de la memoria virtual (con reemplazo LRU)
+     */
+    explicit Simulador(const std::string& archivoProcesos = ListaProcesso::ARCHIVO_PROCESOS,
+                       int capacidadMemoria = 3, uint32_t marcos = 256);
+
+    /**
+     * Asigna un bloque de memoria a nombre de un proceso.
+     * @param pid Proceso dueo (PilaMemoria::SIN_DUENO para el sistema)
+     * @param direccion Direccin del bloque
+     * @return Manija del bloque (su direccin puede cambiar al compactar)
+     * @throws runtime_error Si el proceso no existe o la memoria est llena
+     */
+    PilaMemoria::Manija asignarMemoria(int pid, int direccion);
+
+    /**
+     * Elimina un proceso y todo lo que posee: lo saca de la cola de
+     * listos (O(log n)), libera sus bloques de memoria (O(bloques propios))
+     * y su espacio de direcciones virtual. Sus hijos pasan a colgar de init.
+     * @param id Identificador del proceso
+     * @return Nmero de bloques de memoria liberados
+     * @throws runtime_error Si el proceso no existe
+     */
+    int eliminarProceso(int id);
+
+    /**
+     * Crea un proceso hijo (fork): clona el nombre y la prioridad del
+     * padre y lo cuelga de l en el rbol. El hijo queda NUEVO, sin
+     * cuerpo, memoria ni espacio de direcciones, y es un proceso comn
+     * aunque el padre sea una tarea de tiempo real.
+     * @return Proceso hijo
+     * @throws runtime_error Si el padre no existe o ya termin, o el ID
+     *         del hijo ya existe
+     */
+    NodoProcesso* clonarProceso(int padre, int hijo);
+
+    /**
+     * Elimina un proceso y todos sus descendientes, cada uno como en
+     * eliminarProceso(). El subrbol se recorre en O(su tamao); la
+     * memoria de todos se libera en un solo lote y la tabla se recorre
+     * una sola vez.
+     * @param bloques Si no es NULL, recibe los bloques de memoria liberados
+     * @return Procesos eliminados
+     * @throws runtime_error Si el proceso no existe
+     */
+    size_t eliminarSubarbol(int id, int* bloques = NULL);
+
+    /**
+     * Descendientes de un proceso, en O(tamao del subrbol).
+     * @throws runtime_error Si el proceso no existe
+     */
+    size_t contarDescendientes(int id);
+
+    /**
+     * Cuelga un proceso (con sus descendientes) de init.
+     * @throws runtime_error Si el proceso no existe
+     */
+    void reparentarAInit(int id);
+
+    /**
+     * Padre de un proceso (ArbolProcesos::INIT si no tiene).
+     * @throws runtime_error Si el proceso no existe
+     */
+    int padreDe(int id);
+
+    /**
+     * Cambia la prioridad de un proceso manteniendo coherente la cola de
+     * listos si est encolado.
+     * @throws runtime_error Si el proceso no existe o la prioridad es invlida
+     */
+    void cambiarPrioridad(int id, int prioridad);
+
+    /**
+     * Admite un proceso nuevo en la cola de listos.
+     * @throws runtime_error Si no existe o no est en estado NUEVO
+     */
+    void encolar(int id);
+
+    /**
+     * Saca un proceso de la cola de listos y lo devuelve a NUEVO.
+     * @return true si estaba en la cola
+     */
+    bool retirarDeCola(int id);
+
+    /**
+     * Pone en la CPU al proceso de mayor prioridad. Si haba uno en
+     * ejecucin, vuelve a la cola de listos (expropiacin).
+     * @return Proceso que pasa a ejecucin
+     * @throws runtime_error Si no hay procesos listos
+     */
+    NodoProcesso* despachar();
+
+    /**
+     * Bloquea al proceso en ejecucin (una tarea de tiempo real con su
+     * trabajo sin terminar lo retoma al despertar).
+     * @param ticks Plazo tras el que despierta solo; 0 espera a desbloquear()
+     * @return Proceso bloqueado
+     * @throws runtime_error Si la CPU est libre
+     */
+    NodoProcesso* bloquear(uint64_t ticks);
+
+    /**
+     * Despierta un proceso bloqueado (fin de E/S) y lo pasa a listos.
+     * @throws runtime_error Si no existe o no est bloqueado, o si es una
+     *         tarea de tiempo real que espera su prxima activacin
+     */
+    void desbloquear(int id);
+
+    /**
+     * Termina el proceso en ejecucin y libera sus recursos; su entrada
+     * queda en la tabla como TERMINADO hasta que se elimine.
+     * @return Proceso terminado
+     * @throws runtime_error Si la CPU est libre
+     */
+    NodoProcesso* terminar();
+
+    /**
+     * Activa un trabajo de una tarea espordica que espera su activacin.
+     * Si no pas todava el periodo mnimo desde la anterior, la
+     * activacin se difiere hasta entonces.
+     * @return true si el trabajo qued listo ya, false si se difiri
+     * @throws runtime_error Si no es una tarea espordica, su trabajo
+     *         anterior no termin o ya tiene una activacin diferida
+     */
+    bool activarEsporadica(int id);
+
+    /**
+     * Elige la poltica de la cola de listos y la cota del control de
+     * admisin de las tareas que se creen desde ahora.
+     */
+    void setPolitica(PoliticaPlanificacion politica);
+    PoliticaPlanificacion getPolitica() const { return planificador.getPolitica(); }
+
+    /**
+     * Trabajos de tiempo real completados, perdidos y vencidos (estos
+     * ltimos se cuentan recorriendo la tabla: O(n)).
+     */
+    EstadisticasTiempoReal estadisticasTiempoReal() const;
+
+    /**
+     * Le da cdigo a un proceso (reemplaza el que tuviera).
+     * @throws runtime_error Si no existe o ya termin
+     */
+    void asignarCuerpo(int id, CuerpoProceso cuerpo);
+
+    /**
+     * Da la CPU por un quantum: despacha si est libre, reanuda el cuerpo
+     * del proceso en ejecucin y aplica el resultado: al ceder o agotar
+     * el quantum vuelve a listos, al pedir E/S se bloquea con ese plazo y
+     * al terminar se liberan sus recursos. Un proceso sin cuerpo consume
+     * el quantum entero. El reloj avanza las unidades consumidas.
+     * @param quantum Unidades de CPU (> 0)
+     * @throws runtime_error Si no hay procesos listos, o si el cuerpo
+     *         lanz una excepcin (el proceso queda terminado)
+     */
+    ResultadoQuantum ejecutarQuantum(uint64_t quantum);
+
+    /**
+     * Ejecuta quantums hasta que no queden listos ni bloqueados con plazo,
+     * o hasta agotar el lmite. Con la CPU ociosa y procesos dormidos, el
+     * reloj avanza de a un quantum.
+     * @return Quantums ejecutados
+     */
+    size_t correr(uint64_t quantum, size_t maxQuantums);
+
+    /**
+     * Avanza el tiempo simulado y pasa a listos a los bloqueados cuyo
+     * plazo venci.
+     * @return Nmero de procesos despertados
+     */
+    size_t avanzarTiempo(uint64_t ticks);
+
+    /**
+     * Guarda una instantnea completa sin detener el sistema: el
+     * estado se congela en este instante y se serializa en segundo plano.
+     * @return false si ya haba un guardado en curso
+     */
+    bool guardarInstantaneaEnSegundoPlano(const std::string& archivo);
+
+    /**
+     * Guarda la tabla de procesos (en su formato) en segundo plano.
+     * @return false si ya haba un guardado en curso
+     * @throws runtime_error Si la tabla no tiene archivo de persistencia
+     */
+    bool guardarProcesosEnSegundoPlano();
+
+    GuardadoFondo& getGuardado() { return guardado; }
+
+    /**
+     * Empieza a registrar la lnea de tiempo de la CPU, descartando la
+     * anterior.
+     * @param capacidad Tramos a reservar (0 = dejar de registrar)
+     * @param cpu Nmero de CPU con que se anotan los tramos
+     */
+    void activarLineaTiempo(size_t capacidad, uint16_t cpu = 0) { lineaTiempo.activar(capacidad, cpu); }
+
+    const LineaTiempo& getLineaTiempo() const { return lineaTiempo; }
+
+    NodoProcesso* getEnEjecucion() const { return enEjecucion; }
+    int contarBloqueados() const { return bloqueados; }
+    uint64_t getAhora() const { return temporizadores.getAhora(); }
+
+    ListaProcesso& getProcesos() { return procesos; }
+    const ArbolProcesos& getArbol() const { return arbol; }
+    ColaPrioridad& getPlanificador() { return planificador; }
+    PilaMemoria& getMemoria() { return memoria; }
+    MemoriaVirtual& getMemoriaVirtual() { return memoriaVirtual; }
+
+private:
+    NodoProcesso* buscar(int id);
+    void desalojar(NodoProcesso* proc);
+    void vaciar();
+    void ponerListo(NodoProcesso* proc);
+    void completarTrabajo(NodoProcesso* proc);
+
+    /**
+     * Anota en la lnea de tiempo el tramo del proceso en ejecucin, que
+     * deja la CPU ahora.
+     */
+    void salirDeCpu(LineaTiempo::Salida salida) {
+        if (lineaTiempo.activa()) {
+            lineaTiempo.registrar(enEjecucion->id, enEjecucion->nombre, inicioEjecucion,
+                                  temporizadores.getAhora(), salida);
+        }
+    }
+
+    Simulador(const Simulador&);
+    Simulador& operator=(const Simulador&);
+};
+
+#endif // SIMULADOR_H
@@ -0,0 +1,91 @@
+#ifndef TABLA_HASH_H
+#define TABLA_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* ================================================================
+ *                   TABLA HASH DE DIRECCIONAMIENTO ABIERTO
+ * ================================================================ */
+/**
+ * Mapa uint64 -> uint32 con sondeo lineal y borrado por desplazamiento
+ * hacia atrs (sin lpidas). La capacidad se fija al construir, as que
+ * nunca reserva memoria durante las operaciones.
+ */
+class TablaHash {
+private:
+    std::vector<uint64_t> claves;
+    std::vector<uint32_t> valores;
+    size_t mascara;
+    size_t elementos;
+
+public:
+    static constexpr uint64_t VACIA = ~0ull;
+
+    /**
+     * @param maxElementos Elementos mximos simultneos (carga <= 50%)
+     */
+    explicit TablaHash(size_t maxElementos) : elementos(0) {
+        size_t cap = 16;
+        while (cap < 2 * maxElementos) cap <<= 1;
+        claves.assign(cap, VACIA);
+        valores.assign(cap, 0);
+        mascara = cap - 1;
+    }
+
+    static uint64_t mezclar(uint64_t k) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdull;
+        k ^= k >> 33;
+        return k;
+    }
+
+    /**
+     * @return Puntero al valor asociado, o NULL si la clave no est
+     */
+    uint32_t* buscar(uint64_t clave) {
+        for (size_t i = mezclar(clave) & mascara;; i = (i + 1) & mascara) {
+            if (claves[i] == clave) return &valores[i];
+            if (claves[i] == VACIA) return NULL;
+        }
+    }
+
+    /**
+     * Inserta o actualiza una clave (no puede ser VACIA).
+     */
+    void insertar(uint64_t clave, uint32_t valor) {
+        size_t i = mezclar(clave) & mascara;
+        while (claves[i] != VACIA && claves[i] != clave) i = (i + 1) & mascara;
+        if (claves[i] == VACIA) elementos++;
+        claves[i] = clave;
+        valores[i] = valor;
+    }
+
+    /**
+     * Elimina una clave si existe.
+     */
+    void borrar(uint64_t clave) {
+        size_t i = mezclar(clave) & mascara;
+        while (claves[i] != clave) {
+            if (claves[i] == VACIA) return;
+            i = (i + 1) & mascara;
+        }
+        // Desplaza hacia atrs los elementos de la misma racha
+        for (size_t j = (i + 1) & mascara; claves[j] != VACIA; j = (j + 1) & mascara) {
+            size_t ideal = mezclar(claves[j]) & mascara;
+            bool mover = (i <= j) ? (ideal <= i || ideal > j) : (ideal <= i && ideal > j);
+            if (mover) {
+                claves[i] = claves[j];
+                valores[i] = valores[j];
+                i = j;
+            }
+        }
+        claves[i] = VACIA;
+        elementos--;
+    }
+
+    size_t size() const { return elementos; }
+};
+
+#endif // TABLA_HASH_H
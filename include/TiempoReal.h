@@ -0,0 +1,174 @@
+#ifndef TIEMPO_REAL_H
+#define TIEMPO_REAL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/* ================================================================
+ *                   PLANIFICACIN DE TIEMPO REAL
+ * ================================================================ */
+
+/**
+ * Criterio con que la cola de listos elige al siguiente proceso.
+ */
+enum PoliticaPlanificacion {
+    PLAN_PRIORIDAD,       // Prioridad esttica con envejecimiento
+    PLAN_EDF,             // Plazo absoluto ms prximo primero
+    PLAN_RATE_MONOTONIC   // Plazo relativo ms corto primero (= periodo si plazo == periodo)
+};
+
+const char* nombrePolitica(PoliticaPlanificacion politica);
+
+/**
+ * Tarea de tiempo real: cada 'periodo' ticks (o, si es espordica, como
+ * mucho una vez cada 'periodo' ticks) se activa un trabajo que necesita
+ * 'costo' ticks de CPU y debe terminar a ms tardar 'plazo' ticks despus
+ * de su activacin. Un trabajo que termina tarde cuenta como plazo
+ * perdido y se completa igual (tiempo real blando).
+ *
+ * Un proceso comn tiene periodo 0.
+ */
+struct TareaTiempoReal {
+    // Parmetros, en ticks simulados
+    uint64_t periodo;        // Entre activaciones (0 = no es de tiempo real)
+    uint64_t plazo;          // Relativo a la activacin, costo <= plazo <= periodo
+    uint64_t costo;          // CPU por trabajo (peor caso)
+    bool esporadica;         // Se activa con Simulador::activarEsporadica()
+    bool admitida;           // Suma en la utilizacin del control de admisin
+
+    // Trabajo en curso
+    uint64_t activacion;     // Tick de su activacin
+    uint64_t plazoAbsoluto;  // activacion + plazo
+    uint64_t restante;       // CPU que le falta (0 = esperando activacin)
+
+    // Historial
+    uint64_t trabajos;       // Trabajos completados
+    uint64_t perdidos;       // De ellos, terminados despus de su plazo
+
+    TareaTiempoReal()
+        : periodo(0), plazo(0), costo(0), esporadica(false), admitida(false), activacion(0),
+          plazoAbsoluto(0), restante(0), trabajos(0), perdidos(0) {}
+
+    /**
+     * @param plazo Plazo relativo (0 = igual al periodo)
+     */
+    TareaTiempoReal(uint64_t periodo, uint64_t costo, uint64_t plazo = 0, bool esporadica = false)
+        : periodo(periodo), plazo(plazo != 0 ? plazo : periodo), costo(costo),
+          esporadica(esporadica), admitida(false), activacion(0), plazoAbsoluto(0), restante(0),
+          trabajos(0), perdidos(0) {}
+
+    bool esTiempoReal() const { return periodo != 0; }
+    bool esperandoActivacion() const { return periodo != 0 && restante == 0; }
+
+    /**
+     * Empieza un trabajo activado en el tick dado.
+     */
+    void activar(uint64_t tick) {
+        activacion = tick;
+        plazoAbsoluto = tick + plazo;
+        restante = costo;
+    }
+};
+
+/**
+ * Contadores de plazos de un simulador.
+ */
+struct EstadisticasTiempoReal {
+    uint64_t completados;     // Trabajos terminados
+    uint64_t perdidos;        // Terminados despus de su plazo
+    uint64_t vencidos;        // Sin terminar y con el plazo ya pasado
+    uint64_t tardanzaMaxima;  // Mayor retraso de un trabajo terminado (ticks)
+    uint64_t tardanzaTotal;   // Suma de los retrasos
+
+    /**
+     * Fraccin de trabajos que no cumplieron su plazo, contando los
+     * vencidos sin terminar (0 si no hubo ninguno).
+     */
+    double tasaPerdidas() const {
+        uint64_t total = completados + vencidos;
+        return total == 0 ? 0.0 : (double)(perdidos + vencidos) / (double)total;
+    }
+};
+
+/* ================================================================
+ *                   CONTROL DE ADMISIN
+ * ================================================================ */
+/**
+ * Control de admisin por utilizacin: una tarea nueva se acepta solo
+ * si la suma de las densidades costo / plazo de las admitidas sigue
+ * dentro de la cota de la poltica:
+ *
+ * - EDF (y prioridad esttica): densidad total <= 1, exacta para EDF
+ *   cuando el plazo es igual al periodo.
+ * - Rate Monotonic: cota de Liu y Layland n (2^(1/n) - 1), suficiente
+ *   (tiende a ln 2 ~ 0.693 con muchas tareas). Con plazo < periodo la
+ *   prueba por densidad solo es suficiente si las prioridades siguen el
+ *   plazo relativo (Deadline Monotonic), as que PLAN_RATE_MONOTONIC
+ *   ordena por plazo; con plazo == periodo es Rate Monotonic clsico.
+ *
+ * Las densidades se suman en punto fijo (32 bits de fraccin, redondeo
+ * hacia arriba): admitir y retirar cuestan O(1) y la suma no acumula
+ * error con cientos de miles de tareas.
+ */
+class AdmisionTiempoReal {
+public:
+    /**
+     * Periodo mximo aceptado (ticks): mantiene exacta la densidad en
+     * punto fijo.
+     */
+    static const uint64_t PERIODO_MAXIMO = (1ull << 32) - 1;
+
+private:
+    PoliticaPlanificacion politica;
+    bool activa;         // false = se aceptan todas (para medir sobrecarga)
+    size_t tareas;       // Tareas admitidas
+    uint64_t densidad;   // Suma de densidades, en punto fijo
+
+public:
+    AdmisionTiempoReal();
+
+    /**
+     * Comprueba los parmetros de la tarea y la suma a la utilizacin.
+     * @throws runtime_error Si los parmetros son invlidos o, con el
+     *         control activo, la tarea no cabe
+     */
+    void admitir(TareaTiempoReal& tarea);
+
+    /**
+     * Quita de la utilizacin una tarea admitida (sin efecto si no lo est).
+     */
+    void retirar(TareaTiempoReal& tarea);
+
+    /**
+     * Suma una tarea ya marcada como admitida, sin comprobar la cota
+     * (al restaurar una instantnea).
+     */
+    void contar(const TareaTiempoReal& tarea);
+
+    void vaciar();
+
+    void setPolitica(PoliticaPlanificacion valor) { politica = valor; }
+    void setActiva(bool valor) { activa = valor; }
+    bool esActiva() const { return activa; }
+
+    size_t getTareas() const { return tareas; }
+
+    /**
+     * Densidad total de las tareas admitidas.
+     */
+    double getUtilizacion() const;
+
+    /**
+     * Cota de la poltica con 'n' tareas admitidas.
+     */
+    double cota(size_t n) const;
+
+private:
+    static uint64_t densidadDe(const TareaTiempoReal& tarea);
+    uint64_t cotaFija(size_t n) const;
+
+    AdmisionTiempoReal(const AdmisionTiempoReal&);
+    AdmisionTiempoReal& operator=(const AdmisionTiempoReal&);
+};
+
+#endif // TIEMPO_REAL_H
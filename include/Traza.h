@@ -0,0 +1,205 @@
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* ================================================================
+ *                   TRAZA DE OPERACIONES
+ * ================================================================ */
+/**
+ * Grabacin de todas las operaciones sobre ListaProcesso, ColaPrioridad
+ * y PilaMemoria en una traza binaria compacta, para reproducirlas
+ * despus de forma determinista (ver ReproductorTraza).
+ *
+ * Cada hilo escribe registros de tamao fijo en su propio anillo de
+ * bytes, sin cerrojos; un hilo de vaciado los recoge peridicamente y
+ * los escribe codificados (varints y tiempos delta) en el archivo.
+ * Si un anillo se llena, su hilo espera al vaciado: la traza nunca
+ * pierde registros.
+ *
+ * Cada estructura se anuncia en la traza la primera vez que se usa en
+ * una sesin: un registro *_CREAR seguido de las operaciones que
+ * reconstruyen su contenido actual. As la grabacin puede empezar en
+ * cualquier momento y la traza siempre se reproduce desde cero.
+ *
+ * Formato del archivo:
+ *
+ *     cabecera: "SOTRAZA" '\0', versin (u32), reservado (u32),
+ *               ticks por segundo (u64; se escribe al detener)
+ *     bloques:  hilo (u32), registros (u32), marca base (u64),
+ *               bytes (u32), reservado (u32), registros codificados
+ *
+ * Registro codificado: operacin (u8; bit 7 = lleva texto), objeto
+ * (varint), delta de la marca de tiempo (varint), a, b y resultado
+ * (varints zigzag) y, si lleva texto, su longitud (varint) y sus bytes.
+ * Las marcas son ciclos del TSC en x86 y ns en el resto.
+ *
+ * Con SO_TRAZA desactivado la grabacin no genera cdigo.
+ */
+namespace Traza {
+
+/**
+ * Operaciones grabadas. Los campos a, b y resultado de cada una:
+ *
+ *     LISTA_INSERTAR           a = id, b = prioridad, texto = nombre
+ *     LISTA_ELIMINAR           a = id
+ *     LISTA_BUSCAR             a = id, resultado = 1 si existe
+ *     COLA_ENCOLAR             a = id, b = prioridad
+ *     COLA_DESENCOLAR          resultado = id despachado
+ *     COLA_ELIMINAR            a = id, resultado = 1 si estaba
+ *     COLA_CAMBIAR_PRIORIDAD   a = id, b = prioridad, resultado = 1 si estaba
+ *     COLA_AVANZAR_RELOJ       a = ticks
+ *     COLA_PERIODO             b = ticks por punto de envejecimiento
+ *     COLA_POLITICA            b = PoliticaPlanificacion
+ *     COLA_PLAZOS              a = id, b = plazo relativo, resultado = plazo
+ *                              absoluto; antecede al COLA_ENCOLAR de un
+ *                              proceso de tiempo real
+ *     PILA_CREAR               b = capacidad
+ *     PILA_PUSH                a = direccin, b = pid
+ *     PILA_POP                 resultado = direccin
+ *     PILA_LIBERAR_PROCESO     b = pid, resultado = bloques liberados
+ *     PILA_REUBICAR            a = origen, b = destino, resultado = bloques movidos
+ */
+enum Operacion {
+    LISTA_CREAR,
+    LISTA_DESTRUIR,
+    LISTA_INSERTAR,
+    LISTA_ELIMINAR,
+    LISTA_BUSCAR,
+    LISTA_VACIAR,
+    COLA_CREAR,
+    COLA_DESTRUIR,
+    COLA_ENCOLAR,
+    COLA_DESENCOLAR,
+    COLA_ELIMINAR,
+    COLA_VACIAR,
+    COLA_CAMBIAR_PRIORIDAD,
+    COLA_AVANZAR_RELOJ,
+    COLA_PERIODO,
+    PILA_CREAR,
+    PILA_DESTRUIR,
+    PILA_PUSH,
+    PILA_POP,
+    PILA_LIBERAR_PROCESO,
+    PILA_VACIAR,
+    PILA_REUBICAR,
+    COLA_POLITICA,
+    COLA_PLAZOS,
+    NUM_OPERACIONES
+};
+
+/**
+ * Registro tal como queda en el anillo de un hilo (32 bytes), seguido
+ * de 'longitud' bytes de texto rellenados hasta mltiplo de 8.
+ */
+struct Registro {
+    uint64_t marca;     // Marca de tiempo desde el inicio de la sesin
+    int64_t a;
+    uint32_t objeto;    // Estructura sobre la que se oper
+    int32_t b;
+    int32_t resultado;
+    uint16_t longitud;  // Bytes de texto que siguen
+    uint8_t operacion;
+    uint8_t epoca;      // Sesin que lo escribi (descarta restos de otra)
+};
+
+/**
+ * Evento ledo de una traza.
+ */
+struct Evento {
+    uint64_t ns;        // Desde el inicio de la sesin
+    int64_t a;
+    uint32_t objeto;
+    int32_t b;
+    int32_t resultado;
+    int32_t texto;      // ndice en TrazaCargada::textos, o -1
+    uint16_t hilo;
+    uint8_t operacion;
+};
+
+/**
+ * Traza completa en memoria, ordenada por tiempo.
+ */
+struct TrazaCargada {
+    std::vector<Evento> eventos;
+    std::vector<std::string> textos;
+    uint32_t hilos;
+};
+
+/**
+ * Estadsticas de la sesin de grabacin actual (o la ltima).
+ */
+struct EstadisticasTraza {
+    uint64_t registros;  // Registros escritos en el archivo
+    uint64_t bytes;      // Bytes escritos en el archivo
+    uint64_t esperas;    // Veces que un hilo encontr su anillo lleno
+    uint64_t vaciados;   // Pasadas del hilo de vaciado
+};
+
+/**
+ * poca de la sesin activa (0 = sin grabacin). Solo la escriben
+ * iniciar() y detener().
+ */
+extern std::atomic<uint32_t> epocaActual;
+
+/**
+ * poca de la sesin activa, o 0 si no se est grabando.
+ */
+inline uint32_t epoca() {
+#if SO_TRAZA
+    return epocaActual.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+inline bool activa() { return epoca() != 0; }
+
+/**
+ * Empieza a grabar en un archivo.
+ * @param ruta Archivo destino (se sobrescribe)
+ * @param bytesPorHilo Tamao del anillo de cada hilo (se redondea a
+ *        potencia de dos, mnimo 128 KiB)
+ * @return false si ya haba una grabacin en curso
+ * @throws runtime_error Si no se puede abrir el archivo
+ */
+bool iniciar(const std::string& ruta, size_t bytesPorHilo = 1 << 20);
+
+/**
+ * Detiene la grabacin, vaca los anillos y cierra el archivo.
+ * Las operaciones que corran en paralelo con detener() pueden quedar
+ * fuera de la traza.
+ * @throws runtime_error Si fall alguna escritura del archivo
+ */
+void detener();
+
+/**
+ * Identificador nuevo para una estructura trazable.
+ */
+uint32_t nuevoObjeto();
+
+/**
+ * Graba una operacin desde el hilo actual (no hace nada si la sesin
+ * ya termin).
+ * @param texto Bytes de texto adjuntos (o NULL)
+ */
+void registrar(Operacion op, uint32_t objeto, int64_t a = 0, int32_t b = 0,
+               int32_t resultado = 0, const char* texto = NULL, size_t longitud = 0);
+
+EstadisticasTraza estadisticas();
+
+/**
+ * Lee una traza completa y ordena sus eventos por tiempo (estable, as
+ * los de un mismo hilo conservan su orden).
+ * @throws runtime_error Si el archivo no existe o est daado
+ */
+TrazaCargada cargar(const std::string& ruta);
+
+const char* nombre(Operacion op);
+
+} // namespace Traza
+
+#endif // TRAZA_H
@@ -0,0 +1,24 @@
+#ifndef UTILIDADES_H
+#define UTILIDADES_H
+
+#include <sstream> // Para to_string alternativo
+#include <string>
+
+/* ================================================================
+ *                   FUNCIONES AUXILIARES
+ * ================================================================ */
+/**
+ * Implementacin alternativa de to_string para compiladores antiguos
+ * que no soportan std::to_string().
+ * @tparam T Tipo del valor a convertir
+ * @param value Valor a convertir a string
+ * @return String que representa el valor
+ */
+template <typename T>
+std::string to_string_alt(T value) {
+    std::ostringstream os;
+    os << value;
+    return os.str();
+}
+
+#endif // UTILIDADES_H
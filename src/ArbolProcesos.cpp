@@ -0,0 +1,168 @@
+#include "ArbolProcesos.h"
+
+#include <stdexcept>
+
+#include "ErrorHandler.h"
+#include "Persistencia.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+const string ArbolProcesos::ARCHIVO_ARBOL = "arbol.dat";
+
+ArbolProcesos::ArbolProcesos(const string& archivo) : archivo(archivo) {
+    vaciar();
+    if (!archivo.empty()) {
+        Persistencia::cargarArbol(archivo, *this);
+    }
+}
+
+ArbolProcesos::~ArbolProcesos() {
+    if (!archivo.empty()) {
+        try {
+            guardar();
+        } catch (const exception& e) {
+            ErrorHandler::manejar(e);
+        }
+    }
+}
+
+void ArbolProcesos::guardar() const {
+    if (archivo.empty()) {
+        throw runtime_error("El rbol de procesos no tiene archivo de persistencia");
+    }
+    Persistencia::guardarArbol(*this, archivo);
+}
+
+void ArbolProcesos::vaciar() {
+    Nodo init = { INIT, NINGUNO, NINGUNO, NINGUNO, NINGUNO, NINGUNO };
+    nodos.assign(1, init);
+    libres.clear();
+    posiciones.clear();
+}
+
+uint32_t ArbolProcesos::posicion(int pid) const {
+    if (pid == INIT) return 0;
+    unordered_map<int, uint32_t>::const_iterator it = posiciones.find(pid);
+    if (it == posiciones.end()) {
+        throw runtime_error("Proceso " + to_string_alt(pid) + " no est en el rbol");
+    }
+    return it->second;
+}
+
+/* ---------------- Enlaces ---------------- */
+
+void ArbolProcesos::enlazar(uint32_t n, uint32_t padre) {
+    Nodo& p = nodos[padre];
+    nodos[n].padre = padre;
+    nodos[n].sigHermano = NINGUNO;
+    nodos[n].antHermano = p.ultimoHijo;
+    if (p.ultimoHijo != NINGUNO) nodos[p.ultimoHijo].sigHermano = n; else p.primerHijo = n;
+    p.ultimoHijo = n;
+}
+
+void ArbolProcesos::desenlazar(uint32_t n) {
+    Nodo& nodo = nodos[n];
+    Nodo& p = nodos[nodo.padre];
+    if (nodo.antHermano != NINGUNO) nodos[nodo.antHermano].sigHermano = nodo.sigHermano;
+    else p.primerHijo = nodo.sigHermano;
+    if (nodo.sigHermano != NINGUNO) nodos[nodo.sigHermano].antHermano = nodo.antHermano;
+    else p.ultimoHijo = nodo.antHermano;
+    nodo.padre = nodo.sigHermano = nodo.antHermano = NINGUNO;
+}
+
+/* ---------------- Operaciones ---------------- */
+
+void ArbolProcesos::agregar(int pid, int padre) {
+    if (pid == INIT || posiciones.count(pid)) {
+        throw runtime_error("Proceso " + to_string_alt(pid) + " ya est en el rbol");
+    }
+    uint32_t p = posicion(padre);
+
+    uint32_t n;
+    if (libres.empty()) {
+        n = (uint32_t)nodos.size();
+        nodos.push_back(Nodo());
+    } else {
+        n = libres.back();
+        libres.pop_back();
+    }
+    nodos[n].pid = pid;
+    nodos[n].primerHijo = nodos[n].ultimoHijo = NINGUNO;
+    enlazar(n, p);
+    posiciones[pid] = n;
+}
+
+size_t ArbolProcesos::eliminar(int pid) {
+    if (pid == INIT) {
+        throw runtime_error("init no se puede quitar del rbol");
+    }
+    uint32_t n = posicion(pid);
+    desenlazar(n);
+
+    // Los hijos se empalman al final de los de init
+    size_t hijos = 0;
+    uint32_t primero = nodos[n].primerHijo;
+    if (primero != NINGUNO) {
+        for (uint32_t h = primero; h != NINGUNO; h = nodos[h].sigHermano) {
+            nodos[h].padre = 0;
+            hijos++;
+        }
+        Nodo& init = nodos[0];
+        nodos[primero].antHermano = init.ultimoHijo;
+        if (init.ultimoHijo != NINGUNO) nodos[init.ultimoHijo].sigHermano = primero;
+        else init.primerHijo = primero;
+        init.ultimoHijo = nodos[n].ultimoHijo;
+    }
+
+    posiciones.erase(pid);
+    libres.push_back(n);
+    return hijos;
+}
+
+void ArbolProcesos::reparentarAInit(int pid) {
+    if (pid == INIT) return;
+    uint32_t n = posicion(pid);
+    if (nodos[n].padre == 0) return;
+    desenlazar(n);
+    enlazar(n, 0);
+}
+
+size_t ArbolProcesos::quitarSubarbol(int pid, vector<int>& pids) {
+    if (pid == INIT) {
+        throw runtime_error("init no se puede quitar del rbol");
+    }
+    uint32_t raiz = posicion(pid);
+    size_t inicio = pids.size();
+    int profundidad = 0;
+    for (uint32_t n = raiz; n != NINGUNO; n = siguiente(n, raiz, profundidad)) {
+        pids.push_back(nodos[n].pid);
+    }
+    // Se desenlaza al final: el recorrido sube por los padres del subrbol
+    desenlazar(raiz);
+    for (size_t i = inicio; i < pids.size(); i++) {
+        unordered_map<int, uint32_t>::iterator it = posiciones.find(pids[i]);
+        libres.push_back(it->second);
+        posiciones.erase(it);
+    }
+    return pids.size() - inicio;
+}
+
+size_t ArbolProcesos::contarDescendientes(int pid) const {
+    if (pid == INIT) return posiciones.size();
+    uint32_t raiz = posicion(pid);
+    size_t cuenta = 0;
+    int profundidad = 0;
+    for (uint32_t n = siguiente(raiz, raiz, profundidad); n != NINGUNO;
+         n = siguiente(n, raiz, profundidad)) {
+        cuenta++;
+    }
+    return cuenta;
+}
+
+int ArbolProcesos::padreDe(int pid) const {
+    if (pid == INIT) {
+        throw runtime_error("init no tiene padre");
+    }
+    return nodos[nodos[posicion(pid)].padre].pid;
+}
@@ -0,0 +1,53 @@
+#include "ArchivoProyectado.h"
+
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+ArchivoProyectado::ArchivoProyectado(const string& archivo) : inicio(NULL), longitud(0) {
+#ifdef _WIN32
+    ifstream in(archivo.c_str(), ios::binary);
+    if (!in) throw runtime_error("No se pudo abrir " + archivo);
+    copia.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    inicio = copia.empty() ? NULL : copia.data();
+    longitud = copia.size();
+#else
+    int fd = open(archivo.c_str(), O_RDONLY);
+    if (fd < 0) throw runtime_error("No se pudo abrir " + archivo);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw runtime_error("No se pudo leer " + archivo);
+    }
+    longitud = (size_t)st.st_size;
+    if (longitud > 0) {
+        void* p = mmap(NULL, longitud, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close(fd);
+            throw runtime_error("No se pudo proyectar " + archivo);
+        }
+        madvise(p, longitud, MADV_SEQUENTIAL);
+        inicio = static_cast<const char*>(p);
+    }
+    close(fd);
+#endif
+}
+
+ArchivoProyectado::~ArchivoProyectado() {
+#ifndef _WIN32
+    if (inicio) munmap(const_cast<char*>(inicio), longitud);
+#endif
+}
+
+bool ArchivoProyectado::existe(const string& archivo) {
+    ifstream in(archivo.c_str(), ios::binary);
+    return in.is_open();
+}
@@ -0,0 +1,345 @@
+#include "AsignadorSlab.h"
+
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+#include "Metricas.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+vector<uint32_t> AsignadorSlab::clasesPorDefecto() {
+    vector<uint32_t> tamanos;
+    tamanos.push_back(16);
+    for (uint32_t t = 32; t <= 2048; t *= 2) {
+        if (t > 32) tamanos.push_back(t - t / 4);
+        tamanos.push_back(t);
+    }
+    return tamanos;
+}
+
+AsignadorSlab::AsignadorSlab(uint32_t paginas, uint32_t tamSlab, int cpus, uint32_t tamCargador,
+                             const vector<uint32_t>& tamanos, size_t vaciosMax)
+    : bitsSlab(0), tamSlab(tamSlab), cpus(cpus), tamCargador(tamCargador), vaciosMax(vaciosMax) {
+    if (tamSlab < 256 || tamSlab > 32768 || (tamSlab & (tamSlab - 1)) != 0) {
+        throw runtime_error("El tamao de slab debe ser potencia de dos entre 256 y 32768");
+    }
+    if (paginas == 0 || (uint64_t)paginas * tamSlab > (1ull << 32)) {
+        throw runtime_error("La arena debe tener entre 1 pgina y 4 GiB");
+    }
+    if (cpus < 1 || cpus > 1024) {
+        throw runtime_error("Nmero de CPUs debe ser 1-1024");
+    }
+    if (tamCargador > 65536) {
+        throw runtime_error("Cargador de ms de 65536 objetos");
+    }
+    if (tamanos.empty() || tamanos.size() > 255) {
+        throw runtime_error("Debe haber entre 1 y 255 clases de tamao");
+    }
+    for (size_t i = 0; i < tamanos.size(); i++) {
+        if (tamanos[i] == 0 || tamanos[i] % 8 != 0 || tamanos[i] > tamSlab ||
+            (i > 0 && tamanos[i] <= tamanos[i - 1])) {
+            throw runtime_error("Clases de tamao invlidas: deben ser mltiplos de 8, "
+                                "crecientes y no mayores que el slab");
+        }
+    }
+    while ((1u << bitsSlab) < tamSlab) bitsSlab++;
+
+    slabs.resize(paginas);
+    paginasLibres.reserve(paginas);
+    for (uint32_t p = paginas; p > 0; p--) {
+        Slab& s = slabs[p - 1];
+        s.clase = -1;
+        s.estado = SLAB_LIBRE;
+        s.ocupados = 0;
+        s.ant = s.sig = NULL;
+        paginasLibres.push_back(p - 1);  // Se toman de la ms baja
+    }
+
+    clases.resize(tamanos.size());
+    clasePorTamano.assign(tamanos.back() / 8 + 1, 0);
+    size_t c = 0;
+    for (size_t i = 1; i < clasePorTamano.size(); i++) {
+        while (tamanos[c] < i * 8) c++;
+        clasePorTamano[i] = (uint8_t)c;
+    }
+    for (size_t i = 0; i < clases.size(); i++) {
+        Clase& cl = clases[i];
+        cl.tamano = tamanos[i];
+        cl.objetosPorSlab = tamSlab / tamanos[i];
+        memset(cl.listas, 0, sizeof(cl.listas));
+        memset(&cl.est, 0, sizeof(cl.est));
+        cl.est.tamano = cl.tamano;
+        cl.est.objetosPorSlab = cl.objetosPorSlab;
+    }
+    cargadores.assign((size_t)cpus * clases.size() * tamCargador, 0);
+    cargados.assign((size_t)cpus * clases.size(), 0);
+}
+
+int AsignadorSlab::claseDe(uint32_t tamano) const {
+    if (tamano == 0 || tamano > clases.back().tamano) {
+        throw runtime_error("Tamao " + to_string_alt(tamano) + " sin clase (mximo " +
+                            to_string_alt(clases.back().tamano) + ")");
+    }
+    return clasePorTamano[(tamano + 7) >> 3];
+}
+
+/* ---------------- Listas de slabs ---------------- */
+
+void AsignadorSlab::mover(Clase& clase, Slab* s, EstadoSlab estado) {
+    if (s->estado != SLAB_LIBRE) {
+        ListaSlabs& vieja = clase.listas[s->estado];
+        if (s->ant) s->ant->sig = s->sig; else vieja.cabeza = s->sig;
+        if (s->sig) s->sig->ant = s->ant;
+        vieja.tam--;
+    }
+    s->estado = estado;
+    s->ant = s->sig = NULL;
+    if (estado != SLAB_LIBRE) {
+        ListaSlabs& nueva = clase.listas[estado];
+        s->sig = nueva.cabeza;
+        if (nueva.cabeza) nueva.cabeza->ant = s;
+        nueva.cabeza = s;
+        nueva.tam++;
+    }
+    clase.est.parciales = clase.listas[SLAB_PARCIAL].tam;
+    clase.est.llenos = clase.listas[SLAB_LLENO].tam;
+    clase.est.vacios = clase.listas[SLAB_VACIO].tam;
+}
+
+AsignadorSlab::Slab* AsignadorSlab::nuevoSlab(int c) {
+    if (paginasLibres.empty()) return NULL;
+    Slab* s = &slabs[paginasLibres.back()];
+    paginasLibres.pop_back();
+    uint32_t n = clases[(size_t)c].objetosPorSlab;
+    s->clase = c;
+    s->ocupados = 0;
+    s->libres.resize(n);
+    for (uint32_t i = 0; i < n; i++) s->libres[i] = (uint16_t)(n - 1 - i);  // El 0 sale primero
+    s->pedido.assign(n, 0);
+    mover(clases[(size_t)c], s, SLAB_VACIO);
+    SO_MEDIDOR(SLAB_PAGINAS, 1);
+    return s;
+}
+
+uint32_t AsignadorSlab::tomarObjeto(int c, bool reclamar) {
+    Clase& cl = clases[(size_t)c];
+    Slab* s = cl.listas[SLAB_PARCIAL].cabeza;
+    if (!s) s = cl.listas[SLAB_VACIO].cabeza;
+    if (!s) s = nuevoSlab(c);
+    if (!s && reclamar && recuperar() > 0) {
+        // Sin pginas: los cargadores y los vacos de otras clases las retenan
+        s = cl.listas[SLAB_PARCIAL].cabeza;
+        if (!s) s = nuevoSlab(c);
+    }
+    if (!s) return NINGUNO;
+
+    uint32_t indice = s->libres.back();
+    s->libres.pop_back();
+    s->ocupados++;
+    EstadoSlab estado = s->ocupados == cl.objetosPorSlab ? SLAB_LLENO : SLAB_PARCIAL;
+    if (estado != s->estado) mover(cl, s, estado);
+    return ((uint32_t)(s - &slabs[0]) << bitsSlab) + indice * cl.tamano;
+}
+
+void AsignadorSlab::devolverObjeto(uint32_t direccion) {
+    Slab* s = &slabs[direccion >> bitsSlab];
+    Clase& cl = clases[(size_t)s->clase];
+    s->libres.push_back((uint16_t)((direccion & (tamSlab - 1)) / cl.tamano));
+    s->ocupados--;
+    if (s->ocupados > 0) {
+        if (s->estado == SLAB_LLENO) mover(cl, s, SLAB_PARCIAL);
+    } else if (cl.listas[SLAB_VACIO].tam < vaciosMax) {
+        mover(cl, s, SLAB_VACIO);
+    } else {
+        // Ya hay bastantes vacos retenidos: la pgina vuelve a la arena
+        mover(cl, s, SLAB_LIBRE);
+        s->clase = -1;
+        paginasLibres.push_back((uint32_t)(s - &slabs[0]));
+        SO_MEDIDOR(SLAB_PAGINAS, -1);
+    }
+}
+
+/* ---------------- Cargadores por CPU ---------------- */
+
+void AsignadorSlab::recargar(int c, size_t k) {
+    // Solo se reclama con el cargador vaco: vaciarlo para volver a
+    // llenarlo no ganara nada y no terminara
+    uint32_t* cargador = &cargadores[k * tamCargador];
+    uint32_t lote = tamCargador / 2 > 0 ? tamCargador / 2 : 1;
+    EstadisticasClaseSlab& est = clases[(size_t)c].est;
+    while (cargados[k] < lote) {
+        uint32_t d = tomarObjeto(c, cargados[k] == 0);
+        if (d == NINGUNO) break;
+        cargador[cargados[k]++] = d;
+        est.enCargadores++;
+    }
+    if (cargados[k] == 0) {
+        SO_CONTAR(MEMORIA_RECHAZOS);
+        throw runtime_error("Memoria llena");
+    }
+    est.recargas++;
+    SO_CONTAR(SLAB_RECARGAS);
+}
+
+void AsignadorSlab::descargar(int c, size_t k, uint32_t cuantos) {
+    // Salen los ms antiguos (el fondo): los recientes siguen calientes
+    uint32_t* cargador = &cargadores[k * tamCargador];
+    for (uint32_t i = 0; i < cuantos; i++) devolverObjeto(cargador[i]);
+    memmove(cargador, cargador + cuantos, (cargados[k] - cuantos) * sizeof(uint32_t));
+    cargados[k] -= cuantos;
+    clases[(size_t)c].est.enCargadores -= cuantos;
+}
+
+void AsignadorSlab::vaciarCargadores() {
+    for (size_t k = 0; k < cargados.size(); k++) {
+        if (cargados[k] > 0) descargar((int)(k % clases.size()), k, cargados[k]);
+    }
+}
+
+size_t AsignadorSlab::recuperar() {
+    vaciarCargadores();
+    size_t liberadas = 0;
+    for (size_t c = 0; c < clases.size(); c++) {
+        Clase& cl = clases[c];
+        while (Slab* s = cl.listas[SLAB_VACIO].cabeza) {
+            mover(cl, s, SLAB_LIBRE);
+            s->clase = -1;
+            paginasLibres.push_back((uint32_t)(s - &slabs[0]));
+            liberadas++;
+        }
+    }
+    SO_MEDIDOR(SLAB_PAGINAS, -(int64_t)liberadas);
+    return liberadas;
+}
+
+/* ---------------- Asignar y liberar ---------------- */
+
+uint32_t AsignadorSlab::asignar(uint32_t tamano, int cpu) {
+    int c = claseDe(tamano);
+    if (cpu < 0 || cpu >= cpus) {
+        throw runtime_error("CPU " + to_string_alt(cpu) + " inexistente");
+    }
+    Clase& cl = clases[(size_t)c];
+    uint32_t d;
+    if (tamCargador == 0) {
+        d = tomarObjeto(c, true);
+        if (d == NINGUNO) {
+            SO_CONTAR(MEMORIA_RECHAZOS);
+            throw runtime_error("Memoria llena");
+        }
+        cl.est.recargas++;
+    } else {
+        size_t k = (size_t)cpu * clases.size() + (size_t)c;
+        if (cargados[k] == 0) recargar(c, k);
+        d = cargadores[k * tamCargador + --cargados[k]];
+        cl.est.enCargadores--;
+    }
+    slabs[d >> bitsSlab].pedido[(d & (tamSlab - 1)) / cl.tamano] = (uint16_t)tamano;
+    cl.est.enUso++;
+    cl.est.bytesPedidos += tamano;
+    cl.est.asignaciones++;
+    SO_CONTAR(SLAB_ASIGNACIONES);
+    return d;
+}
+
+void AsignadorSlab::liberar(uint32_t direccion, int cpu) {
+    if (cpu < 0 || cpu >= cpus) {
+        throw runtime_error("CPU " + to_string_alt(cpu) + " inexistente");
+    }
+    uint32_t pagina = direccion >> bitsSlab;
+    if (pagina >= slabs.size() || slabs[pagina].clase < 0) {
+        throw runtime_error("La direccin " + to_string_alt(direccion) + " no est asignada");
+    }
+    Slab& s = slabs[pagina];
+    int c = s.clase;
+    Clase& cl = clases[(size_t)c];
+    uint32_t desplazamiento = direccion & (tamSlab - 1);
+    uint32_t indice = desplazamiento / cl.tamano;
+    if (desplazamiento % cl.tamano != 0 || indice >= cl.objetosPorSlab || s.pedido[indice] == 0) {
+        throw runtime_error("La direccin " + to_string_alt(direccion) + " no est asignada");
+    }
+    cl.est.bytesPedidos -= s.pedido[indice];
+    s.pedido[indice] = 0;
+    cl.est.enUso--;
+    cl.est.liberaciones++;
+    SO_CONTAR(SLAB_LIBERACIONES);
+
+    if (tamCargador == 0) {
+        devolverObjeto(direccion);
+        return;
+    }
+    size_t k = (size_t)cpu * clases.size() + (size_t)c;
+    if (cargados[k] == tamCargador) {
+        descargar(c, k, tamCargador / 2 > 0 ? tamCargador / 2 : 1);
+        cl.est.descargas++;
+    }
+    cargadores[k * tamCargador + cargados[k]++] = direccion;
+    cl.est.enCargadores++;
+}
+
+uint32_t AsignadorSlab::tamanoPedido(uint32_t direccion) const {
+    uint32_t pagina = direccion >> bitsSlab;
+    if (pagina >= slabs.size() || slabs[pagina].clase < 0) return 0;
+    const Slab& s = slabs[pagina];
+    const Clase& cl = clases[(size_t)s.clase];
+    uint32_t desplazamiento = direccion & (tamSlab - 1);
+    uint32_t indice = desplazamiento / cl.tamano;
+    if (desplazamiento % cl.tamano != 0 || indice >= cl.objetosPorSlab) return 0;
+    return s.pedido[indice];
+}
+
+/* ---------------- Estadsticas ---------------- */
+
+ResumenSlab AsignadorSlab::resumen() const {
+    ResumenSlab r;
+    memset(&r, 0, sizeof(r));
+    r.paginas = (uint32_t)slabs.size();
+    r.paginasLibres = (uint32_t)paginasLibres.size();
+    r.bytesSlabs = (uint64_t)(r.paginas - r.paginasLibres) * tamSlab;
+    for (size_t c = 0; c < clases.size(); c++) {
+        const EstadisticasClaseSlab& e = clases[c].est;
+        r.objetos += e.enUso;
+        r.bytesPedidos += e.bytesPedidos;
+        r.bytesObjetos += e.enUso * e.tamano;
+        r.asignaciones += e.asignaciones;
+        r.recargas += e.recargas;
+    }
+    r.utilizacion = r.bytesSlabs ? (double)r.bytesObjetos / (double)r.bytesSlabs : 0.0;
+    r.fragmentacionInterna =
+        r.bytesObjetos ? 1.0 - (double)r.bytesPedidos / (double)r.bytesObjetos : 0.0;
+    r.aciertosCargador =
+        r.asignaciones ? 1.0 - (double)r.recargas / (double)r.asignaciones : 0.0;
+    return r;
+}
+
+void AsignadorSlab::mostrarEstadisticas(ostream& os) const {
+    ResumenSlab r = resumen();
+    ios::fmtflags formato = os.flags();
+    streamsize precision = os.precision();
+    os << "\n--- Asignador slab ---\n";
+    os << "Pginas: " << r.paginas - r.paginasLibres << "/" << r.paginas << " de " << tamSlab
+       << " bytes | CPUs: " << cpus << " | Cargador: " << tamCargador << " objetos\n";
+    os << fixed << setprecision(3) << "Objetos: " << r.objetos << " | Utilizacin: "
+       << r.utilizacion << " | Fragmentacin interna: " << r.fragmentacionInterna
+       << " | Aciertos del cargador: " << r.aciertosCargador << "\n";
+    os << right << setw(7) << "clase" << setw(10) << "obj/slab" << setw(10) << "parciales"
+       << setw(8) << "llenos" << setw(8) << "vacios" << setw(10) << "en uso" << setw(11)
+       << "cargadores" << setw(7) << "util" << setw(12) << "recargas" << "\n";
+    for (size_t c = 0; c < clases.size(); c++) {
+        const EstadisticasClaseSlab& e = clases[c].est;
+        size_t slabsClase = e.parciales + e.llenos + e.vacios;
+        if (slabsClase == 0 && e.asignaciones == 0) continue;
+        double util = slabsClase ? (double)(e.enUso * e.tamano) /
+                                       ((double)slabsClase * (double)tamSlab)
+                                 : 0.0;
+        os << setw(7) << e.tamano << setw(10) << e.objetosPorSlab << setw(10) << e.parciales
+           << setw(8) << e.llenos << setw(8) << e.vacios << setw(10) << e.enUso << setw(11)
+           << e.enCargadores << setw(7) << setprecision(2) << util << setw(12) << e.recargas
+           << "\n";
+    }
+    os.flags(formato);
+    os.precision(precision);
+}
@@ -0,0 +1,38 @@
+#include "CargasTrabajo.h"
+
+namespace CargasTrabajo {
+
+CuerpoProceso primos(uint64_t limite) {
+    uint64_t cuenta = 0;
+    for (uint64_t n = 2; n < limite; n++) {
+        co_await usarCpu(1);
+        bool primo = true;
+        for (uint64_t d = 2; d * d <= n; d++) {
+            if (n % d == 0) {
+                primo = false;
+                break;
+            }
+        }
+        cuenta += primo;
+    }
+    co_return cuenta;
+}
+
+CuerpoProceso interactivo(uint64_t rafagas, uint64_t cpu, uint64_t es) {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint64_t r = 0; r < rafagas; r++) {
+        for (uint64_t i = 0; i < cpu; i++) {
+            co_await usarCpu(1);
+            hash = (hash ^ (r * cpu + i)) * 1099511628211ull;
+        }
+        co_await esperarES(es);
+    }
+    co_return hash;
+}
+
+CuerpoProceso cedente(uint64_t veces) {
+    for (uint64_t i = 0; i < veces; i++) co_await ceder();
+    co_return veces;
+}
+
+} // namespace CargasTrabajo
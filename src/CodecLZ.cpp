@@ -0,0 +1,138 @@
+#include "CodecLZ.h"
+
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace CodecLZ {
+
+namespace {
+
+const int MIN_COINCIDENCIA = 4;
+const size_t VENTANA = 65535;
+const int BITS_HASH = 14;
+// Los ltimos bytes siempre van como literales: la bsqueda lee de a 4
+const size_t MARGEN_FINAL = 12;
+
+uint32_t leer32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+uint32_t hash4(uint32_t v) {
+    return (v * 2654435761u) >> (32 - BITS_HASH);
+}
+
+void escribirLongitud(vector<uint8_t>& out, size_t resto) {
+    while (resto >= 255) {
+        out.push_back(255);
+        resto -= 255;
+    }
+    out.push_back((uint8_t)resto);
+}
+
+void emitir(vector<uint8_t>& out, const uint8_t* literales, size_t numLiterales,
+            size_t desplazamiento, size_t longitud) {
+    size_t extraCoincidencia = longitud ? longitud - MIN_COINCIDENCIA : 0;
+    uint8_t token = (uint8_t)((numLiterales >= 15 ? 15 : numLiterales) << 4);
+    if (longitud) token |= (uint8_t)(extraCoincidencia >= 15 ? 15 : extraCoincidencia);
+    out.push_back(token);
+    if (numLiterales >= 15) escribirLongitud(out, numLiterales - 15);
+    out.insert(out.end(), literales, literales + numLiterales);
+    if (!longitud) return;
+    out.push_back((uint8_t)(desplazamiento & 0xFF));
+    out.push_back((uint8_t)(desplazamiento >> 8));
+    if (extraCoincidencia >= 15) escribirLongitud(out, extraCoincidencia - 15);
+}
+
+size_t leerLongitud(const uint8_t*& ip, const uint8_t* fin, size_t base) {
+    if (base != 15) return base;
+    size_t total = base;
+    for (;;) {
+        if (ip >= fin) throw runtime_error("Bloque comprimido truncado");
+        uint8_t b = *ip++;
+        total += b;
+        if (b != 255) return total;
+    }
+}
+
+} // namespace
+
+size_t comprimir(const uint8_t* entrada, size_t n, vector<uint8_t>& salida) {
+    salida.clear();
+    salida.reserve(cotaComprimido(n));
+    size_t ancla = 0;
+
+    if (n > MARGEN_FINAL) {
+        vector<uint32_t> tabla((size_t)1 << BITS_HASH, 0); // posicin + 1 (0 = vaca)
+        size_t limite = n - MARGEN_FINAL;
+        size_t ip = 0;
+        while (ip < limite) {
+            uint32_t secuencia = leer32(entrada + ip);
+            uint32_t h = hash4(secuencia);
+            size_t candidato = tabla[h];
+            tabla[h] = (uint32_t)(ip + 1);
+            if (candidato == 0 || ip - (candidato - 1) > VENTANA ||
+                leer32(entrada + candidato - 1) != secuencia) {
+                // Sin coincidencia: avanza ms rpido cuanto ms dura la racha
+                ip += 1 + ((ip - ancla) >> 6);
+                continue;
+            }
+            size_t ref = candidato - 1;
+            size_t longitud = MIN_COINCIDENCIA;
+            size_t maximo = n - 5 - ip;
+            while (longitud < maximo && entrada[ref + longitud] == entrada[ip + longitud]) {
+                longitud++;
+            }
+            emitir(salida, entrada + ancla, ip - ancla, ip - ref, longitud);
+            ip += longitud;
+            ancla = ip;
+        }
+    }
+    emitir(salida, entrada + ancla, n - ancla, 0, 0);
+    return salida.size();
+}
+
+void descomprimir(const uint8_t* entrada, size_t n, uint8_t* salida, size_t tamOriginal) {
+    const uint8_t* ip = entrada;
+    const uint8_t* fin = entrada + n;
+    uint8_t* op = salida;
+    uint8_t* finSalida = salida + tamOriginal;
+
+    while (ip < fin) {
+        uint8_t token = *ip++;
+        size_t literales = leerLongitud(ip, fin, token >> 4);
+        if ((size_t)(fin - ip) < literales || (size_t)(finSalida - op) < literales) {
+            throw runtime_error("Bloque comprimido daado (literales)");
+        }
+        // Sin literales op puede ser nulo (salida vaca): memcpy no lo admite
+        if (literales) memcpy(op, ip, literales);
+        ip += literales;
+        op += literales;
+        if (ip == fin) break;
+
+        if (fin - ip < 2) throw runtime_error("Bloque comprimido truncado");
+        size_t desplazamiento = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        size_t longitud = leerLongitud(ip, fin, token & 15) + MIN_COINCIDENCIA;
+        if (desplazamiento == 0 || desplazamiento > (size_t)(op - salida) ||
+            (size_t)(finSalida - op) < longitud) {
+            throw runtime_error("Bloque comprimido daado (coincidencia)");
+        }
+        const uint8_t* ref = op - desplazamiento;
+        if (desplazamiento >= longitud) {
+            memcpy(op, ref, longitud);
+            op += longitud;
+        } else {
+            // Solapada: repite un patrn corto byte a byte
+            for (size_t i = 0; i < longitud; i++) *op++ = *ref++;
+        }
+    }
+    if (op != finSalida) {
+        throw runtime_error("Bloque comprimido de tamao inesperado");
+    }
+}
+
+} // namespace CodecLZ
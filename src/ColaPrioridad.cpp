@@ -0,0 +1,236 @@
+#include "ColaPrioridad.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include "Metricas.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+ColaPrioridad::ColaPrioridad()
+    : llegadas(0), reloj(0), periodo(PERIODO_ENVEJECIMIENTO), politica(PLAN_PRIORIDAD),
+      esperaMaxima(0),
+      idTraza(Traza::nuevoObjeto()), epocaTraza(0) {}
+
+ColaPrioridad::~ColaPrioridad() {
+    SO_MEDIDOR(COLA_PROFUNDIDAD, -(int64_t)monticulo.size());
+    if (Traza::activa() && epocaTraza == Traza::epoca()) {
+        Traza::registrar(Traza::COLA_DESTRUIR, idTraza);
+    }
+}
+
+void ColaPrioridad::colocar(size_t i, const EntradaCola& e) {
+    monticulo[i] = e;
+    posiciones[e.proceso->id] = i;
+}
+
+size_t ColaPrioridad::subir(size_t i) {
+    EntradaCola e = monticulo[i];
+    size_t pasos = 0;
+    while (i > 0) {
+        size_t padre = (i - 1) / 2;
+        if (!antes(e, monticulo[padre])) break;
+        colocar(i, monticulo[padre]);
+        i = padre;
+        pasos++;
+    }
+    colocar(i, e);
+    return pasos;
+}
+
+size_t ColaPrioridad::bajar(size_t i) {
+    EntradaCola e = monticulo[i];
+    size_t n = monticulo.size();
+    size_t pasos = 0;
+    for (;;) {
+        size_t hijo = 2 * i + 1;
+        if (hijo >= n) break;
+        if (hijo + 1 < n && antes(monticulo[hijo + 1], monticulo[hijo])) hijo++;
+        if (!antes(monticulo[hijo], e)) break;
+        colocar(i, monticulo[hijo]);
+        i = hijo;
+        pasos++;
+    }
+    colocar(i, e);
+    return pasos;
+}
+
+void ColaPrioridad::quitarEn(size_t i) {
+    posiciones.erase(monticulo[i].proceso->id);
+    EntradaCola ultimo = monticulo.back();
+    monticulo.pop_back();
+    if (i < monticulo.size()) {
+        // El ltimo ocupa el hueco y se reacomoda hacia donde corresponda
+        monticulo[i] = ultimo;
+        if (subir(i) == 0) bajar(i);
+    }
+    SO_MEDIDOR(COLA_PROFUNDIDAD, -1);
+}
+
+void ColaPrioridad::encolarPrioridad(NodoProcesso* proceso) {
+    if (!proceso) {
+        throw runtime_error("Proceso invlido");
+    }
+    if (contiene(proceso->id)) {
+        throw runtime_error("Proceso " + to_string_alt(proceso->id) + " ya est encolado");
+    }
+    SO_CRONOMETRO(COLA_ENCOLAR_NS);
+    bool traza = trazando();
+
+    EntradaCola e = { proceso, proceso->prioridad,
+                      calcularClave(proceso, proceso->prioridad, reloj), reloj, llegadas++ };
+    monticulo.push_back(e);
+    size_t pasos = subir(monticulo.size() - 1);
+    SO_HISTOGRAMA(COLA_LONGITUD_ESCANEO, pasos);
+    (void)pasos;
+    SO_CONTAR(COLA_ENCOLADOS);
+    SO_MEDIDOR(COLA_PROFUNDIDAD, 1);
+    if (traza) {
+        registrarPlazos(proceso);
+        Traza::registrar(Traza::COLA_ENCOLAR, idTraza, proceso->id, proceso->prioridad);
+    }
+}
+
+NodoProcesso* ColaPrioridad::desencolar() {
+    if (monticulo.empty()) {
+        throw runtime_error("Cola vaca");
+    }
+    bool traza = trazando();
+
+    NodoProcesso* proceso = monticulo[0].proceso;
+    uint64_t espera = reloj - monticulo[0].encolado;
+    if (espera > esperaMaxima) esperaMaxima = espera;
+    quitarEn(0);
+    reloj++;
+    SO_HISTOGRAMA(COLA_ESPERA_TICKS, espera);
+    SO_CONTAR(COLA_DESENCOLADOS);
+    if (traza) Traza::registrar(Traza::COLA_DESENCOLAR, idTraza, 0, 0, proceso->id);
+    return proceso;
+}
+
+bool ColaPrioridad::eliminar(int id) {
+    bool traza = trazando();
+    unordered_map<int, size_t>::iterator it = posiciones.find(id);
+    bool estaba = it != posiciones.end();
+    if (estaba) quitarEn(it->second);
+    if (traza) Traza::registrar(Traza::COLA_ELIMINAR, idTraza, id, 0, estaba);
+    return estaba;
+}
+
+void ColaPrioridad::vaciar() {
+    bool traza = trazando();
+    SO_MEDIDOR(COLA_PROFUNDIDAD, -(int64_t)monticulo.size());
+    monticulo.clear();
+    posiciones.clear();
+    if (traza) Traza::registrar(Traza::COLA_VACIAR, idTraza);
+}
+
+bool ColaPrioridad::cambiarPrioridad(int id, int prioridad) {
+    bool traza = trazando();
+    unordered_map<int, size_t>::iterator it = posiciones.find(id);
+    if (it == posiciones.end()) {
+        if (traza) Traza::registrar(Traza::COLA_CAMBIAR_PRIORIDAD, idTraza, id, prioridad, 0);
+        return false;
+    }
+
+    // La espera acumulada se conserva: solo cambia la parte base de la clave
+    size_t i = it->second;
+    int64_t anterior = monticulo[i].clave;
+    monticulo[i].prioridad = prioridad;
+    monticulo[i].clave = calcularClave(monticulo[i].proceso, prioridad, monticulo[i].encolado);
+    monticulo[i].proceso->prioridad = prioridad;
+    if (monticulo[i].clave > anterior) {
+        subir(i);
+    } else if (monticulo[i].clave < anterior) {
+        bajar(i);
+    }
+    if (traza) Traza::registrar(Traza::COLA_CAMBIAR_PRIORIDAD, idTraza, id, prioridad, 1);
+    return true;
+}
+
+void ColaPrioridad::setPeriodoEnvejecimiento(int ticks) {
+    if (ticks < 0) {
+        throw runtime_error("Periodo de envejecimiento invlido");
+    }
+    if (trazando()) Traza::registrar(Traza::COLA_PERIODO, idTraza, 0, ticks);
+    periodo = ticks;
+    recalcularClaves();
+}
+
+void ColaPrioridad::setPolitica(PoliticaPlanificacion valor) {
+    if (trazando()) Traza::registrar(Traza::COLA_POLITICA, idTraza, 0, valor);
+    politica = valor;
+    recalcularClaves();
+}
+
+void ColaPrioridad::recalcularClaves() {
+    for (size_t i = 0; i < monticulo.size(); i++) {
+        const EntradaCola& e = monticulo[i];
+        monticulo[i].clave = calcularClave(e.proceso, e.prioridad, e.encolado);
+    }
+    for (size_t i = monticulo.size() / 2; i-- > 0;) {
+        bajar(i);
+    }
+}
+
+int ColaPrioridad::prioridadEfectiva(int id) const {
+    unordered_map<int, size_t>::const_iterator it = posiciones.find(id);
+    if (it == posiciones.end()) return -1;
+    return efectiva(monticulo[it->second]);
+}
+
+bool ColaPrioridad::anunciarTraza(uint32_t epoca) {
+    epocaTraza = epoca;
+    Traza::registrar(Traza::COLA_CREAR, idTraza);
+    Traza::registrar(Traza::COLA_PERIODO, idTraza, 0, periodo);
+    Traza::registrar(Traza::COLA_POLITICA, idTraza, 0, politica);
+
+    // Se reencolan en orden de llegada, con el reloj de cada llegada:
+    // as se reproducen las mismas claves y el mismo desempate FIFO
+    vector<EntradaCola> orden(monticulo);
+    sort(orden.begin(), orden.end(),
+         [](const EntradaCola& x, const EntradaCola& y) { return x.orden < y.orden; });
+    uint64_t t = 0;
+    for (size_t i = 0; i < orden.size(); i++) {
+        if (orden[i].encolado > t) {
+            Traza::registrar(Traza::COLA_AVANZAR_RELOJ, idTraza, (int64_t)(orden[i].encolado - t));
+            t = orden[i].encolado;
+        }
+        registrarPlazos(orden[i].proceso);
+        Traza::registrar(Traza::COLA_ENCOLAR, idTraza, orden[i].proceso->id, orden[i].prioridad);
+    }
+    if (reloj > t) Traza::registrar(Traza::COLA_AVANZAR_RELOJ, idTraza, (int64_t)(reloj - t));
+    return true;
+}
+
+void ColaPrioridad::registrarPlazos(const NodoProcesso* proceso) {
+    const TareaTiempoReal& t = proceso->tiempoReal;
+    if (!t.esTiempoReal()) return;
+    Traza::registrar(Traza::COLA_PLAZOS, idTraza, proceso->id, (int32_t)t.plazo,
+                     (int32_t)t.plazoAbsoluto);
+}
+
+void ColaPrioridad::mostrar() const {
+    if (monticulo.empty()) {
+        cout << "\nCola de prioridad vaca!\n";
+        return;
+    }
+
+    // Copia ordenada: el montculo solo garantiza el orden del frente
+    vector<EntradaCola> orden(monticulo);
+    sort(orden.begin(), orden.end(), antes);
+    cout << "\n--- Cola de Prioridad (" << contarProcesos() << ") ---\n";
+    for (size_t i = 0; i < orden.size(); i++) {
+        cout << "ID: " << orden[i].proceso->id
+             << " | Prioridad: " << orden[i].prioridad
+             << " | Efectiva: " << efectiva(orden[i])
+             << " | Espera: " << (reloj - orden[i].encolado);
+        const TareaTiempoReal& t = orden[i].proceso->tiempoReal;
+        if (t.esTiempoReal()) cout << " | Plazo: " << t.plazoAbsoluto << " | Periodo: " << t.periodo;
+        cout << endl;
+    }
+    cout << "Poltica: " << nombrePolitica(politica) << " | ";
+    cout << "Reloj: " << reloj << " | Espera mxima despachada: " << esperaMaxima << "\n";
+}
@@ -0,0 +1,169 @@
+#include "ConjuntoDirecciones.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+/**
+ * lower_bound sin saltos: el tamao se reduce a la mitad con un
+ * movimiento condicional, sin ramas que el procesador pueda predecir
+ * mal con claves al azar.
+ */
+const int* primeroNoMenor(const int* a, size_t n, int x) {
+    if (n == 0) return a;
+    const int* base = a;
+    while (n > 1) {
+        size_t mitad = n / 2;
+        base = base[mitad] < x ? base + mitad : base;
+        n -= mitad;
+    }
+    return base + (*base < x);
+}
+
+} // namespace
+
+ConjuntoDirecciones::ConjuntoDirecciones() : total(0) {}
+
+ConjuntoDirecciones::~ConjuntoDirecciones() {
+    vaciar();
+}
+
+void ConjuntoDirecciones::vaciar() {
+    for (size_t i = 0; i < hojas.size(); i++) delete hojas[i];
+    hojas.clear();
+    maximos.clear();
+    total = 0;
+}
+
+size_t ConjuntoDirecciones::hojaPara(int x) const {
+    if (x >= maximos.back()) {
+        // Por encima de todo o en la ltima hoja: el caso de la pila
+        return maximos.size() - 1;
+    }
+    return (size_t)(primeroNoMenor(maximos.data(), maximos.size(), x) - maximos.data());
+}
+
+void ConjuntoDirecciones::vecinos(size_t i, int pos, Vecinos& v) const {
+    const Hoja* h = hojas[i];
+    v.hayAnterior = pos > 0 || i > 0;
+    if (v.hayAnterior) v.anterior = pos > 0 ? h->claves[pos - 1] : maximos[i - 1];
+    v.haySiguiente = pos < h->n || i + 1 < hojas.size();
+    if (v.haySiguiente) v.siguiente = pos < h->n ? h->claves[pos] : hojas[i + 1]->claves[0];
+}
+
+bool ConjuntoDirecciones::contiene(int x) const {
+    if (total == 0) return false;
+    const Hoja* h = hojas[hojaPara(x)];
+    const int* c = primeroNoMenor(h->claves, (size_t)h->n, x);
+    return c != h->claves + h->n && *c == x;
+}
+
+bool ConjuntoDirecciones::primeroDesde(int x, int& y) const {
+    if (total == 0 || x > maximos.back()) return false;
+    const Hoja* h = hojas[hojaPara(x)];
+    y = *primeroNoMenor(h->claves, (size_t)h->n, x);
+    return true;
+}
+
+bool ConjuntoDirecciones::insertar(int x, Vecinos& v) {
+    if (total == 0) {
+        Hoja* h = new Hoja();
+        h->claves[h->n++] = x;
+        hojas.push_back(h);
+        maximos.push_back(x);
+        total = 1;
+        v.hayAnterior = v.haySiguiente = false;
+        return true;
+    }
+
+    size_t i = hojaPara(x);
+    Hoja* h = hojas[i];
+    int pos = (int)(primeroNoMenor(h->claves, (size_t)h->n, x) - h->claves);
+    if (pos < h->n && h->claves[pos] == x) return false;
+    vecinos(i, pos, v);
+
+    if (h->n == HOJA) {
+        if (pos == HOJA && i + 1 == hojas.size()) {
+            // Nuevo mximo con la ltima hoja llena: empieza otra, as
+            // las inserciones crecientes dejan las hojas llenas
+            Hoja* nueva = new Hoja();
+            nueva->claves[nueva->n++] = x;
+            hojas.push_back(nueva);
+            maximos.push_back(x);
+            total++;
+            return true;
+        }
+        partir(i);
+        if (pos > h->n) {
+            pos -= h->n;
+            h = hojas[++i];
+        }
+    }
+    memmove(h->claves + pos + 1, h->claves + pos, (size_t)(h->n - pos) * sizeof(int));
+    h->claves[pos] = x;
+    h->n++;
+    maximos[i] = h->claves[h->n - 1];
+    total++;
+    return true;
+}
+
+bool ConjuntoDirecciones::eliminar(int x, Vecinos& v) {
+    if (total == 0) return false;
+    size_t i = hojaPara(x);
+    Hoja* h = hojas[i];
+    int pos = (int)(primeroNoMenor(h->claves, (size_t)h->n, x) - h->claves);
+    if (pos == h->n || h->claves[pos] != x) return false;
+
+    h->n--;
+    memmove(h->claves + pos, h->claves + pos + 1, (size_t)(h->n - pos) * sizeof(int));
+    vecinos(i, pos, v);
+    total--;
+
+    if (h->n == 0) {
+        delete h;
+        hojas.erase(hojas.begin() + (ptrdiff_t)i);
+        maximos.erase(maximos.begin() + (ptrdiff_t)i);
+        return true;
+    }
+    maximos[i] = h->claves[h->n - 1];
+    if (h->n < HOJA / 4) fundir(i);
+    return true;
+}
+
+void ConjuntoDirecciones::partir(size_t i) {
+    Hoja* h = hojas[i];
+    Hoja* nueva = new Hoja();
+    nueva->n = h->n / 2;
+    h->n -= nueva->n;
+    memcpy(nueva->claves, h->claves + h->n, (size_t)nueva->n * sizeof(int));
+    hojas.insert(hojas.begin() + (ptrdiff_t)i + 1, nueva);
+    maximos.insert(maximos.begin() + (ptrdiff_t)i + 1, nueva->claves[nueva->n - 1]);
+    maximos[i] = h->claves[h->n - 1];
+}
+
+void ConjuntoDirecciones::fundir(size_t i) {
+    // Con una vecina que deje la hoja resultante a lo sumo a 3/4
+    size_t destino;
+    if (i + 1 < hojas.size() && hojas[i]->n + hojas[i + 1]->n <= 3 * HOJA / 4) {
+        destino = i + 1;
+    } else if (i > 0 && hojas[i]->n + hojas[i - 1]->n <= 3 * HOJA / 4) {
+        destino = i - 1;
+    } else {
+        return;
+    }
+    Hoja* h = hojas[i];
+    Hoja* d = hojas[destino];
+    if (destino > i) {
+        memmove(d->claves + h->n, d->claves, (size_t)d->n * sizeof(int));
+        memcpy(d->claves, h->claves, (size_t)h->n * sizeof(int));
+    } else {
+        memcpy(d->claves + d->n, h->claves, (size_t)h->n * sizeof(int));
+        maximos[destino] = maximos[i];
+    }
+    d->n += h->n;
+    delete h;
+    hojas.erase(hojas.begin() + (ptrdiff_t)i);
+    maximos.erase(maximos.begin() + (ptrdiff_t)i);
+}
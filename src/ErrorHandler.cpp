@@ -0,0 +1,15 @@
+#include "ErrorHandler.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+void ErrorHandler::manejar(const exception& e) {
+    cerr << "\n[ERROR] " << e.what() << endl;
+    ofstream log("errors.log", ios::app);
+    if (log.is_open()) {
+        log << "[ERROR] " << e.what() << endl;
+        log.close();
+    }
+}
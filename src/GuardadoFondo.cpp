@@ -0,0 +1,149 @@
+#include "GuardadoFondo.h"
+
+#include <cerrno>
+#include <chrono>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "Metricas.h"
+
+using namespace std;
+
+GuardadoFondo::GuardadoFondo()
+    : activo(false), ultimoExito(true), ultimaDuracionMs(0.0), guardados(0) {}
+
+GuardadoFondo::~GuardadoFondo() {
+    esperar();
+}
+
+void GuardadoFondo::terminar(bool exito, const string& error, double ms) {
+    {
+        lock_guard<std::mutex> guarda(mutex);
+        ultimoExito = exito;
+        ultimoError = error;
+        ultimaDuracionMs = ms;
+        if (exito) guardados++;
+    }
+    activo.store(false, memory_order_release);
+}
+
+bool GuardadoFondo::iniciar(const function<void()>& rutina) {
+    if (activo.load(memory_order_acquire)) return false;
+    if (vigia.joinable()) vigia.join();
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+
+#ifdef _WIN32
+    activo.store(true, memory_order_release);
+    string error;
+    try {
+        rutina();
+    } catch (const exception& e) {
+        error = e.what();
+    }
+    terminar(error.empty(), error, chrono::duration<double, milli>(
+                                       chrono::steady_clock::now() - inicio).count());
+    return true;
+#else
+    // El hijo informa el mensaje de error (si lo hay) por una tubera.
+    // Con O_CLOEXEC un fork/exec de otro hilo no hereda el extremo de
+    // escritura, que dejara al viga esperando un EOF que no llega.
+    int tubo[2];
+#ifdef __linux__
+    int creada = pipe2(tubo, O_CLOEXEC);
+#else
+    int creada = pipe(tubo);
+    if (creada == 0) {
+        fcntl(tubo[0], F_SETFD, FD_CLOEXEC);
+        fcntl(tubo[1], F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    if (creada != 0) {
+        throw runtime_error("No se pudo crear la tubera del guardado");
+    }
+    pid_t pid;
+    {
+        SO_CRONOMETRO(PERSISTENCIA_PAUSA_FORK_NS);
+        pid = fork();
+    }
+    if (pid < 0) {
+        close(tubo[0]);
+        close(tubo[1]);
+        throw runtime_error("No se pudo crear el proceso de guardado");
+    }
+    if (pid == 0) {
+        // Hijo: copia congelada del estado. Termina con _exit para no
+        // ejecutar destructores globales ni vaciar bferes del padre.
+        close(tubo[0]);
+        int codigo = 0;
+        try {
+            rutina();
+        } catch (const exception& e) {
+            const char* msg = e.what();
+            size_t n = 0;
+            while (msg[n]) n++;
+            ssize_t escrito = write(tubo[1], msg, n);
+            (void)escrito;
+            codigo = 1;
+        } catch (...) {
+            codigo = 1;
+        }
+        _exit(codigo);
+    }
+
+    close(tubo[1]);
+    activo.store(true, memory_order_release);
+    SO_CONTAR(PERSISTENCIA_GUARDADOS_FONDO);
+    vigia = thread([this, pid, tubo, inicio]() {
+        string error;
+        char buf[256];
+        for (;;) {
+            ssize_t n = read(tubo[0], buf, sizeof(buf));
+            if (n > 0) {
+                error.append(buf, (size_t)n);
+            } else if (n == 0 || errno != EINTR) {
+                break;
+            }
+        }
+        close(tubo[0]);
+
+        int estado = 0;
+        while (waitpid(pid, &estado, 0) < 0 && errno == EINTR) {}
+        bool exito = WIFEXITED(estado) && WEXITSTATUS(estado) == 0;
+        if (!exito && error.empty()) error = "El proceso de guardado termin de forma anormal";
+        terminar(exito, error, chrono::duration<double, milli>(
+                                   chrono::steady_clock::now() - inicio).count());
+    });
+    return true;
+#endif
+}
+
+bool GuardadoFondo::esperar() {
+    if (vigia.joinable()) vigia.join();
+    return getUltimoExito();
+}
+
+bool GuardadoFondo::getUltimoExito() const {
+    lock_guard<std::mutex> guarda(mutex);
+    return ultimoExito;
+}
+
+string GuardadoFondo::getUltimoError() const {
+    lock_guard<std::mutex> guarda(mutex);
+    return ultimoError;
+}
+
+double GuardadoFondo::getUltimaDuracionMs() const {
+    lock_guard<std::mutex> guarda(mutex);
+    return ultimaDuracionMs;
+}
+
+int GuardadoFondo::getGuardados() const {
+    lock_guard<std::mutex> guarda(mutex);
+    return guardados;
+}
@@ -0,0 +1,370 @@
+#include "IndiceProcesos.h"
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+IndiceProcesos::IndiceProcesos() : raiz(new Hoja()), total(0), altura(1) {}
+
+IndiceProcesos::~IndiceProcesos() {
+    liberar(raiz);
+}
+
+void IndiceProcesos::liberar(Nodo* nodo) {
+    if (nodo->hoja) {
+        delete static_cast<Hoja*>(nodo);
+        return;
+    }
+    Interno* in = static_cast<Interno*>(nodo);
+    for (int i = 0; i <= in->n; i++) liberar(in->hijos[i]);
+    delete in;
+}
+
+size_t IndiceProcesos::tamNodo(const Nodo* nodo) {
+    if (nodo->hoja) return (size_t)nodo->n;
+    const Interno* in = static_cast<const Interno*>(nodo);
+    size_t suma = 0;
+    for (int i = 0; i <= in->n; i++) suma += in->cuentas[i];
+    return suma;
+}
+
+void IndiceProcesos::vaciar() {
+    liberar(raiz);
+    raiz = new Hoja();
+    total = 0;
+    altura = 1;
+}
+
+/* ---------------- Insercin ---------------- */
+
+bool IndiceProcesos::insertarEn(Nodo* nodo, NodoProcesso* proceso, int& claveSubida,
+                                Nodo*& hermano) {
+    int id = proceso->id;
+    if (nodo->hoja) {
+        Hoja* h = static_cast<Hoja*>(nodo);
+        int i = (int)(lower_bound(h->claves, h->claves + h->n, id) - h->claves);
+        if (i < h->n && h->claves[i] == id) return false;
+        for (int j = h->n; j > i; j--) {
+            h->claves[j] = h->claves[j - 1];
+            h->valores[j] = h->valores[j - 1];
+        }
+        h->claves[i] = id;
+        h->valores[i] = proceso;
+        h->n++;
+        if (h->n > ORDEN) {
+            // Mitad superior a una hoja nueva, enlazada a continuacin
+            Hoja* d = new Hoja();
+            int mitad = h->n / 2;
+            d->n = h->n - mitad;
+            copy(h->claves + mitad, h->claves + h->n, d->claves);
+            copy(h->valores + mitad, h->valores + h->n, d->valores);
+            h->n = mitad;
+            d->siguiente = h->siguiente;
+            h->siguiente = d;
+            claveSubida = d->claves[0];
+            hermano = d;
+        }
+        return true;
+    }
+
+    Interno* in = static_cast<Interno*>(nodo);
+    int i = (int)(upper_bound(in->claves, in->claves + in->n, id) - in->claves);
+    int clave;
+    Nodo* nuevo = NULL;
+    if (!insertarEn(in->hijos[i], proceso, clave, nuevo)) return false;
+    in->cuentas[i]++;
+    if (!nuevo) return true;
+
+    // El hijo se dividi: su mitad derecha entra como hijo i + 1
+    for (int j = in->n; j > i; j--) {
+        in->claves[j] = in->claves[j - 1];
+        in->hijos[j + 1] = in->hijos[j];
+        in->cuentas[j + 1] = in->cuentas[j];
+    }
+    size_t derecha = tamNodo(nuevo);
+    in->claves[i] = clave;
+    in->hijos[i + 1] = nuevo;
+    in->cuentas[i + 1] = derecha;
+    in->cuentas[i] -= derecha;
+    in->n++;
+    if (in->n > ORDEN) {
+        // La clave del medio sube; las de su derecha pasan al hermano
+        Interno* d = new Interno();
+        int mitad = in->n / 2;
+        claveSubida = in->claves[mitad];
+        d->n = in->n - mitad - 1;
+        copy(in->claves + mitad + 1, in->claves + in->n, d->claves);
+        copy(in->hijos + mitad + 1, in->hijos + in->n + 1, d->hijos);
+        copy(in->cuentas + mitad + 1, in->cuentas + in->n + 1, d->cuentas);
+        in->n = mitad;
+        hermano = d;
+    }
+    return true;
+}
+
+bool IndiceProcesos::insertar(NodoProcesso* proceso) {
+    int clave;
+    Nodo* hermano = NULL;
+    if (!insertarEn(raiz, proceso, clave, hermano)) return false;
+    total++;
+    if (hermano) {
+        Interno* r = new Interno();
+        r->n = 1;
+        r->claves[0] = clave;
+        r->hijos[0] = raiz;
+        r->hijos[1] = hermano;
+        r->cuentas[1] = tamNodo(hermano);
+        r->cuentas[0] = total - r->cuentas[1];
+        raiz = r;
+        altura++;
+    }
+    return true;
+}
+
+/* ---------------- Eliminacin ---------------- */
+
+NodoProcesso* IndiceProcesos::eliminarEn(Nodo* nodo, int id) {
+    if (nodo->hoja) {
+        Hoja* h = static_cast<Hoja*>(nodo);
+        int i = (int)(lower_bound(h->claves, h->claves + h->n, id) - h->claves);
+        if (i == h->n || h->claves[i] != id) return NULL;
+        NodoProcesso* proceso = h->valores[i];
+        for (int j = i + 1; j < h->n; j++) {
+            h->claves[j - 1] = h->claves[j];
+            h->valores[j - 1] = h->valores[j];
+        }
+        h->n--;
+        return proceso;
+    }
+
+    Interno* in = static_cast<Interno*>(nodo);
+    int i = (int)(upper_bound(in->claves, in->claves + in->n, id) - in->claves);
+    NodoProcesso* proceso = eliminarEn(in->hijos[i], id);
+    if (!proceso) return NULL;
+    in->cuentas[i]--;
+    if (in->hijos[i]->n < MINIMO) rebalancear(in, i);
+    return proceso;
+}
+
+void IndiceProcesos::rebalancear(Interno* padre, int i) {
+    Nodo* hijo = padre->hijos[i];
+
+    if (i > 0 && padre->hijos[i - 1]->n > MINIMO) {
+        // Prstamo del hermano izquierdo: su ltima entrada pasa al frente
+        Nodo* izq = padre->hijos[i - 1];
+        size_t movidos;
+        if (hijo->hoja) {
+            Hoja* h = static_cast<Hoja*>(hijo);
+            Hoja* hi = static_cast<Hoja*>(izq);
+            copy_backward(h->claves, h->claves + h->n, h->claves + h->n + 1);
+            copy_backward(h->valores, h->valores + h->n, h->valores + h->n + 1);
+            h->claves[0] = hi->claves[hi->n - 1];
+            h->valores[0] = hi->valores[hi->n - 1];
+            padre->claves[i - 1] = h->claves[0];
+            movidos = 1;
+        } else {
+            Interno* h = static_cast<Interno*>(hijo);
+            Interno* hi = static_cast<Interno*>(izq);
+            copy_backward(h->claves, h->claves + h->n, h->claves + h->n + 1);
+            copy_backward(h->hijos, h->hijos + h->n + 1, h->hijos + h->n + 2);
+            copy_backward(h->cuentas, h->cuentas + h->n + 1, h->cuentas + h->n + 2);
+            h->claves[0] = padre->claves[i - 1];
+            h->hijos[0] = hi->hijos[hi->n];
+            h->cuentas[0] = hi->cuentas[hi->n];
+            padre->claves[i - 1] = hi->claves[hi->n - 1];
+            movidos = h->cuentas[0];
+        }
+        izq->n--;
+        hijo->n++;
+        padre->cuentas[i - 1] -= movidos;
+        padre->cuentas[i] += movidos;
+        return;
+    }
+
+    if (i < padre->n && padre->hijos[i + 1]->n > MINIMO) {
+        // Prstamo del hermano derecho: su primera entrada pasa al final
+        Nodo* der = padre->hijos[i + 1];
+        size_t movidos;
+        if (hijo->hoja) {
+            Hoja* h = static_cast<Hoja*>(hijo);
+            Hoja* hd = static_cast<Hoja*>(der);
+            h->claves[h->n] = hd->claves[0];
+            h->valores[h->n] = hd->valores[0];
+            copy(hd->claves + 1, hd->claves + hd->n, hd->claves);
+            copy(hd->valores + 1, hd->valores + hd->n, hd->valores);
+            padre->claves[i] = hd->claves[0];
+            movidos = 1;
+        } else {
+            Interno* h = static_cast<Interno*>(hijo);
+            Interno* hd = static_cast<Interno*>(der);
+            h->claves[h->n] = padre->claves[i];
+            h->hijos[h->n + 1] = hd->hijos[0];
+            h->cuentas[h->n + 1] = hd->cuentas[0];
+            padre->claves[i] = hd->claves[0];
+            movidos = hd->cuentas[0];
+            copy(hd->claves + 1, hd->claves + hd->n, hd->claves);
+            copy(hd->hijos + 1, hd->hijos + hd->n + 1, hd->hijos);
+            copy(hd->cuentas + 1, hd->cuentas + hd->n + 1, hd->cuentas);
+        }
+        der->n--;
+        hijo->n++;
+        padre->cuentas[i] += movidos;
+        padre->cuentas[i + 1] -= movidos;
+        return;
+    }
+
+    // Ningn hermano puede prestar: se fusiona con uno (caben en un nodo)
+    int j = i > 0 ? i - 1 : i;
+    Nodo* a = padre->hijos[j];
+    Nodo* b = padre->hijos[j + 1];
+    if (a->hoja) {
+        Hoja* ha = static_cast<Hoja*>(a);
+        Hoja* hb = static_cast<Hoja*>(b);
+        copy(hb->claves, hb->claves + hb->n, ha->claves + ha->n);
+        copy(hb->valores, hb->valores + hb->n, ha->valores + ha->n);
+        ha->n += hb->n;
+        ha->siguiente = hb->siguiente;
+        delete hb;
+    } else {
+        Interno* ia = static_cast<Interno*>(a);
+        Interno* ib = static_cast<Interno*>(b);
+        ia->claves[ia->n] = padre->claves[j];
+        copy(ib->claves, ib->claves + ib->n, ia->claves + ia->n + 1);
+        copy(ib->hijos, ib->hijos + ib->n + 1, ia->hijos + ia->n + 1);
+        copy(ib->cuentas, ib->cuentas + ib->n + 1, ia->cuentas + ia->n + 1);
+        ia->n += ib->n + 1;
+        delete ib;
+    }
+    padre->cuentas[j] += padre->cuentas[j + 1];
+    for (int k = j + 1; k < padre->n; k++) {
+        padre->claves[k - 1] = padre->claves[k];
+        padre->hijos[k] = padre->hijos[k + 1];
+        padre->cuentas[k] = padre->cuentas[k + 1];
+    }
+    padre->n--;
+}
+
+NodoProcesso* IndiceProcesos::eliminar(int id) {
+    NodoProcesso* proceso = eliminarEn(raiz, id);
+    if (!proceso) return NULL;
+    total--;
+    if (!raiz->hoja && raiz->n == 0) {
+        // La raz qued con un solo hijo: el rbol baja un nivel
+        Interno* vieja = static_cast<Interno*>(raiz);
+        raiz = vieja->hijos[0];
+        delete vieja;
+        altura--;
+    }
+    return proceso;
+}
+
+/* ---------------- Rango y seleccin ---------------- */
+
+size_t IndiceProcesos::posicion(int id) const {
+    size_t antes = 0;
+    const Nodo* nodo = raiz;
+    while (!nodo->hoja) {
+        const Interno* in = static_cast<const Interno*>(nodo);
+        int i = (int)(upper_bound(in->claves, in->claves + in->n, id) - in->claves);
+        for (int j = 0; j < i; j++) antes += in->cuentas[j];
+        nodo = in->hijos[i];
+    }
+    return antes + (size_t)(lower_bound(nodo->claves, nodo->claves + nodo->n, id) - nodo->claves);
+}
+
+NodoProcesso* IndiceProcesos::seleccionar(size_t k) const {
+    if (k >= total) return NULL;
+    const Nodo* nodo = raiz;
+    while (!nodo->hoja) {
+        const Interno* in = static_cast<const Interno*>(nodo);
+        int i = 0;
+        while (k >= in->cuentas[i]) k -= in->cuentas[i++];
+        nodo = in->hijos[i];
+    }
+    return static_cast<const Hoja*>(nodo)->valores[k];
+}
+
+size_t IndiceProcesos::contarRango(int desde, int hasta) const {
+    if (desde > hasta) return 0;
+    size_t hastaIncluido = hasta == INT_MAX ? total : posicion(hasta + 1);
+    return hastaIncluido - posicion(desde);
+}
+
+/* ---------------- Construccin masiva ---------------- */
+
+void IndiceProcesos::construir(NodoProcesso* cabeza) {
+    vector<pair<int, NodoProcesso*> > pares;
+    for (NodoProcesso* p = cabeza; p; p = p->siguiente) pares.push_back(make_pair(p->id, p));
+    // Estable: entre IDs repetidos queda primero el de la lista
+    stable_sort(pares.begin(), pares.end(),
+                [](const pair<int, NodoProcesso*>& a, const pair<int, NodoProcesso*>& b) {
+                    return a.first < b.first;
+                });
+    pares.erase(unique(pares.begin(), pares.end(),
+                       [](const pair<int, NodoProcesso*>& a, const pair<int, NodoProcesso*>& b) {
+                           return a.first == b.first;
+                       }),
+                pares.end());
+
+    vaciar();
+    size_t n = pares.size();
+    if (n == 0) return;
+    liberar(raiz);
+
+    // Hojas: reparto parejo, as ninguna queda por debajo de MINIMO
+    vector<Nodo*> nivel;
+    vector<int> minimos;
+    vector<size_t> cuentas;
+    size_t numHojas = (n + ORDEN - 1) / ORDEN;
+    Hoja* anterior = NULL;
+    for (size_t k = 0; k < numHojas; k++) {
+        size_t ini = n * k / numHojas;
+        size_t fin = n * (k + 1) / numHojas;
+        Hoja* h = new Hoja();
+        for (size_t j = ini; j < fin; j++) {
+            h->claves[j - ini] = pares[j].first;
+            h->valores[j - ini] = pares[j].second;
+        }
+        h->n = (int)(fin - ini);
+        if (anterior) anterior->siguiente = h;
+        anterior = h;
+        nivel.push_back(h);
+        minimos.push_back(h->claves[0]);
+        cuentas.push_back(fin - ini);
+    }
+
+    // Niveles internos, de a lo sumo ORDEN + 1 hijos por nodo
+    altura = 1;
+    while (nivel.size() > 1) {
+        size_t m = nivel.size();
+        size_t grupos = (m + ORDEN) / (ORDEN + 1);
+        vector<Nodo*> arriba;
+        vector<int> minimosArriba;
+        vector<size_t> cuentasArriba;
+        for (size_t g = 0; g < grupos; g++) {
+            size_t ini = m * g / grupos;
+            size_t fin = m * (g + 1) / grupos;
+            Interno* in = new Interno();
+            size_t suma = 0;
+            for (size_t j = ini; j < fin; j++) {
+                in->hijos[j - ini] = nivel[j];
+                in->cuentas[j - ini] = cuentas[j];
+                if (j > ini) in->claves[j - ini - 1] = minimos[j];
+                suma += cuentas[j];
+            }
+            in->n = (int)(fin - ini - 1);
+            arriba.push_back(in);
+            minimosArriba.push_back(minimos[ini]);
+            cuentasArriba.push_back(suma);
+        }
+        nivel.swap(arriba);
+        minimos.swap(minimosArriba);
+        cuentas.swap(cuentasArriba);
+        altura++;
+    }
+    raiz = nivel[0];
+    total = n;
+}
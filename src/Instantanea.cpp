@@ -0,0 +1,452 @@
+#include "Instantanea.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "ArchivoProyectado.h"
+#include "Metricas.h"
+#include "Simulador.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+namespace {
+
+const char MAGIA[8] = { 'S', 'O', 'S', 'N', 'A', 'P', '\0', '\0' };
+const uint64_t SIN_DESPERTAR = 0;
+
+struct CabeceraInstantanea {
+    char magia[8];
+    uint32_t version;
+    uint32_t numProcesos;
+    uint32_t numCola;
+    uint32_t numBloques;
+    uint32_t bytesNombres;
+    int32_t capacidadMemoria;
+    int32_t periodoEnvejecimiento;
+    int32_t politica;        // PoliticaPlanificacion de la cola
+    uint64_t ahora;          // Tiempo simulado (rueda de temporizadores)
+    uint64_t relojCola;      // Reloj de envejecimiento de la cola
+    uint64_t llegadas;       // Contador de llegadas de la cola
+    uint64_t esperaMaxima;
+    uint64_t trCompletados;  // EstadisticasTiempoReal del simulador
+    uint64_t trPerdidos;
+    uint64_t trTardanzaMaxima;
+    uint64_t trTardanzaTotal;
+    uint32_t admisionActiva;
+    uint32_t numArbol;       // Procesos en el rbol (sin init)
+    uint64_t suma;           // Suma de verificacin de todo lo que sigue
+};
+
+struct RegistroProceso {
+    int32_t id;
+    int32_t prioridad;
+    int32_t estado;
+    uint32_t nombreInicio;   // Desplazamiento en la seccin de nombres
+    uint32_t nombreLongitud;
+    uint32_t banderasTR;     // TR_ESPORADICA | TR_ADMITIDA
+    uint64_t despertar;      // Tick de despertar, o SIN_DESPERTAR
+    uint64_t periodo;        // TareaTiempoReal (periodo 0 = proceso comn)
+    uint64_t plazo;
+    uint64_t costo;
+    uint64_t activacion;
+    uint64_t plazoAbsoluto;
+    uint64_t restante;
+    uint64_t trabajos;
+    uint64_t perdidos;
+};
+
+const uint32_t TR_ESPORADICA = 1;
+const uint32_t TR_ADMITIDA = 2;
+
+struct RegistroCola {        // En orden de montculo
+    int32_t id;
+    int32_t prioridad;
+    int64_t clave;
+    uint64_t encolado;
+    uint64_t orden;
+};
+
+struct RegistroBloque {      // Desde el fondo de la pila hasta el tope
+    int32_t direccion;
+    int32_t pid;
+};
+
+struct RegistroArbol {       // En preorden: cada padre antes que sus hijos
+    int32_t pid;
+    int32_t padre;           // ArbolProcesos::INIT si cuelga de la raz
+};
+
+/**
+ * Suma de verificacin por palabras de 64 bits (FNV-1a por palabra):
+ * detecta archivos truncados o daados sin costar ms que la lectura.
+ */
+uint64_t sumar(uint64_t h, const void* datos, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(datos);
+    while (n >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ w) * 0x100000001B3ull;
+        p += 8;
+        n -= 8;
+    }
+    while (n--) h = (h ^ *p++) * 0x100000001B3ull;
+    return h;
+}
+
+const uint64_t SUMA_INICIAL = 0xCBF29CE484222325ull;
+
+/**
+ * Escribe todos los fragmentos en orden; en POSIX con writev, reintentando
+ * solo si el ncleo acepta una escritura parcial.
+ */
+void escribirTodo(const string& archivo, vector<pair<const void*, size_t> >& partes) {
+#ifdef _WIN32
+    ofstream out(archivo.c_str(), ios::binary | ios::trunc);
+    if (!out) throw runtime_error("No se pudo crear " + archivo);
+    for (size_t i = 0; i < partes.size(); i++) {
+        out.write(static_cast<const char*>(partes[i].first), (streamsize)partes[i].second);
+    }
+    if (!out) throw runtime_error("Error al escribir " + archivo);
+#else
+    int fd = open(archivo.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw runtime_error("No se pudo crear " + archivo);
+
+    vector<struct iovec> iov;
+    for (size_t i = 0; i < partes.size(); i++) {
+        if (partes[i].second == 0) continue;
+        struct iovec v;
+        v.iov_base = const_cast<void*>(partes[i].first);
+        v.iov_len = partes[i].second;
+        iov.push_back(v);
+    }
+    size_t i = 0;
+    while (i < iov.size()) {
+        int cuantos = (int)min(iov.size() - i, (size_t)IOV_MAX);
+        ssize_t n = writev(fd, &iov[i], cuantos);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            close(fd);
+            throw runtime_error("Error al escribir " + archivo);
+        }
+        // Avanza sobre lo ya escrito
+        size_t resto = (size_t)n;
+        while (i < iov.size() && resto >= iov[i].iov_len) {
+            resto -= iov[i].iov_len;
+            i++;
+        }
+        if (resto > 0) {
+            iov[i].iov_base = static_cast<char*>(iov[i].iov_base) + resto;
+            iov[i].iov_len -= resto;
+        }
+    }
+    if (close(fd) != 0) throw runtime_error("Error al cerrar " + archivo);
+#endif
+}
+
+} // namespace
+
+size_t Instantanea::guardar(const Simulador& sim, const string& archivo) {
+    CabeceraInstantanea cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magia, MAGIA, sizeof(MAGIA));
+    cab.version = VERSION;
+
+    vector<RegistroProceso> procesos;
+    string nombres;
+    for (NodoProcesso* p = sim.procesos.primero(); p; p = p->siguiente) {
+        RegistroProceso r;
+        memset(&r, 0, sizeof(r));
+        r.id = p->id;
+        r.prioridad = p->prioridad;
+        r.estado = (int32_t)p->estado;
+        r.nombreInicio = (uint32_t)nombres.size();
+        r.nombreLongitud = (uint32_t)p->nombre.str().size();
+        r.despertar = p->despertar.programado() ? p->despertar.expira : SIN_DESPERTAR;
+        const TareaTiempoReal& t = p->tiempoReal;
+        r.banderasTR = (t.esporadica ? TR_ESPORADICA : 0) | (t.admitida ? TR_ADMITIDA : 0);
+        r.periodo = t.periodo;
+        r.plazo = t.plazo;
+        r.costo = t.costo;
+        r.activacion = t.activacion;
+        r.plazoAbsoluto = t.plazoAbsoluto;
+        r.restante = t.restante;
+        r.trabajos = t.trabajos;
+        r.perdidos = t.perdidos;
+        nombres += p->nombre.str();
+        procesos.push_back(r);
+    }
+
+    const ColaPrioridad& cola = sim.planificador;
+    vector<RegistroCola> entradas(cola.monticulo.size());
+    for (size_t i = 0; i < cola.monticulo.size(); i++) {
+        const ColaPrioridad::EntradaCola& e = cola.monticulo[i];
+        entradas[i].id = e.proceso->id;
+        entradas[i].prioridad = e.prioridad;
+        entradas[i].clave = e.clave;
+        entradas[i].encolado = e.encolado;
+        entradas[i].orden = e.orden;
+    }
+
+    const PilaMemoria& memoria = sim.memoria;
+    vector<RegistroBloque> bloques(memoria.contador);
+    size_t k = bloques.size();
+    for (PilaMemoria::NodoMemoria* n = memoria.tope; n; n = n->abajo) {
+        k--;
+        bloques[k].direccion = n->direccion;
+        bloques[k].pid = n->pid;
+    }
+
+    const ArbolProcesos& arbol = sim.arbol;
+    vector<RegistroArbol> ramas;
+    ramas.reserve(arbol.tamano());
+    arbol.recorrer(ArbolProcesos::INIT, [&](int pid, int profundidad) {
+        if (profundidad == 0) return;
+        RegistroArbol r = { pid, arbol.padreDe(pid) };
+        ramas.push_back(r);
+    });
+
+    cab.numProcesos = (uint32_t)procesos.size();
+    cab.numCola = (uint32_t)entradas.size();
+    cab.numBloques = (uint32_t)bloques.size();
+    cab.bytesNombres = (uint32_t)nombres.size();
+    cab.capacidadMemoria = memoria.capacidad;
+    cab.periodoEnvejecimiento = cola.periodo;
+    cab.politica = (int32_t)cola.politica;
+    cab.ahora = sim.temporizadores.getAhora();
+    cab.relojCola = cola.reloj;
+    cab.llegadas = cola.llegadas;
+    cab.esperaMaxima = cola.esperaMaxima;
+    cab.trCompletados = sim.plazos.completados;
+    cab.trPerdidos = sim.plazos.perdidos;
+    cab.trTardanzaMaxima = sim.plazos.tardanzaMaxima;
+    cab.trTardanzaTotal = sim.plazos.tardanzaTotal;
+    cab.admisionActiva = sim.procesos.admision.esActiva() ? 1 : 0;
+    cab.numArbol = (uint32_t)ramas.size();
+
+    vector<pair<const void*, size_t> > partes;
+    partes.push_back(make_pair((const void*)&cab, sizeof(cab)));
+    partes.push_back(make_pair((const void*)procesos.data(), procesos.size() * sizeof(RegistroProceso)));
+    partes.push_back(make_pair((const void*)entradas.data(), entradas.size() * sizeof(RegistroCola)));
+    partes.push_back(make_pair((const void*)bloques.data(), bloques.size() * sizeof(RegistroBloque)));
+    partes.push_back(make_pair((const void*)ramas.data(), ramas.size() * sizeof(RegistroArbol)));
+    partes.push_back(make_pair((const void*)nombres.data(), nombres.size()));
+
+    size_t total = 0;
+    uint64_t suma = SUMA_INICIAL;
+    for (size_t i = 0; i < partes.size(); i++) {
+        if (i > 0) suma = sumar(suma, partes[i].first, partes[i].second);
+        total += partes[i].second;
+    }
+    cab.suma = suma;
+
+    string temporal = archivo + ".tmp";
+    escribirTodo(temporal, partes);
+    if (rename(temporal.c_str(), archivo.c_str()) != 0) {
+        remove(temporal.c_str());
+        throw runtime_error("No se pudo reemplazar " + archivo);
+    }
+    return total;
+}
+
+void Instantanea::restaurar(Simulador& sim, const string& archivo) {
+    ArchivoProyectado mapa(archivo);
+
+    /* ---- Validacin completa antes de modificar nada ---- */
+    if (mapa.tam() < sizeof(CabeceraInstantanea)) {
+        throw runtime_error("Instantnea truncada: " + archivo);
+    }
+    CabeceraInstantanea cab;
+    memcpy(&cab, mapa.datos(), sizeof(cab));
+    if (memcmp(cab.magia, MAGIA, sizeof(MAGIA)) != 0) {
+        throw runtime_error(archivo + " no es una instantnea del simulador");
+    }
+    if (cab.version != VERSION) {
+        throw runtime_error("Versin de instantnea no soportada: " + to_string_alt(cab.version));
+    }
+    size_t esperado = sizeof(cab) + (size_t)cab.numProcesos * sizeof(RegistroProceso) +
+                      (size_t)cab.numCola * sizeof(RegistroCola) +
+                      (size_t)cab.numBloques * sizeof(RegistroBloque) +
+                      (size_t)cab.numArbol * sizeof(RegistroArbol) + cab.bytesNombres;
+    if (mapa.tam() != esperado) {
+        throw runtime_error("Instantnea de tamao inesperado: " + archivo);
+    }
+    if (sumar(SUMA_INICIAL, mapa.datos() + sizeof(cab), mapa.tam() - sizeof(cab)) != cab.suma) {
+        throw runtime_error("Instantnea daada (suma de verificacin): " + archivo);
+    }
+    if (cab.numBloques > (uint32_t)max(cab.capacidadMemoria, 0) || cab.periodoEnvejecimiento < 0 ||
+        cab.politica < PLAN_PRIORIDAD || cab.politica > PLAN_RATE_MONOTONIC) {
+        throw runtime_error("Instantnea inconsistente: " + archivo);
+    }
+
+    // Las secciones estn alineadas a 8 bytes: se leen en el sitio
+    const RegistroProceso* regProcesos =
+        reinterpret_cast<const RegistroProceso*>(mapa.datos() + sizeof(cab));
+    const RegistroCola* regCola =
+        reinterpret_cast<const RegistroCola*>(regProcesos + cab.numProcesos);
+    const RegistroBloque* regBloques =
+        reinterpret_cast<const RegistroBloque*>(regCola + cab.numCola);
+    const RegistroArbol* regArbol =
+        reinterpret_cast<const RegistroArbol*>(regBloques + cab.numBloques);
+    const char* nombres = reinterpret_cast<const char*>(regArbol + cab.numArbol);
+
+    unordered_map<int, uint32_t> indice;
+    indice.reserve(cab.numProcesos);
+    int enEjecucion = 0;
+    for (uint32_t i = 0; i < cab.numProcesos; i++) {
+        const RegistroProceso& r = regProcesos[i];
+        if (!indice.insert(make_pair((int)r.id, i)).second ||
+            r.estado < NUEVO || r.estado > TERMINADO ||
+            (uint64_t)r.nombreInicio + r.nombreLongitud > cab.bytesNombres ||
+            (r.periodo != 0 && (r.periodo > AdmisionTiempoReal::PERIODO_MAXIMO || r.costo == 0 ||
+                                r.costo > r.plazo || r.plazo > r.periodo || r.restante > r.costo))) {
+            throw runtime_error("Registro de proceso invlido en " + archivo);
+        }
+        if (r.estado == EJECUCION) enEjecucion++;
+    }
+    if (enEjecucion > 1) {
+        throw runtime_error("Instantnea con ms de un proceso en ejecucin");
+    }
+    // Cada entrada de la cola es un proceso LISTO distinto (el que est
+    // en ejecucin no puede estar encolado), y el arreglo respeta el orden
+    // del montculo: ningn hijo va antes que su padre
+    unordered_map<int, uint32_t> encolados;
+    encolados.reserve(cab.numCola);
+    for (uint32_t i = 0; i < cab.numCola; i++) {
+        const RegistroCola& r = regCola[i];
+        unordered_map<int, uint32_t>::const_iterator it = indice.find(r.id);
+        if (it != indice.end() && regProcesos[it->second].estado == EJECUCION) {
+            throw runtime_error("Proceso " + to_string_alt(r.id) +
+                                " en ejecucin y encolado en " + archivo);
+        }
+        if (it == indice.end() || regProcesos[it->second].estado != LISTO) {
+            throw runtime_error("Cola de listos inconsistente en " + archivo);
+        }
+        if (!encolados.insert(make_pair((int)r.id, i)).second) {
+            throw runtime_error("Proceso " + to_string_alt(r.id) +
+                                " encolado dos veces en " + archivo);
+        }
+        if (i > 0) {
+            const RegistroCola& p = regCola[(i - 1) / 2];
+            ColaPrioridad::EntradaCola hijo = { NULL, r.prioridad, r.clave, r.encolado, r.orden };
+            ColaPrioridad::EntradaCola padre = { NULL, p.prioridad, p.clave, p.encolado, p.orden };
+            if (ColaPrioridad::antes(hijo, padre)) {
+                throw runtime_error("Cola de listos fuera de orden de montculo en " + archivo);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < cab.numBloques; i++) {
+        if (regBloques[i].pid != PilaMemoria::SIN_DUENO && !indice.count(regBloques[i].pid)) {
+            throw runtime_error("Bloque de memoria con dueo desconocido en " + archivo);
+        }
+    }
+    // Cada proceso del rbol est en la tabla y una sola vez, y su padre
+    // es init o un proceso que ya apareci (preorden)
+    unordered_map<int, uint32_t> enArbol;
+    enArbol.reserve(cab.numArbol);
+    for (uint32_t i = 0; i < cab.numArbol; i++) {
+        const RegistroArbol& r = regArbol[i];
+        if (!indice.count(r.pid) || (r.padre != ArbolProcesos::INIT && !enArbol.count(r.padre)) ||
+            !enArbol.insert(make_pair((int)r.pid, i)).second) {
+            throw runtime_error("rbol de procesos inconsistente en " + archivo);
+        }
+    }
+
+    /* ---- Reconstruccin directa ---- */
+    sim.vaciar();
+
+    vector<NodoProcesso*> nodos(cab.numProcesos);
+    NodoProcesso* cabeza = NULL;
+    NodoProcesso* ultimo = NULL;
+    for (uint32_t i = 0; i < cab.numProcesos; i++) {
+        const RegistroProceso& r = regProcesos[i];
+        NombreProceso nombre(PoolNombres::internar(string_view(nombres + r.nombreInicio,
+                                                               r.nombreLongitud)));
+        NodoProcesso* p = new NodoProcesso(r.id, nombre, r.prioridad);
+        p->estado = (EstadoProceso)r.estado;
+        if (r.periodo != 0) {
+            TareaTiempoReal& t = p->tiempoReal;
+            t = TareaTiempoReal(r.periodo, r.costo, r.plazo, (r.banderasTR & TR_ESPORADICA) != 0);
+            t.admitida = (r.banderasTR & TR_ADMITIDA) != 0;
+            t.activacion = r.activacion;
+            t.plazoAbsoluto = r.plazoAbsoluto;
+            t.restante = r.restante;
+            t.trabajos = r.trabajos;
+            t.perdidos = r.perdidos;
+            if (t.admitida) sim.procesos.admision.contar(t);
+        }
+        if (ultimo) ultimo->siguiente = p; else cabeza = p;
+        ultimo = p;
+        nodos[i] = p;
+    }
+    sim.procesos.cabeza = cabeza;
+    sim.procesos.ultimo = ultimo;
+    sim.procesos.indice.construir(cabeza);
+    SO_MEDIDOR(LISTA_PROCESOS, cab.numProcesos);
+
+    ColaPrioridad& cola = sim.planificador;
+    cola.monticulo.resize(cab.numCola);
+    cola.posiciones.reserve(cab.numCola);
+    for (uint32_t i = 0; i < cab.numCola; i++) {
+        ColaPrioridad::EntradaCola& e = cola.monticulo[i];
+        e.proceso = nodos[indice[regCola[i].id]];
+        e.prioridad = regCola[i].prioridad;
+        e.clave = regCola[i].clave;
+        e.encolado = regCola[i].encolado;
+        e.orden = regCola[i].orden;
+        cola.posiciones[e.proceso->id] = i;
+    }
+    cola.reloj = cab.relojCola;
+    cola.llegadas = cab.llegadas;
+    cola.periodo = cab.periodoEnvejecimiento;
+    cola.politica = (PoliticaPlanificacion)cab.politica;
+    sim.procesos.admision.setPolitica(cola.politica);
+    sim.procesos.admision.setActiva(cab.admisionActiva != 0);
+    cola.esperaMaxima = cab.esperaMaxima;
+    SO_MEDIDOR(COLA_PROFUNDIDAD, cab.numCola);
+
+    PilaMemoria& memoria = sim.memoria;
+    memoria.capacidad = cab.capacidadMemoria;
+    for (uint32_t i = 0; i < cab.numBloques; i++) {
+        memoria.apilar(regBloques[i].direccion, regBloques[i].pid);
+    }
+    SO_MEDIDOR(MEMORIA_OCUPACION, cab.numBloques);
+
+    for (uint32_t i = 0; i < cab.numArbol; i++) sim.arbol.agregar(regArbol[i].pid, regArbol[i].padre);
+
+    // El contenido cambi por debajo de la traza: cada estructura se
+    // vuelve a anunciar en su prxima operacin
+    sim.procesos.epocaTraza = 0;
+    cola.epocaTraza = 0;
+    memoria.epocaTraza = 0;
+
+    sim.temporizadores.reiniciar(cab.ahora);
+    sim.inicioEjecucion = cab.ahora;
+    sim.plazos.completados = cab.trCompletados;
+    sim.plazos.perdidos = cab.trPerdidos;
+    sim.plazos.tardanzaMaxima = cab.trTardanzaMaxima;
+    sim.plazos.tardanzaTotal = cab.trTardanzaTotal;
+    for (uint32_t i = 0; i < cab.numProcesos; i++) {
+        NodoProcesso* p = nodos[i];
+        if (p->estado == EJECUCION) sim.enEjecucion = p;
+        if (p->estado == BLOQUEADO) {
+            sim.bloqueados++;
+            if (regProcesos[i].despertar != SIN_DESPERTAR) {
+                sim.temporizadores.programar(&p->despertar, regProcesos[i].despertar);
+            }
+        }
+    }
+    SO_MEDIDOR(PROCESOS_BLOQUEADOS, sim.bloqueados);
+}
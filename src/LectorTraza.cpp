@@ -0,0 +1,141 @@
+#include "LectorTraza.h"
+
+#include <stdexcept>
+
+#include "MemoriaVirtual.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+LectorTraza::LectorTraza(const string& ruta, size_t tamBufer)
+    : archivo(NULL), bufer(tamBufer ? tamBufer : 4096), pos(0), fin(0), eof(false), linea(0) {
+    if (ruta == "-") {
+        archivo = stdin;
+    } else {
+        archivo = fopen(ruta.c_str(), "rb");
+    }
+    if (!archivo) {
+        throw runtime_error("No se pudo abrir la traza " + ruta);
+    }
+}
+
+LectorTraza::~LectorTraza() {
+    if (archivo && archivo != stdin) fclose(archivo);
+}
+
+bool LectorTraza::rellenar() {
+    if (eof) return false;
+    fin = fread(&bufer[0], 1, bufer.size(), archivo);
+    pos = 0;
+    if (fin == 0) {
+        eof = true;
+        return false;
+    }
+    return true;
+}
+
+int LectorTraza::caracter() {
+    if (pos == fin && !rellenar()) return EOF;
+    return (unsigned char)bufer[pos++];
+}
+
+int LectorTraza::mirar() {
+    if (pos == fin && !rellenar()) return EOF;
+    return (unsigned char)bufer[pos];
+}
+
+bool LectorTraza::siguiente(AccesoMemoria& acceso) {
+    for (;;) {
+        int c = caracter();
+        if (c == EOF) return false;
+        linea++;
+
+        // Salta espacios iniciales; ignora lneas vacas y comentarios
+        while (c == ' ' || c == '\t') c = caracter();
+        if (c == '\n' || c == '\r' || c == '#') {
+            while (c != '\n' && c != EOF) c = caracter();
+            continue;
+        }
+
+        // pid decimal
+        if (c < '0' || c > '9') {
+            throw runtime_error("Traza invlida en lnea " + to_string_alt(linea));
+        }
+        long pid = 0;
+        while (c >= '0' && c <= '9') {
+            pid = pid * 10 + (c - '0');
+            c = caracter();
+        }
+        while (c == ' ' || c == '\t' || c == ',') c = caracter();
+
+        // Direccin decimal o hexadecimal (0x...)
+        uint64_t dir = 0;
+        bool hex = false;
+        if (c == '0' && (mirar() == 'x' || mirar() == 'X')) {
+            caracter();
+            c = caracter();
+            hex = true;
+        }
+        bool digitos = false;
+        for (;; c = caracter()) {
+            int d;
+            if (c >= '0' && c <= '9') d = c - '0';
+            else if (hex && c >= 'a' && c <= 'f') d = c - 'a' + 10;
+            else if (hex && c >= 'A' && c <= 'F') d = c - 'A' + 10;
+            else break;
+            dir = hex ? (dir << 4) | (uint64_t)d : dir * 10 + (uint64_t)d;
+            digitos = true;
+        }
+        if (!digitos) {
+            throw runtime_error("Direccin invlida en lnea " + to_string_alt(linea));
+        }
+        while (c == ' ' || c == '\t' || c == ',') c = caracter();
+
+        // Tipo de acceso opcional
+        bool escritura = false;
+        if (c == 'W' || c == 'w') {
+            escritura = true;
+            c = caracter();
+        } else if (c == 'R' || c == 'r') {
+            c = caracter();
+        }
+        while (c != '\n' && c != EOF) c = caracter();
+
+        acceso.pid = (int)pid;
+        acceso.direccion = (uint32_t)dir;
+        acceso.escritura = escritura;
+        return true;
+    }
+}
+
+void generarTraza(const string& ruta, uint64_t accesos, int procesos,
+                  uint32_t paginasTrabajo, uint32_t semilla) {
+    FILE* f = fopen(ruta.c_str(), "wb");
+    if (!f) {
+        throw runtime_error("No se pudo abrir " + ruta + " para escritura");
+    }
+    if (procesos < 1) procesos = 1;
+    if (paginasTrabajo < 1) paginasTrabajo = 1;
+
+    // xorshift32: reproducible y sin dependencias
+    uint32_t x = semilla ? semilla : 1;
+    vector<uint32_t> base(procesos, 0);
+    for (int p = 0; p < procesos; p++) base[p] = (uint32_t)p * 4096;
+
+    for (uint64_t i = 0; i < accesos; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        int p = (int)(x % (uint32_t)procesos);
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        uint32_t pagina;
+        if ((x & 63) == 0) {
+            pagina = x >> 12;                               // salto aleatorio
+        } else {
+            pagina = base[p] + (x >> 8) % paginasTrabajo;   // conjunto de trabajo
+        }
+        if ((x & 1023) == 1) base[p] += paginasTrabajo / 4 + 1; // deriva lenta
+        pagina &= (1u << (32 - BITS_DESPLAZAMIENTO)) - 1;
+        uint32_t dir = (pagina << BITS_DESPLAZAMIENTO) | ((x >> 3) & (TAM_PAGINA - 1));
+        fprintf(f, "%d 0x%x %c\n", p + 1, dir, (x & 7) == 0 ? 'W' : 'R');
+    }
+    fclose(f);
+}
@@ -0,0 +1,206 @@
+#include "LineaTiempo.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+/**
+ * Acumula texto en un bfer fijo y lo vuelca al flujo cuando se llena:
+ * exportar millones de tramos sin pasar cada nmero por el formateo de
+ * ostream.
+ */
+class Escritor {
+private:
+    static const size_t TAMANO = 1 << 16;
+    ostream& os;
+    char buffer[TAMANO];
+    size_t usado;
+
+public:
+    explicit Escritor(ostream& os) : os(os), usado(0) {}
+    ~Escritor() { volcar(); }
+
+    void volcar() {
+        os.write(buffer, (streamsize)usado);
+        usado = 0;
+    }
+
+    void texto(const char* s, size_t n) {
+        if (usado + n > TAMANO) {
+            volcar();
+            if (n > TAMANO) {
+                os.write(s, (streamsize)n);
+                return;
+            }
+        }
+        memcpy(buffer + usado, s, n);
+        usado += n;
+    }
+
+    void texto(const char* s) { texto(s, strlen(s)); }
+
+    template <typename T>
+    void numero(T valor) {
+        if (usado + 24 > TAMANO) volcar();
+        usado = (size_t)(to_chars(buffer + usado, buffer + TAMANO, valor).ptr - buffer);
+    }
+
+    /**
+     * Cadena JSON entre comillas, con los caracteres de control escapados.
+     */
+    void cadenaJSON(const string& s) {
+        texto("\"", 1);
+        for (size_t i = 0; i < s.size(); i++) {
+            unsigned char c = (unsigned char)s[i];
+            if (c == '"' || c == '\\') {
+                char esc[2] = { '\\', (char)c };
+                texto(esc, 2);
+            } else if (c < 0x20) {
+                static const char HEX[] = "0123456789abcdef";
+                char esc[6] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 15] };
+                texto(esc, 6);
+            } else {
+                texto(&s[i], 1);
+            }
+        }
+        texto("\"", 1);
+    }
+
+    /**
+     * Campo CSV entre comillas (las comillas internas se duplican).
+     */
+    void cadenaCSV(const string& s) {
+        texto("\"", 1);
+        size_t desde = 0;
+        for (size_t i = 0; i < s.size(); i++) {
+            if (s[i] == '"') {
+                texto(s.data() + desde, i + 1 - desde);
+                texto("\"", 1);
+                desde = i + 1;
+            }
+        }
+        texto(s.data() + desde, s.size() - desde);
+        texto("\"", 1);
+    }
+
+private:
+    Escritor(const Escritor&);
+    Escritor& operator=(const Escritor&);
+};
+
+const char* const NOMBRES_SALIDAS[] = { "cedio", "bloqueo", "termino", "expropiado", "eliminado" };
+
+} // namespace
+
+LineaTiempo::LineaTiempo() : cantidad(0), capacidad(0), descartados(0), cpu(0) {}
+
+void LineaTiempo::activar(size_t capacidad, uint16_t cpu) {
+    // Vectores nuevos con la capacidad justa (reserve() solo no achica)
+    vector<uint64_t>().swap(inicios);
+    vector<uint32_t>().swap(duraciones);
+    vector<int32_t>().swap(ids);
+    vector<uint32_t>().swap(nombres);
+    vector<uint16_t>().swap(cpus);
+    vector<uint8_t>().swap(salidas);
+    inicios.reserve(capacidad);
+    duraciones.reserve(capacidad);
+    ids.reserve(capacidad);
+    nombres.reserve(capacidad);
+    cpus.reserve(capacidad);
+    salidas.reserve(capacidad);
+    this->capacidad = capacidad;
+    this->cpu = cpu;
+    limpiar();
+}
+
+void LineaTiempo::limpiar() {
+    inicios.clear();
+    duraciones.clear();
+    ids.clear();
+    nombres.clear();
+    cpus.clear();
+    salidas.clear();
+    cantidad = 0;
+    descartados = 0;
+}
+
+const char* LineaTiempo::nombreSalida(Salida salida) {
+    return NOMBRES_SALIDAS[salida];
+}
+
+void LineaTiempo::exportarChrome(ostream& os) const {
+    Escritor w(os);
+    w.texto("{\"traceEvents\":[\n");
+
+    // Un hilo con nombre por cada CPU que aparece
+    vector<uint16_t> usadas(cpus.begin(), cpus.begin() + (ptrdiff_t)cantidad);
+    sort(usadas.begin(), usadas.end());
+    usadas.erase(unique(usadas.begin(), usadas.end()), usadas.end());
+    w.texto("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"Simulador\"}}");
+    for (size_t i = 0; i < usadas.size(); i++) {
+        w.texto(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":");
+        w.numero(usadas[i]);
+        w.texto(",\"args\":{\"name\":\"CPU ");
+        w.numero(usadas[i]);
+        w.texto("\"}}");
+    }
+
+    for (size_t i = 0; i < cantidad; i++) {
+        const string& nombre = PoolNombres::texto(nombres[i]);
+        w.texto(",\n{\"name\":");
+        w.cadenaJSON(nombre.empty() ? "ID " + to_string(ids[i]) : nombre);
+        w.texto(",\"cat\":\"");
+        w.texto(NOMBRES_SALIDAS[salidas[i]]);
+        w.texto("\",\"ph\":\"X\",\"pid\":0,\"tid\":");
+        w.numero(cpus[i]);
+        w.texto(",\"ts\":");
+        w.numero(inicios[i]);
+        w.texto(",\"dur\":");
+        w.numero(duraciones[i]);
+        w.texto(",\"args\":{\"id\":");
+        w.numero(ids[i]);
+        w.texto("}}");
+    }
+    w.texto("\n]}\n");
+}
+
+void LineaTiempo::exportarCSV(ostream& os) const {
+    Escritor w(os);
+    w.texto("cpu,id,nombre,inicio,fin,salida\n");
+    for (size_t i = 0; i < cantidad; i++) {
+        w.numero(cpus[i]);
+        w.texto(",", 1);
+        w.numero(ids[i]);
+        w.texto(",", 1);
+        w.cadenaCSV(PoolNombres::texto(nombres[i]));
+        w.texto(",", 1);
+        w.numero(inicios[i]);
+        w.texto(",", 1);
+        w.numero(inicios[i] + duraciones[i]);
+        w.texto(",", 1);
+        w.texto(NOMBRES_SALIDAS[salidas[i]]);
+        w.texto("\n", 1);
+    }
+}
+
+void LineaTiempo::guardar(const string& archivo, bool csv) const {
+    ofstream file(archivo.c_str(), ios::binary);
+    if (!file.is_open()) {
+        throw runtime_error("No se pudo abrir " + archivo + " para escritura");
+    }
+    if (csv) {
+        exportarCSV(file);
+    } else {
+        exportarChrome(file);
+    }
+    file.close();
+    if (file.fail()) {
+        throw runtime_error("Error al escribir " + archivo);
+    }
+}
@@ -0,0 +1,250 @@
+#include "ListaProcesso.h"
+
+#include <iostream>
+#include <stdexcept>
+
+#include "ErrorHandler.h"
+#include "Metricas.h"
+#include "Persistencia.h"
+#include "TablaHash.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+// Inicializacin de miembro esttico
+const string ListaProcesso::ARCHIVO_PROCESOS = "procesos.dat";
+
+ListaProcesso::ListaProcesso(const string& archivo)
+    : cabeza(NULL), ultimo(NULL), archivo(archivo), comprimido(false),
+      idTraza(Traza::nuevoObjeto()), epocaTraza(0) {
+    if (!archivo.empty()) {
+        comprimido = Persistencia::esComprimido(archivo);
+        cabeza = Persistencia::cargarProcesos(archivo);
+        indice.construir(cabeza);
+        for (ultimo = cabeza; ultimo && ultimo->siguiente; ultimo = ultimo->siguiente) {}
+        SO_MEDIDOR(LISTA_PROCESOS, contarProcesos());
+    }
+}
+
+ListaProcesso::~ListaProcesso() {
+    if (!archivo.empty()) {
+        try {
+            guardar();
+        } catch (const exception& e) {
+            ErrorHandler::manejar(e);
+        }
+    }
+    liberarNodos();
+    if (Traza::activa() && epocaTraza == Traza::epoca()) {
+        Traza::registrar(Traza::LISTA_DESTRUIR, idTraza);
+    }
+}
+
+void ListaProcesso::guardar() const {
+    if (archivo.empty()) {
+        throw runtime_error("La tabla de procesos no tiene archivo de persistencia");
+    }
+    if (comprimido) {
+        Persistencia::guardarProcesosComprimido(cabeza, archivo);
+    } else {
+        Persistencia::guardarProcesos(cabeza, archivo);
+    }
+}
+
+void ListaProcesso::liberarMemoria() {
+    bool traza = trazando();
+    liberarNodos();
+    if (traza) Traza::registrar(Traza::LISTA_VACIAR, idTraza);
+}
+
+void ListaProcesso::liberarNodos() {
+    while (cabeza) {
+        NodoProcesso* temp = cabeza;
+        cabeza = cabeza->siguiente;
+        delete temp;
+        SO_MEDIDOR(LISTA_PROCESOS, -1);
+    }
+    ultimo = NULL;
+    indice.vaciar();
+    admision.vaciar();
+}
+
+void ListaProcesso::insertarProcesso(int id, NombreProceso nombre, int prioridad) {
+    SO_CRONOMETRO(LISTA_INSERTAR_NS);
+    bool traza = trazando();
+    if (indice.buscar(id) != NULL) {
+        throw runtime_error("ID " + to_string_alt(id) + " ya existe");
+    }
+
+    if (prioridad < 0 || prioridad > 100) {
+        throw runtime_error("Prioridad debe ser 0-100");
+    }
+
+    NodoProcesso* nuevo = new NodoProcesso(id, nombre, prioridad);
+
+    // Inserta al final de la lista
+    if (!cabeza) {
+        cabeza = nuevo;
+    } else {
+        ultimo->siguiente = nuevo;
+    }
+    ultimo = nuevo;
+    indice.insertar(nuevo);
+    SO_CONTAR(LISTA_INSERCIONES);
+    SO_MEDIDOR(LISTA_PROCESOS, 1);
+    if (traza) {
+        const string& n = nuevo->nombre.str();
+        Traza::registrar(Traza::LISTA_INSERTAR, idTraza, id, prioridad, 0, n.data(), n.size());
+    }
+}
+
+void ListaProcesso::insertarProcesso(int id, NombreProceso nombre, int prioridad,
+                                     const TareaTiempoReal& tarea) {
+    // Solo los parmetros: el trabajo y el historial empiezan de cero
+    TareaTiempoReal t(tarea.periodo, tarea.costo, tarea.plazo, tarea.esporadica);
+    admision.admitir(t);
+    try {
+        insertarProcesso(id, nombre, prioridad);
+    } catch (...) {
+        admision.retirar(t);
+        throw;
+    }
+    ultimo->tiempoReal = t;
+}
+
+void ListaProcesso::eliminarProcesso(int id) {
+    if (!cabeza) {
+        throw runtime_error("Lista vaca");
+    }
+    bool traza = trazando();
+
+    // Caso especial: eliminar el primer nodo
+    if (cabeza->id == id) {
+        NodoProcesso* temp = cabeza;
+        cabeza = cabeza->siguiente;
+        if (!cabeza) ultimo = NULL;
+        indice.eliminar(id);
+        admision.retirar(temp->tiempoReal);
+        delete temp;
+        SO_CONTAR(LISTA_ELIMINACIONES);
+        SO_MEDIDOR(LISTA_PROCESOS, -1);
+        if (traza) Traza::registrar(Traza::LISTA_ELIMINAR, idTraza, id);
+        return;
+    }
+
+    // Busca el nodo anterior al que se quiere eliminar
+    NodoProcesso* actual = cabeza;
+    while (actual->siguiente && actual->siguiente->id != id) {
+        actual = actual->siguiente;
+    }
+
+    if (!actual->siguiente) {
+        throw runtime_error("Proceso no encontrado");
+    }
+
+    // Elimina el nodo y ajusta los punteros
+    NodoProcesso* temp = actual->siguiente;
+    actual->siguiente = temp->siguiente;
+    if (temp == ultimo) ultimo = actual;
+    indice.eliminar(id);
+    admision.retirar(temp->tiempoReal);
+    delete temp;
+    SO_CONTAR(LISTA_ELIMINACIONES);
+    SO_MEDIDOR(LISTA_PROCESOS, -1);
+    if (traza) Traza::registrar(Traza::LISTA_ELIMINAR, idTraza, id);
+}
+
+void ListaProcesso::eliminarProcesos(const vector<int>& ids) {
+    TablaHash pendientes(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (!indice.buscar(ids[i])) {
+            throw runtime_error("Proceso " + to_string_alt(ids[i]) + " no encontrado");
+        }
+        pendientes.insertar((uint32_t)ids[i], 0);
+    }
+    bool traza = trazando();
+
+    size_t faltan = pendientes.size();
+    NodoProcesso* anterior = NULL;
+    NodoProcesso* actual = cabeza;
+    while (actual && faltan > 0) {
+        NodoProcesso* sig = actual->siguiente;
+        if (pendientes.buscar((uint32_t)actual->id)) {
+            faltan--;
+            if (anterior) anterior->siguiente = sig; else cabeza = sig;
+            if (actual == ultimo) ultimo = anterior;
+            int id = actual->id;
+            indice.eliminar(id);
+            admision.retirar(actual->tiempoReal);
+            delete actual;
+            SO_CONTAR(LISTA_ELIMINACIONES);
+            SO_MEDIDOR(LISTA_PROCESOS, -1);
+            if (traza) Traza::registrar(Traza::LISTA_ELIMINAR, idTraza, id);
+        } else {
+            anterior = actual;
+        }
+        actual = sig;
+    }
+}
+
+NodoProcesso* ListaProcesso::buscarPorId(int id) const {
+    SO_CONTAR(LISTA_BUSQUEDAS);
+    // Con el ndice, los nodos recorridos son los niveles del rbol
+    SO_HISTOGRAMA(LISTA_NODOS_RECORRIDOS, indice.getAltura());
+    NodoProcesso* p = indice.buscar(id);
+    if (trazando()) Traza::registrar(Traza::LISTA_BUSCAR, idTraza, id, 0, p != NULL);
+    return p;
+}
+
+bool ListaProcesso::anunciarTraza(uint32_t epoca) const {
+    epocaTraza = epoca;
+    Traza::registrar(Traza::LISTA_CREAR, idTraza);
+    for (NodoProcesso* p = cabeza; p; p = p->siguiente) {
+        const string& n = p->nombre.str();
+        Traza::registrar(Traza::LISTA_INSERTAR, idTraza, p->id, p->prioridad, 0, n.data(),
+                         n.size());
+    }
+    return true;
+}
+
+void ListaProcesso::mostrar() const {
+    if (!cabeza) {
+        cout << "\nNo hay procesos activos!\n";
+        return;
+    }
+
+    NodoProcesso* temp = cabeza;
+    cout << "\n--- Procesos Activos (" << contarProcesos() << ") ---\n";
+    while (temp) {
+        cout << "ID: " << temp->id
+             << " | Nombre: " << temp->nombre
+             << " | Prioridad: " << temp->prioridad
+             << " | Estado: " << nombreEstado(temp->estado) << endl;
+        temp = temp->siguiente;
+    }
+}
+
+void ListaProcesso::mostrarRango(int desde, int hasta) const {
+    size_t cuantos = indice.contarRango(desde, hasta);
+    if (cuantos == 0) {
+        cout << "\nNo hay procesos con ID entre " << desde << " y " << hasta << "\n";
+        return;
+    }
+    cout << "\n--- Procesos con ID " << desde << "-" << hasta << " (" << cuantos << ") ---\n";
+    indice.rango(desde, hasta, [](NodoProcesso* p) {
+        cout << "ID: " << p->id
+             << " | Nombre: " << p->nombre
+             << " | Prioridad: " << p->prioridad
+             << " | Estado: " << nombreEstado(p->estado) << endl;
+    });
+}
+
+int ListaProcesso::contarProcesos() const {
+    int count = 0;
+    NodoProcesso* temp = cabeza;
+    while (temp) {
+        count++;
+        temp = temp->siguiente;
+    }
+    return count;
+}
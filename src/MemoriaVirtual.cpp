@@ -0,0 +1,275 @@
+#include "MemoriaVirtual.h"
+
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+
+#include "Metricas.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+/* ---------------- TablaPaginas ---------------- */
+
+TablaPaginas::TablaPaginas() : paginasMapeadas(0) {
+    memset(directorio, 0, sizeof(directorio));
+}
+
+TablaPaginas::~TablaPaginas() {
+    for (uint32_t d = 0; d < ENTRADAS_NIVEL; d++) {
+        delete[] directorio[d];
+    }
+}
+
+uint32_t* TablaPaginas::entrada(uint32_t vpn) {
+    uint32_t*& tabla = directorio[vpn >> BITS_NIVEL];
+    if (!tabla) {
+        tabla = new uint32_t[ENTRADAS_NIVEL]();
+    }
+    return &tabla[vpn & (ENTRADAS_NIVEL - 1)];
+}
+
+void TablaPaginas::mapear(uint32_t vpn, uint32_t marco) {
+    uint32_t* pte = entrada(vpn);
+    if (!(*pte & PTE_PRESENTE)) paginasMapeadas++;
+    *pte = PTE_PRESENTE | (marco & PTE_MARCO);
+}
+
+int TablaPaginas::desmapear(uint32_t vpn) {
+    int niveles;
+    uint32_t* pte = recorrer(vpn, niveles);
+    if (!pte || !(*pte & PTE_PRESENTE)) return -1;
+    int marco = (int)(*pte & PTE_MARCO);
+    *pte = 0;
+    paginasMapeadas--;
+    return marco;
+}
+
+/* ---------------- AsignadorMarcos ---------------- */
+
+AsignadorMarcos::AsignadorMarcos(uint32_t numMarcos) : marcos(numMarcos) {
+    if (numMarcos == 0 || numMarcos > PTE_MARCO + 1) {
+        throw runtime_error("Nmero de marcos invlido");
+    }
+    libres.reserve(numMarcos);
+    // Se apilan al revs para entregar primero el marco 0
+    for (uint32_t m = numMarcos; m-- > 0;) {
+        libres.push_back(m);
+        marcos[m].pid = -1;
+        marcos[m].vpn = 0;
+    }
+}
+
+int AsignadorMarcos::asignar(int pid, uint32_t vpn) {
+    if (libres.empty()) return -1;
+    uint32_t m = libres.back();
+    libres.pop_back();
+    marcos[m].pid = pid;
+    marcos[m].vpn = vpn;
+    return (int)m;
+}
+
+void AsignadorMarcos::liberar(uint32_t marco) {
+    if (marco >= marcos.size() || marcos[marco].pid < 0) {
+        throw runtime_error("Marco " + to_string_alt(marco) + " no asignado");
+    }
+    marcos[marco].pid = -1;
+    libres.push_back(marco);
+}
+
+/* ---------------- TLB ---------------- */
+
+TLB::TLB(uint32_t conjuntos, uint32_t asociatividad)
+    : asociatividad(asociatividad ? asociatividad : 1), reloj(0) {
+    uint32_t c = 1;
+    while (c < conjuntos) c <<= 1;
+    mascaraConjuntos = c - 1;
+    vias.resize((size_t)c * this->asociatividad);
+    vaciar();
+}
+
+void TLB::insertar(int pid, uint32_t vpn, uint32_t* pte) {
+    Via* conjunto = &vias[(size_t)indiceConjunto(pid, vpn) * asociatividad];
+    Via* victima = &conjunto[0];
+    for (uint32_t w = 0; w < asociatividad; w++) {
+        if (conjunto[w].etiqueta == VACIA) {
+            victima = &conjunto[w];
+            break;
+        }
+        if (conjunto[w].uso < victima->uso) victima = &conjunto[w];
+    }
+    victima->etiqueta = etiqueta(pid, vpn);
+    victima->pte = pte;
+    victima->uso = ++reloj;
+}
+
+void TLB::invalidar(int pid, uint32_t vpn) {
+    uint64_t e = etiqueta(pid, vpn);
+    Via* conjunto = &vias[(size_t)indiceConjunto(pid, vpn) * asociatividad];
+    for (uint32_t w = 0; w < asociatividad; w++) {
+        if (conjunto[w].etiqueta == e) conjunto[w].etiqueta = VACIA;
+    }
+}
+
+void TLB::invalidarProceso(int pid) {
+    for (size_t i = 0; i < vias.size(); i++) {
+        if (vias[i].etiqueta != VACIA && (int)(vias[i].etiqueta >> 32) == pid) {
+            vias[i].etiqueta = VACIA;
+        }
+    }
+}
+
+void TLB::vaciar() {
+    for (size_t i = 0; i < vias.size(); i++) {
+        vias[i].etiqueta = VACIA;
+        vias[i].pte = NULL;
+        vias[i].uso = 0;
+    }
+}
+
+/* ---------------- MemoriaVirtual ---------------- */
+
+MemoriaVirtual::MemoriaVirtual(uint32_t numMarcos, uint32_t conjuntosTLB, uint32_t viasTLB)
+    : asignador(numMarcos), tlb(conjuntosTLB, viasTLB), reemplazo(NULL) {
+    reiniciarEstadisticas();
+}
+
+MemoriaVirtual::~MemoriaVirtual() {
+    for (unordered_map<int, TablaPaginas*>::iterator it = espacios.begin();
+         it != espacios.end(); ++it) {
+        delete it->second;
+    }
+    delete reemplazo;
+}
+
+void MemoriaVirtual::setAlgoritmoReemplazo(AlgoritmoReemplazo* algoritmo) {
+    if (asignador.disponibles() != asignador.total()) {
+        delete algoritmo;
+        throw runtime_error("No se puede cambiar el reemplazo con pginas mapeadas");
+    }
+    if (algoritmo && algoritmo->getCapacidad() != asignador.total()) {
+        delete algoritmo;
+        throw runtime_error("La capacidad del algoritmo debe igualar el nmero de marcos");
+    }
+    delete reemplazo;
+    reemplazo = algoritmo;
+}
+
+void MemoriaVirtual::crearEspacio(NodoProcesso* proceso) {
+    if (!proceso) {
+        throw runtime_error("Proceso invlido");
+    }
+    if (proceso->tablaPaginas || espacios.count(proceso->id)) {
+        throw runtime_error("El proceso " + to_string_alt(proceso->id) +
+                            " ya tiene espacio de direcciones");
+    }
+    TablaPaginas* tabla = new TablaPaginas();
+    espacios[proceso->id] = tabla;
+    proceso->tablaPaginas = tabla;
+}
+
+void MemoriaVirtual::destruirEspacio(NodoProcesso* proceso) {
+    if (!proceso || !proceso->tablaPaginas) return;
+    TablaPaginas* tabla = proceso->tablaPaginas;
+    AsignadorMarcos& a = asignador;
+    AlgoritmoReemplazo* r = reemplazo;
+    int pid = proceso->id;
+    tabla->recorrerPresentes([&a, r, pid](uint32_t vpn, uint32_t marco) {
+        a.liberar(marco);
+        if (r) r->eliminar(TLB::etiqueta(pid, vpn));
+    });
+    tlb.invalidarProceso(proceso->id);
+    espacios.erase(proceso->id);
+    proceso->tablaPaginas = NULL;
+    delete tabla;
+}
+
+uint32_t* MemoriaVirtual::recorrerTabla(NodoProcesso* proceso, uint32_t vpn) {
+    TablaPaginas* tabla = proceso->tablaPaginas;
+    if (!tabla) {
+        throw runtime_error("El proceso " + to_string_alt(proceso->id) +
+                            " no tiene espacio de direcciones");
+    }
+    estadisticas.fallosTLB++;
+    SO_CONTAR(VM_FALLOS_TLB);
+
+    int niveles;
+    uint32_t* pte = tabla->recorrer(vpn, niveles);
+    estadisticas.nivelesRecorridos += niveles;
+    bool presente = pte && (*pte & PTE_PRESENTE);
+    // La vctima nunca es esta pgina: si est presente el algoritmo ya
+    // la conoce, y si no, su marco queda libre para el fallo
+    if (reemplazo) notificarReemplazo(proceso->id, vpn);
+
+    if (!presente) {
+        // Fallo de pgina: asignacin bajo demanda
+        int marco = asignador.asignar(proceso->id, vpn);
+        if (marco < 0) {
+            throw runtime_error("Sin marcos fsicos libres");
+        }
+        estadisticas.fallosPagina++;
+        SO_CONTAR(VM_FALLOS_PAGINA);
+        tabla->mapear(vpn, (uint32_t)marco);
+        pte = tabla->entrada(vpn);
+    }
+    tlb.insertar(proceso->id, vpn, pte);
+    return pte;
+}
+
+void MemoriaVirtual::notificarReemplazo(int pid, uint32_t vpn) {
+    uint64_t victima;
+    reemplazo->referenciar(TLB::etiqueta(pid, vpn), victima);
+    if (victima == AlgoritmoReemplazo::SIN_VICTIMA) return;
+
+    int pidVictima = (int)(victima >> 32);
+    uint32_t vpnVictima = (uint32_t)victima;
+    unordered_map<int, TablaPaginas*>::iterator it = espacios.find(pidVictima);
+    if (it == espacios.end()) return;
+
+    int niveles;
+    uint32_t* pte = it->second->recorrer(vpnVictima, niveles);
+    if (pte && (*pte & PTE_SUCIA)) estadisticas.escriturasDisco++;
+    int marco = it->second->desmapear(vpnVictima);
+    if (marco >= 0) {
+        tlb.invalidar(pidVictima, vpnVictima);
+        asignador.liberar((uint32_t)marco);
+        estadisticas.desalojos++;
+    }
+}
+
+double MemoriaVirtual::tasaAciertosTLB() const {
+    return estadisticas.traducciones
+               ? (double)estadisticas.aciertosTLB / (double)estadisticas.traducciones : 0.0;
+}
+
+double MemoriaVirtual::ciclosPorTraduccion() const {
+    if (!estadisticas.traducciones) return 0.0;
+    double ciclos = (double)estadisticas.traducciones * CICLOS_TLB +
+                    (double)estadisticas.nivelesRecorridos * CICLOS_NIVEL;
+    return ciclos / (double)estadisticas.traducciones;
+}
+
+void MemoriaVirtual::mostrarEstadisticas(ostream& os) const {
+    const EstadisticasVM& e = estadisticas;
+    os << "\n--- Memoria Virtual ---\n";
+    os << "TLB: " << tlb.getConjuntos() << " conjuntos x " << tlb.getAsociatividad()
+       << " vas\n";
+    os << "Marcos usados: " << (asignador.total() - asignador.disponibles()) << "/"
+       << asignador.total() << "\n";
+    os << "Traducciones: " << e.traducciones << "\n";
+    os << "Aciertos TLB: " << e.aciertosTLB << " (" << fixed << setprecision(2)
+       << tasaAciertosTLB() * 100.0 << "%)\n";
+    os << "Fallos de pgina: " << e.fallosPagina << "\n";
+    if (reemplazo) {
+        os << "Reemplazo " << reemplazo->nombre() << ": " << e.desalojos << " desalojos ("
+           << e.escriturasDisco << " pginas sucias)\n";
+    }
+    os << "Niveles por page walk: "
+       << (e.fallosTLB ? (double)e.nivelesRecorridos / (double)e.fallosTLB : 0.0) << "\n";
+    os << "Ciclos estimados por traduccin: " << ciclosPorTraduccion() << "\n";
+    os.unsetf(ios::fixed);
+}
+
+void MemoriaVirtual::reiniciarEstadisticas() {
+    memset(&estadisticas, 0, sizeof(estadisticas));
+}
@@ -0,0 +1,378 @@
+#include "Metricas.h"
+
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+using namespace std;
+
+namespace Metricas {
+
+namespace {
+
+const char* const NOMBRES_CONTADORES[NUM_CONTADORES] = {
+    "lista_inserciones",
+    "lista_eliminaciones",
+    "lista_busquedas",
+    "cola_encolados",
+    "cola_desencolados",
+    "memoria_asignaciones",
+    "memoria_liberaciones",
+    "memoria_rechazos",
+    "memoria_reubicados",
+    "persistencia_guardados",
+    "persistencia_cargas",
+    "persistencia_registros",
+    "persistencia_guardados_fondo",
+    "persistencia_duplicados",
+    "vm_fallos_tlb",
+    "vm_fallos_pagina",
+    "temporizadores_disparados",
+    "rpc_solicitudes",
+    "rpc_reenviadas",
+    "cpu_quantums",
+    "cpu_reanudaciones",
+    "tr_trabajos",
+    "tr_plazos_perdidos",
+    "tr_rechazadas",
+    "slab_asignaciones",
+    "slab_liberaciones",
+    "slab_recargas",
+    "arbol_clonaciones",
+    "arbol_eliminados_subarbol",
+};
+
+const char* const NOMBRES_MEDIDORES[NUM_MEDIDORES] = {
+    "lista_procesos",
+    "cola_profundidad",
+    "memoria_ocupacion",
+    "procesos_bloqueados",
+    "nombres_internados",
+    "rpc_conexiones",
+    "rpc_instancias",
+    "slab_paginas",
+};
+
+const char* const NOMBRES_HISTOGRAMAS[NUM_HISTOGRAMAS] = {
+    "lista_insertar_ns",
+    "lista_nodos_recorridos",
+    "cola_encolar_ns",
+    "cola_longitud_escaneo",
+    "cola_espera_ticks",
+    "persistencia_guardar_ns",
+    "persistencia_cargar_ns",
+    "persistencia_pausa_fork_ns",
+    "tr_tardanza_ticks",
+};
+
+/**
+ * Registro global de bloques. Se reserva con new y nunca se destruye,
+ * para que los hilos que terminan despus de main puedan usarlo.
+ */
+void antesDeFork();
+void despuesDeForkPadre();
+void despuesDeForkHijo();
+
+struct Registro {
+    mutex cerrojo;
+    vector<BloqueHilo*> vivos;
+    BloqueHilo retirados; // Suma de los hilos ya terminados
+
+    Registro() {
+#ifndef _WIN32
+        pthread_atfork(antesDeFork, despuesDeForkPadre, despuesDeForkHijo);
+#endif
+    }
+};
+
+Registro* instancia = NULL;
+
+Registro& registro() {
+    static Registro* r = instancia = new Registro();
+    return *r;
+}
+
+/**
+ * El registro se bloquea durante fork(): un hijo que registre su primer
+ * bloque no encuentra el cerrojo tomado por un hilo que ya no existe
+ * (en el hijo se crea de nuevo, como el del pool de nombres).
+ */
+void antesDeFork() {
+    if (instancia) instancia->cerrojo.lock();
+}
+
+void despuesDeForkPadre() {
+    if (instancia) instancia->cerrojo.unlock();
+}
+
+void despuesDeForkHijo() {
+    if (instancia) new (&instancia->cerrojo) mutex();
+}
+
+// Como el pool de nombres, se crea antes de que haya otros hilos
+const bool registroCreado = (registro(), true);
+
+void ponerACeroContadores(BloqueHilo& b) {
+    for (int i = 0; i < NUM_CONTADORES; i++) b.contadores[i].store(0, memory_order_relaxed);
+    for (int h = 0; h < NUM_HISTOGRAMAS; h++) {
+        HistogramaHdr& hist = b.histogramas[h];
+        for (int i = 0; i < HistogramaHdr::NUM_CUBETAS; i++) {
+            hist.cubetas[i].store(0, memory_order_relaxed);
+        }
+        hist.suma.store(0, memory_order_relaxed);
+        hist.maximo.store(0, memory_order_relaxed);
+    }
+}
+
+void ponerACero(BloqueHilo& b) {
+    ponerACeroContadores(b);
+    for (int i = 0; i < NUM_MEDIDORES; i++) b.medidores[i].store(0, memory_order_relaxed);
+    b.epoca.store(epocaReinicio.load(memory_order_relaxed), memory_order_relaxed);
+}
+
+/**
+ * Suma el bloque origen sobre el destino (el destino no es de ningn hilo).
+ * Los contadores e histogramas de un bloque cuyo dueo an no vio el
+ * ltimo reinicio cuentan como cero. Se llama con el cerrojo del
+ * registro tomado, as la poca no avanza mientras tanto.
+ */
+void acumular(BloqueHilo& destino, const BloqueHilo& origen) {
+    for (int i = 0; i < NUM_MEDIDORES; i++) {
+        destino.medidores[i].fetch_add(origen.medidores[i].load(memory_order_relaxed),
+                                       memory_order_relaxed);
+    }
+    // El dueo publica la poca nueva despus de poner su bloque a cero
+    if (origen.epoca.load(memory_order_acquire) != epocaReinicio.load(memory_order_relaxed)) {
+        return;
+    }
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        destino.contadores[i].fetch_add(origen.contadores[i].load(memory_order_relaxed),
+                                        memory_order_relaxed);
+    }
+    for (int h = 0; h < NUM_HISTOGRAMAS; h++) {
+        HistogramaHdr& d = destino.histogramas[h];
+        const HistogramaHdr& o = origen.histogramas[h];
+        for (int i = 0; i < HistogramaHdr::NUM_CUBETAS; i++) {
+            d.cubetas[i].fetch_add(o.cubetas[i].load(memory_order_relaxed), memory_order_relaxed);
+        }
+        d.suma.fetch_add(o.suma.load(memory_order_relaxed), memory_order_relaxed);
+        uint64_t m = o.maximo.load(memory_order_relaxed);
+        if (m > d.maximo.load(memory_order_relaxed)) d.maximo.store(m, memory_order_relaxed);
+    }
+}
+
+/**
+ * Al terminar un hilo su bloque se suma a "retirados" y se libera.
+ */
+struct GuardaHilo {
+    BloqueHilo* bloque;
+    GuardaHilo() : bloque(NULL) {}
+    ~GuardaHilo() {
+        if (!bloque) return;
+        Registro& r = registro();
+        lock_guard<mutex> lock(r.cerrojo);
+        acumular(r.retirados, *bloque);
+        for (size_t i = 0; i < r.vivos.size(); i++) {
+            if (r.vivos[i] == bloque) {
+                r.vivos[i] = r.vivos.back();
+                r.vivos.pop_back();
+                break;
+            }
+        }
+        delete bloque;
+    }
+};
+
+thread_local GuardaHilo guardaHilo;
+
+/**
+ * Percentil aproximado: punto medio de la cubeta que lo contiene.
+ */
+uint64_t percentil(const vector<uint64_t>& cubetas, uint64_t cuenta, double q, uint64_t maximo) {
+    if (cuenta == 0) return 0;
+    uint64_t objetivo = (uint64_t)(q * (double)cuenta);
+    if (objetivo >= cuenta) objetivo = cuenta - 1;
+    uint64_t acumulado = 0;
+    for (int i = 0; i < HistogramaHdr::NUM_CUBETAS; i++) {
+        acumulado += cubetas[i];
+        if (acumulado > objetivo) {
+            uint64_t inf = HistogramaHdr::limiteInferior(i);
+            uint64_t sup = i + 1 < HistogramaHdr::NUM_CUBETAS
+                               ? HistogramaHdr::limiteInferior(i + 1) - 1 : inf;
+            uint64_t medio = inf + (sup - inf) / 2;
+            return medio < maximo ? medio : maximo;
+        }
+    }
+    return maximo;
+}
+
+} // namespace
+
+atomic<uint32_t> epocaReinicio(0);
+
+BloqueHilo* registrarHilo() {
+    BloqueHilo* b = new BloqueHilo();
+    ponerACero(*b);
+    Registro& r = registro();
+    lock_guard<mutex> lock(r.cerrojo);
+    r.vivos.push_back(b);
+    guardaHilo.bloque = b;
+    return b;
+}
+
+void alcanzarReinicio(BloqueHilo& bloque) {
+    ponerACeroContadores(bloque);
+    bloque.epoca.store(epocaReinicio.load(memory_order_relaxed), memory_order_release);
+}
+
+bool habilitadas() {
+#if SO_METRICAS
+    return true;
+#else
+    return false;
+#endif
+}
+
+Instantanea tomarInstantanea() {
+    BloqueHilo* total = new BloqueHilo();
+    ponerACero(*total);
+    {
+        Registro& r = registro();
+        lock_guard<mutex> lock(r.cerrojo);
+        acumular(*total, r.retirados);
+        for (size_t i = 0; i < r.vivos.size(); i++) acumular(*total, *r.vivos[i]);
+    }
+
+    Instantanea inst;
+    for (int i = 0; i < NUM_CONTADORES; i++) inst.contadores[i] = total->contadores[i].load();
+    for (int i = 0; i < NUM_MEDIDORES; i++) inst.medidores[i] = total->medidores[i].load();
+    vector<uint64_t> cubetas(HistogramaHdr::NUM_CUBETAS);
+    for (int h = 0; h < NUM_HISTOGRAMAS; h++) {
+        const HistogramaHdr& hist = total->histogramas[h];
+        uint64_t cuenta = 0;
+        for (int i = 0; i < HistogramaHdr::NUM_CUBETAS; i++) {
+            cubetas[i] = hist.cubetas[i].load();
+            cuenta += cubetas[i];
+        }
+        ResumenHistograma& res = inst.histogramas[h];
+        res.cuenta = cuenta;
+        res.suma = hist.suma.load();
+        res.maximo = hist.maximo.load();
+        res.p50 = percentil(cubetas, cuenta, 0.50, res.maximo);
+        res.p90 = percentil(cubetas, cuenta, 0.90, res.maximo);
+        res.p99 = percentil(cubetas, cuenta, 0.99, res.maximo);
+        res.p999 = percentil(cubetas, cuenta, 0.999, res.maximo);
+    }
+    delete total;
+    return inst;
+}
+
+void reiniciar() {
+    Registro& r = registro();
+    lock_guard<mutex> lock(r.cerrojo);
+    // Los bloques vivos los pone a cero su dueo (ver alcanzarReinicio);
+    // "retirados" no tiene dueo y se escribe aqu, bajo el cerrojo.
+    // Los medidores describen estructuras vivas: se preservan
+    uint32_t epoca = epocaReinicio.load(memory_order_relaxed) + 1;
+    epocaReinicio.store(epoca, memory_order_relaxed);
+    ponerACeroContadores(r.retirados);
+    r.retirados.epoca.store(epoca, memory_order_relaxed);
+}
+
+const char* nombre(Contador c) { return NOMBRES_CONTADORES[c]; }
+const char* nombre(Medidor m) { return NOMBRES_MEDIDORES[m]; }
+const char* nombre(Histograma h) { return NOMBRES_HISTOGRAMAS[h]; }
+
+void mostrar(ostream& os) {
+    if (!habilitadas()) {
+        os << "Mtricas deshabilitadas en esta compilacin (SO_METRICAS=OFF)\n";
+        return;
+    }
+    Instantanea inst = tomarInstantanea();
+    os << "\n--- Contadores ---\n";
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        os << left << setw(28) << NOMBRES_CONTADORES[i] << inst.contadores[i] << "\n";
+    }
+    os << "\n--- Medidores ---\n";
+    for (int i = 0; i < NUM_MEDIDORES; i++) {
+        os << left << setw(28) << NOMBRES_MEDIDORES[i] << inst.medidores[i] << "\n";
+    }
+    os << "\n--- Histogramas ---\n";
+    os << left << setw(28) << "nombre" << right << setw(10) << "cuenta" << setw(10) << "media"
+       << setw(10) << "p50" << setw(10) << "p99" << setw(12) << "max" << "\n";
+    for (int i = 0; i < NUM_HISTOGRAMAS; i++) {
+        const ResumenHistograma& h = inst.histogramas[i];
+        os << left << setw(28) << NOMBRES_HISTOGRAMAS[i] << right << setw(10) << h.cuenta
+           << setw(10) << (h.cuenta ? h.suma / h.cuenta : 0) << setw(10) << h.p50
+           << setw(10) << h.p99 << setw(12) << h.maximo << "\n";
+    }
+    os << left;
+}
+
+void exportarJSON(ostream& os) {
+    Instantanea inst = tomarInstantanea();
+    os << "{\n  \"habilitadas\": " << (habilitadas() ? "true" : "false") << ",\n";
+    os << "  \"contadores\": {";
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        os << (i ? ", " : "") << "\"" << NOMBRES_CONTADORES[i] << "\": " << inst.contadores[i];
+    }
+    os << "},\n  \"medidores\": {";
+    for (int i = 0; i < NUM_MEDIDORES; i++) {
+        os << (i ? ", " : "") << "\"" << NOMBRES_MEDIDORES[i] << "\": " << inst.medidores[i];
+    }
+    os << "},\n  \"histogramas\": {\n";
+    for (int i = 0; i < NUM_HISTOGRAMAS; i++) {
+        const ResumenHistograma& h = inst.histogramas[i];
+        os << "    \"" << NOMBRES_HISTOGRAMAS[i] << "\": {\"cuenta\": " << h.cuenta
+           << ", \"suma\": " << h.suma << ", \"max\": " << h.maximo
+           << ", \"p50\": " << h.p50 << ", \"p90\": " << h.p90
+           << ", \"p99\": " << h.p99 << ", \"p999\": " << h.p999 << "}"
+           << (i + 1 < NUM_HISTOGRAMAS ? ",\n" : "\n");
+    }
+    os << "  }\n}\n";
+}
+
+void exportarPrometheus(ostream& os) {
+    Instantanea inst = tomarInstantanea();
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        os << "# TYPE so_" << NOMBRES_CONTADORES[i] << "_total counter\n"
+           << "so_" << NOMBRES_CONTADORES[i] << "_total " << inst.contadores[i] << "\n";
+    }
+    for (int i = 0; i < NUM_MEDIDORES; i++) {
+        os << "# TYPE so_" << NOMBRES_MEDIDORES[i] << " gauge\n"
+           << "so_" << NOMBRES_MEDIDORES[i] << " " << inst.medidores[i] << "\n";
+    }
+    for (int i = 0; i < NUM_HISTOGRAMAS; i++) {
+        const ResumenHistograma& h = inst.histogramas[i];
+        const char* n = NOMBRES_HISTOGRAMAS[i];
+        os << "# TYPE so_" << n << " summary\n"
+           << "so_" << n << "{quantile=\"0.5\"} " << h.p50 << "\n"
+           << "so_" << n << "{quantile=\"0.9\"} " << h.p90 << "\n"
+           << "so_" << n << "{quantile=\"0.99\"} " << h.p99 << "\n"
+           << "so_" << n << "{quantile=\"0.999\"} " << h.p999 << "\n"
+           << "so_" << n << "_sum " << h.suma << "\n"
+           << "so_" << n << "_count " << h.cuenta << "\n";
+    }
+}
+
+void guardar(const string& archivo, bool prometheus) {
+    ofstream file(archivo.c_str());
+    if (!file.is_open()) {
+        throw runtime_error("No se pudo abrir " + archivo + " para escritura");
+    }
+    if (prometheus) {
+        exportarPrometheus(file);
+    } else {
+        exportarJSON(file);
+    }
+    file.close();
+}
+
+} // namespace Metricas
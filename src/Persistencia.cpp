@@ -0,0 +1,290 @@
+#include "Persistencia.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ArbolProcesos.h"
+#include "ArchivoProyectado.h"
+#include "ErrorHandler.h"
+#include "Metricas.h"
+#include "TablaHash.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+void Persistencia::guardarProcesos(NodoProcesso* cabeza, const string& archivo) {
+    SO_CRONOMETRO(PERSISTENCIA_GUARDAR_NS);
+    ofstream file(archivo.c_str());
+    if (!file.is_open()) {
+        throw runtime_error("No se pudo abrir " + archivo + " para escritura");
+    }
+
+    // Recorre la lista y escribe cada proceso en el archivo
+    NodoProcesso* actual = cabeza;
+    while (actual) {
+        file << actual->id << "," << actual->nombre << "," << actual->prioridad << "\n";
+        actual = actual->siguiente;
+        SO_CONTAR(PERSISTENCIA_REGISTROS);
+    }
+    file.close();
+    SO_CONTAR(PERSISTENCIA_GUARDADOS);
+}
+
+NodoProcesso* Persistencia::cargarProcesos(const string& archivo) {
+    if (esComprimido(archivo)) {
+        return cargarProcesosComprimido(archivo);
+    }
+    return cargarProcesosCsv(archivo);
+}
+
+/* ---------------- Carga paralela del CSV ---------------- */
+
+namespace {
+
+// Por debajo de esto por hilo, repartir cuesta ms de lo que ahorra
+const size_t BYTES_MINIMOS_POR_HILO = 1 << 20;
+
+/**
+ * Registro analizado; el nombre queda como rango dentro del archivo
+ * proyectado hasta que se crea el nodo.
+ */
+struct RegistroCsv {
+    int id;
+    int prioridad;
+    const char* nombre;
+    uint32_t longitudNombre;
+    bool duplicado;
+};
+
+/**
+ * Trozo del archivo alineado a lneas con su arena de registros.
+ */
+struct TrozoCsv {
+    const char* inicio;
+    const char* fin;
+    vector<RegistroCsv> registros;
+    vector<vector<uint32_t> > porCubeta; // ndices de registro por cubeta de ID
+    vector<string> errores;
+    vector<int> duplicados;
+    NodoProcesso* primero;
+    NodoProcesso* ultimo;
+};
+
+/**
+ * Entero al estilo atoi sobre un rango sin terminador.
+ */
+int leerEnteroCsv(const char* p, const char* fin) {
+    while (p < fin && (*p == ' ' || *p == '\t')) p++;
+    bool negativo = false;
+    if (p < fin && (*p == '-' || *p == '+')) negativo = *p++ == '-';
+    long long v = 0;
+    while (p < fin && *p >= '0' && *p <= '9') {
+        if (v < 10000000000ll) v = v * 10 + (*p - '0');
+        p++;
+    }
+    return (int)(negativo ? -v : v);
+}
+
+size_t cubetaDe(int id, size_t cubetas) {
+    return (size_t)(((uint64_t)(uint32_t)id * 0x9E3779B97F4A7C15ull) >> 32) % cubetas;
+}
+
+void analizarTrozo(TrozoCsv& t, size_t cubetas) {
+    t.porCubeta.resize(cubetas);
+    const char* p = t.inicio;
+    while (p < t.fin) {
+        const char* finLinea = static_cast<const char*>(memchr(p, '\n', (size_t)(t.fin - p)));
+        if (!finLinea) finLinea = t.fin;
+        const char* finDatos = finLinea;
+        if (finDatos > p && finDatos[-1] == '\r') finDatos--;
+
+        if (finDatos > p) {
+            const char* coma1 = static_cast<const char*>(memchr(p, ',', (size_t)(finDatos - p)));
+            const char* coma2 = coma1 ? static_cast<const char*>(
+                                            memchr(coma1 + 1, ',', (size_t)(finDatos - coma1 - 1)))
+                                      : NULL;
+            if (!coma2) {
+                t.errores.push_back("Formato invlido en lnea: " + string(p, finDatos));
+            } else {
+                RegistroCsv r;
+                r.id = leerEnteroCsv(p, coma1);
+                r.nombre = coma1 + 1;
+                r.longitudNombre = (uint32_t)(coma2 - coma1 - 1);
+                r.prioridad = leerEnteroCsv(coma2 + 1, finDatos);
+                r.duplicado = false;
+                t.porCubeta[cubetaDe(r.id, cubetas)].push_back((uint32_t)t.registros.size());
+                t.registros.push_back(r);
+            }
+        }
+        p = finLinea + 1;
+    }
+}
+
+void construirTrozo(TrozoCsv& t) {
+    t.primero = t.ultimo = NULL;
+    for (size_t i = 0; i < t.registros.size(); i++) {
+        const RegistroCsv& r = t.registros[i];
+        if (r.duplicado) continue;
+        NombreProceso nombre(PoolNombres::internar(string_view(r.nombre, r.longitudNombre)));
+        NodoProcesso* nodo = new NodoProcesso(r.id, nombre, r.prioridad);
+        if (t.ultimo) t.ultimo->siguiente = nodo; else t.primero = nodo;
+        t.ultimo = nodo;
+    }
+}
+
+/**
+ * Ejecuta f(i) para i en [0, n) repartido entre 'hilos' hilos.
+ */
+template <typename F>
+void enParalelo(size_t n, unsigned hilos, F f) {
+    atomic<size_t> siguiente(0);
+    auto trabajador = [&]() {
+        for (size_t i; (i = siguiente.fetch_add(1, memory_order_relaxed)) < n;) f(i);
+    };
+    vector<thread> equipo;
+    for (unsigned h = 1; h < hilos && h < n; h++) equipo.push_back(thread(trabajador));
+    trabajador();
+    for (size_t h = 0; h < equipo.size(); h++) equipo[h].join();
+}
+
+} // namespace
+
+NodoProcesso* Persistencia::cargarProcesosCsv(const string& archivo, unsigned hilos) {
+    if (!ArchivoProyectado::existe(archivo)) {
+        return NULL;
+    }
+    SO_CRONOMETRO(PERSISTENCIA_CARGAR_NS);
+    ArchivoProyectado mapa(archivo);
+    const char* datos = mapa.datos();
+    const char* fin = datos + mapa.tam();
+
+    if (hilos == 0) hilos = thread::hardware_concurrency();
+    if (hilos == 0) hilos = 1;
+    size_t maxHilos = mapa.tam() / BYTES_MINIMOS_POR_HILO + 1;
+    if (hilos > maxHilos) hilos = (unsigned)maxHilos;
+
+    // 1. Trozos del mismo tamao, corridos hasta el siguiente salto de lnea
+    vector<TrozoCsv> trozos(hilos);
+    const char* p = datos;
+    for (unsigned t = 0; t < hilos; t++) {
+        const char* corte = t + 1 == hilos ? fin : datos + mapa.tam() / hilos * (t + 1);
+        if (corte < p) corte = p;
+        if (corte < fin) {
+            const char* nl = static_cast<const char*>(memchr(corte, '\n', (size_t)(fin - corte)));
+            corte = nl ? nl + 1 : fin;
+        }
+        trozos[t].inicio = p;
+        trozos[t].fin = corte;
+        p = corte;
+    }
+
+    // 2. Anlisis en paralelo: cada trozo llena su propia arena
+    size_t cubetas = hilos;
+    enParalelo(trozos.size(), hilos, [&](size_t t) { analizarTrozo(trozos[t], cubetas); });
+
+    // 3. Duplicados entre trozos: cada hilo es dueo de una cubeta de IDs y
+    //    la recorre en orden de archivo, as gana la primera aparicin
+    enParalelo(cubetas, hilos, [&](size_t c) {
+        size_t total = 0;
+        for (size_t t = 0; t < trozos.size(); t++) total += trozos[t].porCubeta[c].size();
+        TablaHash vistos(total);
+        for (size_t t = 0; t < trozos.size(); t++) {
+            const vector<uint32_t>& indices = trozos[t].porCubeta[c];
+            for (size_t k = 0; k < indices.size(); k++) {
+                RegistroCsv& r = trozos[t].registros[indices[k]];
+                uint64_t clave = (uint32_t)r.id;
+                if (vistos.buscar(clave)) {
+                    r.duplicado = true;
+                } else {
+                    vistos.insertar(clave, 0);
+                }
+            }
+        }
+    });
+
+    // 4. Creacin de nodos en paralelo y unin en el orden original
+    enParalelo(trozos.size(), hilos, [&](size_t t) { construirTrozo(trozos[t]); });
+
+    NodoProcesso* cabeza = NULL;
+    NodoProcesso* ultimo = NULL;
+    size_t registros = 0;
+    for (size_t t = 0; t < trozos.size(); t++) {
+        TrozoCsv& trozo = trozos[t];
+        for (size_t e = 0; e < trozo.errores.size(); e++) {
+            ErrorHandler::manejar(runtime_error(trozo.errores[e]));
+        }
+        for (size_t i = 0; i < trozo.registros.size(); i++) {
+            if (trozo.registros[i].duplicado) {
+                SO_CONTAR(PERSISTENCIA_DUPLICADOS);
+                ErrorHandler::manejar(runtime_error(
+                    "ID " + to_string_alt(trozo.registros[i].id) + " duplicado en " + archivo +
+                    ": se conserva la primera aparicin"));
+            } else {
+                registros++;
+            }
+        }
+        if (!trozo.primero) continue;
+        if (ultimo) ultimo->siguiente = trozo.primero; else cabeza = trozo.primero;
+        ultimo = trozo.ultimo;
+    }
+    SO_CONTAR_N(PERSISTENCIA_REGISTROS, registros);
+    SO_CONTAR(PERSISTENCIA_CARGAS);
+    return cabeza;
+}
+
+/* ---------------- rbol de procesos ---------------- */
+
+void Persistencia::guardarArbol(const ArbolProcesos& arbol, const string& archivo) {
+    ofstream file(archivo.c_str());
+    if (!file.is_open()) {
+        throw runtime_error("No se pudo abrir " + archivo + " para escritura");
+    }
+
+    // ancestros[p] = proceso de profundidad p en la rama actual
+    vector<int> ancestros;
+    arbol.recorrer(ArbolProcesos::INIT, [&](int pid, int profundidad) {
+        ancestros.resize((size_t)profundidad);
+        if (profundidad > 0) file << pid << "," << ancestros[(size_t)profundidad - 1] << "\n";
+        ancestros.push_back(pid);
+    });
+    file.close();
+    if (file.fail()) {
+        throw runtime_error("Error al escribir " + archivo);
+    }
+}
+
+size_t Persistencia::cargarArbol(const string& archivo, ArbolProcesos& arbol) {
+    if (!ArchivoProyectado::existe(archivo)) {
+        return 0;
+    }
+    ArchivoProyectado mapa(archivo);
+    const char* p = mapa.datos();
+    const char* fin = p + mapa.tam();
+    size_t agregados = 0;
+    while (p < fin) {
+        const char* finLinea = static_cast<const char*>(memchr(p, '\n', (size_t)(fin - p)));
+        if (!finLinea) finLinea = fin;
+        const char* finDatos = finLinea;
+        if (finDatos > p && finDatos[-1] == '\r') finDatos--;
+
+        if (finDatos > p) {
+            const char* coma = static_cast<const char*>(memchr(p, ',', (size_t)(finDatos - p)));
+            try {
+                if (!coma) {
+                    throw runtime_error("Formato invlido en lnea: " + string(p, finDatos));
+                }
+                arbol.agregar(leerEnteroCsv(p, coma), leerEnteroCsv(coma + 1, finDatos));
+                agregados++;
+            } catch (const exception& e) {
+                ErrorHandler::manejar(e);
+            }
+        }
+        p = finLinea + 1;
+    }
+    return agregados;
+}
@@ -0,0 +1,345 @@
+#include "Persistencia.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "CodecLZ.h"
+#include "Metricas.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+/* ---------------- Formato comprimido ----------------
+ *   CabeceraComprimida
+ *   diccionario comprimido (varint cantidad, luego varint longitud + bytes)
+ *   IndiceBloque[bloques]
+ *   bloques comprimidos, uno tras otro
+ */
+
+namespace {
+
+const char MAGIA[4] = { 'S', 'O', 'P', 'Z' };
+const uint32_t VERSION = 1;
+const uint32_t BLOQUE_COMPRIMIDO = 1; // Si no, el bloque va tal cual
+
+struct CabeceraComprimida {
+    char magia[4];
+    uint32_t version;
+    uint64_t registros;
+    uint32_t bloques;
+    uint32_t diccionarioTam;   // Bytes del diccionario sin comprimir
+    uint32_t diccionarioComp;  // Bytes comprimidos
+    uint32_t reservado;
+};
+
+struct IndiceBloque {
+    uint32_t registros;
+    uint32_t tamOriginal;
+    uint32_t tamGuardado;
+    uint32_t banderas;
+};
+
+void escribirVarint(vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+uint64_t leerVarint(const uint8_t*& p, const uint8_t* fin) {
+    uint64_t v = 0;
+    for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7) {
+        if (p >= fin) throw runtime_error("Varint truncado");
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7F) << desplazamiento;
+        if (!(b & 0x80)) return v;
+    }
+    throw runtime_error("Varint demasiado largo");
+}
+
+uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+int64_t desZigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+/**
+ * Comprime un bloque; si no gana espacio lo deja sin comprimir.
+ */
+IndiceBloque empaquetar(const vector<uint8_t>& crudo, uint32_t registros,
+                        vector<uint8_t>& guardado) {
+    IndiceBloque ib;
+    ib.registros = registros;
+    ib.tamOriginal = (uint32_t)crudo.size();
+    CodecLZ::comprimir(crudo.data(), crudo.size(), guardado);
+    if (guardado.size() < crudo.size()) {
+        ib.banderas = BLOQUE_COMPRIMIDO;
+    } else {
+        guardado = crudo;
+        ib.banderas = 0;
+    }
+    ib.tamGuardado = (uint32_t)guardado.size();
+    return ib;
+}
+
+void desempaquetar(const IndiceBloque& ib, const uint8_t* datos, vector<uint8_t>& crudo) {
+    if (!(ib.banderas & BLOQUE_COMPRIMIDO) && ib.tamGuardado != ib.tamOriginal) {
+        throw runtime_error("Bloque sin comprimir invlido");
+    }
+    crudo.resize(ib.tamOriginal);
+    if (ib.banderas & BLOQUE_COMPRIMIDO) {
+        CodecLZ::descomprimir(datos, ib.tamGuardado, crudo.data(), ib.tamOriginal);
+    } else if (ib.tamOriginal) {
+        memcpy(crudo.data(), datos, ib.tamOriginal);
+    }
+}
+
+/**
+ * Codifica por columnas los registros de un bloque.
+ */
+void codificarBloque(NodoProcesso* desde, uint32_t cuantos,
+                     unordered_map<uint32_t, uint32_t>& diccionario,
+                     vector<NombreProceso>& nombres, vector<uint8_t>& crudo) {
+    crudo.clear();
+    int64_t anterior = 0;
+    NodoProcesso* p = desde;
+    for (uint32_t i = 0; i < cuantos; i++, p = p->siguiente) {
+        escribirVarint(crudo, zigzag((int64_t)p->id - anterior));
+        anterior = p->id;
+    }
+    p = desde;
+    for (uint32_t i = 0; i < cuantos; i++, p = p->siguiente) {
+        if (p->prioridad < 0 || p->prioridad > 255) {
+            throw runtime_error("Prioridad fuera de rango en el proceso " + to_string_alt(p->id));
+        }
+        crudo.push_back((uint8_t)p->prioridad);
+    }
+    p = desde;
+    for (uint32_t i = 0; i < cuantos; i++, p = p->siguiente) {
+        pair<unordered_map<uint32_t, uint32_t>::iterator, bool> r =
+            diccionario.insert(make_pair(p->nombre.getId(), (uint32_t)nombres.size()));
+        if (r.second) nombres.push_back(p->nombre);
+        escribirVarint(crudo, r.first->second);
+    }
+}
+
+/**
+ * Resultado de decodificar un bloque: una cadena de nodos ya enlazada.
+ */
+struct TramoDecodificado {
+    NodoProcesso* primero;
+    NodoProcesso* ultimo;
+    string error;
+};
+
+void liberarCadena(NodoProcesso* p) {
+    while (p) {
+        NodoProcesso* sig = p->siguiente;
+        delete p;
+        p = sig;
+    }
+}
+
+void decodificarBloque(const IndiceBloque& ib, const uint8_t* datos,
+                       const vector<NombreProceso>& nombres, TramoDecodificado& tramo) {
+    // Cada registro ocupa al menos un byte: un ndice daado no puede
+    // pedir memoria antes de revisar los datos
+    if (ib.registros > ib.tamOriginal) throw runtime_error("Cuenta de registros del bloque invlida");
+    vector<uint8_t> crudo;
+    desempaquetar(ib, datos, crudo);
+    const uint8_t* p = crudo.data();
+    const uint8_t* fin = p + crudo.size();
+
+    vector<int> ids(ib.registros);
+    int64_t anterior = 0;
+    for (uint32_t i = 0; i < ib.registros; i++) {
+        anterior += desZigzag(leerVarint(p, fin));
+        ids[i] = (int)anterior;
+    }
+    if ((size_t)(fin - p) < ib.registros) throw runtime_error("Columna de prioridades truncada");
+    const uint8_t* prioridades = p;
+    p += ib.registros;
+
+    for (uint32_t i = 0; i < ib.registros; i++) {
+        uint64_t idx = leerVarint(p, fin);
+        if (idx >= nombres.size()) throw runtime_error("ndice de nombre invlido");
+        NodoProcesso* nodo = new NodoProcesso(ids[i], nombres[(size_t)idx], prioridades[i]);
+        if (tramo.ultimo) tramo.ultimo->siguiente = nodo; else tramo.primero = nodo;
+        tramo.ultimo = nodo;
+    }
+    if (p != fin) throw runtime_error("Bytes sobrantes en el bloque");
+}
+
+} // namespace
+
+size_t Persistencia::guardarProcesosComprimido(NodoProcesso* cabeza, const string& archivo) {
+    SO_CRONOMETRO(PERSISTENCIA_GUARDAR_NS);
+    unordered_map<uint32_t, uint32_t> diccionario; // ID del pool -> ndice local
+    vector<NombreProceso> nombres;
+    vector<IndiceBloque> indice;
+    vector<uint8_t> datos;
+    vector<uint8_t> crudo, guardado;
+    uint64_t registros = 0;
+
+    NodoProcesso* p = cabeza;
+    while (p) {
+        NodoProcesso* desde = p;
+        uint32_t cuantos = 0;
+        while (p && cuantos < REGISTROS_POR_BLOQUE) {
+            p = p->siguiente;
+            cuantos++;
+        }
+        codificarBloque(desde, cuantos, diccionario, nombres, crudo);
+        indice.push_back(empaquetar(crudo, cuantos, guardado));
+        datos.insert(datos.end(), guardado.begin(), guardado.end());
+        registros += cuantos;
+    }
+
+    crudo.clear();
+    escribirVarint(crudo, nombres.size());
+    for (size_t i = 0; i < nombres.size(); i++) {
+        const string& texto = nombres[i].str();
+        escribirVarint(crudo, texto.size());
+        crudo.insert(crudo.end(), texto.begin(), texto.end());
+    }
+    IndiceBloque dic = empaquetar(crudo, 0, guardado);
+
+    CabeceraComprimida cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magia, MAGIA, sizeof(MAGIA));
+    cab.version = VERSION;
+    cab.registros = registros;
+    cab.bloques = (uint32_t)indice.size();
+    cab.diccionarioTam = dic.tamOriginal;
+    cab.diccionarioComp = dic.banderas & BLOQUE_COMPRIMIDO ? dic.tamGuardado : 0;
+
+    ofstream file(archivo.c_str(), ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        throw runtime_error("No se pudo abrir " + archivo + " para escritura");
+    }
+    file.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    file.write(reinterpret_cast<const char*>(guardado.data()), (streamsize)guardado.size());
+    file.write(reinterpret_cast<const char*>(indice.data()),
+               (streamsize)(indice.size() * sizeof(IndiceBloque)));
+    file.write(reinterpret_cast<const char*>(datos.data()), (streamsize)datos.size());
+    if (!file) {
+        throw runtime_error("Error al escribir " + archivo);
+    }
+    SO_CONTAR_N(PERSISTENCIA_REGISTROS, registros);
+    SO_CONTAR(PERSISTENCIA_GUARDADOS);
+    return sizeof(cab) + guardado.size() + indice.size() * sizeof(IndiceBloque) + datos.size();
+}
+
+bool Persistencia::esComprimido(const string& archivo) {
+    ifstream file(archivo.c_str(), ios::binary);
+    char magia[4];
+    return file.read(magia, sizeof(magia)) && memcmp(magia, MAGIA, sizeof(MAGIA)) == 0;
+}
+
+NodoProcesso* Persistencia::cargarProcesosComprimido(const string& archivo, unsigned hilos) {
+    ifstream file(archivo.c_str(), ios::binary);
+    if (!file.is_open()) {
+        throw runtime_error("No se pudo abrir " + archivo);
+    }
+    SO_CRONOMETRO(PERSISTENCIA_CARGAR_NS);
+    vector<uint8_t> contenido((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    const uint8_t* p = contenido.data();
+    const uint8_t* fin = p + contenido.size();
+
+    CabeceraComprimida cab;
+    if (contenido.size() < sizeof(cab)) throw runtime_error("Archivo comprimido truncado: " + archivo);
+    memcpy(&cab, p, sizeof(cab));
+    p += sizeof(cab);
+    if (memcmp(cab.magia, MAGIA, sizeof(MAGIA)) != 0 || cab.version != VERSION) {
+        throw runtime_error(archivo + " no es un archivo de procesos comprimido compatible");
+    }
+
+    // Diccionario de nombres
+    IndiceBloque dic;
+    dic.registros = 0;
+    dic.tamOriginal = cab.diccionarioTam;
+    dic.tamGuardado = cab.diccionarioComp ? cab.diccionarioComp : cab.diccionarioTam;
+    dic.banderas = cab.diccionarioComp ? BLOQUE_COMPRIMIDO : 0;
+    if ((size_t)(fin - p) < dic.tamGuardado) throw runtime_error("Diccionario truncado");
+    vector<uint8_t> crudo;
+    desempaquetar(dic, p, crudo);
+    p += dic.tamGuardado;
+    vector<NombreProceso> nombres;
+    {
+        const uint8_t* q = crudo.data();
+        const uint8_t* qfin = q + crudo.size();
+        uint64_t cuantos = leerVarint(q, qfin);
+        if (cuantos > crudo.size()) throw runtime_error("Diccionario invlido");
+        nombres.reserve((size_t)cuantos);
+        for (uint64_t i = 0; i < cuantos; i++) {
+            uint64_t len = leerVarint(q, qfin);
+            if ((uint64_t)(qfin - q) < len) throw runtime_error("Diccionario truncado");
+            nombres.push_back(NombreProceso(PoolNombres::internar(
+                string_view(reinterpret_cast<const char*>(q), (size_t)len))));
+            q += len;
+        }
+    }
+
+    // ndice de bloques y posicin de cada uno
+    if ((uint64_t)(fin - p) < (uint64_t)cab.bloques * sizeof(IndiceBloque)) {
+        throw runtime_error("ndice de bloques truncado");
+    }
+    vector<IndiceBloque> indice(cab.bloques);
+    if (!indice.empty()) memcpy(indice.data(), p, indice.size() * sizeof(IndiceBloque));
+    p += indice.size() * sizeof(IndiceBloque);
+    vector<const uint8_t*> inicio(cab.bloques);
+    uint64_t registros = 0;
+    for (uint32_t b = 0; b < cab.bloques; b++) {
+        if ((size_t)(fin - p) < indice[b].tamGuardado) throw runtime_error("Bloque truncado");
+        inicio[b] = p;
+        p += indice[b].tamGuardado;
+        registros += indice[b].registros;
+    }
+    if (registros != cab.registros) throw runtime_error("Cuenta de registros inconsistente");
+
+    // Descompresin paralela: cada hilo toma el siguiente bloque libre
+    vector<TramoDecodificado> tramos(cab.bloques);
+    for (uint32_t b = 0; b < cab.bloques; b++) {
+        tramos[b].primero = tramos[b].ultimo = NULL;
+    }
+    if (hilos == 0) hilos = thread::hardware_concurrency();
+    if (hilos == 0) hilos = 1;
+    if (hilos > cab.bloques) hilos = cab.bloques ? cab.bloques : 1;
+    atomic<uint32_t> siguiente(0);
+    auto trabajador = [&]() {
+        for (;;) {
+            uint32_t b = siguiente.fetch_add(1, memory_order_relaxed);
+            if (b >= cab.bloques) return;
+            try {
+                decodificarBloque(indice[b], inicio[b], nombres, tramos[b]);
+            } catch (const exception& e) {
+                tramos[b].error = e.what();
+            }
+        }
+    };
+    vector<thread> equipo;
+    for (unsigned h = 1; h < hilos; h++) equipo.push_back(thread(trabajador));
+    trabajador();
+    for (size_t h = 0; h < equipo.size(); h++) equipo[h].join();
+
+    // Enlaza los tramos en orden de bloque
+    NodoProcesso* cabeza = NULL;
+    NodoProcesso* ultimo = NULL;
+    string error;
+    for (uint32_t b = 0; b < cab.bloques; b++) {
+        if (!tramos[b].error.empty() && error.empty()) error = tramos[b].error;
+        if (!tramos[b].primero) continue;
+        if (ultimo) ultimo->siguiente = tramos[b].primero; else cabeza = tramos[b].primero;
+        ultimo = tramos[b].ultimo;
+    }
+    if (!error.empty()) {
+        liberarCadena(cabeza);
+        throw runtime_error("Archivo comprimido daado (" + archivo + "): " + error);
+    }
+    SO_CONTAR_N(PERSISTENCIA_REGISTROS, registros);
+    SO_CONTAR(PERSISTENCIA_CARGAS);
+    return cabeza;
+}
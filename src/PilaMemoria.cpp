@@ -0,0 +1,411 @@
+#include "PilaMemoria.h"
+
+#include <bit>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#include "Metricas.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+const string PilaMemoria::ARCHIVO_MEMORIA = "memoria.dat";
+
+PilaMemoria::PilaMemoria(int cap)
+    : tope(NULL), capacidad(cap), contador(0), huecos(0), libre(0), libreCuadrados(0),
+      idTraza(Traza::nuevoObjeto()), epocaTraza(0), baseCompactacion(0), cursorCompactacion(0) {
+    memset(histograma, 0, sizeof(histograma));
+    memset(&compactacion, 0, sizeof(compactacion));
+}
+
+PilaMemoria::~PilaMemoria() {
+    liberarBloques();
+    if (Traza::activa() && epocaTraza == Traza::epoca()) {
+        Traza::registrar(Traza::PILA_DESTRUIR, idTraza);
+    }
+}
+
+void PilaMemoria::vaciar() {
+    bool traza = trazando();
+    liberarBloques();
+    if (traza) Traza::registrar(Traza::PILA_VACIAR, idTraza);
+}
+
+void PilaMemoria::liberarBloques() {
+    SO_MEDIDOR(MEMORIA_OCUPACION, -contador);
+    while (tope) {
+        NodoMemoria* temp = tope;
+        tope = tope->abajo;
+        delete temp;
+    }
+    porProceso.clear();
+    contador = 0;
+    ocupadas.vaciar();
+    porDireccion.clear();
+    // Las manijas de los bloques liberados dejan de valer
+    manijasLibres.clear();
+    for (size_t i = manijas.size(); i > 0; i--) {
+        if (manijas[i - 1]) generaciones[i - 1]++;
+        manijas[i - 1] = NULL;
+        manijasLibres.push_back((uint32_t)(i - 1));
+    }
+    huecos = libre = libreCuadrados = 0;
+    memset(histograma, 0, sizeof(histograma));
+    compactacion.activa = false;
+}
+
+PilaMemoria::Manija PilaMemoria::push(int direccion, int pid) {
+    if (contador >= capacidad) {
+        SO_CONTAR(MEMORIA_RECHAZOS);
+        throw runtime_error("Memoria llena");
+    }
+    bool traza = trazando();
+    Manija manija = apilar(direccion, pid);
+    SO_CONTAR(MEMORIA_ASIGNACIONES);
+    SO_MEDIDOR(MEMORIA_OCUPACION, 1);
+    if (traza) Traza::registrar(Traza::PILA_PUSH, idTraza, direccion, pid);
+    return manija;
+}
+
+PilaMemoria::Manija PilaMemoria::apilar(int direccion, int pid) {
+    NodoMemoria* nuevo = new NodoMemoria(direccion, pid);
+    nuevo->abajo = tope;
+    if (tope) tope->arriba = nuevo;
+    tope = nuevo;
+    contador++;
+
+    // Los bloques de una misma direccin van enlazados: la direccin se
+    // ocupa con el primero
+    NodoMemoria*& enDireccion = porDireccion[direccion];
+    if (enDireccion) {
+        nuevo->sigDireccion = enDireccion;
+        enDireccion->antDireccion = nuevo;
+    } else {
+        ocupar(direccion);
+    }
+    enDireccion = nuevo;
+
+    uint32_t i;
+    if (manijasLibres.empty()) {
+        i = (uint32_t)manijas.size();
+        manijas.push_back(NULL);
+        generaciones.push_back(1);
+    } else {
+        i = manijasLibres.back();
+        manijasLibres.pop_back();
+    }
+    manijas[i] = nuevo;
+    nuevo->manija = i;
+
+    // Enlaza el bloque al frente de la lista de su proceso
+    if (pid != SIN_DUENO) {
+        NodoMemoria*& primero = porProceso[pid];
+        nuevo->sigProceso = primero;
+        if (primero) primero->antProceso = nuevo;
+        primero = nuevo;
+    }
+    return ((Manija)generaciones[i] << 32) | i;
+}
+
+void PilaMemoria::sumarHueco(int64_t tam) {
+    if (tam <= 0) return;
+    huecos++;
+    libre += (uint64_t)tam;
+    libreCuadrados += (uint64_t)tam * (uint64_t)tam;
+    histograma[bit_width((uint64_t)tam) - 1]++;
+}
+
+void PilaMemoria::restarHueco(int64_t tam) {
+    if (tam <= 0) return;
+    huecos--;
+    libre -= (uint64_t)tam;
+    libreCuadrados -= (uint64_t)tam * (uint64_t)tam;
+    histograma[bit_width((uint64_t)tam) - 1]--;
+}
+
+void PilaMemoria::ocupar(int direccion) {
+    ConjuntoDirecciones::Vecinos v;
+    ocupadas.insertar(direccion, v);
+    // Parte en dos el hueco que haba entre sus vecinas
+    if (v.hayAnterior && v.haySiguiente) restarHueco((int64_t)v.siguiente - v.anterior - 1);
+    if (v.hayAnterior) sumarHueco((int64_t)direccion - v.anterior - 1);
+    if (v.haySiguiente) sumarHueco((int64_t)v.siguiente - direccion - 1);
+}
+
+void PilaMemoria::desocupar(int direccion) {
+    // Un hueco nuevo dentro de la parte ya compacta hace retroceder el cursor
+    if (compactacion.activa && direccion >= baseCompactacion && direccion < cursorCompactacion) {
+        cursorCompactacion = direccion;
+    }
+    // Sus dos huecos vecinos se unen en uno
+    ConjuntoDirecciones::Vecinos v;
+    ocupadas.eliminar(direccion, v);
+    if (v.hayAnterior) restarHueco((int64_t)direccion - v.anterior - 1);
+    if (v.haySiguiente) restarHueco((int64_t)v.siguiente - direccion - 1);
+    if (v.hayAnterior && v.haySiguiente) sumarHueco((int64_t)v.siguiente - v.anterior - 1);
+}
+
+void PilaMemoria::desenlazar(NodoMemoria* nodo) {
+    // Saca el nodo de la pila
+    if (nodo->arriba) nodo->arriba->abajo = nodo->abajo; else tope = nodo->abajo;
+    if (nodo->abajo) nodo->abajo->arriba = nodo->arriba;
+    contador--;
+
+    // Y de los de su direccin, que queda libre si era el ltimo
+    if (nodo->antDireccion) {
+        nodo->antDireccion->sigDireccion = nodo->sigDireccion;
+    } else if (nodo->sigDireccion) {
+        porDireccion[nodo->direccion] = nodo->sigDireccion;
+    } else {
+        porDireccion.erase(nodo->direccion);
+        desocupar(nodo->direccion);
+    }
+    if (nodo->sigDireccion) nodo->sigDireccion->antDireccion = nodo->antDireccion;
+
+    manijas[nodo->manija] = NULL;
+    generaciones[nodo->manija]++;
+    manijasLibres.push_back(nodo->manija);
+    SO_CONTAR(MEMORIA_LIBERACIONES);
+    SO_MEDIDOR(MEMORIA_OCUPACION, -1);
+}
+
+int PilaMemoria::pop() {
+    if (!tope) {
+        throw runtime_error("Memoria vaca");
+    }
+    bool traza = trazando();
+
+    NodoMemoria* temp = tope;
+    int direccion = temp->direccion;
+    desenlazar(temp);
+
+    // Lo quita tambin de la lista de su proceso
+    if (temp->pid != SIN_DUENO) {
+        if (temp->antProceso) {
+            temp->antProceso->sigProceso = temp->sigProceso;
+        } else if (temp->sigProceso) {
+            porProceso[temp->pid] = temp->sigProceso;
+        } else {
+            porProceso.erase(temp->pid);
+        }
+        if (temp->sigProceso) temp->sigProceso->antProceso = temp->antProceso;
+    }
+    delete temp;
+    if (traza) Traza::registrar(Traza::PILA_POP, idTraza, 0, 0, direccion);
+    return direccion;
+}
+
+int PilaMemoria::liberarProceso(int pid) {
+    return liberarBloquesDe(pid, trazando());
+}
+
+int PilaMemoria::liberarProcesos(const vector<int>& pids) {
+    bool traza = trazando();
+    int liberados = 0;
+    for (size_t i = 0; i < pids.size(); i++) liberados += liberarBloquesDe(pids[i], traza);
+    return liberados;
+}
+
+int PilaMemoria::liberarBloquesDe(int pid, bool traza) {
+    unordered_map<int, NodoMemoria*>::iterator it = porProceso.find(pid);
+    if (it == porProceso.end()) {
+        if (traza) Traza::registrar(Traza::PILA_LIBERAR_PROCESO, idTraza, 0, pid, 0);
+        return 0;
+    }
+
+    int liberados = 0;
+    NodoMemoria* actual = it->second;
+    while (actual) {
+        NodoMemoria* sig = actual->sigProceso;
+        desenlazar(actual);
+        delete actual;
+        liberados++;
+        actual = sig;
+    }
+    porProceso.erase(it);
+    if (traza) Traza::registrar(Traza::PILA_LIBERAR_PROCESO, idTraza, 0, pid, liberados);
+    return liberados;
+}
+
+int PilaMemoria::bloquesDe(int pid) const {
+    unordered_map<int, NodoMemoria*>::const_iterator it = porProceso.find(pid);
+    int count = 0;
+    for (NodoMemoria* n = it == porProceso.end() ? NULL : it->second; n; n = n->sigProceso) {
+        count++;
+    }
+    return count;
+}
+
+/* ---------------- Manijas y compactacin ---------------- */
+
+bool PilaMemoria::manijaValida(Manija manija) const {
+    uint32_t i = (uint32_t)manija;
+    return i < manijas.size() && manijas[i] && generaciones[i] == (uint32_t)(manija >> 32);
+}
+
+int PilaMemoria::direccionDe(Manija manija) const {
+    if (!manijaValida(manija)) {
+        throw runtime_error("Manija invlida: " + to_string_alt(manija));
+    }
+    return manijas[(uint32_t)manija]->direccion;
+}
+
+int PilaMemoria::moverDireccion(int origen, int destino) {
+    unordered_map<int, NodoMemoria*>::iterator it = porDireccion.find(origen);
+    NodoMemoria* primero = it->second;
+    porDireccion.erase(it);
+    int bloques = 0;
+    for (NodoMemoria* n = primero; n; n = n->sigDireccion) {
+        n->direccion = destino;
+        bloques++;
+    }
+    porDireccion[destino] = primero;
+    desocupar(origen);
+    ocupar(destino);
+    return bloques;
+}
+
+int PilaMemoria::reubicar(int origen, int destino) {
+    if (!porDireccion.count(origen)) {
+        throw runtime_error("No hay bloques en la direccin " + to_string_alt(origen));
+    }
+    if (porDireccion.count(destino)) {
+        throw runtime_error("La direccin " + to_string_alt(destino) + " ya est ocupada");
+    }
+    bool traza = trazando();
+    int bloques = moverDireccion(origen, destino);
+    SO_CONTAR_N(MEMORIA_REUBICADOS, bloques);
+    if (traza) Traza::registrar(Traza::PILA_REUBICAR, idTraza, origen, destino, bloques);
+    return bloques;
+}
+
+void PilaMemoria::iniciarCompactacion() {
+    if (compactacion.activa) return;
+    ResumenMemoria r = resumen();
+    memset(&compactacion, 0, sizeof(compactacion));
+    compactacion.huecosInicio = r.huecos;
+    compactacion.libreInicio = r.libre;
+    compactacion.fragmentacionInicio = r.fragmentacion;
+    if (ocupadas.vacio()) return;
+    compactacion.activa = true;
+    baseCompactacion = cursorCompactacion = ocupadas.minimo();
+}
+
+bool PilaMemoria::pasoCompactacion(size_t presupuesto) {
+    if (presupuesto == 0) {
+        throw runtime_error("El paso de compactacin debe revisar al menos una direccin");
+    }
+    if (!compactacion.activa) return false;
+    compactacion.pasos++;
+    for (size_t i = 0; i < presupuesto; i++) {
+        int siguiente;
+        if (!ocupadas.primeroDesde(cursorCompactacion, siguiente)) {
+            compactacion.activa = false;
+            return false;
+        }
+        compactacion.examinadas++;
+        if (siguiente != cursorCompactacion) {
+            // Hay un hueco en el cursor: la prxima ocupada baja a llenarlo
+            compactacion.bloquesMovidos += (uint64_t)reubicar(siguiente, cursorCompactacion);
+            compactacion.direccionesMovidas++;
+        }
+        if (cursorCompactacion == ocupadas.maximo()) {
+            compactacion.activa = false;
+            return false;
+        }
+        cursorCompactacion++;
+    }
+    return true;
+}
+
+EstadisticasCompactacion PilaMemoria::compactar(size_t presupuesto) {
+    iniciarCompactacion();
+    while (pasoCompactacion(presupuesto)) {}
+    return compactacion;
+}
+
+bool PilaMemoria::anunciarTraza(uint32_t epoca) {
+    epocaTraza = epoca;
+    Traza::registrar(Traza::PILA_CREAR, idTraza, 0, capacidad);
+    // Del fondo al tope, para reconstruir el mismo orden de la pila
+    NodoMemoria* fondo = tope;
+    while (fondo && fondo->abajo) fondo = fondo->abajo;
+    for (NodoMemoria* n = fondo; n; n = n->arriba) {
+        Traza::registrar(Traza::PILA_PUSH, idTraza, n->direccion, n->pid);
+    }
+    return true;
+}
+
+ResumenMemoria PilaMemoria::resumen() const {
+    ResumenMemoria r;
+    r.usados = contador;
+    r.capacidad = capacidad;
+    r.direcciones = ocupadas.tam();
+    r.minima = ocupadas.vacio() ? 0 : ocupadas.minimo();
+    r.maxima = ocupadas.vacio() ? 0 : ocupadas.maximo();
+    r.huecos = huecos;
+    r.libre = libre;
+    memcpy(r.histograma, histograma, sizeof(histograma));
+    r.fragmentacion = libre ? 1.0 - (double)libreCuadrados / ((double)libre * (double)libre) : 0.0;
+    return r;
+}
+
+void PilaMemoria::estadoMemoria() const {
+    ResumenMemoria r = resumen();
+    cout << "\n--- Estado Memoria ---\n";
+    cout << "Espacio usado: " << contador << "/" << capacidad << endl;
+    if (!tope) {
+        cout << "No hay bloques asignados\n";
+        return;
+    }
+    cout << "Direcciones: " << r.direcciones << " distintas, de " << r.minima << " a "
+         << r.maxima << "\n";
+    ios::fmtflags formato = cout.flags();
+    streamsize precision = cout.precision();
+    cout << "Huecos: " << r.huecos << " (" << r.libre << " direcciones libres)"
+         << " | Fragmentacin: " << fixed << setprecision(3) << r.fragmentacion << "\n";
+    cout.flags(formato);
+    cout.precision(precision);
+    for (int k = 0; k < ResumenMemoria::CLASES; k++) {
+        if (!r.histograma[k]) continue;
+        uint64_t desde = (uint64_t)1 << k;
+        cout << "  Huecos de " << desde;
+        if (k > 0) cout << "-" << 2 * desde - 1;
+        cout << ": " << r.histograma[k] << "\n";
+    }
+    if (compactacion.pasos > 0) {
+        const EstadisticasCompactacion& c = compactacion;
+        cout << "Compactacin " << (c.activa ? "en curso" : "terminada") << ": " << c.pasos
+             << " pasos, " << c.direccionesMovidas << " direcciones movidas (" << c.bloquesMovidos
+             << " bloques)\n";
+        cout << "  Direcciones libres entre mnima y mxima: " << c.libreInicio << " -> "
+             << r.libre << " | Fragmentacin: " << fixed << setprecision(3)
+             << c.fragmentacionInicio << " -> " << r.fragmentacion << "\n";
+        cout.flags(formato);
+        cout.precision(precision);
+    }
+}
+
+size_t PilaMemoria::mostrarDirecciones(size_t pagina, size_t porPagina) const {
+    if (porPagina == 0) {
+        throw runtime_error("Las pginas deben tener al menos una direccin");
+    }
+    size_t paginas = ((size_t)contador + porPagina - 1) / porPagina;
+    if (pagina >= paginas) {
+        cout << "No hay bloques en la pgina " << pagina + 1 << "\n";
+        return paginas;
+    }
+    NodoMemoria* temp = tope;
+    for (size_t i = 0; i < pagina * porPagina; i++) temp = temp->abajo;
+
+    cout << "Direcciones (tope primero), pgina " << pagina + 1 << "/" << paginas << ": ";
+    for (size_t i = 0; temp && i < porPagina; i++, temp = temp->abajo) {
+        cout << temp->direccion;
+        if (temp->pid != SIN_DUENO) cout << "(pid " << temp->pid << ")";
+        cout << " ";
+    }
+    cout << endl;
+    return paginas;
+}
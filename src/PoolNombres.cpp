@@ -0,0 +1,135 @@
+#include "PoolNombres.h"
+
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#include "Metricas.h"
+
+using namespace std;
+
+namespace {
+
+const int BITS_TROZO = 12;
+const uint32_t TAM_TROZO = 1u << BITS_TROZO;
+const uint32_t MAX_TROZOS = 1u << 16;
+
+/**
+ * Estado del pool. Se reserva con new y nunca se destruye, para que los
+ * nombres sigan vlidos en destructores estticos y en hijos de fork().
+ */
+void antesDeFork();
+void despuesDeForkPadre();
+void despuesDeForkHijo();
+
+struct Pool {
+    shared_mutex mutex;
+    unordered_map<string_view, uint32_t> indice; // Vistas sobre las cadenas de 'trozos'
+    string* trozos[MAX_TROZOS];                  // Cadenas en trozos fijos (no se mueven)
+    uint32_t cantidad;
+    size_t bytes;
+
+    Pool() : cantidad(0), bytes(0) {
+        for (uint32_t i = 0; i < MAX_TROZOS; i++) trozos[i] = NULL;
+        agregar(string());
+#ifndef _WIN32
+        pthread_atfork(antesDeFork, despuesDeForkPadre, despuesDeForkHijo);
+#endif
+    }
+
+    // Requiere el bloqueo exclusivo
+    uint32_t agregar(string&& texto) {
+        uint32_t id = cantidad;
+        if (id >> BITS_TROZO >= MAX_TROZOS) {
+            throw runtime_error("Pool de nombres lleno");
+        }
+        string*& trozo = trozos[id >> BITS_TROZO];
+        if (!trozo) trozo = new string[TAM_TROZO];
+        string& destino = trozo[id & (TAM_TROZO - 1)];
+        destino = std::move(texto);
+        indice.insert(make_pair(string_view(destino), id));
+        bytes += destino.size();
+        cantidad++;
+        SO_MEDIDOR(NOMBRES_INTERNADOS, 1);
+        return id;
+    }
+};
+
+Pool* instancia = NULL;
+
+Pool& pool() {
+    static Pool* p = instancia = new Pool();
+    return *p;
+}
+
+/**
+ * El pool se bloquea en exclusiva durante fork(): el hijo (p. ej. un
+ * GuardadoFondo) nace con el ndice consistente y sin que otro hilo
+ * tenga el cerrojo a medias, y puede internar y leer nombres. En el hijo
+ * el cerrojo se crea de nuevo en vez de liberarse: el rwlock de glibc
+ * recuerda el TID del escritor, y el hilo del hijo tiene otro.
+ */
+void antesDeFork() {
+    if (instancia) instancia->mutex.lock();
+}
+
+void despuesDeForkPadre() {
+    if (instancia) instancia->mutex.unlock();
+}
+
+void despuesDeForkHijo() {
+    if (instancia) new (&instancia->mutex) shared_mutex();
+}
+
+// Se crea al cargar el programa, antes de que haya otros hilos: un fork
+// en medio de la primera llamada a pool() dejara al hijo esperando la
+// guarda de la variable esttica
+const bool poolCreado = (pool(), true);
+
+template <typename T>
+uint32_t internarEn(Pool& p, string_view vista, T&& texto) {
+    {
+        shared_lock<shared_mutex> lectura(p.mutex);
+        unordered_map<string_view, uint32_t>::const_iterator it = p.indice.find(vista);
+        if (it != p.indice.end()) return it->second;
+    }
+    unique_lock<shared_mutex> escritura(p.mutex);
+    // Otro hilo pudo agregarlo entre ambos bloqueos
+    unordered_map<string_view, uint32_t>::const_iterator it = p.indice.find(vista);
+    if (it != p.indice.end()) return it->second;
+    return p.agregar(string(std::forward<T>(texto)));
+}
+
+} // namespace
+
+uint32_t PoolNombres::internar(string_view texto) {
+    return internarEn(pool(), texto, texto);
+}
+
+uint32_t PoolNombres::internar(string&& texto) {
+    string_view vista(texto);
+    return internarEn(pool(), vista, std::move(texto));
+}
+
+const string& PoolNombres::texto(uint32_t id) {
+    Pool& p = pool();
+    return p.trozos[id >> BITS_TROZO][id & (TAM_TROZO - 1)];
+}
+
+size_t PoolNombres::cantidad() {
+    Pool& p = pool();
+    shared_lock<shared_mutex> lectura(p.mutex);
+    return p.cantidad;
+}
+
+size_t PoolNombres::bytes() {
+    Pool& p = pool();
+    shared_lock<shared_mutex> lectura(p.mutex);
+    return p.bytes;
+}
@@ -0,0 +1,357 @@
+#include "Reemplazo.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+/* ---------------- AlgoritmoReemplazo ---------------- */
+
+AlgoritmoReemplazo::AlgoritmoReemplazo(size_t capacidad)
+    : capacidad(capacidad), accesos(0), fallos(0), desalojos(0) {
+    if (capacidad == 0 || capacidad >= ListaIntrusiva::NIL / 2) {
+        throw runtime_error("Capacidad de reemplazo invlida");
+    }
+}
+
+AlgoritmoReemplazo::~AlgoritmoReemplazo() {}
+
+/* ---------------- FIFO ---------------- */
+
+ReemplazoFIFO::ReemplazoFIFO(size_t capacidad)
+    : AlgoritmoReemplazo(capacidad), anillo(capacidad, TablaHash::VACIA),
+      cabeza(0), ocupados(0), residentesHash(capacidad) {}
+
+bool ReemplazoFIFO::acceder(uint64_t clave, uint64_t& victima) {
+    if (residentesHash.buscar(clave)) return false;
+
+    if (ocupados == capacidad) {
+        // Sustituye a la ms antigua; el anillo sigue en orden de llegada
+        victima = anillo[cabeza];
+        residentesHash.borrar(victima);
+        anillo[cabeza] = clave;
+        cabeza = (cabeza + 1) % capacidad;
+    } else {
+        // Las posiciones eliminadas se saltan al avanzar la cabeza
+        size_t pos = (cabeza + ocupados) % capacidad;
+        anillo[pos] = clave;
+        ocupados++;
+    }
+    residentesHash.insertar(clave, 1);
+    return true;
+}
+
+void ReemplazoFIFO::eliminar(uint64_t clave) {
+    if (!residentesHash.buscar(clave)) return;
+    residentesHash.borrar(clave);
+    // Compacta el anillo conservando el orden de llegada: O(capacidad),
+    // aceptable porque solo ocurre al destruir procesos
+    vector<uint64_t> orden;
+    orden.reserve(ocupados);
+    for (size_t k = 0; k < ocupados; k++) {
+        uint64_t c = anillo[(cabeza + k) % capacidad];
+        if (c != clave) orden.push_back(c);
+    }
+    fill(anillo.begin(), anillo.end(), TablaHash::VACIA);
+    copy(orden.begin(), orden.end(), anillo.begin());
+    cabeza = 0;
+    ocupados = orden.size();
+}
+
+/* ---------------- LRU ---------------- */
+
+ReemplazoLRU::ReemplazoLRU(size_t capacidad)
+    : AlgoritmoReemplazo(capacidad), claves(capacidad), enlaces(capacidad),
+      indice(capacidad) {
+    libres.reserve(capacidad);
+    for (size_t i = capacidad; i-- > 0;) libres.push_back((uint32_t)i);
+}
+
+bool ReemplazoLRU::acceder(uint64_t clave, uint64_t& victima) {
+    uint32_t* pos = indice.buscar(clave);
+    if (pos) {
+        if (lista.frente != *pos) {
+            lista.quitar(enlaces, *pos);
+            lista.insertarFrente(enlaces, *pos);
+        }
+        return false;
+    }
+
+    uint32_t i;
+    if (libres.empty()) {
+        i = lista.final;
+        victima = claves[i];
+        lista.quitar(enlaces, i);
+        indice.borrar(victima);
+    } else {
+        i = libres.back();
+        libres.pop_back();
+    }
+    claves[i] = clave;
+    lista.insertarFrente(enlaces, i);
+    indice.insertar(clave, i);
+    return true;
+}
+
+void ReemplazoLRU::eliminar(uint64_t clave) {
+    uint32_t* pos = indice.buscar(clave);
+    if (!pos) return;
+    uint32_t i = *pos;
+    lista.quitar(enlaces, i);
+    indice.borrar(clave);
+    libres.push_back(i);
+}
+
+/* ---------------- Clock ---------------- */
+
+ReemplazoClock::ReemplazoClock(size_t capacidad)
+    : AlgoritmoReemplazo(capacidad), claves(capacidad, TablaHash::VACIA),
+      referencia(capacidad, 0), manecilla(0), indice(capacidad) {
+    libres.reserve(capacidad);
+    for (size_t i = capacidad; i-- > 0;) libres.push_back((uint32_t)i);
+}
+
+bool ReemplazoClock::acceder(uint64_t clave, uint64_t& victima) {
+    uint32_t* pos = indice.buscar(clave);
+    if (pos) {
+        referencia[*pos] = 1;
+        return false;
+    }
+
+    uint32_t i;
+    if (!libres.empty()) {
+        i = libres.back();
+        libres.pop_back();
+    } else {
+        // Avanza dando una segunda oportunidad a las pginas referenciadas
+        while (referencia[manecilla]) {
+            referencia[manecilla] = 0;
+            manecilla = (manecilla + 1) % capacidad;
+        }
+        i = (uint32_t)manecilla;
+        victima = claves[i];
+        indice.borrar(victima);
+        manecilla = (manecilla + 1) % capacidad;
+    }
+    claves[i] = clave;
+    referencia[i] = 1;
+    indice.insertar(clave, i);
+    return true;
+}
+
+void ReemplazoClock::eliminar(uint64_t clave) {
+    uint32_t* pos = indice.buscar(clave);
+    if (!pos) return;
+    uint32_t i = *pos;
+    indice.borrar(clave);
+    claves[i] = TablaHash::VACIA;
+    referencia[i] = 0;
+    libres.push_back(i);
+}
+
+/* ---------------- LFU ---------------- */
+
+ReemplazoLFU::ReemplazoLFU(size_t capacidad)
+    : AlgoritmoReemplazo(capacidad), claves(capacidad), nodoDe(capacidad),
+      enlacesPagina(capacidad), nodos(capacidad + 1), enlacesNodo(capacidad + 1),
+      indice(capacidad) {
+    paginasLibres.reserve(capacidad);
+    for (size_t i = capacidad; i-- > 0;) paginasLibres.push_back((uint32_t)i);
+    nodosLibres.reserve(capacidad + 1);
+    for (size_t i = capacidad + 1; i-- > 0;) nodosLibres.push_back((uint32_t)i);
+}
+
+uint32_t ReemplazoLFU::nuevoNodo(uint64_t frecuencia, uint32_t despuesDe) {
+    uint32_t n = nodosLibres.back();
+    nodosLibres.pop_back();
+    nodos[n].frecuencia = frecuencia;
+    nodos[n].paginas = ListaIntrusiva();
+
+    // Enlaza el nodo tras `despuesDe` (o al frente si es NIL)
+    if (despuesDe == ListaIntrusiva::NIL) {
+        frecuencias.insertarFrente(enlacesNodo, n);
+    } else {
+        uint32_t sig = enlacesNodo[despuesDe].sig;
+        enlacesNodo[n].ant = despuesDe;
+        enlacesNodo[n].sig = sig;
+        enlacesNodo[despuesDe].sig = n;
+        if (sig != ListaIntrusiva::NIL) enlacesNodo[sig].ant = n; else frecuencias.final = n;
+        frecuencias.tam++;
+    }
+    return n;
+}
+
+void ReemplazoLFU::quitarPagina(uint32_t pagina) {
+    uint32_t n = nodoDe[pagina];
+    nodos[n].paginas.quitar(enlacesPagina, pagina);
+    if (nodos[n].paginas.tam == 0) {
+        frecuencias.quitar(enlacesNodo, n);
+        nodosLibres.push_back(n);
+    }
+}
+
+bool ReemplazoLFU::acceder(uint64_t clave, uint64_t& victima) {
+    uint32_t* pos = indice.buscar(clave);
+    if (pos) {
+        // Sube la pgina al nodo de frecuencia + 1, crendolo si falta
+        uint32_t i = *pos;
+        uint32_t n = nodoDe[i];
+        uint64_t f = nodos[n].frecuencia + 1;
+        uint32_t sig = enlacesNodo[n].sig;
+        uint32_t destino;
+        if (sig != ListaIntrusiva::NIL && nodos[sig].frecuencia == f) {
+            destino = sig;
+        } else {
+            destino = nuevoNodo(f, n);
+        }
+        quitarPagina(i);
+        nodos[destino].paginas.insertarFrente(enlacesPagina, i);
+        nodoDe[i] = destino;
+        return false;
+    }
+
+    uint32_t i;
+    if (paginasLibres.empty()) {
+        // Vctima: la menos reciente del nodo de menor frecuencia
+        uint32_t n = frecuencias.frente;
+        i = nodos[n].paginas.final;
+        victima = claves[i];
+        indice.borrar(victima);
+        quitarPagina(i);
+    } else {
+        i = paginasLibres.back();
+        paginasLibres.pop_back();
+    }
+
+    uint32_t primero = frecuencias.frente;
+    uint32_t destino;
+    if (primero != ListaIntrusiva::NIL && nodos[primero].frecuencia == 1) {
+        destino = primero;
+    } else {
+        destino = nuevoNodo(1, ListaIntrusiva::NIL);
+    }
+    claves[i] = clave;
+    nodos[destino].paginas.insertarFrente(enlacesPagina, i);
+    nodoDe[i] = destino;
+    indice.insertar(clave, i);
+    return true;
+}
+
+void ReemplazoLFU::eliminar(uint64_t clave) {
+    uint32_t* pos = indice.buscar(clave);
+    if (!pos) return;
+    uint32_t i = *pos;
+    indice.borrar(clave);
+    quitarPagina(i);
+    paginasLibres.push_back(i);
+}
+
+/* ---------------- ARC ---------------- */
+
+ReemplazoARC::ReemplazoARC(size_t capacidad)
+    : AlgoritmoReemplazo(capacidad), claves(2 * capacidad), listaDe(2 * capacidad),
+      enlaces(2 * capacidad), p(0), indice(2 * capacidad) {
+    libres.reserve(2 * capacidad);
+    for (size_t i = 2 * capacidad; i-- > 0;) libres.push_back((uint32_t)i);
+}
+
+void ReemplazoARC::mover(uint32_t i, int destino) {
+    listas[listaDe[i]].quitar(enlaces, i);
+    listas[destino].insertarFrente(enlaces, i);
+    listaDe[i] = (uint8_t)destino;
+}
+
+void ReemplazoARC::borrarFinal(int lista) {
+    uint32_t i = listas[lista].final;
+    listas[lista].quitar(enlaces, i);
+    indice.borrar(claves[i]);
+    libres.push_back(i);
+}
+
+void ReemplazoARC::reemplazar(bool enB2, uint64_t& victima) {
+    // Solo se desaloja si la cach est llena (puede no estarlo tras eliminar)
+    if (listas[T1].tam + listas[T2].tam < capacidad) return;
+    size_t t1 = listas[T1].tam;
+    if (t1 >= 1 && ((enB2 && t1 == p) || t1 > p)) {
+        uint32_t i = listas[T1].final;
+        victima = claves[i];
+        mover(i, B1);
+    } else {
+        uint32_t i = listas[T2].final;
+        victima = claves[i];
+        mover(i, B2);
+    }
+}
+
+bool ReemplazoARC::acceder(uint64_t clave, uint64_t& victima) {
+    uint32_t* pos = indice.buscar(clave);
+    if (pos) {
+        uint32_t i = *pos;
+        int l = listaDe[i];
+        if (l == T1 || l == T2) {
+            // Caso I: acierto, pasa a la lista de frecuencia
+            mover(i, T2);
+            return false;
+        }
+        if (l == B1) {
+            // Caso II: fantasma de recencia, crece el objetivo de T1
+            size_t delta = max<size_t>(listas[B2].tam / listas[B1].tam, 1);
+            p = min(capacidad, p + delta);
+            reemplazar(false, victima);
+        } else {
+            // Caso III: fantasma de frecuencia, decrece el objetivo de T1
+            size_t delta = max<size_t>(listas[B1].tam / listas[B2].tam, 1);
+            p = p > delta ? p - delta : 0;
+            reemplazar(true, victima);
+        }
+        mover(i, T2);
+        return true;
+    }
+
+    // Caso IV: pgina nueva
+    size_t l1 = listas[T1].tam + listas[B1].tam;
+    size_t total = l1 + listas[T2].tam + listas[B2].tam;
+    if (l1 == capacidad) {
+        if (listas[T1].tam < capacidad) {
+            borrarFinal(B1);
+            reemplazar(false, victima);
+        } else {
+            uint32_t i = listas[T1].final;
+            victima = claves[i];
+            borrarFinal(T1);
+        }
+    } else if (total >= capacidad) {
+        if (total == 2 * capacidad) borrarFinal(B2);
+        reemplazar(false, victima);
+    }
+
+    uint32_t i = libres.back();
+    libres.pop_back();
+    claves[i] = clave;
+    listaDe[i] = T1;
+    listas[T1].insertarFrente(enlaces, i);
+    indice.insertar(clave, i);
+    return true;
+}
+
+void ReemplazoARC::eliminar(uint64_t clave) {
+    uint32_t* pos = indice.buscar(clave);
+    if (!pos) return;
+    uint32_t i = *pos;
+    listas[listaDe[i]].quitar(enlaces, i);
+    indice.borrar(clave);
+    libres.push_back(i);
+}
+
+/* ---------------- Fbrica ---------------- */
+
+AlgoritmoReemplazo* crearAlgoritmoReemplazo(const string& nombre, size_t capacidad) {
+    string n(nombre);
+    transform(n.begin(), n.end(), n.begin(), ::tolower);
+    if (n == "fifo") return new ReemplazoFIFO(capacidad);
+    if (n == "lru") return new ReemplazoLRU(capacidad);
+    if (n == "clock") return new ReemplazoClock(capacidad);
+    if (n == "lfu") return new ReemplazoLFU(capacidad);
+    if (n == "arc") return new ReemplazoARC(capacidad);
+    throw runtime_error("Algoritmo de reemplazo desconocido: " + nombre);
+}
@@ -0,0 +1,239 @@
+#include "ReproductorTraza.h"
+
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+#include "ColaPrioridad.h"
+#include "ListaProcesso.h"
+#include "PilaMemoria.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+/**
+ * Cola reproducida junto con los nodos de proceso que encola.
+ */
+struct ReproductorTraza::ColaReproducida {
+    ColaPrioridad cola;
+    unordered_map<int, NodoProcesso*> nodos;
+    int idPlazos;                 // Proceso del ltimo COLA_PLAZOS (-1 = ninguno)
+    TareaTiempoReal plazos;
+
+    ColaReproducida() : idPlazos(-1) {}
+
+    ~ColaReproducida() {
+        cola.vaciar();
+        for (unordered_map<int, NodoProcesso*>::iterator it = nodos.begin(); it != nodos.end(); ++it) {
+            delete it->second;
+        }
+    }
+
+    NodoProcesso* nodo(int id, int prioridad) {
+        NodoProcesso*& p = nodos[id];
+        if (!p) p = new NodoProcesso(id, NombreProceso(), prioridad);
+        p->prioridad = prioridad;
+        // Los plazos valen solo para el encolado que los sigue
+        p->tiempoReal = idPlazos == id ? plazos : TareaTiempoReal();
+        idPlazos = -1;
+        return p;
+    }
+};
+
+namespace {
+
+/**
+ * Busca la estructura de un objeto de la traza.
+ */
+template <typename T>
+T* buscar(unordered_map<uint32_t, T*>& mapa, uint32_t objeto) {
+    typename unordered_map<uint32_t, T*>::iterator it = mapa.find(objeto);
+    return it == mapa.end() ? NULL : it->second;
+}
+
+/**
+ * Crea (o recrea, tras una restauracin) la estructura de un objeto.
+ */
+template <typename T>
+void reemplazar(unordered_map<uint32_t, T*>& mapa, uint32_t objeto, T* nuevo) {
+    T*& actual = mapa[objeto];
+    delete actual;
+    actual = nuevo;
+}
+
+template <typename T>
+void destruir(unordered_map<uint32_t, T*>& mapa, uint32_t objeto) {
+    typename unordered_map<uint32_t, T*>::iterator it = mapa.find(objeto);
+    if (it == mapa.end()) return;
+    delete it->second;
+    mapa.erase(it);
+}
+
+template <typename T>
+void destruirTodos(unordered_map<uint32_t, T*>& mapa) {
+    for (typename unordered_map<uint32_t, T*>::iterator it = mapa.begin(); it != mapa.end(); ++it) {
+        delete it->second;
+    }
+    mapa.clear();
+}
+
+} // namespace
+
+ReproductorTraza::ReproductorTraza() : aplicados(0), divergencias(0) {
+    memset(porOperacion, 0, sizeof(porOperacion));
+}
+
+ReproductorTraza::~ReproductorTraza() {
+    reiniciar();
+}
+
+void ReproductorTraza::reiniciar() {
+    destruirTodos(listas);
+    destruirTodos(colas);
+    destruirTodos(pilas);
+    aplicados = 0;
+    divergencias = 0;
+    primeraDivergencia.clear();
+    memset(porOperacion, 0, sizeof(porOperacion));
+}
+
+void ReproductorTraza::divergir(const Traza::Evento& e, const string& detalle) {
+    if (divergencias++ == 0) {
+        primeraDivergencia = string(Traza::nombre((Traza::Operacion)e.operacion)) + " (objeto " +
+                             to_string_alt(e.objeto) + ", t=" + to_string_alt(e.ns) +
+                             " ns): " + detalle;
+    }
+}
+
+void ReproductorTraza::aplicar(const Traza::Evento& e, const vector<string>& textos) {
+    aplicados++;
+    porOperacion[e.operacion]++;
+    int id = (int)e.a;
+    ListaProcesso* lista = NULL;
+    ColaReproducida* cola = NULL;
+    PilaMemoria* pila = NULL;
+
+    // Las operaciones que no crean su objeto lo necesitan ya creado
+    switch (e.operacion) {
+    case Traza::LISTA_CREAR:
+    case Traza::COLA_CREAR:
+    case Traza::PILA_CREAR:
+    case Traza::LISTA_DESTRUIR:
+    case Traza::COLA_DESTRUIR:
+    case Traza::PILA_DESTRUIR:
+        break;
+    case Traza::LISTA_INSERTAR:
+    case Traza::LISTA_ELIMINAR:
+    case Traza::LISTA_BUSCAR:
+    case Traza::LISTA_VACIAR:
+        lista = buscar(listas, e.objeto);
+        if (!lista) return divergir(e, "lista desconocida");
+        break;
+    case Traza::PILA_PUSH:
+    case Traza::PILA_POP:
+    case Traza::PILA_LIBERAR_PROCESO:
+    case Traza::PILA_VACIAR:
+    case Traza::PILA_REUBICAR:
+        pila = buscar(pilas, e.objeto);
+        if (!pila) return divergir(e, "pila desconocida");
+        break;
+    default:
+        cola = buscar(colas, e.objeto);
+        if (!cola) return divergir(e, "cola desconocida");
+        break;
+    }
+
+    try {
+        int32_t obtenido = e.resultado;
+        switch (e.operacion) {
+        case Traza::LISTA_CREAR:
+            reemplazar(listas, e.objeto, new ListaProcesso(""));
+            break;
+        case Traza::LISTA_DESTRUIR:
+            destruir(listas, e.objeto);
+            break;
+        case Traza::LISTA_INSERTAR:
+            lista->insertarProcesso(id, e.texto >= 0 ? textos[e.texto] : string(), e.b);
+            break;
+        case Traza::LISTA_ELIMINAR:
+            lista->eliminarProcesso(id);
+            break;
+        case Traza::LISTA_BUSCAR:
+            obtenido = lista->buscarPorId(id) != NULL;
+            break;
+        case Traza::LISTA_VACIAR:
+            lista->liberarMemoria();
+            break;
+        case Traza::COLA_CREAR:
+            reemplazar(colas, e.objeto, new ColaReproducida());
+            break;
+        case Traza::COLA_DESTRUIR:
+            destruir(colas, e.objeto);
+            break;
+        case Traza::COLA_ENCOLAR:
+            cola->cola.encolarPrioridad(cola->nodo(id, e.b));
+            break;
+        case Traza::COLA_DESENCOLAR:
+            obtenido = cola->cola.desencolar()->id;
+            break;
+        case Traza::COLA_ELIMINAR:
+            obtenido = cola->cola.eliminar(id);
+            break;
+        case Traza::COLA_VACIAR:
+            cola->cola.vaciar();
+            break;
+        case Traza::COLA_CAMBIAR_PRIORIDAD:
+            obtenido = cola->cola.cambiarPrioridad(id, e.b);
+            break;
+        case Traza::COLA_AVANZAR_RELOJ:
+            cola->cola.avanzarReloj((uint64_t)e.a);
+            break;
+        case Traza::COLA_PERIODO:
+            cola->cola.setPeriodoEnvejecimiento(e.b);
+            break;
+        case Traza::COLA_POLITICA:
+            if (e.b < PLAN_PRIORIDAD || e.b > PLAN_RATE_MONOTONIC) {
+                throw runtime_error("Poltica desconocida " + to_string_alt(e.b));
+            }
+            cola->cola.setPolitica((PoliticaPlanificacion)e.b);
+            break;
+        case Traza::COLA_PLAZOS:
+            cola->idPlazos = id;
+            cola->plazos = TareaTiempoReal((uint64_t)e.b, 1);
+            cola->plazos.plazoAbsoluto = (uint64_t)(uint32_t)e.resultado;
+            break;
+        case Traza::PILA_CREAR:
+            reemplazar(pilas, e.objeto, new PilaMemoria(e.b));
+            break;
+        case Traza::PILA_DESTRUIR:
+            destruir(pilas, e.objeto);
+            break;
+        case Traza::PILA_PUSH:
+            pila->push(id, e.b);
+            break;
+        case Traza::PILA_POP:
+            obtenido = pila->pop();
+            break;
+        case Traza::PILA_LIBERAR_PROCESO:
+            obtenido = pila->liberarProceso(e.b);
+            break;
+        case Traza::PILA_VACIAR:
+            pila->vaciar();
+            break;
+        case Traza::PILA_REUBICAR:
+            obtenido = pila->reubicar(id, e.b);
+            break;
+        }
+        if (obtenido != e.resultado) {
+            divergir(e, "se grab " + to_string_alt(e.resultado) + " y se obtuvo " +
+                            to_string_alt(obtenido));
+        }
+    } catch (const exception& ex) {
+        divergir(e, ex.what());
+    }
+}
+
+void ReproductorTraza::reproducir(const Traza::TrazaCargada& traza) {
+    const vector<Traza::Evento>& eventos = traza.eventos;
+    for (size_t i = 0; i < eventos.size(); i++) aplicar(eventos[i], traza.textos);
+}
@@ -0,0 +1,88 @@
+#include "RuedaTemporizadores.h"
+
+using namespace std;
+
+RuedaTemporizadores::RuedaTemporizadores() : ahora(0), activos(0) {
+    for (int n = 0; n < NIVELES; n++) {
+        for (int r = 0; r < RANURAS; r++) {
+            ranuras[n][r].ant = ranuras[n][r].sig = &ranuras[n][r];
+        }
+    }
+    desborde.ant = desborde.sig = &desborde;
+}
+
+void RuedaTemporizadores::reiniciar(uint64_t tiempo) {
+    for (int n = 0; n < NIVELES; n++) {
+        for (int r = 0; r < RANURAS; r++) {
+            Temporizador* lista = &ranuras[n][r];
+            while (lista->sig != lista) desenlazar(lista->sig);
+        }
+    }
+    while (desborde.sig != &desborde) desenlazar(desborde.sig);
+    ahora = tiempo;
+    activos = 0;
+}
+
+void RuedaTemporizadores::programar(Temporizador* t, uint64_t expira) {
+    if (t->programado()) {
+        desenlazar(t);
+    } else {
+        activos++;
+    }
+    t->expira = expira > ahora ? expira : ahora + 1;
+    insertar(t);
+}
+
+bool RuedaTemporizadores::cancelar(Temporizador* t) {
+    if (!t->programado()) return false;
+    desenlazar(t);
+    activos--;
+    return true;
+}
+
+void RuedaTemporizadores::insertar(Temporizador* t) {
+    uint64_t delta = t->expira - ahora;
+    for (int n = 0; n < NIVELES; n++) {
+        if (delta < (1ull << (BITS_NIVEL * (n + 1)))) {
+            int r = (int)(t->expira >> (BITS_NIVEL * n)) & (RANURAS - 1);
+            enlazar(&ranuras[n][r], t);
+            return;
+        }
+    }
+    enlazar(&desborde, t);
+}
+
+void RuedaTemporizadores::trasladar(Temporizador* origen, Temporizador* destino) {
+    if (origen->sig == origen) return;
+    destino->sig = origen->sig;
+    destino->ant = origen->ant;
+    destino->sig->ant = destino;
+    destino->ant->sig = destino;
+    origen->ant = origen->sig = origen;
+}
+
+void RuedaTemporizadores::redistribuir() {
+    // Se empieza por el nivel ms alto: lo que baja de l puede caer en
+    // la ranura del nivel inferior que toca redistribuir en este mismo tick
+    Temporizador pendientes;
+    if ((ahora & (ALCANCE - 1)) == 0) {
+        pendientes.ant = pendientes.sig = &pendientes;
+        trasladar(&desborde, &pendientes);
+        while (pendientes.sig != &pendientes) {
+            Temporizador* t = pendientes.sig;
+            desenlazar(t);
+            insertar(t);
+        }
+    }
+    for (int n = NIVELES - 1; n >= 1; n--) {
+        if ((ahora & ((1ull << (BITS_NIVEL * n)) - 1)) != 0) continue;
+        int r = (int)(ahora >> (BITS_NIVEL * n)) & (RANURAS - 1);
+        pendientes.ant = pendientes.sig = &pendientes;
+        trasladar(&ranuras[n][r], &pendientes);
+        while (pendientes.sig != &pendientes) {
+            Temporizador* t = pendientes.sig;
+            desenlazar(t);
+            insertar(t);
+        }
+    }
+}
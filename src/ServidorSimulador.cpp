@@ -0,0 +1,525 @@
+#include "ServidorSimulador.h"
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "ErrorHandler.h"
+#include "Metricas.h"
+#include "ProtocoloRPC.h"
+#include "Simulador.h"
+#include "Utilidades.h"
+
+using namespace std;
+using namespace ProtocoloRPC;
+
+/**
+ * Conexin de un cliente; pertenece al fragmento que la acept.
+ */
+struct ServidorSimulador::Conexion {
+    int fd;
+    uint64_t generacion;   // Distingue conexiones que reciclan el mismo fd
+    string entrada;        // Bytes recibidos an sin formar un mensaje
+    string salida;         // Respuestas pendientes de enviar
+    size_t enviados;       // Prefijo de 'salida' ya enviado
+    bool esperaEscritura;  // EPOLLOUT registrado (el socket se llen)
+    bool sucia;            // Tiene salida nueva en esta vuelta del bucle
+};
+
+/**
+ * Solicitud reenviada a otro fragmento, o respuesta que vuelve al de la
+ * conexin.
+ */
+struct ServidorSimulador::Mensaje {
+    bool respuesta;
+    int origen;            // Fragmento dueo de la conexin
+    int fd;
+    uint64_t generacion;
+    string datos;          // Solicitud completa, o respuestas ya codificadas
+};
+
+struct ServidorSimulador::Fragmento {
+    int indice;
+    int epoll;
+    int evento;                                   // eventfd del buzn
+    thread hilo;
+
+    mutex cerrojo;                                // Protege solo 'buzon'
+    vector<Mensaje> buzon;
+
+    unordered_map<uint32_t, Simulador*> instancias; // Dueo
+    unordered_map<int, Conexion*> conexiones;       // fd -> conexin (dueo)
+    uint64_t generaciones;
+    vector<vector<Mensaje> > salientes;           // Por fragmento destino, hasta fin de vuelta
+    vector<Conexion*> sucias;                     // Con salida por escribir en esta vuelta
+    vector<Conexion*> cerradas;                   // Se liberan al terminar la vuelta
+
+    Fragmento() : indice(0), epoll(-1), evento(-1), generaciones(0) {}
+};
+
+#ifdef __linux__
+
+namespace {
+
+void fallar(const string& que) {
+    throw runtime_error(que + ": " + strerror(errno));
+}
+
+void registrar(int epoll, int fd, uint32_t eventos, int operacion = EPOLL_CTL_ADD) {
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = eventos;
+    ev.data.fd = fd;
+    if (epoll_ctl(epoll, operacion, fd, &ev) < 0) fallar("epoll_ctl");
+}
+
+} // namespace
+
+ServidorSimulador::ServidorSimulador(const string& ruta, unsigned hilos)
+    : ruta(ruta), escucha(-1), parar(false) {
+    sockaddr_un dir;
+    memset(&dir, 0, sizeof(dir));
+    dir.sun_family = AF_UNIX;
+    if (ruta.empty() || ruta.size() >= sizeof(dir.sun_path)) {
+        throw runtime_error("Ruta de socket invlida: " + ruta);
+    }
+    memcpy(dir.sun_path, ruta.c_str(), ruta.size());
+
+    // Un socket que qued de una ejecucin anterior se reemplaza; otro
+    // tipo de archivo no se toca
+    struct stat st;
+    if (lstat(ruta.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) throw runtime_error(ruta + " existe y no es un socket");
+        unlink(ruta.c_str());
+    }
+
+    escucha = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (escucha < 0) fallar("socket");
+    if (bind(escucha, (const sockaddr*)&dir, sizeof(dir)) < 0 ||
+        listen(escucha, SOMAXCONN) < 0) {
+        int error = errno;
+        close(escucha);
+        errno = error;
+        fallar("No se pudo escuchar en " + ruta);
+    }
+
+    if (hilos == 0) hilos = thread::hardware_concurrency();
+    if (hilos == 0) hilos = 1;
+    try {
+        for (unsigned i = 0; i < hilos; i++) {
+            Fragmento* f = new Fragmento();
+            fragmentos.push_back(f);
+            f->indice = (int)i;
+            f->salientes.resize(hilos);
+            f->epoll = epoll_create1(EPOLL_CLOEXEC);
+            if (f->epoll < 0) fallar("epoll_create1");
+            f->evento = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (f->evento < 0) fallar("eventfd");
+            registrar(f->epoll, f->evento, EPOLLIN);
+            // EPOLLEXCLUSIVE: una conexin nueva despierta a un solo fragmento
+            registrar(f->epoll, escucha, EPOLLIN | EPOLLEXCLUSIVE);
+        }
+    } catch (...) {
+        for (size_t i = 0; i < fragmentos.size(); i++) {
+            if (fragmentos[i]->epoll >= 0) close(fragmentos[i]->epoll);
+            if (fragmentos[i]->evento >= 0) close(fragmentos[i]->evento);
+            delete fragmentos[i];
+        }
+        close(escucha);
+        unlink(ruta.c_str());
+        throw;
+    }
+}
+
+ServidorSimulador::~ServidorSimulador() {
+    detener();
+    for (size_t i = 0; i < fragmentos.size(); i++) {
+        if (fragmentos[i]->hilo.joinable()) fragmentos[i]->hilo.join();
+    }
+    for (size_t i = 0; i < fragmentos.size(); i++) {
+        Fragmento* f = fragmentos[i];
+        while (!f->conexiones.empty()) cerrar(*f, f->conexiones.begin()->second);
+        for (size_t j = 0; j < f->cerradas.size(); j++) delete f->cerradas[j];
+        for (unordered_map<uint32_t, Simulador*>::iterator it = f->instancias.begin();
+             it != f->instancias.end(); ++it) {
+            delete it->second;
+            SO_MEDIDOR(RPC_INSTANCIAS, -1);
+        }
+        close(f->epoll);
+        close(f->evento);
+        delete f;
+    }
+    close(escucha);
+    unlink(ruta.c_str());
+}
+
+void ServidorSimulador::ejecutar() {
+    for (size_t i = 0; i < fragmentos.size(); i++) {
+        Fragmento* f = fragmentos[i];
+        f->hilo = thread([this, f]() { bucle(*f); });
+    }
+    for (size_t i = 0; i < fragmentos.size(); i++) fragmentos[i]->hilo.join();
+}
+
+void ServidorSimulador::detener() {
+    parar.store(true, memory_order_release);
+    uint64_t uno = 1;
+    for (size_t i = 0; i < fragmentos.size(); i++) {
+        ssize_t r = write(fragmentos[i]->evento, &uno, sizeof(uno));
+        (void)r;
+    }
+}
+
+/* ---------------- Bucle de eventos ---------------- */
+
+void ServidorSimulador::bucle(Fragmento& f) {
+    const int MAX_EVENTOS = 64;
+    epoll_event eventos[MAX_EVENTOS];
+    while (!parar.load(memory_order_acquire)) {
+        int n = epoll_wait(f.epoll, eventos, MAX_EVENTOS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ErrorHandler::manejar(runtime_error(string("epoll_wait: ") + strerror(errno)));
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            int fd = eventos[i].data.fd;
+            if (fd == escucha) {
+                aceptar(f);
+            } else if (fd == f.evento) {
+                recibirBuzon(f);
+            } else {
+                unordered_map<int, Conexion*>::iterator it = f.conexiones.find(fd);
+                if (it == f.conexiones.end()) continue;
+                Conexion* c = it->second;
+                if (eventos[i].events & EPOLLOUT) {
+                    if (!escribir(f, c)) continue;
+                }
+                if (eventos[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) leer(f, c);
+            }
+        }
+
+        // Fin de vuelta: un envo por buzn destino y una escritura por conexin
+        enviarBuzones(f);
+        for (size_t i = 0; i < f.sucias.size(); i++) {
+            Conexion* c = f.sucias[i];
+            c->sucia = false;
+            if (!c->esperaEscritura) escribir(f, c);
+        }
+        f.sucias.clear();
+        for (size_t i = 0; i < f.cerradas.size(); i++) delete f.cerradas[i];
+        f.cerradas.clear();
+    }
+}
+
+void ServidorSimulador::aceptar(Fragmento& f) {
+    for (;;) {
+        int fd = accept4(escucha, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                ErrorHandler::manejar(runtime_error(string("accept: ") + strerror(errno)));
+            }
+            return;
+        }
+        Conexion* c = new Conexion();
+        c->fd = fd;
+        c->generacion = ++f.generaciones;
+        c->enviados = 0;
+        c->esperaEscritura = false;
+        c->sucia = false;
+        f.conexiones[fd] = c;
+        registrar(f.epoll, fd, EPOLLIN);
+        SO_MEDIDOR(RPC_CONEXIONES, 1);
+    }
+}
+
+void ServidorSimulador::cerrar(Fragmento& f, Conexion* c) {
+    if (c->fd < 0) return;
+    epoll_ctl(f.epoll, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    // Puede seguir en 'sucias': se libera al final de la vuelta. Las
+    // respuestas remotas que lleguen despus no la encuentran en el mapa
+    f.conexiones.erase(c->fd);
+    c->fd = -1;
+    f.cerradas.push_back(c);
+    SO_MEDIDOR(RPC_CONEXIONES, -1);
+}
+
+void ServidorSimulador::leer(Fragmento& f, Conexion* c) {
+    char buf[65536];
+    bool fin = false;
+    for (;;) {
+        ssize_t n = read(c->fd, buf, sizeof(buf));
+        if (n > 0) {
+            c->entrada.append(buf, (size_t)n);
+            if ((size_t)n < sizeof(buf)) break;
+        } else if (n == 0) {
+            fin = true;
+            break;
+        } else {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) fin = true;
+            break;
+        }
+    }
+
+    size_t pos = 0;
+    const char* datos = c->entrada.data();
+    while (c->fd >= 0) {
+        uint32_t longitud = longitudMensaje(datos + pos, c->entrada.size() - pos);
+        if (longitud == 0) break;
+        if (longitud < sizeof(Solicitud) || longitud > LONGITUD_MAXIMA) {
+            ErrorHandler::manejar(runtime_error("Mensaje de " + to_string_alt(longitud) +
+                                                " bytes: se cierra la conexin"));
+            cerrar(f, c);
+            return;
+        }
+        if (c->entrada.size() - pos < longitud) break;
+        atender(f, c, datos + pos, longitud);
+        pos += longitud;
+    }
+    c->entrada.erase(0, pos);
+    if (fin) cerrar(f, c);
+}
+
+void ServidorSimulador::atender(Fragmento& f, Conexion* c, const char* datos, uint32_t longitud) {
+    Solicitud s;
+    memcpy(&s, datos, sizeof(s));
+    SO_CONTAR(RPC_SOLICITUDES);
+    int destino = s.operacion == PING ? f.indice : (int)(s.instancia % fragmentos.size());
+    if (destino == f.indice) {
+        resolver(f, datos, longitud, c->salida);
+        if (!c->sucia) {
+            c->sucia = true;
+            f.sucias.push_back(c);
+        }
+        return;
+    }
+    Mensaje m;
+    m.respuesta = false;
+    m.origen = f.indice;
+    m.fd = c->fd;
+    m.generacion = c->generacion;
+    m.datos.assign(datos, longitud);
+    f.salientes[destino].push_back(std::move(m));
+    SO_CONTAR(RPC_REENVIADAS);
+}
+
+/* ---------------- Buzones entre fragmentos ---------------- */
+
+void ServidorSimulador::enviarBuzones(Fragmento& f) {
+    for (size_t d = 0; d < f.salientes.size(); d++) {
+        vector<Mensaje>& lote = f.salientes[d];
+        if (lote.empty()) continue;
+        Fragmento& destino = *fragmentos[d];
+        bool despertar;
+        {
+            lock_guard<mutex> guarda(destino.cerrojo);
+            despertar = destino.buzon.empty();
+            if (despertar) {
+                destino.buzon.swap(lote);
+            } else {
+                for (size_t i = 0; i < lote.size(); i++) {
+                    destino.buzon.push_back(std::move(lote[i]));
+                }
+            }
+        }
+        lote.clear();
+        // Si el buzn no estaba vaco, su dueo ya tiene un aviso pendiente
+        if (despertar) {
+            uint64_t uno = 1;
+            ssize_t r = write(destino.evento, &uno, sizeof(uno));
+            (void)r;
+        }
+    }
+}
+
+void ServidorSimulador::recibirBuzon(Fragmento& f) {
+    uint64_t avisos;
+    ssize_t r = read(f.evento, &avisos, sizeof(avisos));
+    (void)r;
+    vector<Mensaje> recibidos;
+    {
+        lock_guard<mutex> guarda(f.cerrojo);
+        recibidos.swap(f.buzon);
+    }
+    for (size_t i = 0; i < recibidos.size(); i++) {
+        Mensaje& m = recibidos[i];
+        if (!m.respuesta) {
+            // Solicitud a una instancia propia: la respuesta vuelve al origen
+            string salida;
+            resolver(f, m.datos.data(), (uint32_t)m.datos.size(), salida);
+            m.respuesta = true;
+            m.datos.swap(salida);
+            vector<Mensaje>& lote = f.salientes[m.origen];
+            if (!lote.empty() && lote.back().respuesta && lote.back().fd == m.fd &&
+                lote.back().generacion == m.generacion) {
+                lote.back().datos += m.datos; // Misma conexin: un solo mensaje
+            } else {
+                lote.push_back(std::move(m));
+            }
+        } else {
+            unordered_map<int, Conexion*>::iterator it = f.conexiones.find(m.fd);
+            if (it == f.conexiones.end() || it->second->generacion != m.generacion) continue;
+            Conexion* c = it->second;
+            c->salida += m.datos;
+            if (!c->sucia) {
+                c->sucia = true;
+                f.sucias.push_back(c);
+            }
+        }
+    }
+}
+
+bool ServidorSimulador::escribir(Fragmento& f, Conexion* c) {
+    while (c->fd >= 0 && c->enviados < c->salida.size()) {
+        ssize_t n = send(c->fd, c->salida.data() + c->enviados, c->salida.size() - c->enviados,
+                         MSG_NOSIGNAL);
+        if (n > 0) {
+            c->enviados += (size_t)n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!c->esperaEscritura) {
+                registrar(f.epoll, c->fd, EPOLLIN | EPOLLOUT, EPOLL_CTL_MOD);
+                c->esperaEscritura = true;
+            }
+            return true;
+        } else {
+            cerrar(f, c);
+            return false;
+        }
+    }
+    if (c->fd < 0) return false;
+    c->salida.clear();
+    c->enviados = 0;
+    if (c->esperaEscritura) {
+        registrar(f.epoll, c->fd, EPOLLIN, EPOLL_CTL_MOD);
+        c->esperaEscritura = false;
+    }
+    return true;
+}
+
+#else // !__linux__
+
+ServidorSimulador::ServidorSimulador(const string& ruta, unsigned)
+    : ruta(ruta), escucha(-1), parar(false) {
+    throw runtime_error("El servidor de simuladores requiere Linux (epoll y eventfd)");
+}
+
+ServidorSimulador::~ServidorSimulador() {}
+void ServidorSimulador::ejecutar() {}
+void ServidorSimulador::detener() {}
+
+#endif
+
+/* ---------------- Ejecucin de solicitudes ---------------- */
+
+void ServidorSimulador::resolver(Fragmento& f, const char* datos, uint32_t longitud,
+                                 string& salida) {
+    Solicitud s;
+    memcpy(&s, datos, sizeof(s));
+    const char* nombre = datos + sizeof(s);
+    size_t largoNombre = longitud - sizeof(s);
+
+    if (s.operacion >= NUM_OPERACIONES) {
+        escribirRespuesta(salida, s.id, SOLICITUD_INVALIDA, 0, 0,
+                          "Operacin desconocida " + to_string_alt(s.operacion));
+        return;
+    }
+    if (s.operacion == PING) {
+        escribirRespuesta(salida, s.id, OK);
+        return;
+    }
+
+    unordered_map<uint32_t, Simulador*>::iterator it = f.instancias.find(s.instancia);
+    try {
+        if (s.operacion == CREAR_INSTANCIA) {
+            if (s.a < 0 || s.a > BLOQUES_MAXIMOS || s.b < 0 || s.b > MARCOS_MAXIMOS) {
+                escribirRespuesta(salida, s.id, SOLICITUD_INVALIDA, 0, 0,
+                                  "Bloques (hasta " + to_string_alt(BLOQUES_MAXIMOS) +
+                                      ") o marcos (hasta " + to_string_alt(MARCOS_MAXIMOS) +
+                                      ") fuera de rango");
+                return;
+            }
+            if (it != f.instancias.end()) {
+                throw runtime_error("La instancia " + to_string_alt(s.instancia) + " ya existe");
+            }
+            if (f.instancias.size() >= INSTANCIAS_POR_FRAGMENTO) {
+                throw runtime_error("El fragmento " + to_string_alt(f.indice) + " ya tiene " +
+                                    to_string_alt(INSTANCIAS_POR_FRAGMENTO) + " instancias");
+            }
+            Simulador* sim = new Simulador("", s.a > 0 ? s.a : BLOQUES_DEFECTO,
+                                           s.b > 0 ? (uint32_t)s.b : (uint32_t)MARCOS_DEFECTO);
+            f.instancias[s.instancia] = sim;
+            SO_MEDIDOR(RPC_INSTANCIAS, 1);
+            escribirRespuesta(salida, s.id, OK);
+            return;
+        }
+        if (it == f.instancias.end()) {
+            escribirRespuesta(salida, s.id, SIN_INSTANCIA, 0, 0,
+                              "Instancia " + to_string_alt(s.instancia) + " inexistente");
+            return;
+        }
+
+        Simulador& sim = *it->second;
+        int32_t valor0 = 0, valor1 = 0;
+        switch (s.operacion) {
+            case DESTRUIR_INSTANCIA:
+                delete it->second;
+                f.instancias.erase(it);
+                SO_MEDIDOR(RPC_INSTANCIAS, -1);
+                break;
+            case INSERTAR_PROCESO:
+                sim.getProcesos().insertarProcesso(s.a, string(nombre, largoNombre), s.b);
+                break;
+            case ELIMINAR_PROCESO:
+                valor0 = sim.eliminarProceso(s.a);
+                break;
+            case ENCOLAR:
+                sim.encolar(s.a);
+                break;
+            case DESPACHAR:
+                valor0 = sim.despachar()->id;
+                break;
+            case BLOQUEAR:
+                valor0 = sim.bloquear(s.a > 0 ? (uint64_t)s.a : 0)->id;
+                break;
+            case DESBLOQUEAR:
+                sim.desbloquear(s.a);
+                break;
+            case TERMINAR:
+                valor0 = sim.terminar()->id;
+                break;
+            case AVANZAR_TIEMPO:
+                valor0 = (int32_t)sim.avanzarTiempo(s.a > 0 ? (uint64_t)s.a : 0);
+                break;
+            case CAMBIAR_PRIORIDAD:
+                sim.cambiarPrioridad(s.a, s.b);
+                break;
+            case ASIGNAR_MEMORIA:
+                sim.asignarMemoria(s.a, s.b);
+                break;
+            case CONSULTAR_ESTADO:
+                valor0 = (int32_t)sim.getProcesos().getIndice().tam();
+                valor1 = sim.getPlanificador().contarProcesos();
+                break;
+        }
+        escribirRespuesta(salida, s.id, OK, valor0, valor1);
+    } catch (const exception& e) {
+        escribirRespuesta(salida, s.id, ERROR_OPERACION, 0, 0, e.what());
+    }
+}
@@ -0,0 +1,401 @@
+#include "Simulador.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "Instantanea.h"
+#include "Metricas.h"
+#include "Reemplazo.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+Simulador::Simulador(const string& archivoProcesos, int capacidadMemoria, uint32_t marcos)
+    : procesos(archivoProcesos),
+      arbol(archivoProcesos.empty() ? string() : ArbolProcesos::ARCHIVO_ARBOL),
+      memoria(capacidadMemoria), memoriaVirtual(marcos), enEjecucion(NULL), bloqueados(0),
+      inicioEjecucion(0), plazos() {
+    memoriaVirtual.setAlgoritmoReemplazo(new ReemplazoLRU(marcos));
+
+    // El rbol guardado puede nombrar procesos que ya no estn en la tabla
+    vector<int> pids;
+    arbol.recorrer(ArbolProcesos::INIT, [&pids](int pid, int) { pids.push_back(pid); });
+    for (size_t i = 1; i < pids.size(); i++) {
+        if (!procesos.buscarPorId(pids[i])) arbol.eliminar(pids[i]);
+    }
+}
+
+PilaMemoria::Manija Simulador::asignarMemoria(int pid, int direccion) {
+    if (pid != PilaMemoria::SIN_DUENO && !procesos.buscarPorId(pid)) {
+        throw runtime_error("Proceso " + to_string_alt(pid) + " no encontrado");
+    }
+    return memoria.push(direccion, pid);
+}
+
+NodoProcesso* Simulador::buscar(int id) {
+    NodoProcesso* proc = procesos.buscarPorId(id);
+    if (!proc) {
+        throw runtime_error("Proceso no encontrado");
+    }
+    return proc;
+}
+
+void Simulador::ponerListo(NodoProcesso* proc) {
+    planificador.encolarPrioridad(proc);
+    proc->estado = LISTO;
+}
+
+void Simulador::cambiarPrioridad(int id, int prioridad) {
+    if (prioridad < 0 || prioridad > 100) {
+        throw runtime_error("Prioridad debe ser 0-100");
+    }
+    NodoProcesso* proc = buscar(id);
+    if (!planificador.cambiarPrioridad(id, prioridad)) {
+        proc->prioridad = prioridad;
+    }
+}
+
+void Simulador::encolar(int id) {
+    NodoProcesso* proc = buscar(id);
+    if (proc->estado != NUEVO) {
+        throw runtime_error("El proceso " + to_string_alt(id) + " est en estado " +
+                            nombreEstado(proc->estado));
+    }
+    if (proc->tiempoReal.esperandoActivacion()) {
+        proc->tiempoReal.activar(temporizadores.getAhora());
+    }
+    ponerListo(proc);
+}
+
+bool Simulador::retirarDeCola(int id) {
+    if (!planificador.eliminar(id)) return false;
+    procesos.buscarPorId(id)->estado = NUEVO;
+    return true;
+}
+
+NodoProcesso* Simulador::despachar() {
+    if (enEjecucion) {
+        salirDeCpu(LineaTiempo::EXPROPIADO);
+        ponerListo(enEjecucion);
+        enEjecucion = NULL;
+    }
+    NodoProcesso* proc = planificador.desencolar();
+    proc->estado = EJECUCION;
+    enEjecucion = proc;
+    inicioEjecucion = temporizadores.getAhora();
+    return proc;
+}
+
+NodoProcesso* Simulador::bloquear(uint64_t ticks) {
+    if (!enEjecucion) {
+        throw runtime_error("No hay proceso en ejecucin");
+    }
+    salirDeCpu(LineaTiempo::BLOQUEO);
+    NodoProcesso* proc = enEjecucion;
+    enEjecucion = NULL;
+    proc->estado = BLOQUEADO;
+    bloqueados++;
+    SO_MEDIDOR(PROCESOS_BLOQUEADOS, 1);
+    if (ticks > 0) {
+        temporizadores.programar(&proc->despertar, temporizadores.getAhora() + ticks);
+    }
+    return proc;
+}
+
+void Simulador::desbloquear(int id) {
+    NodoProcesso* proc = buscar(id);
+    if (proc->estado != BLOQUEADO) {
+        throw runtime_error("El proceso " + to_string_alt(id) + " no est bloqueado");
+    }
+    if (proc->tiempoReal.esperandoActivacion()) {
+        throw runtime_error("La tarea " + to_string_alt(id) + " espera su prxima activacin");
+    }
+    temporizadores.cancelar(&proc->despertar);
+    bloqueados--;
+    SO_MEDIDOR(PROCESOS_BLOQUEADOS, -1);
+    ponerListo(proc);
+}
+
+NodoProcesso* Simulador::terminar() {
+    if (!enEjecucion) {
+        throw runtime_error("No hay proceso en ejecucin");
+    }
+    salirDeCpu(LineaTiempo::TERMINO);
+    NodoProcesso* proc = enEjecucion;
+    enEjecucion = NULL;
+    proc->estado = TERMINADO;
+    proc->cuerpo = CuerpoProceso();
+    procesos.getAdmision().retirar(proc->tiempoReal);
+    memoria.liberarProceso(proc->id);
+    memoriaVirtual.destruirEspacio(proc);
+    return proc;
+}
+
+void Simulador::asignarCuerpo(int id, CuerpoProceso cuerpo) {
+    NodoProcesso* proc = buscar(id);
+    if (proc->estado == TERMINADO) {
+        throw runtime_error("El proceso " + to_string_alt(id) + " ya termin");
+    }
+    proc->cuerpo = std::move(cuerpo);
+}
+
+ResultadoQuantum Simulador::ejecutarQuantum(uint64_t quantum) {
+    if (quantum == 0) {
+        throw runtime_error("El quantum debe ser mayor que 0");
+    }
+    if (!enEjecucion) despachar();
+    NodoProcesso* proc = enEjecucion;
+    TareaTiempoReal& tarea = proc->tiempoReal;
+    SO_CONTAR(CPU_QUANTUMS);
+
+    // Una tarea de tiempo real no usa ms de lo que le falta al trabajo
+    if (tarea.esTiempoReal() && tarea.restante < quantum) quantum = tarea.restante;
+
+    ResultadoQuantum r;
+    r.id = proc->id;
+    r.motivo = CuerpoProceso::CEDIO;
+    r.usadas = quantum;
+    r.valor = 0;
+    if (proc->cuerpo) {
+        if (proc->cuerpo.getDeuda() < quantum) SO_CONTAR(CPU_REANUDACIONES);
+        try {
+            r.motivo = proc->cuerpo.reanudar(quantum, r.usadas);
+        } catch (const exception& e) {
+            terminar();
+            throw runtime_error("El proceso " + to_string_alt(r.id) + " fall: " + e.what());
+        }
+    }
+
+    // El tiempo corre antes de la transicin: la E/S empieza al final del
+    // tramo de CPU y los que despiertan en l llegan antes que el expropiado
+    avanzarTiempo(r.usadas);
+    if (tarea.esTiempoReal()) tarea.restante -= min(r.usadas, tarea.restante);
+    if (r.motivo != CuerpoProceso::TERMINO && tarea.esperandoActivacion()) {
+        // El trabajo termina al consumir su costo, aunque el cuerpo pida E/S
+        completarTrabajo(proc);
+    } else if (r.motivo == CuerpoProceso::CEDIO) {
+        salirDeCpu(LineaTiempo::CEDIO);
+        ponerListo(proc);
+        enEjecucion = NULL;
+    } else if (r.motivo == CuerpoProceso::ESPERA_ES) {
+        uint64_t ticks = proc->cuerpo.getTicksES();
+        bloquear(ticks > 0 ? ticks : 1);
+    } else {
+        r.valor = proc->cuerpo.getValor();
+        terminar();
+    }
+    return r;
+}
+
+void Simulador::completarTrabajo(NodoProcesso* proc) {
+    TareaTiempoReal& tarea = proc->tiempoReal;
+    uint64_t ahora = temporizadores.getAhora();
+    tarea.trabajos++;
+    plazos.completados++;
+    SO_CONTAR(TR_TRABAJOS);
+    if (ahora > tarea.plazoAbsoluto) {
+        uint64_t tardanza = ahora - tarea.plazoAbsoluto;
+        tarea.perdidos++;
+        plazos.perdidos++;
+        plazos.tardanzaTotal += tardanza;
+        if (tardanza > plazos.tardanzaMaxima) plazos.tardanzaMaxima = tardanza;
+        SO_CONTAR(TR_PLAZOS_PERDIDOS);
+        SO_HISTOGRAMA(TR_TARDANZA_TICKS, tardanza);
+    }
+
+    if (tarea.esporadica) {
+        bloquear(0);
+        return;
+    }
+    uint64_t proxima = tarea.activacion + tarea.periodo;
+    if (proxima > ahora) {
+        bloquear(proxima - ahora);
+        return;
+    }
+    // Atrasada: el trabajo siguiente ya est activado y espera en listos
+    salirDeCpu(LineaTiempo::CEDIO);
+    enEjecucion = NULL;
+    tarea.activar(proxima);
+    ponerListo(proc);
+}
+
+bool Simulador::activarEsporadica(int id) {
+    NodoProcesso* proc = buscar(id);
+    TareaTiempoReal& tarea = proc->tiempoReal;
+    if (!tarea.esporadica || proc->estado == TERMINADO) {
+        throw runtime_error("El proceso " + to_string_alt(id) + " no es una tarea espordica activa");
+    }
+    if (proc->estado != BLOQUEADO || !tarea.esperandoActivacion()) {
+        throw runtime_error("La tarea " + to_string_alt(id) + " no termin su trabajo anterior");
+    }
+    if (proc->despertar.programado()) {
+        throw runtime_error("La tarea " + to_string_alt(id) + " ya tiene una activacin pendiente");
+    }
+    uint64_t ahora = temporizadores.getAhora();
+    uint64_t minima = tarea.activacion + tarea.periodo;
+    if (minima > ahora) {
+        // Demasiado pronto: la rueda la activa al cumplirse el periodo
+        temporizadores.programar(&proc->despertar, minima);
+        return false;
+    }
+    bloqueados--;
+    SO_MEDIDOR(PROCESOS_BLOQUEADOS, -1);
+    tarea.activar(ahora);
+    ponerListo(proc);
+    return true;
+}
+
+void Simulador::setPolitica(PoliticaPlanificacion politica) {
+    planificador.setPolitica(politica);
+    procesos.getAdmision().setPolitica(politica);
+}
+
+EstadisticasTiempoReal Simulador::estadisticasTiempoReal() const {
+    EstadisticasTiempoReal e = plazos;
+    uint64_t ahora = temporizadores.getAhora();
+    e.vencidos = 0;
+    for (const NodoProcesso* p = procesos.primero(); p; p = p->siguiente) {
+        const TareaTiempoReal& t = p->tiempoReal;
+        if (t.esTiempoReal() && t.restante > 0 && p->estado != TERMINADO &&
+            t.plazoAbsoluto < ahora) {
+            e.vencidos++;
+        }
+    }
+    return e;
+}
+
+size_t Simulador::correr(uint64_t quantum, size_t maxQuantums) {
+    size_t ejecutados = 0;
+    while (ejecutados < maxQuantums) {
+        if (enEjecucion || planificador.frente()) {
+            ejecutarQuantum(quantum);
+            ejecutados++;
+        } else if (temporizadores.getActivos() > 0) {
+            avanzarTiempo(quantum);
+        } else {
+            break;
+        }
+    }
+    return ejecutados;
+}
+
+size_t Simulador::avanzarTiempo(uint64_t ticks) {
+    planificador.avanzarReloj(ticks);
+    size_t despertados = temporizadores.avanzar(ticks, [this](Temporizador* t) {
+        NodoProcesso* proc = static_cast<NodoProcesso*>(t->dueno);
+        bloqueados--;
+        // Una tarea que esperaba su activacin despierta con el trabajo nuevo
+        if (proc->tiempoReal.esperandoActivacion()) proc->tiempoReal.activar(t->expira);
+        ponerListo(proc);
+    });
+    SO_CONTAR_N(TEMPORIZADORES_DISPARADOS, despertados);
+    SO_MEDIDOR(PROCESOS_BLOQUEADOS, -(int64_t)despertados);
+    return despertados;
+}
+
+bool Simulador::guardarInstantaneaEnSegundoPlano(const string& archivo) {
+    const Simulador* sim = this;
+    return guardado.iniciar([sim, archivo]() { Instantanea::guardar(*sim, archivo); });
+}
+
+bool Simulador::guardarProcesosEnSegundoPlano() {
+    if (procesos.getArchivo().empty()) {
+        throw runtime_error("La tabla de procesos no tiene archivo de persistencia");
+    }
+    const ListaProcesso* lista = &procesos;
+    return guardado.iniciar([lista]() { lista->guardar(); });
+}
+
+void Simulador::vaciar() {
+    for (NodoProcesso* p = procesos.primero(); p; p = p->siguiente) {
+        memoriaVirtual.destruirEspacio(p);
+    }
+    temporizadores.reiniciar(temporizadores.getAhora());
+    planificador.vaciar();
+    memoria.vaciar();
+    procesos.liberarMemoria();
+    arbol.vaciar();
+    enEjecucion = NULL;
+    SO_MEDIDOR(PROCESOS_BLOQUEADOS, -bloqueados);
+    bloqueados = 0;
+    plazos = EstadisticasTiempoReal();
+}
+
+void Simulador::desalojar(NodoProcesso* proc) {
+    if (proc->estado == BLOQUEADO) {
+        temporizadores.cancelar(&proc->despertar);
+        bloqueados--;
+        SO_MEDIDOR(PROCESOS_BLOQUEADOS, -1);
+    }
+    if (enEjecucion == proc) {
+        salirDeCpu(LineaTiempo::ELIMINADO);
+        enEjecucion = NULL;
+    }
+    planificador.eliminar(proc->id);
+    memoriaVirtual.destruirEspacio(proc);
+}
+
+int Simulador::eliminarProceso(int id) {
+    NodoProcesso* proc = buscar(id);
+    desalojar(proc);
+    int liberados = memoria.liberarProceso(id);
+    if (arbol.contiene(id)) arbol.eliminar(id);
+    procesos.eliminarProcesso(id);
+    return liberados;
+}
+
+/* ---------------- rbol de procesos ---------------- */
+
+NodoProcesso* Simulador::clonarProceso(int padre, int hijo) {
+    NodoProcesso* original = buscar(padre);
+    if (original->estado == TERMINADO) {
+        throw runtime_error("El proceso " + to_string_alt(padre) + " ya termin");
+    }
+    procesos.insertarProcesso(hijo, original->nombre, original->prioridad);
+    if (!arbol.contiene(padre)) arbol.agregar(padre);
+    arbol.agregar(hijo, padre);
+    SO_CONTAR(ARBOL_CLONACIONES);
+    return procesos.buscarPorId(hijo);
+}
+
+size_t Simulador::eliminarSubarbol(int id, int* bloques) {
+    NodoProcesso* proc = buscar(id);
+    vector<int> pids;
+    if (arbol.contiene(id)) {
+        arbol.quitarSubarbol(id, pids);
+    } else {
+        pids.push_back(id);
+    }
+    // Los del rbol siempre estn en la tabla, salvo que se los haya
+    // eliminado de ella sin pasar por el simulador
+    size_t vivos = 0;
+    for (size_t i = 0; i < pids.size(); i++) {
+        NodoProcesso* p = i == 0 ? proc : procesos.buscarPorId(pids[i]);
+        if (!p) continue;
+        desalojar(p);
+        pids[vivos++] = pids[i];
+    }
+    pids.resize(vivos);
+
+    int liberados = memoria.liberarProcesos(pids);
+    procesos.eliminarProcesos(pids);
+    SO_CONTAR_N(ARBOL_ELIMINADOS_SUBARBOL, pids.size());
+    if (bloques) *bloques = liberados;
+    return pids.size();
+}
+
+size_t Simulador::contarDescendientes(int id) {
+    buscar(id);
+    return arbol.contiene(id) ? arbol.contarDescendientes(id) : 0;
+}
+
+void Simulador::reparentarAInit(int id) {
+    buscar(id);
+    if (arbol.contiene(id)) arbol.reparentarAInit(id);
+}
+
+int Simulador::padreDe(int id) {
+    buscar(id);
+    return arbol.contiene(id) ? arbol.padreDe(id) : ArbolProcesos::INIT;
+}
@@ -0,0 +1,87 @@
+#include "TiempoReal.h"
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "Metricas.h"
+#include "Utilidades.h"
+
+using namespace std;
+
+namespace {
+
+const uint64_t UNO = 1ull << 32;  // 1.0 en punto fijo
+
+const char* const NOMBRES_POLITICAS[] = { "prioridad", "edf", "rm" };
+
+string fraccion(double valor) {
+    char texto[32];
+    snprintf(texto, sizeof(texto), "%.4f", valor);
+    return texto;
+}
+
+} // namespace
+
+const char* nombrePolitica(PoliticaPlanificacion politica) {
+    return NOMBRES_POLITICAS[politica];
+}
+
+AdmisionTiempoReal::AdmisionTiempoReal()
+    : politica(PLAN_PRIORIDAD), activa(true), tareas(0), densidad(0) {}
+
+uint64_t AdmisionTiempoReal::densidadDe(const TareaTiempoReal& tarea) {
+    // costo <= plazo < 2^32: el producto cabe en 64 bits
+    return (tarea.costo * UNO + tarea.plazo - 1) / tarea.plazo;
+}
+
+uint64_t AdmisionTiempoReal::cotaFija(size_t n) const {
+    if (politica != PLAN_RATE_MONOTONIC || n == 0) return UNO;
+    double c = (double)n * (pow(2.0, 1.0 / (double)n) - 1.0);
+    return (uint64_t)(c * (double)UNO);
+}
+
+double AdmisionTiempoReal::cota(size_t n) const {
+    return (double)cotaFija(n) / (double)UNO;
+}
+
+double AdmisionTiempoReal::getUtilizacion() const {
+    return (double)densidad / (double)UNO;
+}
+
+void AdmisionTiempoReal::admitir(TareaTiempoReal& tarea) {
+    if (tarea.periodo == 0 || tarea.periodo > PERIODO_MAXIMO) {
+        throw runtime_error("Periodo debe ser 1-" + to_string_alt(PERIODO_MAXIMO));
+    }
+    if (tarea.costo == 0 || tarea.costo > tarea.plazo || tarea.plazo > tarea.periodo) {
+        throw runtime_error("Debe cumplirse 0 < costo <= plazo <= periodo");
+    }
+    uint64_t d = densidadDe(tarea);
+    if (activa && densidad + d > cotaFija(tareas + 1)) {
+        SO_CONTAR(TR_RECHAZADAS);
+        throw runtime_error("Tarea rechazada: la utilizacin llegara a " +
+                            fraccion((double)(densidad + d) / (double)UNO) + " (cota " +
+                            nombrePolitica(politica) + " " + fraccion(cota(tareas + 1)) + ")");
+    }
+    densidad += d;
+    tareas++;
+    tarea.admitida = true;
+}
+
+void AdmisionTiempoReal::retirar(TareaTiempoReal& tarea) {
+    if (!tarea.admitida) return;
+    densidad -= densidadDe(tarea);
+    tareas--;
+    tarea.admitida = false;
+}
+
+void AdmisionTiempoReal::contar(const TareaTiempoReal& tarea) {
+    densidad += densidadDe(tarea);
+    tareas++;
+}
+
+void AdmisionTiempoReal::vaciar() {
+    tareas = 0;
+    densidad = 0;
+}
@@ -0,0 +1,577 @@
+#include "Traza.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+
+using namespace std;
+
+namespace Traza {
+
+atomic<uint32_t> epocaActual(0);
+
+namespace {
+
+const char MAGIA[8] = { 'S', 'O', 'T', 'R', 'A', 'Z', 'A', '\0' };
+const uint32_t VERSION = 1;
+const size_t BYTES_MINIMOS = 1 << 17;
+const chrono::milliseconds PERIODO_VACIADO(10);
+const uint8_t CON_TEXTO = 0x80;
+
+const char* const NOMBRES[NUM_OPERACIONES] = {
+    "lista_crear",
+    "lista_destruir",
+    "lista_insertar",
+    "lista_eliminar",
+    "lista_buscar",
+    "lista_vaciar",
+    "cola_crear",
+    "cola_destruir",
+    "cola_encolar",
+    "cola_desencolar",
+    "cola_eliminar",
+    "cola_vaciar",
+    "cola_cambiar_prioridad",
+    "cola_avanzar_reloj",
+    "cola_periodo",
+    "pila_crear",
+    "pila_destruir",
+    "pila_push",
+    "pila_pop",
+    "pila_liberar_proceso",
+    "pila_vaciar",
+    "pila_reubicar",
+    "cola_politica",
+    "cola_plazos",
+};
+
+struct CabeceraArchivo {
+    char magia[8];
+    uint32_t version;
+    uint32_t reservado;
+    uint64_t ticksPorSegundo; // Frecuencia de las marcas de tiempo (se fija al detener)
+};
+
+struct CabeceraBloque {
+    uint32_t hilo;
+    uint32_t registros;
+    uint64_t base;      // Marca de tiempo del primer registro
+    uint32_t bytes;     // Bytes codificados que siguen
+    uint32_t reservado;
+};
+
+/**
+ * Anillo de bytes de un hilo: un solo productor (el hilo dueo) y un
+ * solo consumidor (el hilo de vaciado).
+ */
+struct Anillo {
+    vector<char> datos;
+    size_t mascara;
+    atomic<uint64_t> escrito;    // Avanzado por el productor
+    atomic<uint64_t> leido;      // Avanzado por el consumidor
+    atomic<bool> terminado;      // El hilo dueo ya sali
+    uint32_t hilo;
+
+    Anillo(size_t bytes, uint32_t hilo)
+        : datos(bytes), mascara(bytes - 1), escrito(0), leido(0), terminado(false),
+          hilo(hilo) {}
+};
+
+/**
+ * Estado global de la grabacin. Se reserva con new y nunca se
+ * destruye, para que los hilos que terminan despus de main puedan
+ * usarlo.
+ */
+struct Estado {
+    mutex control;                 // Serializa iniciar() y detener()
+    mutex cerrojo;                 // Protege anillos, archivo y estadsticas
+    vector<Anillo*> anillos;
+    uint32_t siguienteHilo;
+    size_t bytesPorHilo;
+    bool vaciando;                 // Hay un hilo de vaciado corriendo
+    FILE* archivo;
+    bool fallo;                    // Fall una escritura de la sesin
+    uint32_t ultimaEpoca;
+    atomic<uint64_t> inicio;       // Marca de tiempo de iniciar()
+    int64_t inicioNs;              // Lo mismo en ns del reloj montono (calibracin)
+    EstadisticasTraza stats;
+    atomic<uint64_t> esperas;
+    vector<char> pendiente;        // Bytes extrados de un anillo
+    vector<char> codificado;       // Bloque codificado en construccin
+
+    thread vaciador;
+    mutex mutexAviso;
+    condition_variable aviso;
+    bool pedido;
+    bool parar;
+
+    Estado()
+        : siguienteHilo(0), bytesPorHilo(BYTES_MINIMOS), vaciando(false), archivo(NULL),
+          fallo(false), ultimaEpoca(0), inicio(0), inicioNs(0), esperas(0), pedido(false), parar(false) {
+        memset(&stats, 0, sizeof(stats));
+    }
+};
+
+Estado& estado() {
+    static Estado* e = new Estado();
+    return *e;
+}
+
+int64_t ahoraNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+               chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Marca de tiempo de un registro. En x86 se usa el contador de ciclos
+ * (TSC invariante), bastante ms barato que el reloj montono; al
+ * detener se calibra su frecuencia contra este.
+ */
+uint64_t marcaTiempo() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    return (uint64_t)ahoraNs();
+#endif
+}
+
+/* ---------------- Anillos ---------------- */
+
+void escribirEn(Anillo& an, uint64_t pos, const void* origen, size_t n) {
+    size_t i = (size_t)pos & an.mascara;
+    size_t primero = min(n, an.datos.size() - i);
+    memcpy(&an.datos[i], origen, primero);
+    memcpy(&an.datos[0], (const char*)origen + primero, n - primero);
+}
+
+void leerDe(const Anillo& an, uint64_t pos, void* destino, size_t n) {
+    size_t i = (size_t)pos & an.mascara;
+    size_t primero = min(n, an.datos.size() - i);
+    memcpy(destino, &an.datos[i], primero);
+    memcpy((char*)destino + primero, &an.datos[0], n - primero);
+}
+
+/**
+ * Al terminar un hilo su anillo se marca; el vaciador lo drena y lo
+ * libera (o se libera aqu si no hay sesin).
+ */
+struct GuardaHilo {
+    Anillo* anillo;
+    GuardaHilo() : anillo(NULL) {}
+    ~GuardaHilo() {
+        if (!anillo) return;
+        Estado& e = estado();
+        lock_guard<mutex> lock(e.cerrojo);
+        anillo->terminado.store(true, memory_order_release);
+        if (e.vaciando) return;
+        e.anillos.erase(find(e.anillos.begin(), e.anillos.end(), anillo));
+        delete anillo;
+    }
+};
+
+thread_local GuardaHilo guardaHilo;
+
+Anillo& anilloLocal() {
+    static thread_local Anillo* anillo = NULL;
+    if (__builtin_expect(anillo == NULL, 0)) {
+        Estado& e = estado();
+        lock_guard<mutex> lock(e.cerrojo);
+        anillo = new Anillo(e.bytesPorHilo, e.siguienteHilo++);
+        e.anillos.push_back(anillo);
+        guardaHilo.anillo = anillo;
+    }
+    return *anillo;
+}
+
+void despertar() {
+    Estado& e = estado();
+    {
+        lock_guard<mutex> lock(e.mutexAviso);
+        e.pedido = true;
+    }
+    e.aviso.notify_one();
+}
+
+/* ---------------- Codificacin ---------------- */
+
+char* ponerVarint(char* p, uint64_t x) {
+    while (x >= 0x80) {
+        *p++ = (char)(x | 0x80);
+        x >>= 7;
+    }
+    *p++ = (char)x;
+    return p;
+}
+
+uint64_t zigzag(int64_t x) { return ((uint64_t)x << 1) ^ (uint64_t)(x >> 63); }
+int64_t desZigzag(uint64_t x) { return (int64_t)(x >> 1) ^ -(int64_t)(x & 1); }
+
+/**
+ * Codifica los registros extrados de un anillo como un bloque del
+ * archivo, descartando los de otras sesiones.
+ */
+void codificarBloque(Estado& e, uint32_t hilo) {
+    uint8_t epoca = (uint8_t)e.ultimaEpoca;
+    CabeceraBloque cab = { hilo, 0, 0, 0, 0 };
+    uint64_t anterior = 0;
+    // Peor caso: un registro codificado ocupa hasta 7 bytes ms que en el anillo
+    e.codificado.resize(e.pendiente.size() + e.pendiente.size() / 4 + 16);
+    char* salida = e.codificado.data();
+
+    const char* p = e.pendiente.data();
+    const char* fin = p + e.pendiente.size();
+    while (p < fin) {
+        Registro r;
+        memcpy(&r, p, sizeof(r));
+        const char* texto = p + sizeof(r);
+        p = texto + ((r.longitud + 7u) & ~7u);
+        if (r.epoca != epoca) continue;
+
+        if (cab.registros == 0) cab.base = anterior = r.marca;
+        uint64_t delta = r.marca > anterior ? r.marca - anterior : 0;
+        anterior = max(anterior, r.marca);
+        *salida++ = (char)(r.operacion | (r.longitud ? CON_TEXTO : 0));
+        salida = ponerVarint(salida, r.objeto);
+        salida = ponerVarint(salida, delta);
+        salida = ponerVarint(salida, zigzag(r.a));
+        salida = ponerVarint(salida, zigzag(r.b));
+        salida = ponerVarint(salida, zigzag(r.resultado));
+        if (r.longitud) {
+            salida = ponerVarint(salida, r.longitud);
+            memcpy(salida, texto, r.longitud);
+            salida += r.longitud;
+        }
+        cab.registros++;
+    }
+    if (cab.registros == 0) return;
+
+    cab.bytes = (uint32_t)(salida - e.codificado.data());
+    if (fwrite(&cab, sizeof(cab), 1, e.archivo) != 1 ||
+        fwrite(e.codificado.data(), 1, cab.bytes, e.archivo) != cab.bytes) {
+        e.fallo = true;
+    }
+    e.stats.registros += cab.registros;
+    e.stats.bytes += sizeof(cab) + cab.bytes;
+}
+
+/**
+ * Drena todos los anillos al archivo (con e.cerrojo tomado).
+ */
+void vaciarAnillos(Estado& e) {
+    for (size_t i = 0; i < e.anillos.size();) {
+        Anillo& an = *e.anillos[i];
+        // Se mira 'terminado' antes que 'escrito': si ya sali, no escribe ms
+        bool terminado = an.terminado.load(memory_order_acquire);
+        uint64_t w = an.escrito.load(memory_order_acquire);
+        uint64_t r = an.leido.load(memory_order_relaxed);
+        if (w != r) {
+            e.pendiente.resize((size_t)(w - r));
+            leerDe(an, r, e.pendiente.data(), e.pendiente.size());
+            an.leido.store(w, memory_order_release);
+            if (e.archivo) codificarBloque(e, an.hilo);
+        }
+        if (terminado) {
+            delete e.anillos[i];
+            e.anillos[i] = e.anillos.back();
+            e.anillos.pop_back();
+        } else {
+            i++;
+        }
+    }
+    e.stats.vaciados++;
+    if (e.archivo) fflush(e.archivo);
+}
+
+void bucleVaciado() {
+    Estado& e = estado();
+    for (;;) {
+        bool fin;
+        {
+            unique_lock<mutex> lock(e.mutexAviso);
+            e.aviso.wait_for(lock, PERIODO_VACIADO, [&e] { return e.pedido || e.parar; });
+            e.pedido = false;
+            fin = e.parar;
+        }
+        {
+            lock_guard<mutex> lock(e.cerrojo);
+            vaciarAnillos(e);
+        }
+        if (fin) break;
+    }
+}
+
+/**
+ * Espera a que el vaciador libere 'necesario' bytes del anillo.
+ * @return false si la sesin termin mientras tanto
+ */
+bool esperarEspacio(Anillo& an, uint64_t necesario, uint32_t epoca) {
+    estado().esperas.fetch_add(1, memory_order_relaxed);
+    while (an.leido.load(memory_order_acquire) < necesario) {
+        if (epocaActual.load(memory_order_relaxed) != epoca) return false;
+        despertar();
+        this_thread::yield();
+    }
+    return true;
+}
+
+/* ---------------- Lectura ---------------- */
+
+class Lector {
+public:
+    Lector(const char* p, const char* fin, const string& ruta) : p(p), fin(fin), ruta(ruta) {}
+
+    uint8_t byte() {
+        if (p >= fin) danada();
+        return (uint8_t)*p++;
+    }
+
+    uint64_t varint() {
+        uint64_t x = 0;
+        for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7) {
+            uint8_t b = byte();
+            x |= (uint64_t)(b & 0x7F) << desplazamiento;
+            if (!(b & 0x80)) return x;
+        }
+        danada();
+        return 0;
+    }
+
+    const char* bytes(size_t n) {
+        if ((size_t)(fin - p) < n) danada();
+        const char* inicio = p;
+        p += n;
+        return inicio;
+    }
+
+    bool agotado() const { return p >= fin; }
+
+    void danada() const { throw runtime_error("Traza daada o truncada: " + ruta); }
+
+private:
+    const char* p;
+    const char* fin;
+    const string& ruta;
+};
+
+} // namespace
+
+/* ---------------- Grabacin ---------------- */
+
+bool iniciar(const string& ruta, size_t bytesPorHilo) {
+#if !SO_TRAZA
+    throw runtime_error("La traza de operaciones no est compilada (SO_TRAZA)");
+#endif
+    Estado& e = estado();
+    lock_guard<mutex> control(e.control);
+    if (e.vaciando) return false;
+
+    FILE* f = fopen(ruta.c_str(), "wb");
+    if (!f) {
+        throw runtime_error("No se pudo crear la traza " + ruta);
+    }
+    CabeceraArchivo cab;
+    memcpy(cab.magia, MAGIA, sizeof(MAGIA));
+    cab.version = VERSION;
+    cab.reservado = 0;
+    cab.ticksPorSegundo = 0;
+    if (fwrite(&cab, sizeof(cab), 1, f) != 1) {
+        fclose(f);
+        throw runtime_error("Error al escribir la traza " + ruta);
+    }
+
+    size_t bytes = BYTES_MINIMOS;
+    while (bytes < bytesPorHilo) bytes <<= 1;
+    {
+        lock_guard<mutex> lock(e.cerrojo);
+        e.archivo = f;
+        e.fallo = false;
+        e.bytesPorHilo = bytes;
+        memset(&e.stats, 0, sizeof(e.stats));
+        e.stats.bytes = sizeof(cab);
+        e.esperas.store(0, memory_order_relaxed);
+        if (++e.ultimaEpoca == 0) e.ultimaEpoca = 1;
+        e.vaciando = true;
+    }
+    e.parar = false;
+    e.pedido = false;
+    e.vaciador = thread(bucleVaciado);
+    e.inicioNs = ahoraNs();
+    e.inicio.store(marcaTiempo(), memory_order_relaxed);
+    epocaActual.store(e.ultimaEpoca, memory_order_release);
+    return true;
+}
+
+void detener() {
+    Estado& e = estado();
+    lock_guard<mutex> control(e.control);
+    if (!e.vaciando) return;
+
+    epocaActual.store(0, memory_order_release);
+    {
+        lock_guard<mutex> lock(e.mutexAviso);
+        e.parar = true;
+    }
+    e.aviso.notify_one();
+    e.vaciador.join(); // Su ltima pasada drena todos los anillos
+
+    bool fallo;
+    {
+        lock_guard<mutex> lock(e.cerrojo);
+        e.vaciando = false;
+        vaciarAnillos(e); // Anillos de hilos que salieron tras la ltima pasada
+
+        // Calibracin de las marcas de tiempo sobre toda la sesin
+        double ns = (double)(ahoraNs() - e.inicioNs);
+        double ticks = (double)(marcaTiempo() - e.inicio.load(memory_order_relaxed));
+        uint64_t ticksPorSegundo = ns > 0 ? (uint64_t)(ticks / ns * 1e9) : 1000000000u;
+        if (ticksPorSegundo == 0) ticksPorSegundo = 1;
+        fallo = e.fallo ||
+                fseek(e.archivo, offsetof(CabeceraArchivo, ticksPorSegundo), SEEK_SET) != 0 ||
+                fwrite(&ticksPorSegundo, sizeof(ticksPorSegundo), 1, e.archivo) != 1;
+        fallo = fclose(e.archivo) != 0 || fallo;
+        e.archivo = NULL;
+        e.stats.esperas = e.esperas.load(memory_order_relaxed);
+    }
+    if (fallo) {
+        throw runtime_error("Error al escribir la traza de operaciones");
+    }
+}
+
+uint32_t nuevoObjeto() {
+    static atomic<uint32_t> siguiente(1);
+    return siguiente.fetch_add(1, memory_order_relaxed);
+}
+
+void registrar(Operacion op, uint32_t objeto, int64_t a, int32_t b, int32_t resultado,
+               const char* texto, size_t longitud) {
+    uint32_t epoca = epocaActual.load(memory_order_acquire);
+    if (epoca == 0) return;
+    Anillo& an = anilloLocal();
+
+    if (longitud > 0xFFFF) longitud = 0xFFFF;
+    Registro r;
+    r.marca = marcaTiempo() - estado().inicio.load(memory_order_relaxed);
+    r.a = a;
+    r.objeto = objeto;
+    r.b = b;
+    r.resultado = resultado;
+    r.longitud = (uint16_t)longitud;
+    r.operacion = (uint8_t)op;
+    r.epoca = (uint8_t)epoca;
+
+    size_t capacidad = an.datos.size();
+    uint64_t total = sizeof(r) + ((longitud + 7) & ~(size_t)7);
+    uint64_t w = an.escrito.load(memory_order_relaxed);
+    uint64_t usado = w + total - an.leido.load(memory_order_acquire);
+    if (usado > capacidad && !esperarEspacio(an, w + total - capacidad, epoca)) return;
+
+    escribirEn(an, w, &r, sizeof(r));
+    if (longitud) escribirEn(an, w + sizeof(r), texto, longitud);
+    an.escrito.store(w + total, memory_order_release);
+
+    // Se avisa al vaciador una sola vez, al cruzar la mitad del anillo
+    if (usado > capacidad / 2 && usado - total <= capacidad / 2) despertar();
+}
+
+EstadisticasTraza estadisticas() {
+    Estado& e = estado();
+    lock_guard<mutex> lock(e.cerrojo);
+    EstadisticasTraza s = e.stats;
+    s.esperas = e.esperas.load(memory_order_relaxed);
+    return s;
+}
+
+/* ---------------- Lectura ---------------- */
+
+TrazaCargada cargar(const string& ruta) {
+    FILE* f = fopen(ruta.c_str(), "rb");
+    if (!f) {
+        throw runtime_error("No se pudo abrir la traza " + ruta);
+    }
+    vector<char> datos;
+    char bufer[1 << 16];
+    size_t n;
+    while ((n = fread(bufer, 1, sizeof(bufer), f)) > 0) datos.insert(datos.end(), bufer, bufer + n);
+    fclose(f);
+
+    TrazaCargada traza;
+    traza.hilos = 0;
+    Lector lector(datos.data(), datos.data() + datos.size(), ruta);
+    if (memcmp(lector.bytes(sizeof(MAGIA)), MAGIA, sizeof(MAGIA)) != 0) {
+        throw runtime_error(ruta + " no es una traza de operaciones");
+    }
+    CabeceraArchivo cab;
+    memcpy(cab.magia, MAGIA, sizeof(MAGIA));
+    memcpy(&cab.version, lector.bytes(sizeof(cab) - sizeof(MAGIA)), sizeof(cab) - sizeof(MAGIA));
+    if (cab.version != VERSION) {
+        throw runtime_error("Versin de traza no soportada en " + ruta);
+    }
+    // Una traza sin calibrar (grabacin interrumpida) se lee en ticks
+    double nsPorTick = cab.ticksPorSegundo ? 1e9 / (double)cab.ticksPorSegundo : 1.0;
+
+    vector<bool> hilos;
+    traza.eventos.reserve(datos.size() / 8); // Un registro codificado ocupa ~9 bytes
+    bool ordenados = true;
+    while (!lector.agotado()) {
+        CabeceraBloque bloque;
+        memcpy(&bloque, lector.bytes(sizeof(bloque)), sizeof(bloque));
+        const char* cuerpo = lector.bytes(bloque.bytes);
+        Lector reg(cuerpo, cuerpo + bloque.bytes, ruta);
+        if (bloque.hilo > 0xFFFF) lector.danada();
+        if (bloque.hilo >= hilos.size()) hilos.resize(bloque.hilo + 1, false);
+        if (!hilos[bloque.hilo]) traza.hilos++;
+        hilos[bloque.hilo] = true;
+
+        uint64_t marca = bloque.base;
+        for (uint32_t i = 0; i < bloque.registros; i++) {
+            Evento ev;
+            uint8_t op = reg.byte();
+            ev.operacion = op & ~CON_TEXTO;
+            if (ev.operacion >= NUM_OPERACIONES) reg.danada();
+            ev.objeto = (uint32_t)reg.varint();
+            marca += reg.varint();
+            ev.ns = (uint64_t)((double)marca * nsPorTick);
+            ev.a = desZigzag(reg.varint());
+            ev.b = (int32_t)desZigzag(reg.varint());
+            ev.resultado = (int32_t)desZigzag(reg.varint());
+            ev.hilo = (uint16_t)bloque.hilo;
+            ev.texto = -1;
+            if (op & CON_TEXTO) {
+                size_t longitud = (size_t)reg.varint();
+                const char* texto = reg.bytes(longitud);
+                ev.texto = (int32_t)traza.textos.size();
+                traza.textos.push_back(string(texto, longitud));
+            }
+            if (!traza.eventos.empty() && ev.ns < traza.eventos.back().ns) ordenados = false;
+            traza.eventos.push_back(ev);
+        }
+        if (!reg.agotado()) reg.danada();
+    }
+
+    if (!ordenados) {
+        stable_sort(traza.eventos.begin(), traza.eventos.end(),
+                    [](const Evento& x, const Evento& y) { return x.ns < y.ns; });
+    }
+    return traza;
+}
+
+const char* nombre(Operacion op) {
+    return op >= 0 && op < NUM_OPERACIONES ? NOMBRES[op] : "desconocida";
+}
+
+} // namespace Traza
@@ -0,0 +1,51 @@
+#include "Pruebas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+using namespace std;
+
+vector<CasoPrueba>& casosPrueba() {
+    static vector<CasoPrueba> casos;
+    return casos;
+}
+
+void fallarPrueba(const char* archivo, int linea, const string& detalle) {
+    const char* barra = strrchr(archivo, '/');
+    FalloPrueba fallo;
+    fallo.mensaje = string(barra ? barra + 1 : archivo) + ":" + to_string(linea) + ": " + detalle;
+    throw fallo;
+}
+
+int main(int argc, char** argv) {
+    string filtro = argc > 1 ? argv[1] : "";
+
+    vector<CasoPrueba> casos = casosPrueba();
+    sort(casos.begin(), casos.end(),
+         [](const CasoPrueba& a, const CasoPrueba& b) { return a.nombre < b.nombre; });
+
+    size_t corridos = 0;
+    size_t fallidos = 0;
+    for (size_t c = 0; c < casos.size(); c++) {
+        if (!filtro.empty() && casos[c].nombre.find(filtro) == string::npos) continue;
+        corridos++;
+        string error;
+        try {
+            casos[c].funcion();
+        } catch (const FalloPrueba& f) {
+            error = f.mensaje;
+        } catch (const exception& e) {
+            error = string("excepción inesperada: ") + e.what();
+        }
+        if (error.empty()) {
+            cout << "[ OK ]    " << casos[c].nombre << "\n";
+        } else {
+            fallidos++;
+            cout << "[FALLA]   " << casos[c].nombre << "\n          " << error << "\n";
+        }
+    }
+    cout << "\n" << corridos - fallidos << " de " << corridos << " pruebas correctas\n";
+    return fallidos == 0 ? 0 : 1;
+}
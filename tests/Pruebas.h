@@ -0,0 +1,83 @@
+#ifndef PRUEBAS_H
+#define PRUEBAS_H
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* ================================================================
+ *                   ARNÉS DE PRUEBAS
+ * ================================================================ */
+/**
+ * Arnés mínimo de pruebas unitarias sin dependencias externas, con el
+ * mismo registro estático que el de benchmarks. Cada caso corre hasta
+ * la primera verificación que falla; el ejecutable devuelve 1 si falló
+ * alguno, así ctest lo marca como fallido.
+ */
+typedef void (*FuncionPrueba)();
+
+struct CasoPrueba {
+    std::string nombre;
+    FuncionPrueba funcion;
+};
+
+/**
+ * Registro global de casos, poblado por inicializadores estáticos.
+ */
+std::vector<CasoPrueba>& casosPrueba();
+
+struct RegistradorPrueba {
+    RegistradorPrueba(const char* nombre, FuncionPrueba funcion) {
+        CasoPrueba caso = { nombre, funcion };
+        casosPrueba().push_back(caso);
+    }
+};
+
+/**
+ * Lo que lanza una verificación fallida: corta el caso en curso.
+ */
+struct FalloPrueba {
+    std::string mensaje;
+};
+
+[[noreturn]] void fallarPrueba(const char* archivo, int linea, const std::string& detalle);
+
+/**
+ * Define y registra un caso: PRUEBA_SO(tabla_hash_borrar) { ... }
+ */
+#define PRUEBA_SO(nombre)                                           \
+    static void prueba_##nombre();                                  \
+    static RegistradorPrueba registro_##nombre(#nombre, prueba_##nombre); \
+    static void prueba_##nombre()
+
+#define VERIFICAR(cond)                                             \
+    do {                                                            \
+        if (!(cond)) fallarPrueba(__FILE__, __LINE__, #cond);       \
+    } while (0)
+
+#define VERIFICAR_IGUAL(a, b)                                       \
+    do {                                                            \
+        auto va_ = (a);                                             \
+        auto vb_ = (b);                                             \
+        if (!(va_ == vb_)) {                                        \
+            std::ostringstream os_;                                 \
+            os_ << #a << " == " << #b << " (" << va_ << " != " << vb_ << ")"; \
+            fallarPrueba(__FILE__, __LINE__, os_.str());            \
+        }                                                           \
+    } while (0)
+
+/**
+ * Verifica que la expresión lance std::exception (u otra derivada).
+ */
+#define VERIFICAR_LANZA(expr)                                       \
+    do {                                                            \
+        bool lanzo_ = false;                                        \
+        try {                                                       \
+            expr;                                                   \
+        } catch (const std::exception&) {                           \
+            lanzo_ = true;                                          \
+        }                                                           \
+        if (!lanzo_) fallarPrueba(__FILE__, __LINE__, "no lanzó: " #expr); \
+    } while (0)
+
+#endif // PRUEBAS_H
@@ -0,0 +1,142 @@
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "ArbolProcesos.h"
+#include "Persistencia.h"
+#include "Pruebas.h"
+#include "Simulador.h"
+
+using namespace std;
+
+/* ================================================================
+ *                   PRUEBAS DEL ÁRBOL DE PROCESOS
+ * ================================================================ */
+
+namespace {
+
+const char* const ARCHIVO = "prueba_arbol.dat";
+
+// Preorden como pares (pid, profundidad)
+vector<pair<int, int> > preorden(const ArbolProcesos& arbol, int pid) {
+    vector<pair<int, int> > visitados;
+    arbol.recorrer(pid, [&](int p, int profundidad) {
+        visitados.push_back(make_pair(p, profundidad));
+    });
+    return visitados;
+}
+
+/*
+ *        init
+ *       /    \
+ *      1      2
+ *     / \     |
+ *    3   4    5
+ *    |
+ *    6
+ */
+void poblar(ArbolProcesos& arbol) {
+    arbol.agregar(1);
+    arbol.agregar(2);
+    arbol.agregar(3, 1);
+    arbol.agregar(4, 1);
+    arbol.agregar(5, 2);
+    arbol.agregar(6, 3);
+}
+
+} // namespace
+
+PRUEBA_SO(arbol_agregar_y_recorrer) {
+    ArbolProcesos arbol;
+    poblar(arbol);
+    VERIFICAR_IGUAL(arbol.tamano(), 6u);
+    VERIFICAR_LANZA(arbol.agregar(3));
+    VERIFICAR_LANZA(arbol.agregar(7, 99));
+    VERIFICAR_LANZA(arbol.agregar(ArbolProcesos::INIT));
+
+    vector<pair<int, int> > esperado;
+    esperado.push_back(make_pair(1, 0));
+    esperado.push_back(make_pair(3, 1));
+    esperado.push_back(make_pair(6, 2));
+    esperado.push_back(make_pair(4, 1));
+    VERIFICAR(preorden(arbol, 1) == esperado);
+    VERIFICAR_IGUAL(preorden(arbol, ArbolProcesos::INIT).size(), 7u);
+
+    VERIFICAR_IGUAL(arbol.padreDe(6), 3);
+    VERIFICAR_IGUAL(arbol.padreDe(2), ArbolProcesos::INIT);
+    VERIFICAR_IGUAL(arbol.contarDescendientes(1), 3u);
+    VERIFICAR_IGUAL(arbol.contarDescendientes(6), 0u);
+    VERIFICAR_IGUAL(arbol.contarDescendientes(ArbolProcesos::INIT), 6u);
+}
+
+PRUEBA_SO(arbol_eliminar_y_reparentar) {
+    ArbolProcesos arbol;
+    poblar(arbol);
+
+    // Los hijos de 1 pasan al final de los de init, con su subárbol
+    VERIFICAR_IGUAL(arbol.eliminar(1), 2u);
+    VERIFICAR(!arbol.contiene(1));
+    VERIFICAR_IGUAL(arbol.padreDe(3), ArbolProcesos::INIT);
+    VERIFICAR_IGUAL(arbol.padreDe(6), 3);
+    vector<pair<int, int> > raiz = preorden(arbol, ArbolProcesos::INIT);
+    int orden[] = { ArbolProcesos::INIT, 2, 5, 3, 6, 4 };
+    VERIFICAR_IGUAL(raiz.size(), 6u);
+    for (size_t i = 0; i < raiz.size(); i++) VERIFICAR_IGUAL(raiz[i].first, orden[i]);
+    VERIFICAR_LANZA(arbol.eliminar(1));
+    VERIFICAR_LANZA(arbol.eliminar(ArbolProcesos::INIT));
+
+    arbol.reparentarAInit(6);
+    VERIFICAR_IGUAL(arbol.padreDe(6), ArbolProcesos::INIT);
+    VERIFICAR_IGUAL(arbol.contarDescendientes(3), 0u);
+
+    // Una posición liberada se reutiliza
+    arbol.agregar(7, 5);
+    VERIFICAR_IGUAL(arbol.padreDe(7), 5);
+    VERIFICAR_IGUAL(arbol.tamano(), 6u);
+}
+
+PRUEBA_SO(arbol_quitar_subarbol) {
+    ArbolProcesos arbol;
+    poblar(arbol);
+    vector<int> pids;
+    VERIFICAR_IGUAL(arbol.quitarSubarbol(1, pids), 4u);
+    int esperado[] = { 1, 3, 6, 4 };
+    VERIFICAR_IGUAL(pids.size(), 4u);
+    for (size_t i = 0; i < pids.size(); i++) VERIFICAR_IGUAL(pids[i], esperado[i]);
+    VERIFICAR_IGUAL(arbol.tamano(), 2u);
+    VERIFICAR(!arbol.contiene(6));
+    VERIFICAR(arbol.contiene(5));
+    VERIFICAR_LANZA(arbol.quitarSubarbol(ArbolProcesos::INIT, pids));
+}
+
+PRUEBA_SO(arbol_persistencia_ida_y_vuelta) {
+    ArbolProcesos arbol;
+    poblar(arbol);
+    arbol.eliminar(4);
+    Persistencia::guardarArbol(arbol, ARCHIVO);
+
+    ArbolProcesos cargado;
+    VERIFICAR_IGUAL(Persistencia::cargarArbol(ARCHIVO, cargado), 5u);
+    remove(ARCHIVO);
+    VERIFICAR(preorden(cargado, ArbolProcesos::INIT) == preorden(arbol, ArbolProcesos::INIT));
+    VERIFICAR_IGUAL(Persistencia::cargarArbol(ARCHIVO, cargado), 0u);
+}
+
+// clonarProceso cuelga al hijo del padre y le pasa su nombre internado;
+// eliminarSubarbol se lleva a los descendientes de la tabla
+PRUEBA_SO(simulador_clonar_y_eliminar_subarbol) {
+    Simulador sim("", 3, 16);
+    sim.getProcesos().insertarProcesso(1, "shell", 40);
+    NodoProcesso* hijo = sim.clonarProceso(1, 2);
+    sim.clonarProceso(2, 3);
+    VERIFICAR(hijo->nombre == sim.getProcesos().buscarPorId(1)->nombre);
+    VERIFICAR_IGUAL(hijo->prioridad, 40);
+    VERIFICAR_IGUAL(sim.padreDe(3), 2);
+    VERIFICAR_IGUAL(sim.contarDescendientes(1), 2u);
+    VERIFICAR_LANZA(sim.clonarProceso(1, 2));
+
+    VERIFICAR_IGUAL(sim.eliminarSubarbol(2), 2u);
+    VERIFICAR(sim.getProcesos().buscarPorId(3) == NULL);
+    VERIFICAR_IGUAL(sim.getProcesos().contarProcesos(), 1);
+    VERIFICAR_IGUAL(sim.contarDescendientes(1), 0u);
+}
@@ -0,0 +1,191 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "ArbolProcesos.h"
+#include "Instantanea.h"
+#include "Pruebas.h"
+#include "Simulador.h"
+
+using namespace std;
+
+/* ================================================================
+ *                   PRUEBAS DE INSTANTÁNEAS
+ * ================================================================ */
+
+namespace {
+
+const char* const ARCHIVO = "prueba_instantanea.snap";
+
+// Formato de la versión 3 (ver Instantanea.cpp): registros de tamaño
+// fijo tras la cabecera, que termina con la suma de verificación
+const size_t TAM_PROCESO = 96;
+const size_t TAM_COLA = 32;
+const size_t TAM_BLOQUE = 8;
+const size_t TAM_ARBOL = 8;
+const size_t POS_NUM_ARBOL = 108; // En la cabecera
+
+struct ArchivoInstantanea {
+    string bytes;
+    size_t cabecera;
+
+    explicit ArchivoInstantanea(const char* archivo) {
+        ifstream in(archivo, ios::binary);
+        bytes.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        uint32_t procesos = leer32(12), cola = leer32(16), bloques = leer32(20), nombres = leer32(24);
+        cabecera = bytes.size() - procesos * TAM_PROCESO - cola * TAM_COLA -
+                   bloques * TAM_BLOQUE - leer32(POS_NUM_ARBOL) * TAM_ARBOL - nombres;
+    }
+
+    uint32_t leer32(size_t pos) const {
+        uint32_t v;
+        memcpy(&v, bytes.data() + pos, 4);
+        return v;
+    }
+
+    char* entradaCola(uint32_t i) {
+        return &bytes[cabecera + leer32(12) * TAM_PROCESO + i * TAM_COLA];
+    }
+
+    int32_t idCola(uint32_t i) {
+        int32_t id;
+        memcpy(&id, entradaCola(i), 4);
+        return id;
+    }
+
+    void ponerIdCola(uint32_t i, int32_t id) { memcpy(entradaCola(i), &id, 4); }
+
+    // Registro del árbol: pid y, a continuación, su padre
+    char* entradaArbol(uint32_t i) {
+        return &bytes[cabecera + leer32(12) * TAM_PROCESO + leer32(16) * TAM_COLA +
+                      leer32(20) * TAM_BLOQUE + i * TAM_ARBOL];
+    }
+
+    // Rehace la suma (FNV-1a por palabra) para que solo falle la validación
+    // de contenido
+    void guardar(const char* archivo) {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(bytes.data()) + cabecera;
+        size_t n = bytes.size() - cabecera;
+        uint64_t h = 0xCBF29CE484222325ull;
+        while (n >= 8) {
+            uint64_t w;
+            memcpy(&w, p, 8);
+            h = (h ^ w) * 0x100000001B3ull;
+            p += 8;
+            n -= 8;
+        }
+        while (n--) h = (h ^ *p++) * 0x100000001B3ull;
+        memcpy(&bytes[cabecera - 8], &h, 8);
+        ofstream out(archivo, ios::binary | ios::trunc);
+        out.write(bytes.data(), (streamsize)bytes.size());
+    }
+};
+
+// Cinco procesos de prioridades distintas; el de mayor prioridad (4)
+// queda en la CPU y los otros cuatro en la cola
+void poblar(Simulador& sim) {
+    const char* nombres[] = { "p0", "p1", "p2", "p3", "p4" };
+    int prioridades[] = { 10, 50, 30, 70, 90 };
+    for (int i = 0; i < 5; i++) {
+        sim.getProcesos().insertarProcesso(i, nombres[i], prioridades[i]);
+        sim.encolar(i);
+    }
+    sim.despachar();
+}
+
+} // namespace
+
+PRUEBA_SO(instantanea_ida_y_vuelta) {
+    Simulador origen("", 3, 16);
+    poblar(origen);
+    origen.asignarMemoria(1, 100);
+    origen.clonarProceso(1, 5);
+    origen.clonarProceso(5, 6);
+    origen.clonarProceso(1, 7);
+    origen.clonarProceso(3, 8);
+    Instantanea::guardar(origen, ARCHIVO);
+
+    Simulador destino("", 3, 16);
+    Instantanea::restaurar(destino, ARCHIVO);
+    remove(ARCHIVO);
+
+    VERIFICAR_IGUAL(destino.getProcesos().contarProcesos(), 9);
+    VERIFICAR(destino.getEnEjecucion() != NULL);
+    VERIFICAR_IGUAL(destino.getEnEjecucion()->id, 4);
+    VERIFICAR_IGUAL(destino.getMemoria().bloquesDe(1), 1);
+    VERIFICAR_IGUAL(destino.getProcesos().buscarPorId(2)->nombre.str(), string("p2"));
+    int esperado[] = { 3, 1, 2, 0 };
+    for (int i = 0; i < 4; i++) {
+        VERIFICAR_IGUAL(destino.getPlanificador().desencolar()->id, esperado[i]);
+    }
+
+    // La jerarquía vuelve igual, con los hermanos en el mismo orden
+    VERIFICAR_IGUAL(destino.padreDe(6), 5);
+    VERIFICAR_IGUAL(destino.padreDe(8), 3);
+    VERIFICAR_IGUAL(destino.contarDescendientes(1), 3u);
+    vector<int> antes, despues;
+    origen.getArbol().recorrer(ArbolProcesos::INIT, [&](int pid, int) { antes.push_back(pid); });
+    destino.getArbol().recorrer(ArbolProcesos::INIT, [&](int pid, int) { despues.push_back(pid); });
+    VERIFICAR(antes == despues);
+    VERIFICAR_IGUAL(despues.size(), 7u);
+}
+
+// Cada daño deja la suma correcta: lo debe rechazar la validación de la
+// cola, sin tocar el estado del simulador destino
+PRUEBA_SO(instantanea_rechaza_cola_inconsistente) {
+    Simulador origen("", 3, 16);
+    poblar(origen);
+    origen.clonarProceso(1, 5);
+    origen.clonarProceso(5, 6);
+    Instantanea::guardar(origen, ARCHIVO);
+    const ArchivoInstantanea original(ARCHIVO);
+
+    Simulador destino("", 3, 16);
+    destino.getProcesos().insertarProcesso(7, "sigue", 5);
+
+    // PID repetido en la cola
+    ArchivoInstantanea repetido = original;
+    repetido.ponerIdCola(1, repetido.idCola(0));
+    repetido.guardar(ARCHIVO);
+    VERIFICAR_LANZA(Instantanea::restaurar(destino, ARCHIVO));
+
+    // El proceso en ejecución también encolado
+    ArchivoInstantanea enCpu = original;
+    enCpu.ponerIdCola(2, 4);
+    enCpu.guardar(ARCHIVO);
+    VERIFICAR_LANZA(Instantanea::restaurar(destino, ARCHIVO));
+
+    // Raíz y primer hijo intercambiados: el hijo va antes que su padre
+    ArchivoInstantanea desordenado = original;
+    string raiz(desordenado.entradaCola(0), TAM_COLA);
+    memcpy(desordenado.entradaCola(0), desordenado.entradaCola(1), TAM_COLA);
+    memcpy(desordenado.entradaCola(1), raiz.data(), TAM_COLA);
+    desordenado.guardar(ARCHIVO);
+    VERIFICAR_LANZA(Instantanea::restaurar(destino, ARCHIVO));
+
+    // Un padre que no está en el árbol
+    ArchivoInstantanea huerfano = original;
+    int32_t desconocido = 99;
+    memcpy(huerfano.entradaArbol(2) + 4, &desconocido, 4);
+    huerfano.guardar(ARCHIVO);
+    VERIFICAR_LANZA(Instantanea::restaurar(destino, ARCHIVO));
+
+    // Un hijo antes que su padre
+    ArchivoInstantanea invertido = original;
+    string padre(invertido.entradaArbol(0), TAM_ARBOL);
+    memcpy(invertido.entradaArbol(0), invertido.entradaArbol(1), TAM_ARBOL);
+    memcpy(invertido.entradaArbol(1), padre.data(), TAM_ARBOL);
+    invertido.guardar(ARCHIVO);
+    VERIFICAR_LANZA(Instantanea::restaurar(destino, ARCHIVO));
+
+    // Sin daño se restaura
+    ArchivoInstantanea(original).guardar(ARCHIVO);
+    VERIFICAR_IGUAL(destino.getProcesos().contarProcesos(), 1);
+    Instantanea::restaurar(destino, ARCHIVO);
+    VERIFICAR_IGUAL(destino.getProcesos().contarProcesos(), 7);
+    VERIFICAR_IGUAL(destino.padreDe(6), 5);
+    remove(ARCHIVO);
+}
@@ -0,0 +1,53 @@
+#include "MemoriaVirtual.h"
+#include "NodoProcesso.h"
+#include "Pruebas.h"
+#include "Reemplazo.h"
+
+using namespace std;
+
+/* ================================================================
+ *                   PRUEBAS DE MEMORIA VIRTUAL
+ * ================================================================ */
+
+PRUEBA_SO(vm_traducir_demanda_y_tlb) {
+    MemoriaVirtual vm(8);
+    NodoProcesso p(1, NombreProceso("p"), 10);
+    vm.crearEspacio(&p);
+
+    uint32_t fisica = vm.traducir(&p, 0x5123);
+    VERIFICAR_IGUAL(fisica & (TAM_PAGINA - 1), 0x123u);
+    VERIFICAR_IGUAL(vm.traducir(&p, 0x5FFF), (fisica & ~(TAM_PAGINA - 1)) | 0xFFFu);
+    VERIFICAR_IGUAL(vm.getEstadisticas().fallosPagina, 1u);
+    VERIFICAR_IGUAL(vm.getEstadisticas().aciertosTLB, 1u);
+
+    vm.destruirEspacio(&p);
+    VERIFICAR(p.tablaPaginas == NULL);
+    VERIFICAR_IGUAL(vm.getAsignador().disponibles(), 8u);
+}
+
+// Sin espacio de direcciones la traducción falla sin que el algoritmo de
+// reemplazo registre la referencia ni desaloje páginas de otro proceso
+PRUEBA_SO(vm_traducir_sin_espacio_no_desaloja) {
+    MemoriaVirtual vm(2);
+    vm.setAlgoritmoReemplazo(new ReemplazoLRU(2));
+    NodoProcesso a(1, NombreProceso("a"), 10);
+    NodoProcesso b(2, NombreProceso("b"), 10);
+    vm.crearEspacio(&a);
+    vm.traducir(&a, 0x1000);
+    vm.traducir(&a, 0x2000);
+
+    VERIFICAR_LANZA(vm.traducir(&b, 0x1000));
+    VERIFICAR_LANZA(vm.traducir(&b, 0x3000));
+    VERIFICAR_IGUAL(vm.getEstadisticas().desalojos, 0u);
+
+    vm.traducir(&a, 0x1000);
+    vm.traducir(&a, 0x2000);
+    VERIFICAR_IGUAL(vm.getEstadisticas().fallosPagina, 2u);
+
+    // Con los marcos llenos, un fallo desaloja la menos usada (0x1000)
+    vm.traducir(&a, 0x3000);
+    VERIFICAR_IGUAL(vm.getEstadisticas().desalojos, 1u);
+    vm.traducir(&a, 0x2000);
+    VERIFICAR_IGUAL(vm.getEstadisticas().fallosPagina, 3u);
+    vm.destruirEspacio(&a);
+}
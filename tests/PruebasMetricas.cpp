@@ -0,0 +1,57 @@
+#include <atomic>
+#include <thread>
+
+#include "Metricas.h"
+#include "Pruebas.h"
+
+using namespace std;
+
+/* ================================================================
+ *                   PRUEBAS DE MÉTRICAS
+ * ================================================================ */
+
+PRUEBA_SO(metricas_reiniciar_conserva_medidores) {
+    if (!Metricas::habilitadas()) return;
+    Metricas::reiniciar();
+    int64_t medidor = Metricas::tomarInstantanea().medidores[Metricas::RPC_CONEXIONES];
+    Metricas::contar(Metricas::RPC_REENVIADAS, 7);
+    Metricas::ajustar(Metricas::RPC_CONEXIONES, 3);
+    Metricas::registrar(Metricas::TR_TARDANZA_TICKS, 100);
+    VERIFICAR_IGUAL(Metricas::tomarInstantanea().contadores[Metricas::RPC_REENVIADAS], 7u);
+
+    Metricas::reiniciar();
+    Metricas::Instantanea inst = Metricas::tomarInstantanea();
+    VERIFICAR_IGUAL(inst.contadores[Metricas::RPC_REENVIADAS], 0u);
+    VERIFICAR_IGUAL(inst.histogramas[Metricas::TR_TARDANZA_TICKS].cuenta, 0u);
+    VERIFICAR_IGUAL(inst.medidores[Metricas::RPC_CONEXIONES], medidor + 3);
+    Metricas::ajustar(Metricas::RPC_CONEXIONES, -3);
+}
+
+// Un hilo que contó antes del reinicio y todavía no volvió a contar
+// aporta cero; lo que cuenta después se suma desde cero, también al
+// terminar el hilo
+PRUEBA_SO(metricas_reiniciar_con_hilo_vivo) {
+    if (!Metricas::habilitadas()) return;
+    atomic<int> paso(0);
+    thread trabajador([&paso]() {
+        Metricas::contar(Metricas::RPC_REENVIADAS, 1000);
+        Metricas::ajustar(Metricas::RPC_CONEXIONES, 1);
+        paso.store(1);
+        while (paso.load() != 2) this_thread::yield();
+        Metricas::contar(Metricas::RPC_REENVIADAS, 5);
+        Metricas::ajustar(Metricas::RPC_CONEXIONES, -1);
+    });
+    while (paso.load() != 1) this_thread::yield();
+    int64_t medidor = Metricas::tomarInstantanea().medidores[Metricas::RPC_CONEXIONES];
+
+    Metricas::reiniciar();
+    Metricas::Instantanea inst = Metricas::tomarInstantanea();
+    VERIFICAR_IGUAL(inst.contadores[Metricas::RPC_REENVIADAS], 0u);
+    VERIFICAR_IGUAL(inst.medidores[Metricas::RPC_CONEXIONES], medidor);
+
+    paso.store(2);
+    trabajador.join();
+    inst = Metricas::tomarInstantanea();
+    VERIFICAR_IGUAL(inst.contadores[Metricas::RPC_REENVIADAS], 5u);
+    VERIFICAR_IGUAL(inst.medidores[Metricas::RPC_CONEXIONES], medidor - 1);
+}
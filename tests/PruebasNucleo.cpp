@@ -0,0 +1,366 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ColaPrioridad.h"
+#include "IndiceProcesos.h"
+#include "ListaProcesso.h"
+#include "PilaMemoria.h"
+#include "PoolNombres.h"
+#include "Pruebas.h"
+
+using namespace std;
+
+/* ================================================================
+ *          PRUEBAS DE LAS ESTRUCTURAS DEL NÚCLEO
+ * ================================================================ */
+
+PRUEBA_SO(lista_insertar_buscar_eliminar) {
+    ListaProcesso lista("");
+    lista.insertarProcesso(3, "c", 10);
+    lista.insertarProcesso(1, "a", 20);
+    lista.insertarProcesso(2, "b", 30);
+    VERIFICAR_IGUAL(lista.contarProcesos(), 3);
+    VERIFICAR_LANZA(lista.insertarProcesso(1, "otro", 5));
+    VERIFICAR_LANZA(lista.insertarProcesso(4, "d", 101));
+
+    VERIFICAR(lista.buscarPorId(1) != NULL);
+    VERIFICAR_IGUAL(lista.buscarPorId(2)->prioridad, 30);
+    VERIFICAR(lista.buscarPorId(4) == NULL);
+
+    // La lista conserva el orden de inserción
+    VERIFICAR_IGUAL(lista.primero()->id, 3);
+    lista.eliminarProcesso(1);
+    VERIFICAR(lista.buscarPorId(1) == NULL);
+    VERIFICAR_IGUAL(lista.contarProcesos(), 2);
+    VERIFICAR_LANZA(lista.eliminarProcesso(1));
+}
+
+namespace {
+
+uint32_t siguienteAzar(uint32_t& x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// Compara el índice completo contra el mapa: recorrido, búsqueda, rango,
+// selección y consultas de intervalo al azar
+void verificarIndice(const IndiceProcesos& indice, const map<int, NodoProcesso*>& referencia,
+                     uint32_t& azar) {
+    VERIFICAR_IGUAL(indice.tam(), referencia.size());
+    vector<NodoProcesso*> enOrden;
+    indice.recorrer([&](NodoProcesso* p) { enOrden.push_back(p); });
+    VERIFICAR_IGUAL(enOrden.size(), referencia.size());
+    size_t k = 0;
+    for (map<int, NodoProcesso*>::const_iterator it = referencia.begin(); it != referencia.end();
+         ++it, k++) {
+        VERIFICAR(enOrden[k] == it->second);
+        VERIFICAR(indice.seleccionar(k) == it->second);
+        VERIFICAR(indice.buscar(it->first) == it->second);
+        VERIFICAR_IGUAL(indice.posicion(it->first), k);
+    }
+    VERIFICAR(indice.seleccionar(referencia.size()) == NULL);
+
+    for (int i = 0; i < 200; i++) {
+        int desde = (int)(siguienteAzar(azar) % 120000) - 60000;
+        int hasta = desde + (int)(siguienteAzar(azar) % 5000) - 100;
+        map<int, NodoProcesso*>::const_iterator a = referencia.lower_bound(desde);
+        VERIFICAR_IGUAL(indice.posicion(desde), (size_t)distance(referencia.begin(), a));
+        VERIFICAR_IGUAL(indice.buscar(desde) != NULL, referencia.count(desde) == 1);
+        size_t esperados = desde > hasta ? 0 : (size_t)distance(a, referencia.upper_bound(hasta));
+        VERIFICAR_IGUAL(indice.contarRango(desde, hasta), esperados);
+        vector<NodoProcesso*> visitados;
+        VERIFICAR_IGUAL(indice.rango(desde, hasta, [&](NodoProcesso* p) { visitados.push_back(p); }),
+                        esperados);
+        for (size_t j = 0; j < visitados.size(); j++, ++a) VERIFICAR(visitados[j] == a->second);
+    }
+}
+
+} // namespace
+
+// Inserciones y bajas al azar contra un std::map. Las bajas vacían zonas
+// enteras del espacio de IDs, así que las hojas y los nodos internos
+// piden prestado a sus hermanos o se fusionan y el árbol pierde niveles
+PRUEBA_SO(indice_procesos_contra_mapa) {
+    IndiceProcesos indice;
+    map<int, NodoProcesso*> referencia;
+    vector<unique_ptr<NodoProcesso> > procesos;
+    uint32_t azar = 2463534242u;
+    NombreProceso nombre("indexado");
+
+    for (int i = 0; i < 20000; i++) {
+        int id = (int)(siguienteAzar(azar) % 100000) - 50000;
+        procesos.push_back(unique_ptr<NodoProcesso>(new NodoProcesso(id, nombre, 1)));
+        bool nuevo = referencia.insert(make_pair(id, procesos.back().get())).second;
+        VERIFICAR_IGUAL(indice.insertar(procesos.back().get()), nuevo);
+        if (i % 5000 == 0) verificarIndice(indice, referencia, azar);
+    }
+    verificarIndice(indice, referencia, azar);
+    int alturaMaxima = indice.getAltura();
+    VERIFICAR(alturaMaxima >= 3);
+
+    // Bajas por tramos de IDs contiguos y sueltas, incluso de IDs ausentes
+    for (int ronda = 0; referencia.size() > 100; ronda++) {
+        int desde = (int)(siguienteAzar(azar) % 100000) - 50000;
+        for (int id = desde; id < desde + 3000; id++) {
+            map<int, NodoProcesso*>::iterator it = referencia.find(id);
+            NodoProcesso* esperado = it == referencia.end() ? NULL : it->second;
+            VERIFICAR(indice.eliminar(id) == esperado);
+            if (esperado) referencia.erase(it);
+        }
+        for (int i = 0; i < 500 && !referencia.empty(); i++) {
+            int id = indice.seleccionar(siguienteAzar(azar) % indice.tam())->id;
+            VERIFICAR(indice.eliminar(id) == referencia[id]);
+            referencia.erase(id);
+            VERIFICAR(indice.eliminar(id) == NULL);
+        }
+        if (ronda % 4 == 0) verificarIndice(indice, referencia, azar);
+    }
+    verificarIndice(indice, referencia, azar);
+    VERIFICAR(indice.getAltura() < alturaMaxima);
+
+    while (!referencia.empty()) {
+        VERIFICAR(indice.eliminar(referencia.begin()->first) == referencia.begin()->second);
+        referencia.erase(referencia.begin());
+    }
+    verificarIndice(indice, referencia, azar);
+    VERIFICAR_IGUAL(indice.getAltura(), 1);
+    VERIFICAR(indice.insertar(procesos[0].get()));
+    VERIFICAR(indice.seleccionar(0) == procesos[0].get());
+}
+
+PRUEBA_SO(cola_prioridad_orden) {
+    vector<unique_ptr<NodoProcesso> > procesos;
+    int prioridades[] = { 5, 90, 40, 90, 1 };
+    ColaPrioridad cola;
+    cola.setPeriodoEnvejecimiento(0);
+    for (int i = 0; i < 5; i++) {
+        procesos.emplace_back(new NodoProcesso(i, NombreProceso("p"), prioridades[i]));
+        cola.encolarPrioridad(procesos.back().get());
+    }
+    // Mayor prioridad primero; a igual prioridad, el que llegó antes
+    int esperado[] = { 1, 3, 2, 0, 4 };
+    for (int i = 0; i < 5; i++) VERIFICAR_IGUAL(cola.desencolar()->id, esperado[i]);
+    VERIFICAR_IGUAL(cola.contarProcesos(), 0);
+}
+
+// Subir y bajar la prioridad de un proceso ya encolado lo reubica en el
+// montículo sin perder a los demás
+PRUEBA_SO(cola_prioridad_cambiar_encolado) {
+    vector<unique_ptr<NodoProcesso> > procesos;
+    ColaPrioridad cola;
+    cola.setPeriodoEnvejecimiento(0);
+    for (int i = 0; i < 8; i++) {
+        procesos.emplace_back(new NodoProcesso(i, NombreProceso("p"), 10 + i * 5));
+        cola.encolarPrioridad(procesos.back().get());
+    }
+    VERIFICAR_IGUAL(cola.frente()->id, 7);
+
+    // El de menor prioridad pasa al frente
+    VERIFICAR(cola.cambiarPrioridad(0, 100));
+    VERIFICAR_IGUAL(cola.frente()->id, 0);
+    VERIFICAR_IGUAL(procesos[0]->prioridad, 100);
+
+    // El de mayor prioridad pasa al fondo
+    VERIFICAR(cola.cambiarPrioridad(7, 0));
+    VERIFICAR_IGUAL(cola.prioridadEfectiva(7), 0);
+
+    // A igual prioridad conserva su turno de llegada: 3 llegó antes que 5
+    VERIFICAR(cola.cambiarPrioridad(5, 25));
+    VERIFICAR(!cola.cambiarPrioridad(42, 50));
+
+    int esperado[] = { 0, 6, 4, 3, 5, 2, 1, 7 };
+    for (int i = 0; i < 8; i++) VERIFICAR_IGUAL(cola.desencolar()->id, esperado[i]);
+    VERIFICAR_IGUAL(cola.contarProcesos(), 0);
+}
+
+namespace {
+
+// Despachos hasta que sale 'bajo' mientras dos procesos de prioridad alta
+// vuelven a la cola tras cada despacho (0 si no sale en 'limite')
+int despachosHastaSalir(int periodo, int limite) {
+    NodoProcesso bajo(0, NombreProceso("bajo"), 0);
+    NodoProcesso alto1(1, NombreProceso("alto"), 50);
+    NodoProcesso alto2(2, NombreProceso("alto"), 50);
+    ColaPrioridad cola;
+    cola.setPeriodoEnvejecimiento(periodo);
+    cola.encolarPrioridad(&bajo);
+    cola.encolarPrioridad(&alto1);
+    cola.encolarPrioridad(&alto2);
+    for (int i = 1; i <= limite; i++) {
+        NodoProcesso* p = cola.desencolar();
+        if (p == &bajo) return i;
+        cola.encolarPrioridad(p);
+    }
+    return 0;
+}
+
+} // namespace
+
+// Con envejecimiento el proceso postergado gana un punto cada 'periodo'
+// despachos y termina saliendo; sin él espera para siempre
+PRUEBA_SO(cola_prioridad_envejecimiento_evita_inanicion) {
+    int periodo = ColaPrioridad::PERIODO_ENVEJECIMIENTO;
+    int despachos = despachosHastaSalir(periodo, 2000);
+    VERIFICAR(despachos > 0);
+    VERIFICAR(despachos <= 50 * periodo + 2);
+    VERIFICAR_IGUAL(despachosHastaSalir(0, 2000), 0);
+}
+
+PRUEBA_SO(pila_memoria_lifo_y_capacidad) {
+    PilaMemoria memoria(3);
+    memoria.push(100, 1);
+    memoria.push(200, 2);
+    memoria.push(300, 1);
+    VERIFICAR_LANZA(memoria.push(400));
+    VERIFICAR_IGUAL(memoria.bloquesDe(1), 2);
+    VERIFICAR_IGUAL(memoria.pop(), 300);
+    VERIFICAR_IGUAL(memoria.liberarProceso(2), 1);
+    VERIFICAR_IGUAL(memoria.usados(), 1);
+    VERIFICAR_IGUAL(memoria.pop(), 100);
+    VERIFICAR_LANZA(memoria.pop());
+}
+
+PRUEBA_SO(pool_nombres_internados) {
+    size_t antes = PoolNombres::cantidad();
+    NombreProceso a("prueba_pool"), b(string("prueba_pool"));
+    VERIFICAR(a == b);
+    VERIFICAR_IGUAL(PoolNombres::cantidad(), antes + 1);
+    VERIFICAR_IGUAL(a.str(), string("prueba_pool"));
+    VERIFICAR_IGUAL(NombreProceso().str(), string());
+
+    // Un nombre ya internado se inserta sin volver a buscarlo ni copiarlo
+    ListaProcesso lista("");
+    lista.insertarProcesso(1, a, 10);
+    VERIFICAR(lista.buscarPorId(1)->nombre == a);
+    VERIFICAR_IGUAL(PoolNombres::cantidad(), antes + 1);
+}
+
+PRUEBA_SO(pila_memoria_manijas) {
+    PilaMemoria memoria(4);
+    PilaMemoria::Manija a = memoria.push(300, 1);
+    PilaMemoria::Manija b = memoria.push(100, 1);
+    VERIFICAR(memoria.manijaValida(a));
+    VERIFICAR_IGUAL(memoria.direccionDe(b), 100);
+
+    // Una manija liberada no vale aunque su posición se reutilice
+    memoria.pop();
+    VERIFICAR(!memoria.manijaValida(b));
+    PilaMemoria::Manija c = memoria.push(200, 2);
+    VERIFICAR(!memoria.manijaValida(b));
+    VERIFICAR(memoria.manijaValida(c));
+    VERIFICAR(!memoria.manijaValida(~0ull));
+    VERIFICAR_LANZA(memoria.direccionDe(b));
+
+    // Compactar mueve los bloques pero las manijas los siguen encontrando
+    memoria.iniciarCompactacion();
+    while (memoria.pasoCompactacion(1)) {}
+    VERIFICAR(memoria.manijaValida(a));
+    VERIFICAR(memoria.manijaValida(c));
+    VERIFICAR(memoria.direccionDe(a) != memoria.direccionDe(c));
+}
+
+namespace {
+
+struct BloqueReferencia {
+    PilaMemoria::Manija manija;
+    int pid;
+};
+
+// Recuenta desde cero, con las direcciones actuales de las manijas, lo
+// que resumen() mantiene en forma incremental
+void verificarResumen(const PilaMemoria& memoria, const vector<BloqueReferencia>& pila) {
+    vector<int> direcciones;
+    for (size_t i = 0; i < pila.size(); i++) {
+        VERIFICAR(memoria.manijaValida(pila[i].manija));
+        direcciones.push_back(memoria.direccionDe(pila[i].manija));
+    }
+    sort(direcciones.begin(), direcciones.end());
+    direcciones.erase(unique(direcciones.begin(), direcciones.end()), direcciones.end());
+
+    uint64_t huecos = 0, libre = 0, cuadrados = 0;
+    uint64_t histograma[ResumenMemoria::CLASES] = { 0 };
+    for (size_t i = 1; i < direcciones.size(); i++) {
+        uint64_t tam = (uint64_t)(direcciones[i] - direcciones[i - 1] - 1);
+        if (tam == 0) continue;
+        huecos++;
+        libre += tam;
+        cuadrados += tam * tam;
+        int clase = 0;
+        while ((tam >> (clase + 1)) != 0) clase++;
+        histograma[clase]++;
+    }
+
+    ResumenMemoria r = memoria.resumen();
+    VERIFICAR_IGUAL(r.usados, (int)pila.size());
+    VERIFICAR_IGUAL(r.direcciones, direcciones.size());
+    VERIFICAR_IGUAL(r.minima, direcciones.empty() ? 0 : direcciones.front());
+    VERIFICAR_IGUAL(r.maxima, direcciones.empty() ? 0 : direcciones.back());
+    VERIFICAR_IGUAL(r.huecos, huecos);
+    VERIFICAR_IGUAL(r.libre, libre);
+    for (int k = 0; k < ResumenMemoria::CLASES; k++) VERIFICAR_IGUAL(r.histograma[k], histograma[k]);
+    double fragmentacion = libre ? 1.0 - (double)cuadrados / ((double)libre * (double)libre) : 0.0;
+    VERIFICAR(fabs(r.fragmentacion - fragmentacion) < 1e-9);
+}
+
+} // namespace
+
+// Asignaciones, pops, liberaciones por proceso y pasos de compactación
+// intercalados al azar; el resumen incremental coincide siempre con un
+// recuento completo. El rango de direcciones llena y vacía muchas hojas
+// del conjunto de direcciones ocupadas
+PRUEBA_SO(pila_memoria_resumen_contra_recuento) {
+    PilaMemoria memoria(1 << 20);
+    vector<BloqueReferencia> pila;
+    uint32_t azar = 1234567u;
+
+    for (int op = 1; op <= 30000; op++) {
+        uint32_t r = siguienteAzar(azar) % 100;
+        if (r < 62 || pila.empty()) {
+            int direccion = (int)(siguienteAzar(azar) % 30000);
+            BloqueReferencia b = { 0, (int)(siguienteAzar(azar) % 256) };
+            b.manija = memoria.push(direccion, b.pid);
+            pila.push_back(b);
+        } else if (r < 86) {
+            int direccion = memoria.direccionDe(pila.back().manija);
+            VERIFICAR_IGUAL(memoria.pop(), direccion);
+            pila.pop_back();
+        } else if (r < 87) {
+            int pid = (int)(siguienteAzar(azar) % 256);
+            size_t antes = pila.size();
+            vector<BloqueReferencia> quedan;
+            for (size_t i = 0; i < pila.size(); i++) {
+                if (pila[i].pid != pid) quedan.push_back(pila[i]);
+            }
+            pila.swap(quedan);
+            VERIFICAR_IGUAL(memoria.liberarProceso(pid), (int)(antes - pila.size()));
+        } else if (r < 89) {
+            memoria.iniciarCompactacion();
+        } else if (memoria.compactando()) {
+            memoria.pasoCompactacion(1 + siguienteAzar(azar) % 200);
+        }
+        if (op % 500 == 0) verificarResumen(memoria, pila);
+    }
+    verificarResumen(memoria, pila);
+    VERIFICAR(memoria.resumen().direcciones > 10 * ConjuntoDirecciones::HOJA);
+
+    // Compactada del todo no quedan huecos
+    memoria.compactar(97);
+    verificarResumen(memoria, pila);
+    ResumenMemoria r = memoria.resumen();
+    VERIFICAR_IGUAL(r.huecos, 0u);
+    VERIFICAR_IGUAL(r.maxima - r.minima + 1, (int)r.direcciones);
+
+    while (!pila.empty()) {
+        memoria.pop();
+        pila.pop_back();
+        if (pila.size() % 97 == 0) verificarResumen(memoria, pila);
+    }
+}
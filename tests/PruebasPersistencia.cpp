@@ -0,0 +1,184 @@
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CodecLZ.h"
+#include "GuardadoFondo.h"
+#include "NodoProcesso.h"
+#include "Persistencia.h"
+#include "PoolNombres.h"
+#include "Pruebas.h"
+
+using namespace std;
+
+/* ================================================================
+ *                   PRUEBAS DE PERSISTENCIA
+ * ================================================================ */
+
+namespace {
+
+const char* const ARCHIVO = "prueba_procesos.soz";
+
+void liberar(NodoProcesso* cabeza) {
+    while (cabeza) {
+        NodoProcesso* sig = cabeza->siguiente;
+        delete cabeza;
+        cabeza = sig;
+    }
+}
+
+void idaYVueltaLZ(const vector<uint8_t>& original) {
+    vector<uint8_t> comprimido;
+    size_t n = CodecLZ::comprimir(original.data(), original.size(), comprimido);
+    VERIFICAR(n <= CodecLZ::cotaComprimido(original.size()));
+    vector<uint8_t> salida(original.size());
+    CodecLZ::descomprimir(comprimido.data(), n, salida.data(), salida.size());
+    VERIFICAR(salida == original);
+}
+
+} // namespace
+
+PRUEBA_SO(lz_ida_y_vuelta) {
+    idaYVueltaLZ(vector<uint8_t>());
+
+    vector<uint8_t> repetido;
+    for (int i = 0; i < 100000; i++) repetido.push_back((uint8_t)("servicio_"[i % 9]));
+    idaYVueltaLZ(repetido);
+
+    // Datos sin repeticiones: la salida no puede pasar de la cota
+    vector<uint8_t> azar;
+    uint32_t x = 2463534242u;
+    for (int i = 0; i < 70000; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        azar.push_back((uint8_t)x);
+    }
+    idaYVueltaLZ(azar);
+
+    // Un tamaño original que no coincide es un bloque dañado
+    vector<uint8_t> comprimido;
+    size_t n = CodecLZ::comprimir(repetido.data(), repetido.size(), comprimido);
+    vector<uint8_t> corto(repetido.size() - 1);
+    VERIFICAR_LANZA(CodecLZ::descomprimir(comprimido.data(), n, corto.data(), corto.size()));
+}
+
+PRUEBA_SO(comprimido_guardar_y_cargar) {
+    NodoProcesso* cabeza = NULL;
+    NodoProcesso* ultimo = NULL;
+    int total = 3 * (int)Persistencia::REGISTROS_POR_BLOQUE + 17;
+    for (int i = 0; i < total; i++) {
+        NodoProcesso* n = new NodoProcesso(i * 3 - 500, "srv_" + to_string(i % 7), i % 101);
+        if (ultimo) ultimo->siguiente = n; else cabeza = n;
+        ultimo = n;
+    }
+    Persistencia::guardarProcesosComprimido(cabeza, ARCHIVO);
+    VERIFICAR(Persistencia::esComprimido(ARCHIVO));
+
+    NodoProcesso* cargada = Persistencia::cargarProcesosComprimido(ARCHIVO, 2);
+    int i = 0;
+    NodoProcesso* a = cabeza;
+    for (NodoProcesso* b = cargada; b; b = b->siguiente, a = a->siguiente, i++) {
+        VERIFICAR(a != NULL);
+        VERIFICAR_IGUAL(b->id, a->id);
+        VERIFICAR_IGUAL(b->prioridad, a->prioridad);
+        VERIFICAR(b->nombre == a->nombre);
+    }
+    VERIFICAR_IGUAL(i, total);
+    liberar(cabeza);
+    liberar(cargada);
+    remove(ARCHIVO);
+}
+
+// Un CSV de más de 2 MiB se parte en tres trozos. Hay IDs repetidos a
+// ambos lados del primer corte y entre trozos lejanos: gana la primera
+// aparición y la lista respeta el orden del archivo, igual que con un hilo
+PRUEBA_SO(csv_paralelo_duplicados_entre_trozos) {
+    const char* const csv = "prueba_procesos.csv";
+    const int lineas = 130000; // 20 bytes por línea
+    const int corte = lineas / 3;
+    vector<int> ids(lineas);
+    for (int i = 0; i < lineas; i++) ids[i] = i;
+    ids[corte + 1] = corte;         // Justo después del primer corte
+    ids[corte + 2] = corte - 1;
+    ids[lineas / 2] = 0;            // Del primer trozo en el segundo
+    ids[lineas - 1] = 0;            // ... y en el tercero
+    ids[2 * corte + 5] = corte + 9; // Del segundo en el tercero
+
+    FILE* f = fopen(csv, "wb");
+    VERIFICAR(f != NULL);
+    for (int i = 0; i < lineas; i++) {
+        fprintf(f, "%07d,proc_%03d,%02d\n", ids[i], i % 1000, i % 100);
+    }
+    fclose(f);
+
+    vector<bool> visto(lineas, false);
+    vector<int> esperado;
+    for (int i = 0; i < lineas; i++) {
+        if (visto[ids[i]]) continue;
+        visto[ids[i]] = true;
+        esperado.push_back(i);
+    }
+    VERIFICAR_IGUAL(esperado.size(), (size_t)lineas - 5);
+
+    NodoProcesso* paralela = Persistencia::cargarProcesosCsv(csv, 4);
+    NodoProcesso* secuencial = Persistencia::cargarProcesosCsv(csv, 1);
+    remove(csv);
+    size_t k = 0;
+    NodoProcesso* b = secuencial;
+    for (NodoProcesso* a = paralela; a; a = a->siguiente, b = b->siguiente, k++) {
+        VERIFICAR(k < esperado.size());
+        VERIFICAR(b != NULL);
+        int linea = esperado[k];
+        VERIFICAR_IGUAL(a->id, ids[linea]);
+        VERIFICAR_IGUAL(a->prioridad, linea % 100);
+        char nombre[16];
+        snprintf(nombre, sizeof(nombre), "proc_%03d", linea % 1000);
+        VERIFICAR_IGUAL(a->nombre.str(), string(nombre));
+        VERIFICAR_IGUAL(b->id, a->id);
+        VERIFICAR_IGUAL(b->prioridad, a->prioridad);
+        VERIFICAR(b->nombre == a->nombre);
+    }
+    VERIFICAR(b == NULL);
+    VERIFICAR_IGUAL(k, esperado.size());
+    liberar(paralela);
+    liberar(secuencial);
+}
+
+// Un archivo vacío pero válido devuelve NULL; uno que no existe lanza
+PRUEBA_SO(comprimido_vacio_y_ausente) {
+    Persistencia::guardarProcesosComprimido(NULL, ARCHIVO);
+    VERIFICAR(Persistencia::cargarProcesosComprimido(ARCHIVO) == NULL);
+    remove(ARCHIVO);
+    VERIFICAR_LANZA(Persistencia::cargarProcesosComprimido(ARCHIVO));
+    VERIFICAR(Persistencia::cargarProcesos(ARCHIVO) == NULL);
+}
+
+// Guardados en segundo plano mientras otro hilo interna nombres: el hijo
+// también interna y no debe heredar el cerrojo del pool tomado
+PRUEBA_SO(guardado_fondo_con_hilos) {
+    atomic<bool> seguir(true);
+    thread internador([&]() {
+        for (int i = 0; seguir.load(memory_order_relaxed); i++) {
+            PoolNombres::internar("fondo_" + to_string(i % 4096));
+        }
+    });
+    GuardadoFondo guardado;
+    for (int i = 0; i < 20; i++) {
+        VERIFICAR(guardado.iniciar([i]() {
+            if (NombreProceso("hijo_" + to_string(i)).str().empty()) {
+                throw runtime_error("nombre vacío");
+            }
+        }));
+        VERIFICAR(guardado.esperar());
+    }
+    VERIFICAR(guardado.iniciar([]() { throw runtime_error("falla a propósito"); }));
+    VERIFICAR(!guardado.esperar());
+    VERIFICAR_IGUAL(guardado.getUltimoError(), string("falla a propósito"));
+    seguir.store(false);
+    internador.join();
+    VERIFICAR_IGUAL(guardado.getGuardados(), 20);
+}
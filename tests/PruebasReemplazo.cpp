@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "Pruebas.h"
+#include "Reemplazo.h"
+#include "TablaHash.h"
+
+using namespace std;
+
+/* ================================================================
+ *          PRUEBAS DE LA TABLA HASH Y DEL REEMPLAZO DE PÁGINAS
+ * ================================================================ */
+
+PRUEBA_SO(tabla_hash_contra_map) {
+    TablaHash tabla(64);
+    map<uint64_t, uint32_t> modelo;
+    uint64_t azar = 88172645463325252ull;
+    for (int i = 0; i < 20000; i++) {
+        azar ^= azar << 13;
+        azar ^= azar >> 7;
+        azar ^= azar << 17;
+        // Claves de un rango chico: muchas colisiones y rachas largas
+        uint64_t clave = azar % 97;
+        if (azar % 3 == 0) {
+            tabla.borrar(clave);
+            modelo.erase(clave);
+        } else if (modelo.size() < 64 || modelo.count(clave)) {
+            tabla.insertar(clave, (uint32_t)i);
+            modelo[clave] = (uint32_t)i;
+        }
+        VERIFICAR_IGUAL(tabla.size(), modelo.size());
+    }
+    for (uint64_t clave = 0; clave < 97; clave++) {
+        uint32_t* v = tabla.buscar(clave);
+        map<uint64_t, uint32_t>::iterator it = modelo.find(clave);
+        VERIFICAR_IGUAL(v != NULL, it != modelo.end());
+        if (v) VERIFICAR_IGUAL(*v, it->second);
+    }
+}
+
+namespace {
+
+const uint64_t BELADY[] = { 1, 2, 3, 4, 1, 2, 5, 1, 2, 3, 4, 5 };
+
+uint64_t fallosEn(const string& algoritmo, size_t marcos) {
+    unique_ptr<AlgoritmoReemplazo> a(crearAlgoritmoReemplazo(algoritmo, marcos));
+    uint64_t victima;
+    for (size_t i = 0; i < 12; i++) a->referenciar(BELADY[i], victima);
+    return a->getFallos();
+}
+
+} // namespace
+
+PRUEBA_SO(reemplazo_fifo_anomalia_belady) {
+    VERIFICAR_IGUAL(fallosEn("fifo", 3), 9u);
+    VERIFICAR_IGUAL(fallosEn("fifo", 4), 10u);
+}
+
+PRUEBA_SO(reemplazo_lru_secuencia_belady) {
+    VERIFICAR_IGUAL(fallosEn("lru", 3), 10u);
+    VERIFICAR_IGUAL(fallosEn("lru", 4), 8u);
+}
+
+PRUEBA_SO(reemplazo_lfu_conserva_la_frecuente) {
+    ReemplazoLFU lfu(2);
+    uint64_t victima;
+    for (int i = 0; i < 5; i++) lfu.referenciar(7, victima);
+    for (uint64_t p = 100; p < 110; p++) {
+        lfu.referenciar(p, victima);
+        VERIFICAR(victima != 7);
+    }
+    VERIFICAR(!lfu.referenciar(7, victima));
+}
+
+// Invariantes comunes contra un modelo del conjunto residente: un fallo
+// es exactamente una página no residente, la víctima era residente y
+// nunca es la página pedida, y no se supera la capacidad
+PRUEBA_SO(reemplazo_invariantes_todos) {
+    const char* nombres[] = { "fifo", "lru", "clock", "lfu", "arc" };
+    for (int n = 0; n < 5; n++) {
+        unique_ptr<AlgoritmoReemplazo> a(crearAlgoritmoReemplazo(nombres[n], 16));
+        set<uint64_t> residentes;
+        uint64_t azar = 2463534242ull;
+        for (int i = 0; i < 20000; i++) {
+            azar ^= azar << 13;
+            azar ^= azar >> 17;
+            azar ^= azar << 5;
+            uint64_t clave = (azar % 4 == 0) ? azar % 200 : azar % 24;
+            if (azar % 50 == 0 && !residentes.empty()) {
+                uint64_t quitar = *residentes.begin();
+                a->eliminar(quitar);
+                residentes.erase(quitar);
+                continue;
+            }
+            uint64_t victima;
+            bool fallo = a->referenciar(clave, victima);
+            VERIFICAR_IGUAL(fallo, residentes.count(clave) == 0);
+            if (victima != AlgoritmoReemplazo::SIN_VICTIMA) {
+                VERIFICAR(victima != clave);
+                VERIFICAR_IGUAL(residentes.erase(victima), 1u);
+            }
+            residentes.insert(clave);
+            VERIFICAR(residentes.size() <= 16);
+            VERIFICAR_IGUAL(a->residentes(), residentes.size());
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "ProtocoloRPC.h"
+#include "Pruebas.h"
+#include "ServidorSimulador.h"
+
+using namespace std;
+using namespace ProtocoloRPC;
+
+/* ================================================================
+ *                   PRUEBAS DEL SERVIDOR
+ * ================================================================ */
+
+#ifdef __linux__
+
+namespace {
+
+const char* const SOCKET = "prueba_servidor.sock";
+
+// Servidor atendiendo en otro hilo; se detiene aunque la prueba falle
+struct ServidorEnHilo {
+    ServidorSimulador servidor;
+    thread hilo;
+
+    explicit ServidorEnHilo(unsigned hilos) : servidor(SOCKET, hilos) {
+        hilo = thread([this]() { servidor.ejecutar(); });
+    }
+
+    ~ServidorEnHilo() {
+        servidor.detener();
+        hilo.join();
+    }
+};
+
+struct Cliente {
+    int fd;
+    string entrada;
+
+    Cliente() : fd(socket(AF_UNIX, SOCK_STREAM, 0)) {
+        sockaddr_un dir;
+        memset(&dir, 0, sizeof(dir));
+        dir.sun_family = AF_UNIX;
+        strncpy(dir.sun_path, SOCKET, sizeof(dir.sun_path) - 1);
+        VERIFICAR(fd >= 0);
+        VERIFICAR(connect(fd, (const sockaddr*)&dir, sizeof(dir)) == 0);
+    }
+
+    ~Cliente() {
+        if (fd >= 0) close(fd);
+    }
+
+    // Envía una solicitud y espera su respuesta
+    Respuesta pedir(uint32_t instancia, Operacion operacion, int32_t a = 0, int32_t b = 0) {
+        string salida;
+        escribirSolicitud(salida, 1, instancia, operacion, a, b);
+        VERIFICAR(send(fd, salida.data(), salida.size(), MSG_NOSIGNAL) == (ssize_t)salida.size());
+        for (;;) {
+            uint32_t longitud = longitudMensaje(entrada.data(), entrada.size());
+            if (longitud != 0 && entrada.size() >= longitud) {
+                Respuesta r;
+                memcpy(&r, entrada.data(), sizeof(r));
+                entrada.erase(0, longitud);
+                return r;
+            }
+            char buf[4096];
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if (n < 0 && errno == EINTR) continue;
+            VERIFICAR(n > 0);
+            entrada.append(buf, (size_t)n);
+        }
+    }
+};
+
+} // namespace
+
+// Un cliente no puede pedir una instancia enorme ni crear instancias
+// sin límite en un fragmento
+PRUEBA_SO(servidor_limita_creacion) {
+    ServidorEnHilo s(1);
+    Cliente c;
+
+    VERIFICAR_IGUAL(c.pedir(1, CREAR_INSTANCIA, ServidorSimulador::BLOQUES_MAXIMOS + 1).estado,
+                    (int32_t)SOLICITUD_INVALIDA);
+    VERIFICAR_IGUAL(c.pedir(1, CREAR_INSTANCIA, 0, ServidorSimulador::MARCOS_MAXIMOS + 1).estado,
+                    (int32_t)SOLICITUD_INVALIDA);
+    VERIFICAR_IGUAL(c.pedir(1, CREAR_INSTANCIA, INT32_MAX, INT32_MAX).estado,
+                    (int32_t)SOLICITUD_INVALIDA);
+    VERIFICAR_IGUAL(c.pedir(1, CREAR_INSTANCIA, -1, 0).estado, (int32_t)SOLICITUD_INVALIDA);
+    VERIFICAR_IGUAL(c.pedir(1, CONSULTAR_ESTADO).estado, (int32_t)SIN_INSTANCIA);
+
+    // En el límite se crea
+    VERIFICAR_IGUAL(c.pedir(1, CREAR_INSTANCIA, ServidorSimulador::BLOQUES_MAXIMOS,
+                            ServidorSimulador::MARCOS_MAXIMOS).estado,
+                    (int32_t)OK);
+    for (uint32_t i = 2; i <= ServidorSimulador::INSTANCIAS_POR_FRAGMENTO; i++) {
+        VERIFICAR_IGUAL(c.pedir(i, CREAR_INSTANCIA, 0, 16).estado, (int32_t)OK);
+    }
+    uint32_t otra = ServidorSimulador::INSTANCIAS_POR_FRAGMENTO + 1;
+    VERIFICAR_IGUAL(c.pedir(otra, CREAR_INSTANCIA, 0, 16).estado, (int32_t)ERROR_OPERACION);
+
+    // Al destruir una vuelve a haber lugar
+    VERIFICAR_IGUAL(c.pedir(1, DESTRUIR_INSTANCIA).estado, (int32_t)OK);
+    VERIFICAR_IGUAL(c.pedir(otra, CREAR_INSTANCIA, 0, 16).estado, (int32_t)OK);
+    VERIFICAR_IGUAL(c.pedir(otra, CONSULTAR_ESTADO).estado, (int32_t)OK);
+}
+
+#endif // __linux__
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Pruebas.h"
+#include "RuedaTemporizadores.h"
+
+using namespace std;
+
+/* ================================================================
+ *               PRUEBAS DE LA RUEDA DE TEMPORIZADORES
+ * ================================================================ */
+
+namespace {
+
+struct Disparo {
+    uint64_t tick;
+    size_t indice;
+};
+
+} // namespace
+
+// Vencimientos en todos los niveles y en el desborde, avanzando en tramos
+// de distinto largo: cada temporizador dispara en su tick, en orden, y
+// los cancelados después de bajar de nivel no disparan
+PRUEBA_SO(rueda_cascada_y_cancelacion) {
+    const uint64_t R = RuedaTemporizadores::RANURAS;
+    RuedaTemporizadores rueda;
+    vector<Temporizador> temporizadores(2000);
+    vector<bool> cancelado(temporizadores.size(), false);
+
+    uint64_t x = 88172645463325252ull;
+    for (size_t i = 0; i < temporizadores.size(); i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        uint64_t alcance = i % 4 == 0 ? R : i % 4 == 1 ? R * R : i % 4 == 2 ? R * R * R : 4 * R * R * R;
+        temporizadores[i].dueno = &temporizadores[i];
+        rueda.programar(&temporizadores[i], 1 + x % alcance);
+    }
+    // Justo en los bordes de nivel y más allá del alcance total
+    Temporizador bordes[4];
+    uint64_t ticksBorde[4] = { R, R * R, R * R * R, RuedaTemporizadores::ALCANCE + 3 };
+    for (int i = 0; i < 4; i++) rueda.programar(&bordes[i], ticksBorde[i]);
+    VERIFICAR_IGUAL(rueda.getActivos(), temporizadores.size() + 4);
+
+    vector<Disparo> disparos;
+    size_t bordesDisparados = 0;
+    auto alDisparar = [&](Temporizador* t) {
+        if (t >= bordes && t < bordes + 4) {
+            VERIFICAR_IGUAL(rueda.getAhora(), t->expira);
+            bordesDisparados++;
+            return;
+        }
+        Disparo d = { rueda.getAhora(), (size_t)(t - temporizadores.data()) };
+        disparos.push_back(d);
+    };
+
+    // Se avanza hasta pasar varios bordes del segundo nivel; los que
+    // vencen más adelante ya bajaron de nivel y se cancela la mitad
+    uint64_t corte = 3 * R * R + 5;
+    rueda.avanzar(corte - 17, alDisparar);
+    rueda.avanzar(17, alDisparar);
+    size_t cancelados = 0;
+    for (size_t i = 0; i < temporizadores.size(); i += 2) {
+        if (temporizadores[i].expira > corte && temporizadores[i].expira < corte + R * R) {
+            VERIFICAR(rueda.cancelar(&temporizadores[i]));
+            VERIFICAR(!rueda.cancelar(&temporizadores[i]));
+            cancelado[i] = true;
+            cancelados++;
+        }
+    }
+    VERIFICAR(cancelados > 0);
+
+    for (uint64_t paso = 1; rueda.getActivos() > 0; paso = paso * 3 + 1) {
+        rueda.avanzar(paso, alDisparar);
+    }
+    VERIFICAR_IGUAL(bordesDisparados, 4u);
+
+    vector<pair<uint64_t, size_t> > referencia;
+    for (size_t i = 0; i < temporizadores.size(); i++) {
+        if (!cancelado[i]) referencia.push_back(make_pair(temporizadores[i].expira, i));
+    }
+    sort(referencia.begin(), referencia.end());
+    VERIFICAR_IGUAL(disparos.size(), referencia.size());
+    for (size_t i = 0; i < disparos.size(); i++) {
+        if (i > 0) VERIFICAR(disparos[i - 1].tick <= disparos[i].tick);
+        VERIFICAR_IGUAL(disparos[i].tick, temporizadores[disparos[i].indice].expira);
+        VERIFICAR(!cancelado[disparos[i].indice]);
+    }
+    vector<pair<uint64_t, size_t> > obtenidos;
+    for (size_t i = 0; i < disparos.size(); i++) {
+        obtenidos.push_back(make_pair(disparos[i].tick, disparos[i].indice));
+    }
+    sort(obtenidos.begin(), obtenidos.end());
+    VERIFICAR(obtenidos == referencia);
+}
+
+// Reprogramar desde el callback y programar en el pasado
+PRUEBA_SO(rueda_reprogramar_y_vencidos) {
+    RuedaTemporizadores rueda;
+    rueda.reiniciar(1000);
+    Temporizador t;
+    rueda.programar(&t, 10);
+    vector<uint64_t> ticks;
+    rueda.avanzar(1, [&](Temporizador*) { ticks.push_back(rueda.getAhora()); });
+    VERIFICAR_IGUAL(ticks.size(), 1u);
+    VERIFICAR_IGUAL(ticks[0], 1001u);
+
+    ticks.clear();
+    int veces = 0;
+    rueda.programar(&t, 1000 + 100);
+    rueda.avanzar(10200, [&](Temporizador* p) {
+        ticks.push_back(rueda.getAhora());
+        if (++veces < 3) rueda.programar(p, rueda.getAhora() + 5000);
+    });
+    VERIFICAR_IGUAL(ticks.size(), 3u);
+    VERIFICAR_IGUAL(ticks[0], 1100u);
+    VERIFICAR_IGUAL(ticks[1], 6100u);
+    VERIFICAR_IGUAL(ticks[2], 11100u);
+    VERIFICAR_IGUAL(rueda.getActivos(), 0u);
+}
@@ -0,0 +1,59 @@
+#include "ColaPrioridad.h"
+#include "NodoProcesso.h"
+#include "Pruebas.h"
+#include "TiempoReal.h"
+
+using namespace std;
+
+/* ================================================================
+ *                   PRUEBAS DE TIEMPO REAL
+ * ================================================================ */
+
+PRUEBA_SO(admision_cotas_por_politica) {
+    // Dos tareas de densidad 0.4 caben en la cota RM de dos (0.828); una
+    // tercera de 0.1 supera la de tres (0.780) pero cabe con EDF
+    AdmisionTiempoReal rm;
+    rm.setPolitica(PLAN_RATE_MONOTONIC);
+    TareaTiempoReal a(10, 4), b(20, 8), c(50, 5);
+    rm.admitir(a);
+    rm.admitir(b);
+    VERIFICAR_LANZA(rm.admitir(c));
+    VERIFICAR(!c.admitida);
+    VERIFICAR_IGUAL(rm.getTareas(), 2u);
+
+    AdmisionTiempoReal edf;
+    edf.setPolitica(PLAN_EDF);
+    TareaTiempoReal d(10, 4), e(20, 8), f(50, 5);
+    edf.admitir(d);
+    edf.admitir(e);
+    edf.admitir(f);
+    VERIFICAR_IGUAL(edf.getTareas(), 3u);
+
+    // Al retirar una tarea vuelve a haber lugar
+    rm.retirar(b);
+    rm.admitir(c);
+    VERIFICAR_IGUAL(rm.getTareas(), 2u);
+
+    // Parámetros fuera de 0 < costo <= plazo <= periodo
+    TareaTiempoReal mala(10, 6, 5);
+    VERIFICAR_LANZA(edf.admitir(mala));
+}
+
+// Con plazo < periodo la admisión por densidad solo vale si el orden
+// sigue el plazo relativo: la tarea de periodo largo y plazo corto va
+// antes que la de periodo corto
+PRUEBA_SO(rate_monotonic_ordena_por_plazo) {
+    NodoProcesso larga(1, NombreProceso("larga"), 50);
+    NodoProcesso corta(2, NombreProceso("corta"), 50);
+    larga.tiempoReal = TareaTiempoReal(100, 5, 10);
+    corta.tiempoReal = TareaTiempoReal(20, 5);
+    larga.tiempoReal.activar(0);
+    corta.tiempoReal.activar(0);
+
+    ColaPrioridad cola;
+    cola.setPolitica(PLAN_RATE_MONOTONIC);
+    cola.encolarPrioridad(&corta);
+    cola.encolarPrioridad(&larga);
+    VERIFICAR_IGUAL(cola.desencolar()->id, 1);
+    VERIFICAR_IGUAL(cola.desencolar()->id, 2);
+}
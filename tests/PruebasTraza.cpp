@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ColaPrioridad.h"
+#include "NodoProcesso.h"
+#include "Pruebas.h"
+#include "ReproductorTraza.h"
+#include "Traza.h"
+
+using namespace std;
+
+/* ================================================================
+ *                   PRUEBAS DE TRAZAS
+ * ================================================================ */
+
+#if SO_TRAZA
+
+namespace {
+
+const char* const ARCHIVO = "prueba_traza.sotr";
+
+} // namespace
+
+// La cola ya ordena por RM al empezar la grabación y pasa a prioridad y
+// luego a EDF a mitad de la sesión: la reproducción debe despachar en el
+// mismo orden, y sin los cambios de política grabados no lo hace
+PRUEBA_SO(traza_reproduce_cambios_de_politica) {
+    vector<unique_ptr<NodoProcesso> > procesos;
+    NombreProceso nombre("trazado");
+    for (int i = 0; i < 24; i++) {
+        procesos.push_back(unique_ptr<NodoProcesso>(new NodoProcesso(i, nombre, (i * 37) % 100)));
+        // Uno de cada tres es de tiempo real, con plazos que no siguen el ID
+        if (i % 3 == 0) {
+            NodoProcesso& p = *procesos.back();
+            p.tiempoReal = TareaTiempoReal(200 - (uint64_t)i * 5, 3, 100 - (uint64_t)(i % 7) * 10);
+            p.tiempoReal.activar((uint64_t)(i % 5) * 20);
+        }
+    }
+
+    ColaPrioridad cola;
+    cola.setPeriodoEnvejecimiento(2);
+    cola.setPolitica(PLAN_RATE_MONOTONIC);
+    for (int i = 0; i < 8; i++) cola.encolarPrioridad(procesos[i].get());
+    cola.avanzarReloj(3);
+
+    VERIFICAR(Traza::iniciar(ARCHIVO));
+    vector<int> despachados;
+    for (int i = 0; i < 3; i++) despachados.push_back(cola.desencolar()->id);
+    for (int i = 8; i < 16; i++) cola.encolarPrioridad(procesos[i].get());
+    cola.setPolitica(PLAN_PRIORIDAD);
+    for (int i = 0; i < 5; i++) {
+        NodoProcesso* p = cola.desencolar();
+        despachados.push_back(p->id);
+        cola.avanzarReloj(1);
+        if (i % 2 == 0) cola.encolarPrioridad(p);
+    }
+    cola.cambiarPrioridad(10, 99);
+    cola.setPolitica(PLAN_EDF);
+    for (int i = 16; i < 24; i++) cola.encolarPrioridad(procesos[i].get());
+    while (cola.contarProcesos() > 0) despachados.push_back(cola.desencolar()->id);
+    Traza::detener();
+
+    Traza::TrazaCargada traza = Traza::cargar(ARCHIVO);
+    remove(ARCHIVO);
+    ReproductorTraza reproductor;
+    reproductor.reproducir(traza);
+    VERIFICAR_IGUAL(reproductor.getDivergencias(), 0u);
+    VERIFICAR_IGUAL(reproductor.getPorOperacion(Traza::COLA_POLITICA), 3u);
+    VERIFICAR(reproductor.getPorOperacion(Traza::COLA_PLAZOS) >= 8u);
+    VERIFICAR_IGUAL(reproductor.getPorOperacion(Traza::COLA_DESENCOLAR), (uint64_t)despachados.size());
+
+    Traza::TrazaCargada sinPolitica;
+    sinPolitica.hilos = traza.hilos;
+    sinPolitica.textos = traza.textos;
+    for (size_t i = 0; i < traza.eventos.size(); i++) {
+        if (traza.eventos[i].operacion != Traza::COLA_POLITICA) {
+            sinPolitica.eventos.push_back(traza.eventos[i]);
+        }
+    }
+    reproductor.reiniciar();
+    reproductor.reproducir(sinPolitica);
+    VERIFICAR(reproductor.getDivergencias() > 0);
+}
+
+#endif // SO_TRAZA